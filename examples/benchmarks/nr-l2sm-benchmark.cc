@@ -0,0 +1,555 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/core-module.h"
+#include "ns3/lte-chunk-processor.h"
+#include "ns3/nr-amc.h"
+#include "ns3/nr-error-model.h"
+#include "ns3/nr-interference.h"
+#include "ns3/nr-spectrum-value-helper.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+/**
+ * \file nr-l2sm-benchmark.cc
+ * \ingroup examples
+ * \brief Microbenchmark of the PHY abstraction: error models, AMC and interference
+ *
+ * The benchmark measures, in isolation and without any channel or PHY, the
+ * cost of the pieces of the link-to-system mapping (L2SM) that are executed for
+ * every received transport block or CSI report:
+ *
+ * - "em": NrErrorModel::GetTbDecodificationStats of each error model, for
+ *   HARQ histories of 0 up to maxHistory previous transmissions. The history
+ *   is built as the PHY does, by feeding back the outputs of the error model;
+ * - "amc": NrAmc::CreateCqiFeedbackWbTdma, with the ErrorModel AMC model for
+ *   each error model, and with the ShannonModel;
+ * - "interference": NrInterference, for a reception with a number of
+ *   overlapping interferers that start at random times, each one creating a
+ *   new SINR chunk to evaluate.
+ *
+ * The SINR vectors are random, but reproducible: each point of the sweep
+ * (bandwidth in RB, numerology) uses the same random streams. For each RB, the
+ * SINR (in dB) is the mean SINR of the TB, uniformly distributed between
+ * sinrMinDb and sinrMaxDb, plus a normal fading term with fadingStdDb deviation.
+ *
+ * For each measure, the output is a CSV line with: the time and the throughput
+ * of the operation (TB/s for "em", CQI reports/s for "amc", receptions/s for
+ * "interference"), the number and the bytes of the heap allocations done in
+ * each operation, the heap bytes retained by a HARQ history (only for "em"),
+ * and the mean output (TBLER for "em", CQI for "amc", SINR chunks per
+ * reception for "interference"). The heap allocations are counted by
+ * replacing the global operator new and delete in this executable.
+ *
+ * \code{.unparsed}
+$ ./ns3 run "nr-l2sm-benchmark --rbNums=25,273 --numerologies=1 --maxHistory=3
+   --errorModels=ns3::NrEesmIrT1,ns3::NrEesmCcT2,ns3::NrLteMiErrorModel --outputFile=l2sm.csv"
+   \endcode
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("NrL2smBenchmark");
+
+static uint64_t g_allocCount = 0; //!< Number of heap allocations done since the start
+static uint64_t g_allocBytes = 0; //!< Bytes allocated on the heap since the start
+static int64_t g_liveBytes = 0;   //!< Bytes currently allocated on the heap
+
+/**
+ * \brief Allocate memory, and account for it
+ * \param size requested size
+ * \return the allocated memory, or nullptr
+ *
+ * The size of the allocation is stored before the returned pointer, to be
+ * able to account for it when it is freed.
+ */
+static void*
+CountedAlloc(std::size_t size)
+{
+    void* ptr = std::malloc(size + alignof(std::max_align_t));
+    if (ptr == nullptr)
+    {
+        return nullptr;
+    }
+    *static_cast<std::size_t*>(ptr) = size;
+    ++g_allocCount;
+    g_allocBytes += size;
+    g_liveBytes += static_cast<int64_t>(size);
+    return static_cast<char*>(ptr) + alignof(std::max_align_t);
+}
+
+/**
+ * \brief Free memory allocated with CountedAlloc
+ * \param ptr the pointer returned by CountedAlloc
+ */
+static void
+CountedFree(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    char* base = static_cast<char*>(ptr) - alignof(std::max_align_t);
+    g_liveBytes -= static_cast<int64_t>(*reinterpret_cast<std::size_t*>(base));
+    std::free(base);
+}
+
+void*
+operator new(std::size_t size)
+{
+    void* ptr = CountedAlloc(size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void*
+operator new[](std::size_t size)
+{
+    void* ptr = CountedAlloc(size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    CountedFree(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+    CountedFree(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+    CountedFree(ptr);
+}
+
+void
+operator delete[](void* ptr, std::size_t) noexcept
+{
+    CountedFree(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    CountedFree(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    CountedFree(ptr);
+}
+
+/**
+ * \brief Configuration common to all the points of the sweep
+ */
+struct BenchmarkConfig
+{
+    uint32_t m_samples{1000};  //!< Number of random SINR vectors for each measure
+    uint32_t m_maxHistory{3};  //!< Maximum number of previous transmissions in the history
+    uint32_t m_symbols{12};    //!< Number of OFDM symbols of each TB
+    double m_sinrMinDb{-5.0};  //!< Minimum mean SINR of a TB
+    double m_sinrMaxDb{25.0};  //!< Maximum mean SINR of a TB
+    double m_fadingStdDb{3.0}; //!< Standard deviation of the SINR of each RB around the mean
+    uint32_t m_interferers{3}; //!< Number of interferers for each reception
+};
+
+/**
+ * \brief A single measure, that will become a CSV line
+ */
+struct BenchmarkMeasure
+{
+    std::string m_section;     //!< Section (em, amc, interference)
+    std::string m_model;       //!< Model under test
+    uint32_t m_history{0};     //!< Number of previous transmissions in the history
+    uint32_t m_ops{0};         //!< Number of measured operations
+    double m_ns{0.0};          //!< Total time spent in the operations
+    uint64_t m_allocs{0};      //!< Total number of heap allocations
+    uint64_t m_bytes{0};       //!< Total heap bytes allocated
+    int64_t m_historyBytes{0}; //!< Heap bytes retained by a history
+    double m_outputSum{0.0};   //!< Sum of the outputs of the operations
+};
+
+/**
+ * \brief Random SINR vectors for a point of the sweep
+ */
+struct SinrSamples
+{
+    std::vector<SpectrumValue> m_sinr; //!< SINR (linear) of each sample
+    std::vector<double> m_uniform;     //!< An uniform value in [0, 1) for each sample
+};
+
+/**
+ * \brief Generate the SINR samples
+ * \param model the spectrum model
+ * \param conf the configuration
+ * \param num number of samples
+ * \param stream the random stream to use
+ * \return the samples
+ */
+static SinrSamples
+GenerateSamples(const Ptr<const SpectrumModel>& model,
+                const BenchmarkConfig& conf,
+                uint32_t num,
+                int64_t stream)
+{
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(stream);
+    Ptr<NormalRandomVariable> fading = CreateObject<NormalRandomVariable>();
+    fading->SetAttribute("Variance", DoubleValue(conf.m_fadingStdDb * conf.m_fadingStdDb));
+    fading->SetStream(stream + 1);
+
+    SinrSamples samples;
+    for (uint32_t i = 0; i < num; ++i)
+    {
+        double meanDb = uniform->GetValue(conf.m_sinrMinDb, conf.m_sinrMaxDb);
+        SpectrumValue sinr(model);
+        for (auto it = sinr.ValuesBegin(); it != sinr.ValuesEnd(); ++it)
+        {
+            *it = std::pow(10.0, (meanDb + fading->GetValue()) / 10.0);
+        }
+        samples.m_sinr.push_back(sinr);
+        samples.m_uniform.push_back(uniform->GetValue());
+    }
+    return samples;
+}
+
+/**
+ * \brief Measure GetTbDecodificationStats of an error model
+ * \param emType the error model type
+ * \param model the spectrum model
+ * \param conf the configuration
+ * \param history number of previous transmissions
+ * \return the measure
+ */
+static BenchmarkMeasure
+MeasureErrorModel(const std::string& emType,
+                  const Ptr<const SpectrumModel>& model,
+                  const BenchmarkConfig& conf,
+                  uint32_t history)
+{
+    ObjectFactory factory;
+    factory.SetTypeId(emType);
+    Ptr<NrErrorModel> em = DynamicCast<NrErrorModel>(factory.Create());
+    NS_ABORT_MSG_IF(em == nullptr, "Can't create a NrErrorModel from type " << emType);
+
+    uint32_t numRbs = model->GetNumBands();
+    std::vector<int> map(numRbs);
+    for (uint32_t rb = 0; rb < numRbs; ++rb)
+    {
+        map.at(rb) = static_cast<int>(rb);
+    }
+
+    // One sample for the transmission under test, and one for each previous one
+    SinrSamples samples = GenerateSamples(model, conf, conf.m_samples * (history + 1), 1);
+
+    std::vector<uint8_t> mcs;
+    std::vector<uint32_t> tbSize;
+    for (uint32_t i = 0; i < conf.m_samples; ++i)
+    {
+        mcs.push_back(static_cast<uint8_t>(samples.m_uniform.at(i) * (em->GetMaxMcs() + 1)));
+        tbSize.push_back(em->GetPayloadSize(NrSpectrumValueHelper::SUBCARRIERS_PER_RB - 1,
+                                            mcs.back(),
+                                            numRbs * conf.m_symbols,
+                                            NrErrorModel::DL));
+    }
+
+    BenchmarkMeasure measure;
+    measure.m_section = "em";
+    measure.m_model = emType;
+    measure.m_history = history;
+    measure.m_ops = conf.m_samples;
+
+    // Build the histories, as the PHY does: each output is appended to the history
+    std::vector<NrErrorModel::NrErrorModelHistory> histories(conf.m_samples);
+    int64_t liveBefore = g_liveBytes;
+    for (uint32_t i = 0; i < conf.m_samples; ++i)
+    {
+        for (uint32_t h = 0; h < history; ++h)
+        {
+            histories.at(i).push_back(
+                em->GetTbDecodificationStats(samples.m_sinr.at(conf.m_samples * (h + 1) + i),
+                                             map,
+                                             tbSize.at(i),
+                                             mcs.at(i),
+                                             histories.at(i)));
+        }
+    }
+    measure.m_historyBytes = (g_liveBytes - liveBefore) / conf.m_samples;
+
+    uint64_t allocCount = g_allocCount;
+    uint64_t allocBytes = g_allocBytes;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < conf.m_samples; ++i)
+    {
+        measure.m_outputSum += em->GetTbDecodificationStats(samples.m_sinr.at(i),
+                                                            map,
+                                                            tbSize.at(i),
+                                                            mcs.at(i),
+                                                            histories.at(i))
+                                   ->m_tbler;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    measure.m_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    measure.m_allocs = g_allocCount - allocCount;
+    measure.m_bytes = g_allocBytes - allocBytes;
+    return measure;
+}
+
+/**
+ * \brief Measure NrAmc::CreateCqiFeedbackWbTdma
+ * \param emType the error model type, or an empty string for the ShannonModel
+ * \param model the spectrum model
+ * \param conf the configuration
+ * \return the measure
+ */
+static BenchmarkMeasure
+MeasureAmc(const std::string& emType,
+           const Ptr<const SpectrumModel>& model,
+           const BenchmarkConfig& conf)
+{
+    Ptr<NrAmc> amc = CreateObject<NrAmc>();
+    amc->SetDlMode();
+    if (emType.empty())
+    {
+        amc->SetAttribute("AmcModel", EnumValue(NrAmc::ShannonModel));
+    }
+    else
+    {
+        amc->SetAttribute("AmcModel", EnumValue(NrAmc::ErrorModel));
+        amc->SetAttribute("ErrorModelType", TypeIdValue(TypeId::LookupByName(emType)));
+    }
+
+    SinrSamples samples = GenerateSamples(model, conf, conf.m_samples, 1);
+
+    BenchmarkMeasure measure;
+    measure.m_section = "amc";
+    measure.m_model = emType.empty() ? "ShannonModel" : emType;
+    measure.m_ops = conf.m_samples;
+
+    uint64_t allocCount = g_allocCount;
+    uint64_t allocBytes = g_allocBytes;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& sinr : samples.m_sinr)
+    {
+        uint8_t mcs = 0;
+        measure.m_outputSum += amc->CreateCqiFeedbackWbTdma(sinr, mcs);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    measure.m_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    measure.m_allocs = g_allocCount - allocCount;
+    measure.m_bytes = g_allocBytes - allocBytes;
+    return measure;
+}
+
+/**
+ * \brief Count the SINR chunks evaluated by the interference
+ * \param chunks the counter
+ * \param sinr the SINR of the chunk (unused)
+ */
+static void
+CountChunk(uint32_t* chunks, [[maybe_unused]] const SpectrumValue& sinr)
+{
+    ++(*chunks);
+}
+
+/**
+ * \brief Measure the chunk processing of NrInterference
+ * \param model the spectrum model
+ * \param conf the configuration
+ * \param numerology the numerology, which sets the duration of a reception
+ * \return the measure
+ */
+static BenchmarkMeasure
+MeasureInterference(const Ptr<const SpectrumModel>& model,
+                    const BenchmarkConfig& conf,
+                    uint16_t numerology)
+{
+    Ptr<NrInterference> interference = CreateObject<NrInterference>();
+    Ptr<const SpectrumValue> noise =
+        NrSpectrumValueHelper::CreateNoisePowerSpectralDensity(5.0, model);
+    interference->SetNoisePowerSpectralDensity(noise);
+
+    uint32_t chunks = 0;
+    Ptr<LteChunkProcessor> processor = Create<LteChunkProcessor>();
+    processor->AddCallback(MakeBoundCallback(&CountChunk, &chunks));
+    interference->AddSinrChunkProcessor(processor);
+
+    int64_t slotNs = static_cast<int64_t>(1e6 / std::pow(2, numerology));
+    Time slot = NanoSeconds(slotNs);
+    SinrSamples samples =
+        GenerateSamples(model, conf, conf.m_samples * (conf.m_interferers + 1), 1);
+
+    // Each reception lasts a slot, and it is followed by a slot of silence. Each
+    // interferer starts at a random time within the reception, and lasts a slot.
+    for (uint32_t i = 0; i < conf.m_samples; ++i)
+    {
+        Time start = NanoSeconds(slotNs * (2 * i + 1));
+        Ptr<SpectrumValue> rx = Create<SpectrumValue>((*noise) * samples.m_sinr.at(i));
+        Simulator::Schedule(start, [=]() {
+            interference->AddSignal(rx, slot);
+            interference->StartRx(rx);
+        });
+        for (uint32_t j = 0; j < conf.m_interferers; ++j)
+        {
+            uint32_t idx = conf.m_samples * (j + 1) + i;
+            Ptr<SpectrumValue> interf =
+                Create<SpectrumValue>((*noise) * samples.m_sinr.at(idx) * 0.1);
+            Time offset = NanoSeconds(static_cast<int64_t>(slotNs * samples.m_uniform.at(idx)));
+            Simulator::Schedule(start + offset,
+                                [=]() { interference->AddSignal(interf, slot); });
+        }
+        Simulator::Schedule(start + slot, [=]() { interference->EndRx(); });
+    }
+
+    BenchmarkMeasure measure;
+    measure.m_section = "interference";
+    measure.m_model = "ns3::NrInterference";
+    measure.m_ops = conf.m_samples;
+
+    // The time includes the simulator event handling, which is common to all
+    // the versions of NrInterference
+    uint64_t allocCount = g_allocCount;
+    uint64_t allocBytes = g_allocBytes;
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto end = std::chrono::steady_clock::now();
+
+    measure.m_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    measure.m_allocs = g_allocCount - allocCount;
+    measure.m_bytes = g_allocBytes - allocBytes;
+    measure.m_outputSum = chunks;
+
+    Simulator::Destroy();
+    return measure;
+}
+
+/**
+ * \brief Split a comma-separated list
+ * \param list the list
+ * \return the elements of the list
+ */
+static std::vector<std::string>
+SplitList(const std::string& list)
+{
+    std::vector<std::string> ret;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            ret.push_back(item);
+        }
+    }
+    return ret;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string errorModels = "ns3::NrEesmIrT1,ns3::NrEesmIrT2,ns3::NrEesmCcT1,"
+                              "ns3::NrEesmCcT2,ns3::NrLteMiErrorModel";
+    std::string rbNums = "25,106,273";
+    std::string numerologies = "0,1";
+    std::string outputFile;
+    BenchmarkConfig conf;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("errorModels", "Comma-separated list of error model TypeId", errorModels);
+    cmd.AddValue("rbNums", "Comma-separated list of bandwidths, in number of RB", rbNums);
+    cmd.AddValue("numerologies", "Comma-separated list of numerologies", numerologies);
+    cmd.AddValue("samples", "Number of random SINR vectors for each measure", conf.m_samples);
+    cmd.AddValue("maxHistory", "Maximum number of previous transmissions", conf.m_maxHistory);
+    cmd.AddValue("symbols", "Number of OFDM symbols of each TB", conf.m_symbols);
+    cmd.AddValue("sinrMinDb", "Minimum mean SINR of a TB, in dB", conf.m_sinrMinDb);
+    cmd.AddValue("sinrMaxDb", "Maximum mean SINR of a TB, in dB", conf.m_sinrMaxDb);
+    cmd.AddValue("fadingStdDb", "Standard deviation of the SINR of each RB", conf.m_fadingStdDb);
+    cmd.AddValue("interferers", "Number of interferers for each reception", conf.m_interferers);
+    cmd.AddValue("outputFile", "CSV output file (empty for the standard output)", outputFile);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(conf.m_samples == 0, "At least one sample is needed");
+    NS_ABORT_MSG_IF(conf.m_sinrMinDb > conf.m_sinrMaxDb, "Wrong SINR range");
+
+    std::ofstream file;
+    if (!outputFile.empty())
+    {
+        file.open(outputFile, std::ios_base::out | std::ios_base::trunc);
+        NS_ABORT_MSG_IF(!file.is_open(), "Can't open file " << outputFile);
+    }
+    std::ostream& out = outputFile.empty() ? std::cout : file;
+
+    out << "section,model,rbs,numerology,history,ops,nsPerOp,opsPerSec,allocsPerOp,bytesPerOp,"
+           "historyBytes,meanOutput"
+        << std::endl;
+
+    auto print = [&out](const BenchmarkMeasure& m, uint32_t rbs, uint16_t numerology) {
+        out << m.m_section << "," << m.m_model << "," << rbs << "," << numerology << ","
+            << m.m_history << "," << m.m_ops << "," << m.m_ns / m.m_ops << ","
+            << m.m_ops / (m.m_ns * 1e-9) << "," << static_cast<double>(m.m_allocs) / m.m_ops
+            << "," << static_cast<double>(m.m_bytes) / m.m_ops << "," << m.m_historyBytes << ","
+            << m.m_outputSum / m.m_ops << std::endl;
+    };
+
+    for (const auto& numerologyStr : SplitList(numerologies))
+    {
+        uint16_t numerology = static_cast<uint16_t>(std::stoul(numerologyStr));
+        NS_ABORT_MSG_IF(numerology > 5, "Numerology " << numerology << " is not valid");
+
+        for (const auto& rbStr : SplitList(rbNums))
+        {
+            uint32_t rbs = static_cast<uint32_t>(std::stoul(rbStr));
+            NS_ABORT_MSG_IF(rbs == 0, "The bandwidth must have at least one RB");
+            Ptr<const SpectrumModel> model =
+                NrSpectrumValueHelper::GetSpectrumModel(rbs, 28e9, 15e3 * std::pow(2, numerology));
+
+            for (const auto& em : SplitList(errorModels))
+            {
+                for (uint32_t history = 0; history <= conf.m_maxHistory; ++history)
+                {
+                    print(MeasureErrorModel(em, model, conf, history), rbs, numerology);
+                }
+                print(MeasureAmc(em, model, conf), rbs, numerology);
+            }
+            print(MeasureAmc("", model, conf), rbs, numerology);
+            print(MeasureInterference(model, conf, numerology), rbs, numerology);
+        }
+    }
+
+    return 0;
+}
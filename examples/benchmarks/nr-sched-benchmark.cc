@@ -0,0 +1,672 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/core-module.h"
+#include "ns3/eps-bearer.h"
+#include "ns3/nr-amc.h"
+#include "ns3/nr-mac-csched-sap.h"
+#include "ns3/nr-mac-sched-sap.h"
+#include "ns3/nr-mac-scheduler-ns3.h"
+#include "ns3/nr-mac-short-bsr-ce.h"
+#include "ns3/nr-spectrum-value-helper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <sys/resource.h>
+
+/**
+ * \file nr-sched-benchmark.cc
+ * \ingroup examples
+ * \brief Microbenchmark of the NR MAC schedulers, without PHY or channel
+ *
+ * The benchmark creates a scheduler (any subclass of NrMacSchedulerNs3, e.g.
+ * the OFDMA and TDMA variants of RR, PF, MR and QoS) and drives it only
+ * through the SAP interfaces, exactly as NrGnbMac does. There is no PHY,
+ * spectrum, or channel: the MAC side of the SAP is a stub that
+ * generates synthetic feedback:
+ *
+ * - a wideband DL CQI for each UE, every cqiPeriod slots;
+ * - a full RLC buffer for each DL LC, refreshed every slot;
+ * - a SHORT_BSR for each UE, refreshed every slot;
+ * - a PUSCH UL CQI for each UL data allocation, in the slot it is transmitted;
+ * - DL and UL HARQ feedback for each data allocation, with a configurable BLER.
+ *
+ * For each point of the sweep (scheduler type, number of UEs, number of RBG,
+ * number of beams, number of LC per UE) the benchmark measures the wall-clock
+ * time spent in SchedDlTriggerReq and SchedUlTriggerReq (that is, the complete
+ * DL and UL scheduling of a slot, DoScheduleDlData/DoScheduleUlData included),
+ * the number of data allocations per slot, and the peak resident memory of
+ * the process. The first warmUpSlots slots are not included in the statistics.
+ *
+ * The output is a CSV line for each point, with an header line, written on the
+ * standard output or in the file specified by --outputFile. Please note that
+ * the peak memory is the high-water mark of the whole process: to have an
+ * isolated value for a point, run the benchmark with a single point.
+ *
+ * An example of a sweep:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "nr-sched-benchmark --schedulers=ns3::NrMacSchedulerTdmaRR,ns3::NrMacSchedulerOfdmaPF
+   --ueNums=10,100 --rbgNums=25,100 --beamNums=1,4 --lcNums=1,4 --outputFile=sched.csv"
+   \endcode
+ *
+ * Scheduler attributes can be changed as usual, e.g.,
+ * --ns3::NrMacSchedulerNs3::EnableHarqReTx=false.
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("NrSchedBenchmark");
+
+/**
+ * \brief Configuration common to all the points of the sweep
+ */
+struct BenchmarkConfig
+{
+    uint32_t m_slots{1000};        //!< Number of measured slots
+    uint32_t m_warmUpSlots{100};   //!< Number of slots excluded from the statistics
+    uint16_t m_numerology{1};      //!< Numerology
+    uint32_t m_numRbPerRbg{1};     //!< Number of RB per RBG
+    uint32_t m_bufferBytes{10000}; //!< Bytes in each LC buffer, refreshed every slot
+    uint32_t m_cqiPeriod{10};      //!< Period (in slots) of the DL CQI
+    uint32_t m_harqDelay{2};       //!< Delay (in slots) of the DL HARQ feedback
+    uint32_t m_l1L2CtrlLatency{2}; //!< Slots between now and the DL slot being scheduled
+    uint32_t m_k2Delay{2};         //!< Slots between the DL and the UL slot being scheduled
+    double m_dlBler{0.1};          //!< Probability of a NACK for a DL TB
+    double m_ulBler{0.1};          //!< Probability of a NACK for a UL TB
+};
+
+/**
+ * \brief A point of the sweep
+ */
+struct BenchmarkPoint
+{
+    std::string m_scheduler; //!< Scheduler TypeId name
+    uint32_t m_ues{0};       //!< Number of UEs
+    uint32_t m_rbgs{0};      //!< Number of RBG
+    uint32_t m_beams{0};     //!< Number of beams over which the UEs are distributed
+    uint32_t m_lcs{0};       //!< Number of LC per UE
+};
+
+/**
+ * \brief The results of a point of the sweep
+ */
+struct BenchmarkResult
+{
+    double m_dlNsMean{0.0};       //!< Mean ns spent in a DL scheduling
+    double m_dlNsP50{0.0};        //!< Median ns spent in a DL scheduling
+    double m_dlNsP99{0.0};        //!< 99th percentile of ns spent in a DL scheduling
+    double m_ulNsMean{0.0};       //!< Mean ns spent in a UL scheduling
+    double m_ulNsP50{0.0};        //!< Median ns spent in a UL scheduling
+    double m_ulNsP99{0.0};        //!< 99th percentile of ns spent in a UL scheduling
+    double m_dlAllocPerSlot{0.0}; //!< Mean DL data allocations per slot
+    double m_ulAllocPerSlot{0.0}; //!< Mean UL data allocations per slot
+    uint64_t m_peakRssKb{0};      //!< Peak resident memory of the process, in kB
+};
+
+/**
+ * \brief The CSCHED SAP user of the benchmark, that ignores everything
+ */
+class BenchCschedSapUser : public NrMacCschedSapUser
+{
+  public:
+    void CschedCellConfigCnf(
+        [[maybe_unused]] const struct CschedCellConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigCnf(
+        [[maybe_unused]] const struct CschedUeConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcConfigCnf(
+        [[maybe_unused]] const struct CschedLcConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcReleaseCnf(
+        [[maybe_unused]] const struct CschedLcReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeReleaseCnf(
+        [[maybe_unused]] const struct CschedUeReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigUpdateInd(
+        [[maybe_unused]] const struct CschedUeConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void CschedCellConfigUpdateInd(
+        [[maybe_unused]] const struct CschedCellConfigUpdateIndParameters& params) override
+    {
+    }
+};
+
+/**
+ * \brief Drive a scheduler for a single point of the sweep
+ *
+ * The class acts as the MAC: it configures the scheduler, and then, slot after
+ * slot, passes the synthetic feedback and triggers the DL and UL scheduling.
+ * The allocations returned through SchedConfigInd are used to generate the
+ * HARQ and UL CQI feedback for the following slots.
+ */
+class NrSchedBenchmark : public NrMacSchedSapUser
+{
+  public:
+    /**
+     * \brief NrSchedBenchmark constructor
+     * \param point the point of the sweep
+     * \param conf the common configuration
+     */
+    NrSchedBenchmark(const BenchmarkPoint& point, const BenchmarkConfig& conf);
+
+    /**
+     * \brief Run the benchmark
+     * \return the results
+     */
+    BenchmarkResult Run();
+
+    void SchedConfigInd(const struct SchedConfigIndParameters& params) override;
+
+    Ptr<const SpectrumModel> GetSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    uint32_t GetNumRbPerRbg() const override
+    {
+        return m_conf.m_numRbPerRbg;
+    }
+
+    uint8_t GetNumHarqProcess() const override
+    {
+        return 20;
+    }
+
+    uint16_t GetBwpId() const override
+    {
+        return 0;
+    }
+
+    uint16_t GetCellId() const override
+    {
+        return 1;
+    }
+
+    uint32_t GetSymbolsPerSlot() const override
+    {
+        return 14;
+    }
+
+    Time GetSlotPeriod() const override
+    {
+        return Seconds(0.001 / std::pow(2, m_conf.m_numerology));
+    }
+
+  private:
+    /**
+     * \brief Create and configure the scheduler, the UEs and their LCs
+     */
+    void Setup();
+    /**
+     * \brief Pass to the scheduler the feedback that should arrive in a slot
+     * \param airSfn the slot that is currently "in the air"
+     * \param slotIdx index of the slot since the start of the benchmark
+     */
+    void SendFeedback(const SfnSf& airSfn, uint32_t slotIdx);
+
+    BenchmarkPoint m_point;             //!< Point of the sweep
+    BenchmarkConfig m_conf;             //!< Common configuration
+    Ptr<const SpectrumModel> m_model;   //!< Spectrum model, used for the UL CQI
+    BenchCschedSapUser m_cschedSapUser; //!< CSCHED SAP user
+    Ptr<NrMacSchedulerNs3> m_sched;     //!< The scheduler under test
+    Ptr<UniformRandomVariable> m_rng;   //!< Random variable for CQI and HARQ
+
+    std::vector<uint8_t> m_ueDlCqi;     //!< Mean DL CQI of each UE
+    std::vector<double> m_ueUlSinr;     //!< UL SINR (linear) of each UE
+    std::vector<DlHarqInfo> m_dlHarqIn; //!< DL HARQ feedback for the next DL trigger
+    std::vector<UlHarqInfo> m_ulHarqIn; //!< UL HARQ feedback for the next UL trigger
+    uint32_t m_dlAllocs{0};             //!< DL data allocations in the current slot
+    uint32_t m_ulAllocs{0};             //!< UL data allocations in the current slot
+
+    /// DL HARQ feedback, indexed by the (normalized) slot in which it arrives
+    std::map<uint64_t, std::vector<DlHarqInfo>> m_dlHarqPending;
+    /// UL data allocations, indexed by the (normalized) slot in which they are transmitted
+    std::map<uint64_t, std::pair<SfnSf, std::vector<std::shared_ptr<DciInfoElementTdma>>>>
+        m_ulDataPending;
+};
+
+NrSchedBenchmark::NrSchedBenchmark(const BenchmarkPoint& point, const BenchmarkConfig& conf)
+    : m_point(point),
+      m_conf(conf)
+{
+    m_model = NrSpectrumValueHelper::GetSpectrumModel(point.m_rbgs * conf.m_numRbPerRbg,
+                                                      28e9,
+                                                      15e3 * std::pow(2, conf.m_numerology));
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+}
+
+void
+NrSchedBenchmark::Setup()
+{
+    ObjectFactory factory;
+    factory.SetTypeId(m_point.m_scheduler);
+    m_sched = DynamicCast<NrMacSchedulerNs3>(factory.Create());
+    NS_ABORT_MSG_IF(m_sched == nullptr, "Can't create a NrMacSchedulerNs3 from type "
+                                            << m_point.m_scheduler);
+    m_sched->AssignStreams(2);
+
+    Ptr<NrAmc> dlAmc = CreateObject<NrAmc>();
+    dlAmc->SetDlMode();
+    Ptr<NrAmc> ulAmc = CreateObject<NrAmc>();
+    ulAmc->SetUlMode();
+    m_sched->InstallDlAmc(dlAmc);
+    m_sched->InstallUlAmc(ulAmc);
+
+    m_sched->SetMacCschedSapUser(&m_cschedSapUser);
+    m_sched->SetMacSchedSapUser(this);
+
+    NrMacCschedSapProvider::CschedCellConfigReqParameters cellConf;
+    cellConf.m_ulBandwidth = static_cast<uint16_t>(m_point.m_rbgs);
+    cellConf.m_dlBandwidth = static_cast<uint16_t>(m_point.m_rbgs);
+    m_sched->GetMacCschedSapProvider()->CschedCellConfigReq(cellConf);
+
+    // The UL CQI of a slot is sent on the air slot itself (see SendFeedback)
+    m_sched->GetMacSchedSapProvider()->SchedSetUlAllocationHorizon(m_conf.m_l1L2CtrlLatency +
+                                                                   m_conf.m_k2Delay);
+
+    for (uint32_t ue = 0; ue < m_point.m_ues; ++ue)
+    {
+        uint16_t rnti = static_cast<uint16_t>(ue + 1);
+
+        NrMacCschedSapProvider::CschedUeConfigReqParameters ueConf;
+        ueConf.m_rnti = rnti;
+        ueConf.m_beamConfId =
+            BeamConfId(BeamId(static_cast<uint16_t>(ue % m_point.m_beams), 90.0),
+                       BeamId::GetEmptyBeamId());
+        m_sched->GetMacCschedSapProvider()->CschedUeConfigReq(ueConf);
+
+        NrMacCschedSapProvider::CschedLcConfigReqParameters lcConf;
+        lcConf.m_rnti = rnti;
+        lcConf.m_reconfigureFlag = false;
+        for (uint32_t lc = 0; lc < m_point.m_lcs; ++lc)
+        {
+            LogicalChannelConfigListElement_s lccle;
+            lccle.m_logicalChannelIdentity = static_cast<uint8_t>(lc + 1);
+            lccle.m_logicalChannelGroup = static_cast<uint8_t>(lc % 4);
+            lccle.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+            lccle.m_qci = lc % 2 == 0 ? EpsBearer::NGBR_VIDEO_TCP_DEFAULT
+                                      : EpsBearer::NGBR_VIDEO_TCP_PREMIUM;
+            lccle.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+            lccle.m_eRabMaximulBitrateUl = 0;
+            lccle.m_eRabMaximulBitrateDl = 0;
+            lccle.m_eRabGuaranteedBitrateUl = 0;
+            lccle.m_eRabGuaranteedBitrateDl = 0;
+            lcConf.m_logicalChannelConfigList.push_back(lccle);
+        }
+        m_sched->GetMacCschedSapProvider()->CschedLcConfigReq(lcConf);
+
+        m_ueDlCqi.push_back(static_cast<uint8_t>(m_rng->GetInteger(3, 15)));
+        m_ueUlSinr.push_back(std::pow(10.0, m_rng->GetValue(0.0, 25.0) / 10.0));
+    }
+}
+
+void
+NrSchedBenchmark::SchedConfigInd(const struct SchedConfigIndParameters& params)
+{
+    for (const auto& varTti : params.m_slotAllocInfo.m_varTtiAllocInfo)
+    {
+        const auto& dci = varTti.m_dci;
+        if (dci->m_type != DciInfoElementTdma::DATA)
+        {
+            continue;
+        }
+
+        if (dci->m_format == DciInfoElementTdma::DL)
+        {
+            ++m_dlAllocs;
+
+            DlHarqInfo harq;
+            harq.m_rnti = dci->m_rnti;
+            harq.m_harqProcessId = dci->m_harqProcess;
+            harq.m_bwpIndex = 0;
+            for (std::size_t stream = 0; stream < dci->m_tbSize.size(); ++stream)
+            {
+                if (dci->m_tbSize.at(stream) == 0)
+                {
+                    harq.m_harqStatus.push_back(DlHarqInfo::NONE);
+                }
+                else
+                {
+                    harq.m_harqStatus.push_back(m_rng->GetValue() < m_conf.m_dlBler
+                                                    ? DlHarqInfo::NACK
+                                                    : DlHarqInfo::ACK);
+                }
+                harq.m_numRetx.push_back(dci->m_rv.at(stream));
+            }
+            m_dlHarqPending[params.m_sfnSf.Normalize() + m_conf.m_harqDelay].push_back(harq);
+        }
+        else
+        {
+            ++m_ulAllocs;
+
+            auto& pending = m_ulDataPending[params.m_sfnSf.Normalize()];
+            pending.first = params.m_sfnSf;
+            pending.second.push_back(dci);
+        }
+    }
+}
+
+void
+NrSchedBenchmark::SendFeedback(const SfnSf& airSfn, uint32_t slotIdx)
+{
+    NrMacSchedSapProvider* provider = m_sched->GetMacSchedSapProvider();
+
+    // DL HARQ feedback that arrives in this slot
+    auto dlIt = m_dlHarqPending.find(airSfn.Normalize());
+    if (dlIt != m_dlHarqPending.end())
+    {
+        m_dlHarqIn.insert(m_dlHarqIn.end(), dlIt->second.begin(), dlIt->second.end());
+        m_dlHarqPending.erase(dlIt);
+    }
+
+    // UL data transmitted in this slot: UL CQI (one for each symbol start) and UL HARQ
+    auto ulIt = m_ulDataPending.find(airSfn.Normalize());
+    if (ulIt != m_ulDataPending.end())
+    {
+        std::set<uint8_t> symStarts;
+        for (const auto& dci : ulIt->second.second)
+        {
+            UlHarqInfo harq;
+            harq.m_rnti = dci->m_rnti;
+            harq.m_harqProcessId = dci->m_harqProcess;
+            harq.m_bwpIndex = 0;
+            harq.m_numRetx = dci->m_rv.at(0);
+            harq.m_receptionStatus =
+                m_rng->GetValue() < m_conf.m_ulBler ? UlHarqInfo::NotOk : UlHarqInfo::Ok;
+            m_ulHarqIn.push_back(harq);
+
+            if (symStarts.insert(dci->m_symStart).second)
+            {
+                NrMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+                ulCqi.m_sfnSf = ulIt->second.first;
+                ulCqi.m_symStart = dci->m_symStart;
+                ulCqi.m_ulCqi.m_type = UlCqiInfo::PUSCH;
+                ulCqi.m_ulCqi.m_sinr.assign(m_model->GetNumBands(), m_ueUlSinr.at(dci->m_rnti - 1));
+                provider->SchedUlCqiInfoReq(ulCqi);
+            }
+        }
+        m_ulDataPending.erase(ulIt);
+    }
+
+    if (slotIdx % m_conf.m_cqiPeriod == 0)
+    {
+        NrMacSchedSapProvider::SchedDlCqiInfoReqParameters dlCqi;
+        dlCqi.m_sfnsf = airSfn;
+        for (uint32_t ue = 0; ue < m_point.m_ues; ++ue)
+        {
+            DlCqiInfo cqi;
+            cqi.m_rnti = static_cast<uint16_t>(ue + 1);
+            cqi.m_ri = 1;
+            cqi.m_cqiType = DlCqiInfo::WB;
+            int32_t value = m_ueDlCqi.at(ue) + static_cast<int32_t>(m_rng->GetInteger(0, 2)) - 1;
+            cqi.m_wbCqi.push_back(static_cast<uint8_t>(std::clamp(value, 1, 15)));
+            dlCqi.m_cqiList.push_back(cqi);
+        }
+        provider->SchedDlCqiInfoReq(dlCqi);
+    }
+
+    NrMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsrs;
+    bsrs.m_sfnSf = airSfn;
+    for (uint32_t ue = 0; ue < m_point.m_ues; ++ue)
+    {
+        uint16_t rnti = static_cast<uint16_t>(ue + 1);
+        std::vector<uint64_t> lcgBytes(4, 0);
+        for (uint32_t lc = 0; lc < m_point.m_lcs; ++lc)
+        {
+            NrMacSchedSapProvider::SchedDlRlcBufferReqParameters rlc;
+            rlc.m_rnti = rnti;
+            rlc.m_logicalChannelIdentity = static_cast<uint8_t>(lc + 1);
+            rlc.m_rlcTransmissionQueueSize = m_conf.m_bufferBytes;
+            rlc.m_rlcTransmissionQueueHolDelay = 0;
+            rlc.m_rlcRetransmissionQueueSize = 0;
+            rlc.m_rlcRetransmissionHolDelay = 0;
+            rlc.m_rlcStatusPduSize = 0;
+            provider->SchedDlRlcBufferReq(rlc);
+
+            lcgBytes.at(lc % 4) += m_conf.m_bufferBytes;
+        }
+
+        MacCeElement bsr;
+        bsr.m_rnti = rnti;
+        bsr.m_macCeType = MacCeElement::BSR;
+        for (const auto& bytes : lcgBytes)
+        {
+            bsr.m_macCeValue.m_bufferStatus.push_back(NrMacShortBsrCe::FromBytesToLevel(bytes));
+        }
+        bsrs.m_macCeList.push_back(bsr);
+    }
+    provider->SchedUlMacCtrlInfoReq(bsrs);
+}
+
+BenchmarkResult
+NrSchedBenchmark::Run()
+{
+    Setup();
+
+    NrMacSchedSapProvider* provider = m_sched->GetMacSchedSapProvider();
+    std::vector<double> dlNs;
+    std::vector<double> ulNs;
+    uint64_t dlAllocs = 0;
+    uint64_t ulAllocs = 0;
+
+    SfnSf airSfn(0, 0, 0, static_cast<uint8_t>(m_conf.m_numerology));
+    for (uint32_t slot = 0; slot < m_conf.m_warmUpSlots + m_conf.m_slots; ++slot)
+    {
+        SendFeedback(airSfn, slot);
+
+        NrMacSchedSapProvider::SchedDlTriggerReqParameters dlParams;
+        dlParams.m_snfSf = airSfn.GetFutureSfnSf(m_conf.m_l1L2CtrlLatency);
+        dlParams.m_slotType = LteNrTddSlotType::F;
+        dlParams.m_dlHarqInfoList = std::move(m_dlHarqIn);
+        m_dlHarqIn.clear();
+
+        NrMacSchedSapProvider::SchedUlTriggerReqParameters ulParams;
+        ulParams.m_snfSf = airSfn.GetFutureSfnSf(m_conf.m_l1L2CtrlLatency + m_conf.m_k2Delay);
+        ulParams.m_slotType = LteNrTddSlotType::F;
+        ulParams.m_ulHarqInfoList = std::move(m_ulHarqIn);
+        m_ulHarqIn.clear();
+
+        m_dlAllocs = 0;
+        m_ulAllocs = 0;
+
+        // Same order of NrGnbMac: first DL, then UL
+        auto start = std::chrono::steady_clock::now();
+        provider->SchedDlTriggerReq(dlParams);
+        auto middle = std::chrono::steady_clock::now();
+        provider->SchedUlTriggerReq(ulParams);
+        auto end = std::chrono::steady_clock::now();
+
+        if (slot >= m_conf.m_warmUpSlots)
+        {
+            dlNs.push_back(std::chrono::duration<double, std::nano>(middle - start).count());
+            ulNs.push_back(std::chrono::duration<double, std::nano>(end - middle).count());
+            dlAllocs += m_dlAllocs;
+            ulAllocs += m_ulAllocs;
+        }
+
+        airSfn.Add(1);
+    }
+
+    auto percentile = [](std::vector<double> v, double p) {
+        std::sort(v.begin(), v.end());
+        return v.at(static_cast<std::size_t>(p * (v.size() - 1)));
+    };
+    auto mean = [](const std::vector<double>& v) {
+        double sum = 0.0;
+        for (const auto& d : v)
+        {
+            sum += d;
+        }
+        return sum / v.size();
+    };
+
+    BenchmarkResult res;
+    res.m_dlNsMean = mean(dlNs);
+    res.m_dlNsP50 = percentile(dlNs, 0.5);
+    res.m_dlNsP99 = percentile(dlNs, 0.99);
+    res.m_ulNsMean = mean(ulNs);
+    res.m_ulNsP50 = percentile(ulNs, 0.5);
+    res.m_ulNsP99 = percentile(ulNs, 0.99);
+    res.m_dlAllocPerSlot = static_cast<double>(dlAllocs) / m_conf.m_slots;
+    res.m_ulAllocPerSlot = static_cast<double>(ulAllocs) / m_conf.m_slots;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    res.m_peakRssKb = static_cast<uint64_t>(usage.ru_maxrss);
+
+    m_sched->Dispose();
+    m_sched = nullptr;
+
+    return res;
+}
+
+/**
+ * \brief Split a comma-separated list
+ * \param list the list
+ * \return the elements of the list
+ */
+static std::vector<std::string>
+SplitList(const std::string& list)
+{
+    std::vector<std::string> ret;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            ret.push_back(item);
+        }
+    }
+    return ret;
+}
+
+/**
+ * \brief Split a comma-separated list of positive integers
+ * \param list the list
+ * \param name name of the parameter, for the error message
+ * \return the integers of the list
+ */
+static std::vector<uint32_t>
+SplitUintList(const std::string& list, const std::string& name)
+{
+    std::vector<uint32_t> ret;
+    for (const auto& item : SplitList(list))
+    {
+        uint32_t value = static_cast<uint32_t>(std::stoul(item));
+        NS_ABORT_MSG_IF(value == 0, "Values of " << name << " must be greater than zero");
+        ret.push_back(value);
+    }
+    NS_ABORT_MSG_IF(ret.empty(), "Empty list for " << name);
+    return ret;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string schedulers = "ns3::NrMacSchedulerTdmaRR,ns3::NrMacSchedulerTdmaPF,"
+                             "ns3::NrMacSchedulerTdmaMR,ns3::NrMacSchedulerTdmaQos,"
+                             "ns3::NrMacSchedulerOfdmaRR,ns3::NrMacSchedulerOfdmaPF,"
+                             "ns3::NrMacSchedulerOfdmaMR,ns3::NrMacSchedulerOfdmaQos";
+    std::string ueNums = "10,50";
+    std::string rbgNums = "25,100";
+    std::string beamNums = "1,4";
+    std::string lcNums = "1,4";
+    std::string outputFile;
+    BenchmarkConfig conf;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("schedulers", "Comma-separated list of scheduler TypeId", schedulers);
+    cmd.AddValue("ueNums", "Comma-separated list of number of UEs", ueNums);
+    cmd.AddValue("rbgNums", "Comma-separated list of number of RBG", rbgNums);
+    cmd.AddValue("beamNums", "Comma-separated list of number of beams", beamNums);
+    cmd.AddValue("lcNums", "Comma-separated list of number of LC per UE", lcNums);
+    cmd.AddValue("slots", "Number of measured slots for each point", conf.m_slots);
+    cmd.AddValue("warmUpSlots", "Number of slots excluded from the measure", conf.m_warmUpSlots);
+    cmd.AddValue("numerology", "Numerology", conf.m_numerology);
+    cmd.AddValue("numRbPerRbg", "Number of RB per RBG", conf.m_numRbPerRbg);
+    cmd.AddValue("bufferBytes", "Bytes in each LC, refreshed at every slot", conf.m_bufferBytes);
+    cmd.AddValue("cqiPeriod", "Period, in slots, of the DL CQI", conf.m_cqiPeriod);
+    cmd.AddValue("dlBler", "Probability of a NACK for a DL TB", conf.m_dlBler);
+    cmd.AddValue("ulBler", "Probability of a NACK for a UL TB", conf.m_ulBler);
+    cmd.AddValue("outputFile", "CSV output file (empty for the standard output)", outputFile);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(conf.m_slots == 0, "At least one slot must be measured");
+    NS_ABORT_MSG_IF(conf.m_cqiPeriod == 0, "The CQI period must be greater than zero");
+    for (const auto& lcs : SplitUintList(lcNums, "lcNums"))
+    {
+        NS_ABORT_MSG_IF(lcs > 32, "A UE can have at most 32 LC, requested " << lcs);
+    }
+
+    std::ofstream file;
+    if (!outputFile.empty())
+    {
+        file.open(outputFile, std::ios_base::out | std::ios_base::trunc);
+        NS_ABORT_MSG_IF(!file.is_open(), "Can't open file " << outputFile);
+    }
+    std::ostream& out = outputFile.empty() ? std::cout : file;
+
+    out << "scheduler,ues,rbgs,beams,lcs,slots,dlNsMean,dlNsP50,dlNsP99,ulNsMean,ulNsP50,"
+           "ulNsP99,dlAllocPerSlot,ulAllocPerSlot,peakRssKb"
+        << std::endl;
+
+    for (const auto& scheduler : SplitList(schedulers))
+    {
+        for (const auto& ues : SplitUintList(ueNums, "ueNums"))
+        {
+            for (const auto& rbgs : SplitUintList(rbgNums, "rbgNums"))
+            {
+                for (const auto& beams : SplitUintList(beamNums, "beamNums"))
+                {
+                    for (const auto& lcs : SplitUintList(lcNums, "lcNums"))
+                    {
+                        BenchmarkPoint point;
+                        point.m_scheduler = scheduler;
+                        point.m_ues = ues;
+                        point.m_rbgs = rbgs;
+                        point.m_beams = beams;
+                        point.m_lcs = lcs;
+
+                        NrSchedBenchmark bench(point, conf);
+                        BenchmarkResult res = bench.Run();
+
+                        out << scheduler << "," << ues << "," << rbgs << "," << beams << ","
+                            << lcs << "," << conf.m_slots << "," << res.m_dlNsMean << ","
+                            << res.m_dlNsP50 << "," << res.m_dlNsP99 << "," << res.m_ulNsMean
+                            << "," << res.m_ulNsP50 << "," << res.m_ulNsP99 << ","
+                            << res.m_dlAllocPerSlot << "," << res.m_ulAllocPerSlot << ","
+                            << res.m_peakRssKb << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
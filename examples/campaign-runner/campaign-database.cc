@@ -0,0 +1,187 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "campaign-database.h"
+
+#include <ns3/abort.h>
+
+namespace ns3
+{
+
+CampaignDatabase::CampaignDatabase(const std::string& filename)
+    : m_db(filename)
+{
+    Exec("CREATE TABLE IF NOT EXISTS Points ("
+         "PointId INTEGER PRIMARY KEY,"
+         "Parameters TEXT UNIQUE NOT NULL,"
+         "Status TEXT NOT NULL,"
+         "Attempts INTEGER NOT NULL,"
+         "ExitCode INTEGER,"
+         "WallTime DOUBLE);");
+    Exec("CREATE TABLE IF NOT EXISTS PointParameters ("
+         "PointId INTEGER NOT NULL,"
+         "Name TEXT NOT NULL,"
+         "Value TEXT NOT NULL,"
+         "PRIMARY KEY (PointId, Name));");
+}
+
+sqlite3_stmt*
+CampaignDatabase::Prepare(const std::string& cmd) const
+{
+    sqlite3_stmt* stmt;
+    bool ret = m_db.SpinPrepare(&stmt, cmd);
+    NS_ABORT_MSG_IF(!ret, "Error preparing: " << cmd);
+    return stmt;
+}
+
+void
+CampaignDatabase::Exec(const std::string& cmd) const
+{
+    bool ret = m_db.SpinExec(cmd);
+    NS_ABORT_MSG_IF(!ret, "Error executing: " << cmd);
+}
+
+std::vector<CampaignDatabase::PointState>
+CampaignDatabase::AddPoints(const std::vector<CampaignPoint>& points)
+{
+    std::vector<PointState> states;
+    states.reserve(points.size());
+
+    Exec("BEGIN TRANSACTION;");
+    for (const auto& point : points)
+    {
+        const std::string key = point.GetKey();
+        bool ret;
+
+        sqlite3_stmt* stmt = Prepare("INSERT OR IGNORE INTO Points (Parameters, Status, Attempts) "
+                                     "VALUES (?, 'pending', 0);");
+        ret = m_db.Bind(stmt, 1, key);
+        NS_ABORT_IF(!ret);
+        ret = m_db.SpinExec(stmt);
+        NS_ABORT_IF(!ret);
+
+        PointState state;
+        stmt = Prepare("SELECT PointId, Status, Attempts FROM Points WHERE Parameters = ?;");
+        ret = m_db.Bind(stmt, 1, key);
+        NS_ABORT_IF(!ret);
+        NS_ABORT_MSG_IF(SQLiteOutput::SpinStep(stmt) != SQLITE_ROW,
+                        "Point " << key << " not found");
+        state.id = static_cast<uint32_t>(sqlite3_column_int64(stmt, 0));
+        state.status = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        state.attempts = static_cast<uint32_t>(sqlite3_column_int64(stmt, 2));
+        SQLiteOutput::SpinFinalize(stmt);
+
+        for (const auto& [name, value] : point.parameters)
+        {
+            stmt = Prepare("INSERT OR IGNORE INTO PointParameters VALUES (?, ?, ?);");
+            ret = m_db.Bind(stmt, 1, state.id);
+            NS_ABORT_IF(!ret);
+            ret = m_db.Bind(stmt, 2, name);
+            NS_ABORT_IF(!ret);
+            ret = m_db.Bind(stmt, 3, value);
+            NS_ABORT_IF(!ret);
+            ret = m_db.SpinExec(stmt);
+            NS_ABORT_IF(!ret);
+        }
+
+        states.push_back(state);
+    }
+    Exec("END TRANSACTION;");
+
+    return states;
+}
+
+void
+CampaignDatabase::SetRunning(uint32_t id)
+{
+    sqlite3_stmt* stmt = Prepare("UPDATE Points SET Status = 'running', Attempts = Attempts + 1 "
+                                 "WHERE PointId = ?;");
+    bool ret = m_db.Bind(stmt, 1, id);
+    NS_ABORT_IF(!ret);
+    ret = m_db.SpinExec(stmt);
+    NS_ABORT_IF(!ret);
+}
+
+void
+CampaignDatabase::SetFailed(uint32_t id, int exitCode, double wallTime)
+{
+    sqlite3_stmt* stmt = Prepare("UPDATE Points SET Status = 'failed', ExitCode = ?, WallTime = ? "
+                                 "WHERE PointId = ?;");
+    bool ret = m_db.Bind(stmt, 1, static_cast<uint32_t>(exitCode));
+    NS_ABORT_IF(!ret);
+    ret = m_db.Bind(stmt, 2, wallTime);
+    NS_ABORT_IF(!ret);
+    ret = m_db.Bind(stmt, 3, id);
+    NS_ABORT_IF(!ret);
+    ret = m_db.SpinExec(stmt);
+    NS_ABORT_IF(!ret);
+}
+
+void
+CampaignDatabase::SetDone(uint32_t id, double wallTime, const std::string& resultsDb)
+{
+    bool ret;
+    sqlite3_stmt* stmt;
+
+    // The results database can not be attached inside a transaction
+    std::vector<std::string> tables;
+    if (!resultsDb.empty())
+    {
+        stmt = Prepare("ATTACH DATABASE ? AS results;");
+        ret = m_db.Bind(stmt, 1, resultsDb);
+        NS_ABORT_IF(!ret);
+        ret = m_db.SpinExec(stmt);
+        NS_ABORT_MSG_IF(!ret, "Can't attach database " << resultsDb);
+
+        stmt = Prepare("SELECT name FROM results.sqlite_master WHERE type = 'table';");
+        while (SQLiteOutput::SpinStep(stmt) == SQLITE_ROW)
+        {
+            tables.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+        }
+        SQLiteOutput::SpinFinalize(stmt);
+    }
+
+    Exec("BEGIN TRANSACTION;");
+    for (const auto& table : tables)
+    {
+        NS_ABORT_MSG_IF(table == "Points" || table == "PointParameters",
+                        "The results database of point " << id << " has a reserved table name");
+        const std::string quoted = "\"" + table + "\"";
+        Exec("CREATE TABLE IF NOT EXISTS main." + quoted +
+             " AS SELECT CAST(0 AS INTEGER) AS PointId, * FROM results." + quoted + " WHERE 0;");
+
+        stmt = Prepare("DELETE FROM main." + quoted + " WHERE PointId = ?;");
+        ret = m_db.Bind(stmt, 1, id);
+        NS_ABORT_IF(!ret);
+        ret = m_db.SpinExec(stmt);
+        NS_ABORT_IF(!ret);
+
+        stmt = Prepare("INSERT INTO main." + quoted + " SELECT ?, * FROM results." + quoted + ";");
+        ret = m_db.Bind(stmt, 1, id);
+        NS_ABORT_IF(!ret);
+        ret = m_db.SpinExec(stmt);
+        NS_ABORT_MSG_IF(!ret,
+                        "Can't copy table " << table << " of point " << id
+                                            << ": are its columns the same of the other points?");
+    }
+
+    stmt = Prepare("UPDATE Points SET Status = 'done', ExitCode = 0, WallTime = ? "
+                   "WHERE PointId = ?;");
+    ret = m_db.Bind(stmt, 1, wallTime);
+    NS_ABORT_IF(!ret);
+    ret = m_db.Bind(stmt, 2, id);
+    NS_ABORT_IF(!ret);
+    ret = m_db.SpinExec(stmt);
+    NS_ABORT_IF(!ret);
+    Exec("END TRANSACTION;");
+
+    if (!resultsDb.empty())
+    {
+        Exec("DETACH DATABASE results;");
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef CAMPAIGN_DATABASE_H
+#define CAMPAIGN_DATABASE_H
+
+#include "campaign-grid.h"
+
+#include <ns3/sqlite-output.h>
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \brief The database of a campaign: the state of its points, and their results
+ *
+ * The database contains the following tables:
+ *
+ * - "Points": one row for each point, with its key (see CampaignPoint::GetKey),
+ *   its state ("pending", "running", "done" or "failed"), the number of times
+ *   it has been run, and the exit code and wall-clock time of its last run;
+ * - "PointParameters": the value of each parameter of each point, to select
+ *   the results by parameter;
+ * - the tables of the databases written by the simulations (e.g., "sinr",
+ *   "thput"), with an additional first column "PointId" that refers to the
+ *   point that produced each row.
+ *
+ * Since the points are identified by their parameters, a campaign can be
+ * interrupted and restarted (also with a larger grid): the points already done
+ * are not run again.
+ */
+class CampaignDatabase
+{
+  public:
+    /**
+     * \brief State of a point
+     */
+    struct PointState
+    {
+        uint32_t id{0};       //!< ID of the point in the database
+        std::string status;   //!< "pending", "running", "done" or "failed"
+        uint32_t attempts{0}; //!< Number of times the point has been run
+    };
+
+    /**
+     * \brief Open (or create) the database
+     * \param filename the name of the database file
+     */
+    CampaignDatabase(const std::string& filename);
+
+    /**
+     * \brief Add the points of a campaign, if they are not already in the database
+     * \param points the points
+     * \return the state of each point
+     */
+    std::vector<PointState> AddPoints(const std::vector<CampaignPoint>& points);
+
+    /**
+     * \brief Mark a point as running, and increase its number of attempts
+     * \param id the ID of the point
+     */
+    void SetRunning(uint32_t id);
+
+    /**
+     * \brief Mark a point as failed
+     * \param id the ID of the point
+     * \param exitCode the exit code of the simulation
+     * \param wallTime the duration of the simulation, in s
+     */
+    void SetFailed(uint32_t id, int exitCode, double wallTime);
+
+    /**
+     * \brief Copy the results of a point in the database, and mark it as done
+     * \param id the ID of the point
+     * \param wallTime the duration of the simulation, in s
+     * \param resultsDb the database written by the simulation, if any
+     *
+     * The results of a previous run of the point, if any, are replaced. The
+     * copy and the change of state are done in the same transaction, so that a
+     * point is either done with all its results, or not done.
+     */
+    void SetDone(uint32_t id, double wallTime, const std::string& resultsDb);
+
+  private:
+    /**
+     * \brief Prepare a statement, aborting on errors
+     * \param cmd the statement
+     * \return the prepared statement
+     */
+    sqlite3_stmt* Prepare(const std::string& cmd) const;
+
+    /**
+     * \brief Execute a statement without parameters, aborting on errors
+     * \param cmd the statement
+     */
+    void Exec(const std::string& cmd) const;
+
+    SQLiteOutput m_db; //!< The database
+};
+
+} // namespace ns3
+
+#endif // CAMPAIGN_DATABASE_H
@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "campaign-grid.h"
+
+#include <ns3/abort.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+/**
+ * \brief Remove the spaces at the beginning and at the end of a string
+ * \param s the string
+ * \return the trimmed string
+ */
+static std::string
+Trim(const std::string& s)
+{
+    auto first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+    {
+        return "";
+    }
+    auto last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+/**
+ * \brief Split a string
+ * \param s the string
+ * \param separator the separator
+ * \return the trimmed substrings
+ */
+static std::vector<std::string>
+Split(const std::string& s, char separator)
+{
+    std::vector<std::string> tokens;
+    std::istringstream is(s);
+    std::string token;
+    while (std::getline(is, token, separator))
+    {
+        tokens.push_back(Trim(token));
+    }
+    return tokens;
+}
+
+/**
+ * \brief Parse an integer
+ * \param s the string
+ * \param value the parsed integer
+ * \return true if the whole string is an integer
+ */
+static bool
+ParseInteger(const std::string& s, int64_t& value)
+{
+    std::istringstream is(s);
+    is >> value;
+    return !is.fail() && is.eof();
+}
+
+std::string
+CampaignPoint::GetKey() const
+{
+    std::string key;
+    for (const auto& [name, value] : parameters)
+    {
+        key += (key.empty() ? "" : " ") + name + "=" + value;
+    }
+    return key;
+}
+
+void
+CampaignGrid::Parse(const std::string& spec)
+{
+    for (const auto& parameter : Split(spec, ';'))
+    {
+        if (parameter.empty())
+        {
+            continue;
+        }
+        auto eq = parameter.find('=');
+        NS_ABORT_MSG_IF(eq == std::string::npos,
+                        "Parameter \"" << parameter << "\" is not in the form name=values");
+        std::vector<std::string> values;
+        for (const auto& value : Split(parameter.substr(eq + 1), ','))
+        {
+            NS_ABORT_MSG_IF(value.empty(), "Empty value in parameter \"" << parameter << "\"");
+            ExpandValue(value, values);
+        }
+        AddParameter(Trim(parameter.substr(0, eq)), values);
+    }
+}
+
+void
+CampaignGrid::ParseFile(const std::string& filename)
+{
+    std::ifstream in(filename);
+    NS_ABORT_MSG_IF(!in.is_open(), "Can't open file " << filename);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        Parse(line.substr(0, line.find('#')));
+    }
+}
+
+void
+CampaignGrid::AddParameter(const std::string& name, const std::vector<std::string>& values)
+{
+    NS_ABORT_MSG_IF(name.empty(), "Parameter without a name");
+    NS_ABORT_MSG_IF(values.empty(), "Parameter " << name << " has no values");
+    for (const auto& parameter : m_parameters)
+    {
+        NS_ABORT_MSG_IF(parameter.first == name, "Parameter " << name << " is repeated");
+    }
+    m_parameters.emplace_back(name, values);
+}
+
+std::size_t
+CampaignGrid::GetNumPoints() const
+{
+    if (m_parameters.empty())
+    {
+        return 0;
+    }
+    std::size_t numPoints = 1;
+    for (const auto& parameter : m_parameters)
+    {
+        numPoints *= parameter.second.size();
+    }
+    return numPoints;
+}
+
+std::vector<CampaignPoint>
+CampaignGrid::GetPoints() const
+{
+    std::vector<CampaignPoint> points;
+    const std::size_t numPoints = GetNumPoints();
+    points.reserve(numPoints);
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        CampaignPoint point;
+        point.parameters.resize(m_parameters.size());
+        // Mixed-radix decomposition of i, with the last parameter as the least significant digit
+        std::size_t rest = i;
+        for (std::size_t p = m_parameters.size(); p-- > 0;)
+        {
+            const auto& values = m_parameters[p].second;
+            point.parameters[p] = {m_parameters[p].first, values[rest % values.size()]};
+            rest /= values.size();
+        }
+        points.push_back(std::move(point));
+    }
+    return points;
+}
+
+void
+CampaignGrid::ExpandValue(const std::string& value, std::vector<std::string>& values)
+{
+    auto bounds = Split(value, ':');
+    int64_t first = 0;
+    int64_t last = 0;
+    int64_t step = 1;
+    if ((bounds.size() != 2 && bounds.size() != 3) || !ParseInteger(bounds[0], first) ||
+        !ParseInteger(bounds[1], last) || (bounds.size() == 3 && !ParseInteger(bounds[2], step)))
+    {
+        values.push_back(value);
+        return;
+    }
+    NS_ABORT_MSG_IF(step <= 0, "The step of range " << value << " must be positive");
+    NS_ABORT_MSG_IF(last < first, "Range " << value << " is empty");
+    for (int64_t v = first; v <= last; v += step)
+    {
+        values.push_back(std::to_string(v));
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef CAMPAIGN_GRID_H
+#define CAMPAIGN_GRID_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief A point of a campaign: a value for each parameter of the grid
+ */
+struct CampaignPoint
+{
+    /**
+     * \brief Get the key of the point, that identifies it in the campaign database
+     * \return the parameters as "name1=value1 name2=value2 ...", in grid order
+     */
+    std::string GetKey() const;
+
+    std::vector<std::pair<std::string, std::string>> parameters; //!< (name, value) pairs
+};
+
+/**
+ * \brief A grid of parameters, whose Cartesian product are the points of a campaign
+ *
+ * A grid is described by a list of parameters separated by ';' (or by new
+ * lines, in a file), each one with the form name=values. The values are
+ * separated by ',', and each of them can be:
+ *
+ * - an integer range first:last, or first:last:step (e.g., RngRun=1:100);
+ * - any other string, used as it is (e.g., scenario=UMa,UMi).
+ *
+ * In a file, the text after a '#' is a comment. The names are the ones of the
+ * command-line arguments of the simulation program, including the ns-3 global
+ * values (e.g., RngRun).
+ */
+class CampaignGrid
+{
+  public:
+    /**
+     * \brief Add the parameters of a grid description
+     * \param spec the description, e.g. "scenario=UMa,UMi;RngRun=1:10"
+     */
+    void Parse(const std::string& spec);
+
+    /**
+     * \brief Add the parameters of a file, one (or more) per line
+     * \param filename the name of the file
+     */
+    void ParseFile(const std::string& filename);
+
+    /**
+     * \brief Add a parameter
+     * \param name the name of the parameter
+     * \param values the values of the parameter
+     */
+    void AddParameter(const std::string& name, const std::vector<std::string>& values);
+
+    /**
+     * \brief Get the number of points of the grid
+     * \return the number of points
+     */
+    std::size_t GetNumPoints() const;
+
+    /**
+     * \brief Get the points of the grid
+     * \return all the combinations of the values of the parameters; the last
+     * parameter varies first
+     */
+    std::vector<CampaignPoint> GetPoints() const;
+
+  private:
+    /**
+     * \brief Expand a value, if it is an integer range
+     * \param value the value
+     * \param values the list where the value(s) are appended
+     */
+    static void ExpandValue(const std::string& value, std::vector<std::string>& values);
+
+    std::vector<std::pair<std::string, std::vector<std::string>>>
+        m_parameters; //!< The parameters, and their values
+};
+
+} // namespace ns3
+
+#endif // CAMPAIGN_GRID_H
@@ -0,0 +1,289 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+/**
+ * \file nr-campaign-runner.cc
+ * \ingroup examples
+ * \brief Run a campaign of simulations in parallel
+ *
+ * The runner executes a simulation program (e.g., lena-lte-comparison-campaign
+ * or cttc-nr-3gpp-calibration-user) once for each point of a parameter grid,
+ * with up to --jobs simulations running at the same time, each one in its own
+ * process. The parameters of each point are passed to the program as
+ * command-line arguments (--name=value), so any argument of the program, and
+ * any ns-3 global value such as RngRun, can be part of the grid:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "nr-campaign-runner --program=<path of lena-lte-comparison-campaign>
+    --grid='scenario=UMa,UMi;trafficScenario=0:3;RngRun=1:50' --jobs=16 --campaign=calib"
+    \endcode
+ *
+ * The grid can also be read from a file (--gridFile), with one parameter per
+ * line. See CampaignGrid for the syntax.
+ *
+ * Each simulation writes its results in a database in the working directory
+ * of the campaign (by setting the simTag and outputDir arguments of the
+ * program) and its output in a log file. When a simulation ends successfully,
+ * the tables of its database are copied in the database of the campaign, with
+ * the ID of the point, and the point is marked as done (see CampaignDatabase).
+ * Failed simulations are retried up to --maxAttempts times.
+ *
+ * If the campaign is interrupted, running it again with the same
+ * --campaign runs only the points that are not done yet. The runner reports
+ * the throughput of the campaign, in points per hour, and the expected
+ * remaining time.
+ */
+
+#include "campaign-database.h"
+#include "campaign-grid.h"
+
+#include <ns3/abort.h>
+#include <ns3/command-line.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace ns3;
+
+/**
+ * \brief A point to run
+ */
+struct Job
+{
+    CampaignPoint point;                               //!< The parameters of the point
+    CampaignDatabase::PointState state;                //!< The state of the point
+    std::chrono::steady_clock::time_point startTime{}; //!< When the current run started
+};
+
+/**
+ * \brief Start the simulation of a point, in a new process
+ * \param program the simulation program
+ * \param job the point
+ * \param extraArgs arguments passed to all the simulations
+ * \param workDir the working directory of the campaign
+ * \param tagArg the name of the argument that sets the name of the results database
+ * \param dirArg the name of the argument that sets the directory of the results database
+ * \return the PID of the process
+ */
+static pid_t
+StartJob(const std::string& program,
+         const Job& job,
+         const std::vector<std::string>& extraArgs,
+         const std::string& workDir,
+         const std::string& tagArg,
+         const std::string& dirArg)
+{
+    const std::string tag = "point-" + std::to_string(job.state.id);
+
+    std::vector<std::string> args = {program};
+    for (const auto& [name, value] : job.point.parameters)
+    {
+        args.push_back("--" + name + "=" + value);
+    }
+    args.push_back("--" + tagArg + "=" + tag);
+    args.push_back("--" + dirArg + "=" + workDir);
+    args.insert(args.end(), extraArgs.begin(), extraArgs.end());
+
+    // Built before forking, the child only calls async-signal-safe functions
+    std::vector<char*> argv;
+    for (auto& arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    const std::string logFile = workDir + "/" + tag + ".log";
+
+    pid_t pid = fork();
+    NS_ABORT_MSG_IF(pid < 0, "Can't create a new process");
+    if (pid == 0)
+    {
+        int fd = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0)
+        {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execv(program.c_str(), argv.data());
+        _exit(127);
+    }
+    return pid;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string program;
+    std::string grid;
+    std::string gridFile;
+    std::string campaign = "campaign";
+    std::string extraArgs;
+    std::string tagArg = "simTag";
+    std::string dirArg = "outputDir";
+    uint32_t jobs = std::max(1U, std::thread::hardware_concurrency());
+    uint32_t maxAttempts = 2;
+    bool keepResults = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("program", "The path of the simulation program to run", program);
+    cmd.AddValue("grid",
+                 "The parameter grid, e.g. \"scenario=UMa,UMi;RngRun=1:10\"",
+                 grid);
+    cmd.AddValue("gridFile", "A file with the parameter grid, one parameter per line", gridFile);
+    cmd.AddValue("campaign",
+                 "The name of the campaign: the database is <campaign>.db, and the "
+                 "simulations run in the directory <campaign>",
+                 campaign);
+    cmd.AddValue("extraArgs",
+                 "Arguments (separated by spaces) passed to all the simulations",
+                 extraArgs);
+    cmd.AddValue("tagArg",
+                 "The argument of the program that sets the name of its output database",
+                 tagArg);
+    cmd.AddValue("dirArg",
+                 "The argument of the program that sets the directory of its output database",
+                 dirArg);
+    cmd.AddValue("jobs", "The maximum number of simulations running at the same time", jobs);
+    cmd.AddValue("maxAttempts", "The maximum number of runs of a failing point", maxAttempts);
+    cmd.AddValue("keepResults",
+                 "Keep the database of each simulation, after copying it in the campaign one",
+                 keepResults);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(program.empty(), "Set the simulation program with --program");
+    NS_ABORT_MSG_IF(access(program.c_str(), X_OK) != 0, "Can't execute " << program);
+    NS_ABORT_MSG_IF(jobs == 0, "At least one job must run at a time");
+    NS_ABORT_MSG_IF(maxAttempts == 0, "At least one attempt is needed");
+
+    CampaignGrid campaignGrid;
+    if (!gridFile.empty())
+    {
+        campaignGrid.ParseFile(gridFile);
+    }
+    campaignGrid.Parse(grid);
+    NS_ABORT_MSG_IF(campaignGrid.GetNumPoints() == 0, "The parameter grid is empty");
+
+    std::vector<std::string> commonArgs;
+    std::istringstream extraArgsStream(extraArgs);
+    for (std::string arg; extraArgsStream >> arg;)
+    {
+        commonArgs.push_back(arg);
+    }
+
+    mkdir(campaign.c_str(), 0755);
+    CampaignDatabase db(campaign + ".db");
+
+    // Queue the points that are not done, and that did not fail too many times
+    auto points = campaignGrid.GetPoints();
+    auto states = db.AddPoints(points);
+    std::deque<Job> queue;
+    uint32_t alreadyDone = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        if (states[i].status == "done" ||
+            (states[i].status == "failed" && states[i].attempts >= maxAttempts))
+        {
+            ++alreadyDone;
+            continue;
+        }
+        queue.push_back({points[i], states[i]});
+    }
+    const std::size_t toRun = queue.size();
+    std::cout << points.size() << " points, " << alreadyDone << " already done or failed, "
+              << toRun << " to run with " << jobs << " parallel jobs" << std::endl;
+
+    const auto campaignStart = std::chrono::steady_clock::now();
+    std::map<pid_t, Job> running;
+    uint32_t done = 0;
+    uint32_t failed = 0;
+
+    while (!queue.empty() || !running.empty())
+    {
+        while (!queue.empty() && running.size() < jobs)
+        {
+            Job job = std::move(queue.front());
+            queue.pop_front();
+            db.SetRunning(job.state.id);
+            ++job.state.attempts;
+            job.startTime = std::chrono::steady_clock::now();
+            pid_t pid = StartJob(program, job, commonArgs, campaign, tagArg, dirArg);
+            running.emplace(pid, std::move(job));
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        NS_ABORT_MSG_IF(pid < 0, "Error waiting for the simulations");
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            continue;
+        }
+        Job job = std::move(it->second);
+        running.erase(it);
+
+        const auto now = std::chrono::steady_clock::now();
+        const double wallTime = std::chrono::duration<double>(now - job.startTime).count();
+        const int exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        const std::string resultsDb =
+            campaign + "/point-" + std::to_string(job.state.id) + ".db";
+
+        if (exitCode == 0)
+        {
+            const bool hasResults = access(resultsDb.c_str(), R_OK) == 0;
+            db.SetDone(job.state.id, wallTime, hasResults ? resultsDb : "");
+            if (hasResults && !keepResults)
+            {
+                std::remove(resultsDb.c_str());
+            }
+            ++done;
+        }
+        else
+        {
+            db.SetFailed(job.state.id, exitCode, wallTime);
+            if (job.state.attempts < maxAttempts)
+            {
+                std::cout << "Point " << job.state.id << " (" << job.point.GetKey()
+                          << ") failed with code " << exitCode << ", retrying" << std::endl;
+                queue.push_back(std::move(job));
+                continue;
+            }
+            std::cout << "Point " << job.state.id << " (" << job.point.GetKey()
+                      << ") failed with code " << exitCode << ", giving up" << std::endl;
+            ++failed;
+        }
+
+        const double hours = std::chrono::duration<double>(now - campaignStart).count() / 3600;
+        const double pointsPerHour = (done + failed) / hours;
+        const double remaining = toRun - done - failed;
+        std::cout << "[" << done + failed << "/" << toRun << "] " << std::fixed
+                  << std::setprecision(1) << pointsPerHour << " points/hour, about "
+                  << remaining / pointsPerHour << " hours left" << std::endl;
+    }
+
+    const double hours =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - campaignStart).count() /
+        3600;
+    std::cout << "Campaign " << campaign << ": " << done << " points done, " << failed
+              << " failed, in " << std::fixed << std::setprecision(2) << hours << " hours";
+    if (hours > 0)
+    {
+        std::cout << " (" << std::setprecision(1) << (done + failed) / hours << " points/hour)";
+    }
+    std::cout << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+/**
+ * \file traffic-trace-converter.cc
+ * \ingroup examples
+ * \brief Convert a text traffic trace to the binary format of TrafficTraceFile
+ *
+ * The input is a text file with one packet per line: the timestamp in
+ * seconds, the size in bytes and, optionally, the flow ID (0 if missing).
+ * The fields can be separated by spaces, tabs, commas or semicolons. Empty
+ * lines, lines starting with '#' and a first line that is not numeric (e.g.,
+ * a CSV header) are skipped. The packets do not need to be sorted, and the
+ * timestamps are made relative to the first packet.
+ *
+ * The duration of the trace (i.e., when it restarts if replayed in a loop) is
+ * the last timestamp plus the gap set with --loopGap, by default the average
+ * time between packets.
+ *
+ * \code{.unparsed}
+$ ./ns3 run "traffic-trace-converter --input=trace.csv --output=trace.nrtt"
+    \endcode
+ *
+ * The output can be replayed with TrafficGeneratorTraceReplay.
+ */
+
+#include "ns3/core-module.h"
+#include <ns3/traffic-trace-file.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    double loopGap = -1;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "The text trace to convert", input);
+    cmd.AddValue("output", "The binary trace to write", output);
+    cmd.AddValue("loopGap",
+                 "The time (in seconds) between the last packet and the restart of the trace "
+                 "when looping. If negative, the average time between packets",
+                 loopGap);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty() || output.empty(), "Set both --input and --output");
+
+    std::ifstream in(input);
+    NS_ABORT_MSG_IF(!in.is_open(), "Can't open file " << input);
+
+    std::vector<TrafficTraceFile::Record> records;
+    std::string line;
+    uint32_t lineNumber = 0;
+    bool headerSkipped = false;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        std::replace_if(
+            line.begin(),
+            line.end(),
+            [](char c) { return c == ',' || c == ';' || c == '\t' || c == '\r'; },
+            ' ');
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream timeField(first);
+        double time = 0;
+        uint64_t size = 0;
+        uint64_t flowId = 0;
+        if (!(timeField >> time) || !(fields >> size))
+        {
+            NS_ABORT_MSG_IF(!records.empty() || headerSkipped,
+                            "Can't parse line " << lineNumber << " of " << input);
+            headerSkipped = true;
+            continue;
+        }
+        fields >> flowId;
+
+        NS_ABORT_MSG_IF(time < 0, "Negative timestamp at line " << lineNumber);
+        NS_ABORT_MSG_IF(size == 0 || size > UINT32_MAX, "Invalid size at line " << lineNumber);
+        NS_ABORT_MSG_IF(flowId >= TrafficTraceFile::ALL_FLOWS,
+                        "Invalid flow ID at line " << lineNumber);
+
+        TrafficTraceFile::Record record;
+        record.m_timeNs = static_cast<uint64_t>(Seconds(time).GetNanoSeconds());
+        record.m_size = static_cast<uint32_t>(size);
+        record.m_flowId = static_cast<uint32_t>(flowId);
+        records.push_back(record);
+    }
+    NS_ABORT_MSG_IF(records.empty(), "No packets in " << input);
+
+    std::stable_sort(records.begin(),
+                     records.end(),
+                     [](const TrafficTraceFile::Record& a, const TrafficTraceFile::Record& b) {
+                         return a.m_timeNs < b.m_timeNs;
+                     });
+    const uint64_t start = records.front().m_timeNs;
+    for (auto& record : records)
+    {
+        record.m_timeNs -= start;
+    }
+
+    const uint64_t last = records.back().m_timeNs;
+    uint64_t gap = 0;
+    if (loopGap >= 0)
+    {
+        gap = static_cast<uint64_t>(Seconds(loopGap).GetNanoSeconds());
+    }
+    else if (records.size() > 1)
+    {
+        gap = last / (records.size() - 1);
+    }
+    if (gap == 0)
+    {
+        gap = 1; // a trace can not be looped if its duration is 0
+    }
+
+    TrafficTraceFile::Write(output, records, last + gap);
+
+    std::cout << "Written " << records.size() << " packets, lasting "
+              << NanoSeconds(last + gap).As(Time::S) << ", to " << output << std::endl;
+    return 0;
+}
@@ -50,7 +50,18 @@ BeamformingHelperBase::RunTask(const Ptr<NrGnbNetDevice>& gNbDev,
     NS_LOG_FUNCTION(this);
     NS_LOG_INFO(" Run beamforming task for gNB:" << gNbDev->GetNode()->GetId()
                                                  << " and UE:" << ueDev->GetNode()->GetId());
-    BeamformingVectorPair bfPair = GetBeamformingVectors(gnbSpectrumPhy, ueSpectrumPhy);
+    BeamformingVectorPair bfPair;
+    auto initialIt = m_initialBeams.find(std::make_pair(gnbSpectrumPhy, ueSpectrumPhy));
+    if (initialIt != m_initialBeams.end())
+    {
+        NS_LOG_INFO("Using the initial beamforming vectors");
+        bfPair = initialIt->second;
+        m_initialBeams.erase(initialIt);
+    }
+    else
+    {
+        bfPair = GetBeamformingVectors(gnbSpectrumPhy, ueSpectrumPhy);
+    }
 
     NS_ASSERT(bfPair.first.first.GetSize() && bfPair.second.first.GetSize());
     gnbSpectrumPhy->GetBeamManager()->SaveBeamformingVector(bfPair.first, ueDev);
@@ -66,4 +77,14 @@ BeamformingHelperBase::SetBeamformingAlgorithmAttribute(const std::string& n,
     m_algorithmFactory.Set(n, v);
 }
 
+void
+BeamformingHelperBase::SetInitialBeamformingVectors(const Ptr<NrSpectrumPhy>& gnbSpectrumPhy,
+                                                    const Ptr<NrSpectrumPhy>& ueSpectrumPhy,
+                                                    const BeamformingVectorPair& bfPair)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(bfPair.first.first.GetSize() && bfPair.second.first.GetSize());
+    m_initialBeams[std::make_pair(gnbSpectrumPhy, ueSpectrumPhy)] = bfPair;
+}
+
 } // namespace ns3
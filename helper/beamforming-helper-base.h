@@ -9,6 +9,8 @@
 #include <ns3/object.h>
 #include <ns3/vector.h>
 
+#include <map>
+
 #ifndef SRC_NR_HELPER_BEAMFORMING_HELPER_BASE_H_
 #define SRC_NR_HELPER_BEAMFORMING_HELPER_BASE_H_
 
@@ -70,6 +72,22 @@ class BeamformingHelperBase : public Object
      */
     void SetBeamformingAlgorithmAttribute(const std::string& n, const AttributeValue& v);
 
+    /**
+     * \brief Set the beamforming vectors to use, instead of running the
+     * algorithm, the next time the task of a pair of devices is run
+     *
+     * It is used to restore the beams saved at the end of the warm-up of a
+     * previous simulation (see NrCheckpointHelper). The following runs of the
+     * task execute the algorithm as usual.
+     *
+     * \param gnbSpectrumPhy the spectrum phy of the gNB
+     * \param ueSpectrumPhy the spectrum phy of the UE
+     * \param bfPair the beamforming vector pair of the gNB and the UE
+     */
+    void SetInitialBeamformingVectors(const Ptr<NrSpectrumPhy>& gnbSpectrumPhy,
+                                      const Ptr<NrSpectrumPhy>& ueSpectrumPhy,
+                                      const BeamformingVectorPair& bfPair);
+
   protected:
     /**
      * \brief This function runs the beamforming algorithm among the provided gNB and UE
@@ -97,6 +115,10 @@ class BeamformingHelperBase : public Object
 
     ObjectFactory
         m_algorithmFactory; //!< Object factory that will be used to create beamforming algorithms
+
+    /// The beamforming vectors to use at the next run of the task of a pair of spectrum phys
+    mutable std::map<std::pair<Ptr<NrSpectrumPhy>, Ptr<NrSpectrumPhy>>, BeamformingVectorPair>
+        m_initialBeams;
 };
 
 }; // namespace ns3
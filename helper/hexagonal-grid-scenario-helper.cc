@@ -9,8 +9,16 @@
 #include "ns3/constant-velocity-mobility-model.h"
 #include <ns3/double.h>
 #include <ns3/mobility-helper.h>
-
+#include <ns3/pointer.h>
+#include <ns3/three-gpp-propagation-loss-model.h>
+#include <ns3/three-gpp-spectrum-propagation-loss-model.h>
+#include <ns3/wrap-around-channel-condition-model.h>
+#include <ns3/wrap-around-propagation-loss-model.h>
+#include <ns3/wrap-around-spectrum-propagation-loss-model.h>
+
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 namespace ns3
 {
@@ -155,6 +163,75 @@ std::vector<double> HexagonalGridScenarioHelper::siteAngles{
     330 // 5. ring
 };
 
+/**
+ * \brief Coordinates of a site in the hexagonal lattice, in ISD units, along the
+ * directions at 30 and 90 degrees
+ */
+using HexCoordinates = std::pair<int32_t, int32_t>;
+
+/**
+ * \brief Gets the position of a site w.r.t. the central site, in ISD units
+ * \param coord the coordinates of the site
+ * \returns the position of the site
+ */
+static Vector
+GetHexPosition(const HexCoordinates& coord)
+{
+    return Vector(coord.first * std::sqrt(3) / 2, coord.first / 2.0 + coord.second, 0);
+}
+
+/**
+ * \brief Gets the sites of a hexagonal layout, ring by ring
+ * \param numRings the number of rings around the central site
+ * \returns the coordinates of the sites, sorted by distance from the central
+ * site and, at the same distance, by angle in [0, 360) degrees
+ *
+ * The squared distance of a site, in ISD units, is the integer
+ * a^2 + b^2 + a * b, so the sites of the same ring are found exactly. The
+ * order is the one of siteDistances and siteAngles.
+ */
+static std::vector<HexCoordinates>
+GetHexSites(uint32_t numRings)
+{
+    // The distance of the last ring is at most numRings, and the sites within
+    // that distance have coordinates not larger than 2 * numRings / sqrt(3)
+    const int32_t maxCoord = 2 * numRings + 1;
+    std::vector<std::pair<int32_t, double>> keys; // squared distance and angle
+    std::vector<HexCoordinates> sites;
+    for (int32_t a = -maxCoord; a <= maxCoord; ++a)
+    {
+        for (int32_t b = -maxCoord; b <= maxCoord; ++b)
+        {
+            const Vector pos = GetHexPosition({a, b});
+            double angle = std::atan2(pos.y, pos.x) * 180 / M_PI;
+            if (angle < 0)
+            {
+                angle += 360;
+            }
+            keys.emplace_back(a * a + b * b + a * b, angle);
+            sites.emplace_back(a, b);
+        }
+    }
+
+    std::vector<std::size_t> order(sites.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](std::size_t i, std::size_t j) {
+        return keys[i] < keys[j];
+    });
+
+    std::vector<HexCoordinates> ret;
+    uint32_t ring = 0;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        if (i > 0 && keys[order[i]].first != keys[order[i - 1]].first && ++ring > numRings)
+        {
+            break;
+        }
+        ret.push_back(sites[order[i]]);
+    }
+    return ret;
+}
+
 /**
  * \brief Creates a GNUPLOT with the hexagonal deployment including base stations
  * (BS), their hexagonal cell areas and user terminals (UT). Positions and cell
@@ -196,8 +273,14 @@ PlotHexagonalDeployment(const Ptr<const ListPositionAllocator>& sitePosVector,
     topologyOutfile << "set style arrow 1 lc \"black\" lt 1 head filled" << std::endl;
     //  topologyOutfile << "set autoscale" << std::endl;
 
-    uint16_t margin =
-        (12 * cellRadius) + 1; //!< This is the farthest hexagonal vertex from the cell center
+    double maxSiteDistance = 0;
+    for (uint16_t siteId = 0; siteId < numSites; ++siteId)
+    {
+        Vector sitePos = sitePosVector->GetNext();
+        maxSiteDistance = std::max(maxSiteDistance, std::hypot(sitePos.x, sitePos.y));
+    }
+    // The farthest hexagonal vertex from the center of the deployment
+    uint16_t margin = std::max(12 * cellRadius, maxSiteDistance + 3 * cellRadius) + 1;
     topologyOutfile << "set xrange [-" << margin << ":" << margin << "]" << std::endl;
     topologyOutfile << "set yrange [-" << margin << ":" << margin << "]" << std::endl;
     // FIXME: Need to recalculate ranges if the scenario origin is different to (0,0)
@@ -287,40 +370,169 @@ GetClosestSitePosition(Vector cellCenterPos, const Ptr<ListPositionAllocator>& s
 void
 HexagonalGridScenarioHelper::SetNumRings(uint8_t numRings)
 {
-    NS_ABORT_MSG_IF(numRings > 5, "Unsupported number of outer rings (Maximum is 5");
-
     m_numRings = numRings;
+    m_numSites = GetHexSites(numRings).size();
+    SetSitesNumber(m_numSites);
+}
 
-    /*
-     * 0 rings = 1 + 6 * 0 = 1 site
-     * 1 rings = 1 + 6 * 1 = 7 sites
-     * 2 rings = 1 + 6 * 2 = 13 sites
-     * 3 rings = 1 + 6 * 3 = 19 site5
-     * 4 rings = 1 + 6 * 5 = 31 sites
-     * 5 rings = 1 + 6 * 6 = 37 sites
-     */
-    switch (numRings)
+std::vector<Vector>
+HexagonalGridScenarioHelper::GetSitePositions() const
+{
+    // A ring has at least 6 sites
+    auto sites = GetHexSites((m_numSites + 4) / 6);
+    NS_ASSERT(sites.size() >= m_numSites);
+
+    std::vector<Vector> positions;
+    positions.reserve(m_numSites);
+    for (std::size_t siteIndex = 0; siteIndex < m_numSites; ++siteIndex)
     {
-    case 0:
-        m_numSites = 1;
-        break;
-    case 1:
-        m_numSites = 7;
-        break;
-    case 2:
-        m_numSites = 13;
-        break;
-    case 3:
-        m_numSites = 19;
-        break;
-    case 4:
-        m_numSites = 31;
-        break;
-    case 5:
-        m_numSites = 37;
-        break;
+        Vector sitePos(m_centralPos);
+        // The tabulated sites keep their positions bit-exact
+        if (siteIndex < siteDistances.size())
+        {
+            const double dist = siteDistances.at(siteIndex);
+            const double angleRad = siteAngles.at(siteIndex) * M_PI / 180;
+            sitePos.x += m_isd * dist * cos(angleRad);
+            sitePos.y += m_isd * dist * sin(angleRad);
+        }
+        else
+        {
+            const Vector hexPos = GetHexPosition(sites.at(siteIndex));
+            sitePos.x += m_isd * hexPos.x;
+            sitePos.y += m_isd * hexPos.y;
+        }
+        sitePos.z = m_bsHeight;
+        positions.push_back(sitePos);
+    }
+    return positions;
+}
+
+std::vector<Vector>
+HexagonalGridScenarioHelper::GetWrapAroundOffsets() const
+{
+    NS_ABORT_MSG_IF(m_isd <= 0, "The ISD must be set before using the wrap-around");
+
+    // A complete hexagon of n tiers has 1 + 3 * n * (n + 1) sites
+    int32_t n = 0;
+    while (1 + 3 * n * (n + 1) < static_cast<int32_t>(m_numSites))
+    {
+        ++n;
+    }
+    NS_ABORT_MSG_IF(1 + 3 * n * (n + 1) != static_cast<int32_t>(m_numSites),
+                    "The wrap-around needs a complete hexagon of sites (1, 7, 19, 37, 61, ...), "
+                    "not "
+                        << m_numSites << " sites");
+    auto sites = GetHexSites((m_numSites + 4) / 6);
+    sites.resize(m_numSites);
+    for (const auto& [a, b] : sites)
+    {
+        // Hexagonal distance of the site from the central one
+        const int32_t tier =
+            (a < 0) == (b < 0) ? std::abs(a + b) : std::max(std::abs(a), std::abs(b));
+        NS_ABORT_MSG_IF(tier > n,
+                        "The " << m_numSites << " sites closest to the central site are not a "
+                               << "complete hexagon: the wrap-around is not supported");
+    }
+
+    // The copies are shifted by (n + 1, n) and by its rotations of 60 degrees
+    std::vector<Vector> offsets;
+    HexCoordinates shift{n + 1, n};
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        const Vector hexPos = GetHexPosition(shift);
+        offsets.emplace_back(m_isd * hexPos.x, m_isd * hexPos.y, 0);
+        shift = {-shift.second, shift.first + shift.second};
+    }
+    return offsets;
+}
+
+Vector
+HexagonalGridScenarioHelper::GetWrappedPosition(const Vector& bsPos, const Vector& utPos) const
+{
+    return GetWrappedPosition(bsPos, utPos, GetWrapAroundOffsets());
+}
+
+Vector
+HexagonalGridScenarioHelper::GetWrappedPosition(const Vector& bsPos,
+                                                const Vector& utPos,
+                                                const std::vector<Vector>& offsets)
+{
+    Vector closest = bsPos;
+    double minDistance = CalculateDistance(bsPos, utPos);
+    for (const auto& offset : offsets)
+    {
+        const Vector copy = bsPos + offset;
+        const double distance = CalculateDistance(copy, utPos);
+        if (distance < minDistance)
+        {
+            minDistance = distance;
+            closest = copy;
+        }
+    }
+    return closest;
+}
+
+Ptr<WrapAroundModel>
+HexagonalGridScenarioHelper::CreateWrapAroundModel() const
+{
+    NS_ABORT_MSG_IF(m_bs.GetN() == 0,
+                    "The scenario must be created before the wrap-around model");
+
+    Ptr<WrapAroundModel> wrapAround = CreateObject<WrapAroundModel>();
+    wrapAround->SetOffsets(GetWrapAroundOffsets());
+    for (uint32_t i = 0; i < m_bs.GetN(); ++i)
+    {
+        wrapAround->AddBaseStation(m_bs.Get(i));
+    }
+    return wrapAround;
+}
+
+void
+HexagonalGridScenarioHelper::ApplyWrapAround(OperationBandInfo* band,
+                                             const Ptr<WrapAroundModel>& wrapAround)
+{
+    NS_ABORT_MSG_IF(wrapAround == nullptr, "The wrap-around model is not set");
+
+    for (const auto& cc : band->m_cc)
+    {
+        for (const auto& bwp : cc->m_bwp)
+        {
+            NS_ABORT_MSG_IF(bwp->m_channel != nullptr,
+                            "The wrap-around must be applied before creating the channel");
+            NS_ABORT_MSG_IF(bwp->m_propagation == nullptr || bwp->m_3gppChannel == nullptr,
+                            "The channel models must be created before applying the wrap-around");
+
+            // The same condition for the pathloss, the fast fading, and the
+            // other users of the condition model
+            auto threeGppPropagation = DynamicCast<ThreeGppPropagationLossModel>(bwp->m_propagation);
+            if (threeGppPropagation != nullptr)
+            {
+                auto condition = CreateObject<WrapAroundChannelConditionModel>();
+                condition->SetChannelConditionModel(
+                    threeGppPropagation->GetChannelConditionModel());
+                condition->SetWrapAroundModel(wrapAround);
+                threeGppPropagation->SetChannelConditionModel(condition);
+
+                auto threeGppFading =
+                    DynamicCast<ThreeGppSpectrumPropagationLossModel>(bwp->m_3gppChannel);
+                if (threeGppFading != nullptr)
+                {
+                    threeGppFading->SetChannelModelAttribute("ChannelConditionModel",
+                                                             PointerValue(condition));
+                }
+            }
+
+            auto propagation = CreateObject<WrapAroundPropagationLossModel>();
+            propagation->SetPropagationLossModel(bwp->m_propagation);
+            propagation->SetWrapAroundModel(wrapAround);
+            bwp->m_propagation = propagation;
+
+            auto fading = CreateObject<WrapAroundSpectrumPropagationLossModel>();
+            fading->SetSpectrumPropagationLossModel(bwp->m_3gppChannel);
+            fading->SetWrapAroundModel(wrapAround);
+            bwp->m_3gppChannel = fading;
+        }
     }
-    SetSitesNumber(m_numSites);
 }
 
 double
@@ -383,7 +595,6 @@ HexagonalGridScenarioHelper::CreateScenario()
     m_ut.Create(m_numUt);
 
     NS_ASSERT(m_isd > 0);
-    NS_ASSERT(m_numRings < 6);
     NS_ASSERT(m_hexagonalRadius > 0);
     NS_ASSERT(m_bsHeight >= 0.0);
     NS_ASSERT(m_utHeight >= 0.0);
@@ -397,15 +608,10 @@ HexagonalGridScenarioHelper::CreateScenario()
     Ptr<ListPositionAllocator> utPosVector = CreateObject<ListPositionAllocator>();
 
     // BS position
+    const auto sitePositions = GetSitePositions();
     for (std::size_t cellId = 0; cellId < m_numBs; cellId++)
     {
-        uint16_t siteIndex = GetSiteIndex(cellId);
-        Vector sitePos(m_centralPos);
-        const double dist = siteDistances.at(siteIndex);
-        const double angleRad = siteAngles.at(siteIndex) * M_PI / 180;
-        sitePos.x += m_isd * dist * cos(angleRad);
-        sitePos.y += m_isd * dist * sin(angleRad);
-        sitePos.z = m_bsHeight;
+        const Vector& sitePos = sitePositions.at(GetSiteIndex(cellId));
 
         if (GetSectorIndex(cellId) == 0)
         {
@@ -482,7 +688,6 @@ HexagonalGridScenarioHelper::CreateScenarioWithMobility(const Vector& speed, dou
     m_ut.Create(m_numUt);
 
     NS_ASSERT(m_isd > 0);
-    NS_ASSERT(m_numRings < 6);
     NS_ASSERT(m_hexagonalRadius > 0);
     NS_ASSERT(m_bsHeight >= 0.0);
     NS_ASSERT(m_utHeight >= 0.0);
@@ -500,15 +705,10 @@ HexagonalGridScenarioHelper::CreateScenarioWithMobility(const Vector& speed, dou
     Ptr<ListPositionAllocator> utPosVector = CreateObject<ListPositionAllocator>();
 
     // BS position
+    const auto sitePositions = GetSitePositions();
     for (std::size_t cellId = 0; cellId < m_numBs; cellId++)
     {
-        uint16_t siteIndex = GetSiteIndex(cellId);
-        Vector sitePos(m_centralPos);
-        const double dist = siteDistances.at(siteIndex);
-        const double angleRad = siteAngles.at(siteIndex) * M_PI / 180;
-        sitePos.x += m_isd * dist * cos(angleRad);
-        sitePos.y += m_isd * dist * sin(angleRad);
-        sitePos.z = m_bsHeight;
+        const Vector& sitePos = sitePositions.at(GetSiteIndex(cellId));
 
         if (GetSectorIndex(cellId) == 0)
         {
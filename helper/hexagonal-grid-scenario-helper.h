@@ -7,9 +7,11 @@
 #ifndef HEXAGONAL_GRID_SCENARIO_HELPER_H
 #define HEXAGONAL_GRID_SCENARIO_HELPER_H
 
+#include "cc-bwp-helper.h"
 #include "node-distribution-scenario-interface.h"
 
 #include <ns3/random-variable-stream.h>
+#include <ns3/wrap-around-model.h>
 #include <ns3/vector.h>
 
 namespace ns3
@@ -46,33 +48,101 @@ class HexagonalGridScenarioHelper : public NodeDistributionScenarioInterface
     /**
      * \brief Sets the number of outer rings of sites around the central site
      *
-     * Relation between the number of rings and the number of rings.
+     * A ring is a group of sites at the same distance from the central site.
+     * Any number of rings is supported. Relation between the number of rings
+     * and the number of sites:
      *
-     * 0 rings = 1 + 6 * 0 = 1 site
-     * 1 rings = 1 + 6 * 1 = 7 sites
-     * 2 rings = 1 + 6 * 2 = 13 sites
-     * 3 rings = 1 + 6 * 3 = 19 sites
-     * 4 rings = 1 + 6 * 4 = 31 sites
-     * 5 rings = 1 + 6 * 5 = 37 sites
+     * 0 rings = 1 site
+     * 1 rings = 1 + 6 = 7 sites (distance ISD)
+     * 2 rings = 7 + 6 = 13 sites (distance sqrt(3) * ISD)
+     * 3 rings = 13 + 6 = 19 sites (distance 2 * ISD)
+     * 4 rings = 19 + 12 = 31 sites (distance sqrt(7) * ISD)
+     * 5 rings = 31 + 6 = 37 sites (distance 3 * ISD)
+     * 6 rings = 37 + 6 = 43 sites (distance sqrt(12) * ISD)
+     * 7 rings = 43 + 12 = 55 sites (distance sqrt(13) * ISD)
+     * 8 rings = 55 + 6 = 61 sites (distance 4 * ISD)
      *
-     * 0 rings = (1 + 6 * 0 ) * 3 = 3 gNBs
-     * 1 rings = (1 + 6 * 1 ) * 3 = 21 gNBs
-     * 2 rings = (1 + 6 * 2 ) * 3 = 39 gNBs
-     * 3 rings = (1 + 6 * 3 ) * 3 = 57 gNBs
-     * 4 rings = (1 + 6 * 5 ) * 3 = 93 gNBs
-     * 5 rings = (1 + 6 * 6 ) * 3 = 111 gNBs
+     * With three sectors per site, there are three gNBs per site (e.g., 57
+     * gNBs with 3 rings), and with 10 UEs per gNB, 30 UEs per site (e.g., 570
+     * UEs with 3 rings).
      *
-     * If 10 UEs per gNB:
-     *
-     * 0 rings = (1 + 6 * 0 ) * 3 * 10 = 30 UEs
-     * 1 rings = (1 + 6 * 1 ) * 3 * 10 = 210 UEs
-     * 2 rings = (1 + 6 * 2 ) * 3 * 10 = 390 UEs
-     * 3 rings = (1 + 6 * 3 ) * 3 * 10 = 570 UEs
-     * 4 rings = (1 + 6 * 5 ) * 3 * 10 = 930 UEs
-     * 5 rings = (1 + 6 * 6 ) * 3 * 10  = 1110 UEs
+     * The layouts of 0, 1, 3, 5 and 8 rings are complete hexagons of 1, 7,
+     * 19, 37 and 61 sites, that support the wrap-around (see
+     * GetWrapAroundOffsets).
      */
     void SetNumRings(uint8_t numRings);
 
+    /**
+     * \brief Gets the offsets of the six copies of the layout that surround it in
+     * the wrap-around model of 3GPP TR 38.901 (and ITU-R M.2412)
+     * \returns the offsets of the copies, in meters
+     *
+     * With the wrap-around, the layout is repeated around itself, so that each
+     * site sees the interference of an infinite network, and a UE is served by
+     * (and interfered by) the closest copy of each site (see GetWrappedPosition).
+     * The layout must be a complete hexagon of sites, i.e., it must have
+     * 1 + 3 * n * (n + 1) sites (1, 7, 19, 37, 61, ...), and the ISD must be set.
+     */
+    std::vector<Vector> GetWrapAroundOffsets() const;
+
+    /**
+     * \brief Gets the position of the copy of a site, or of a gNB, that is the
+     * closest to a UE, in the wrap-around model
+     * \param bsPos the position of the site (or of the gNB) in the layout
+     * \param utPos the position of the UE
+     * \returns the position of the closest copy of bsPos, that gives the
+     * wrapped distance, and the angles, between the gNB and the UE
+     *
+     * See GetWrapAroundOffsets for the requirements on the layout.
+     */
+    Vector GetWrappedPosition(const Vector& bsPos, const Vector& utPos) const;
+
+    /**
+     * \brief Gets the position of the copy of a site that is the closest to a
+     * UE, given the offsets of the copies
+     * \param bsPos the position of the site (or of the gNB) in the layout
+     * \param utPos the position of the UE
+     * \param offsets the offsets of the copies, as returned by GetWrapAroundOffsets
+     * \returns the position of the closest copy of bsPos (bsPos itself, if no
+     * copy is closer to the UE)
+     */
+    static Vector GetWrappedPosition(const Vector& bsPos,
+                                     const Vector& utPos,
+                                     const std::vector<Vector>& offsets);
+
+    /**
+     * \brief Creates the wrap-around model of the base stations of the scenario
+     * \returns a WrapAroundModel with the copies of each base station
+     *
+     * It must be called after CreateScenario, and the layout must support the
+     * wrap-around (see GetWrapAroundOffsets). The model is used by the
+     * wrappers of the channel models (see ApplyWrapAround).
+     */
+    Ptr<WrapAroundModel> CreateWrapAroundModel() const;
+
+    /**
+     * \brief Applies the wrap-around to the channel models of a band
+     * \param band the band
+     * \param wrapAround the wrap-around model (see CreateWrapAroundModel), that
+     * can be shared by all the bands
+     *
+     * The propagation loss model and the spectrum propagation loss model of
+     * each BWP are replaced by a WrapAroundPropagationLossModel and by a
+     * WrapAroundSpectrumPropagationLossModel, that wrap them, and the channel
+     * condition model of the 3GPP models by a WrapAroundChannelConditionModel,
+     * all with the same WrapAroundModel. Then, the base stations serve and
+     * interfere with the UEs from their closest copy. NrHelper::AssignStreams
+     * and the beamforming algorithms use the 3GPP models behind the wrappers,
+     * and the direct path beams point at the closest copy.
+     *
+     * The models must be already created, but not the channel: e.g., call
+     * NrHelper::InitializeOperationBand (band, NrHelper::INIT_PROPAGATION |
+     * NrHelper::INIT_FADING), then this method, and then
+     * NrHelper::InitializeOperationBand (band) to create the channel.
+     * The scenarios with buildings are not supported.
+     */
+    static void ApplyWrapAround(OperationBandInfo* band, const Ptr<WrapAroundModel>& wrapAround);
+
     /**
      * \brief Gets the radius of the hexagonal cell
      * \returns Cell radius in meters
@@ -121,6 +191,12 @@ class HexagonalGridScenarioHelper : public NodeDistributionScenarioInterface
     double m_maxUeDistanceToClosestSite{
         10000}; //!< Set to some huge value to not affect unless is configured
 
+    /**
+     * \brief Gets the positions of the sites of the layout
+     * \returns the position of each site, at the height of the base stations
+     */
+    std::vector<Vector> GetSitePositions() const;
+
     static std::vector<double> siteDistances;
     static std::vector<double> siteAngles;
 
@@ -7,15 +7,21 @@
 #include "ideal-beamforming-helper.h"
 
 #include <ns3/beam-manager.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
 #include <ns3/ideal-beamforming-algorithm.h>
 #include <ns3/log.h>
+#include <ns3/mobility-model.h>
 #include <ns3/nr-gnb-net-device.h>
 #include <ns3/nr-gnb-phy.h>
+#include <ns3/nr-profiler.h>
 #include <ns3/nr-spectrum-phy.h>
 #include <ns3/nr-ue-net-device.h>
 #include <ns3/nr-ue-phy.h>
 #include <ns3/object-factory.h>
+#include <ns3/three-gpp-spectrum-propagation-loss-model.h>
 #include <ns3/vector.h>
+#include <ns3/wrap-around-spectrum-propagation-loss-model.h>
 
 namespace ns3
 {
@@ -62,7 +68,20 @@ IdealBeamformingHelper::GetTypeId()
                           TimeValue(MilliSeconds(100)),
                           MakeTimeAccessor(&IdealBeamformingHelper::SetPeriodicity,
                                            &IdealBeamformingHelper::GetPeriodicity),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("SkipUnchangedPairs",
+                          "If true, the periodic beamforming does not search again the beams of "
+                          "a pair whose channel matrix and positions did not change since its "
+                          "previous search.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&IdealBeamformingHelper::m_skipUnchangedPairs),
+                          MakeBooleanChecker())
+            .AddAttribute("MovementThreshold",
+                          "The movement (in meters) of the gNB or the UE of a pair, since its "
+                          "previous search, after which its beams are searched again.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&IdealBeamformingHelper::m_movementThreshold),
+                          MakeDoubleChecker<double>(0.0));
     return tid;
 }
 
@@ -93,6 +112,11 @@ IdealBeamformingHelper::AddBeamformingTask(const Ptr<NrGnbNetDevice>& gnbDev,
                 std::make_pair(gnbDev, ueDev);
 
             RunTask(gnbDev, ueDev, gnbSpectrumPhy, ueSpectrumPhy);
+            if (m_skipUnchangedPairs)
+            {
+                m_snapshots[std::make_pair(gnbSpectrumPhy, ueSpectrumPhy)] =
+                    TakeSnapshot(gnbSpectrumPhy, ueSpectrumPhy);
+            }
         }
     }
 }
@@ -101,13 +125,86 @@ void
 IdealBeamformingHelper::Run() const
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::BEAMFORMING);
     NS_LOG_INFO("Running the beamforming method. There are :"
                 << m_spectrumPhyPairToDevicePair.size() << " tasks.");
 
+    uint64_t skipped = 0;
     for (const auto& task : m_spectrumPhyPairToDevicePair)
     {
+        if (m_skipUnchangedPairs)
+        {
+            PairSnapshot snapshot = TakeSnapshot(task.first.first, task.first.second);
+            auto it = m_snapshots.find(task.first);
+            if (it != m_snapshots.end() && IsUnchanged(it->second, snapshot))
+            {
+                // The beams saved at the previous search are still the best ones
+                task.first.second->GetBeamManager()->ChangeBeamformingVector(task.second.first);
+                ++skipped;
+                continue;
+            }
+            m_snapshots[task.first] = snapshot;
+        }
         RunTask(task.second.first, task.second.second, task.first.first, task.first.second);
     }
+
+    m_numSearches += m_spectrumPhyPairToDevicePair.size() - skipped;
+    m_numSkippedSearches += skipped;
+    NS_LOG_INFO("Skipped " << skipped << " of " << m_spectrumPhyPairToDevicePair.size()
+                           << " tasks, whose channel and positions did not change");
+}
+
+IdealBeamformingHelper::PairSnapshot
+IdealBeamformingHelper::TakeSnapshot(const Ptr<NrSpectrumPhy>& gnbSpectrumPhy,
+                                     const Ptr<NrSpectrumPhy>& ueSpectrumPhy) const
+{
+    PairSnapshot snapshot;
+    snapshot.m_gnbPosition = gnbSpectrumPhy->GetMobility()->GetPosition();
+    snapshot.m_uePosition = ueSpectrumPhy->GetMobility()->GetPosition();
+
+    // The same channel matrix that the algorithm would get: if it has to be
+    // updated, it is generated now instead of during the search. With the
+    // wrap-around, it is the matrix of the closest copy of the gNB.
+    Ptr<PhasedArraySpectrumPropagationLossModel> channelSplm =
+        gnbSpectrumPhy->GetSpectrumChannel()->GetPhasedArraySpectrumPropagationLossModel();
+    Ptr<ThreeGppSpectrumPropagationLossModel> splm =
+        DynamicCast<ThreeGppSpectrumPropagationLossModel>(
+            WrapAroundSpectrumPropagationLossModel::Unwrap(channelSplm));
+    if (splm != nullptr && splm->GetChannelModel() != nullptr)
+    {
+        const auto [gnbMobility, ueMobility] =
+            WrapAroundSpectrumPropagationLossModel::GetWrappedLink(channelSplm,
+                                                                   gnbSpectrumPhy->GetMobility(),
+                                                                   ueSpectrumPhy->GetMobility());
+        snapshot.m_channel = splm->GetChannelModel()->GetChannel(
+            gnbMobility,
+            ueMobility,
+            gnbSpectrumPhy->GetAntenna()->GetObject<PhasedArrayModel>(),
+            ueSpectrumPhy->GetAntenna()->GetObject<PhasedArrayModel>());
+    }
+    return snapshot;
+}
+
+bool
+IdealBeamformingHelper::IsUnchanged(const PairSnapshot& previous,
+                                    const PairSnapshot& current) const
+{
+    return current.m_channel != nullptr && previous.m_channel == current.m_channel &&
+           CalculateDistance(previous.m_gnbPosition, current.m_gnbPosition) <=
+               m_movementThreshold &&
+           CalculateDistance(previous.m_uePosition, current.m_uePosition) <= m_movementThreshold;
+}
+
+uint64_t
+IdealBeamformingHelper::GetNumSearches() const
+{
+    return m_numSearches;
+}
+
+uint64_t
+IdealBeamformingHelper::GetNumSkippedSearches() const
+{
+    return m_numSkippedSearches;
 }
 
 BeamformingVectorPair
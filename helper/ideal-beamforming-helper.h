@@ -8,7 +8,9 @@
 
 #include "ns3/event-id.h"
 #include <ns3/beamforming-vector.h>
+#include <ns3/matrix-based-channel-model.h>
 #include <ns3/nstime.h>
+#include <ns3/vector.h>
 
 #ifndef SRC_NR_HELPER_IDEAL_BEAMFORMING_HELPER_H_
 #define SRC_NR_HELPER_IDEAL_BEAMFORMING_HELPER_H_
@@ -23,6 +25,14 @@ class IdealBeamformingAlgorithm;
 /**
  * \ingroup helper
  * \brief The IdealBeamformingHelper class
+ *
+ * The beamforming tasks are run when they are added, and then periodically.
+ * With SkipUnchangedPairs, a periodic run skips the search of a pair of
+ * devices if the channel matrix of the pair has not been generated again since
+ * the previous search, and if none of the devices moved by more than
+ * MovementThreshold: the ideal algorithms depend only on the channel and on
+ * the positions, so the search would return the beams already in use. The
+ * pairs whose channel is not a 3GPP channel matrix are always searched.
  */
 class IdealBeamformingHelper : public BeamformingHelperBase
 {
@@ -73,6 +83,19 @@ class IdealBeamformingHelper : public BeamformingHelperBase
     void AddBeamformingTask(const Ptr<NrGnbNetDevice>& gNbDev,
                             const Ptr<NrUeNetDevice>& ueDev) override;
 
+    /**
+     * \brief Get the number of searches run by the periodic beamforming
+     * \return the number of searches run
+     */
+    uint64_t GetNumSearches() const;
+
+    /**
+     * \brief Get the number of searches skipped by the periodic beamforming,
+     * because the channel and the positions of the pair did not change
+     * \return the number of searches skipped
+     */
+    uint64_t GetNumSkippedSearches() const;
+
   protected:
     // inherited from Object
     void DoInitialize() override;
@@ -99,6 +122,41 @@ class IdealBeamformingHelper : public BeamformingHelperBase
         DevicePair; //!< The list of beamforming tasks to be executed
 
     std::map<SpectrumPhyPair, DevicePair> m_spectrumPhyPairToDevicePair;
+
+    /**
+     * \brief The channel and the positions of a pair at its last search
+     */
+    struct PairSnapshot
+    {
+        Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< Channel matrix, if any
+        Vector m_gnbPosition;                                         //!< Position of the gNB
+        Vector m_uePosition;                                          //!< Position of the UE
+    };
+
+    /**
+     * \brief Get the current channel and positions of a pair
+     * \param gnbSpectrumPhy the spectrum phy of the gNB
+     * \param ueSpectrumPhy the spectrum phy of the UE
+     * \return the snapshot of the pair
+     */
+    PairSnapshot TakeSnapshot(const Ptr<NrSpectrumPhy>& gnbSpectrumPhy,
+                              const Ptr<NrSpectrumPhy>& ueSpectrumPhy) const;
+
+    /**
+     * \brief Check if the search of a pair would give the beams of its last search
+     * \param previous the snapshot of the last search
+     * \param current the current snapshot
+     * \return true if the search can be skipped
+     */
+    bool IsUnchanged(const PairSnapshot& previous, const PairSnapshot& current) const;
+
+    bool m_skipUnchangedPairs{true}; //!< Skip the search of the pairs that did not change
+    double m_movementThreshold{0.0}; //!< Movement (m) after which a pair is searched again
+
+    mutable std::map<SpectrumPhyPair, PairSnapshot> m_snapshots; //!< Snapshot of each pair
+
+    mutable uint64_t m_numSearches{0};        //!< Searches run by the periodic beamforming
+    mutable uint64_t m_numSkippedSearches{0}; //!< Searches skipped by the periodic beamforming
 };
 
 }; // namespace ns3
@@ -0,0 +1,406 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-checkpoint-helper.h"
+
+#include "beamforming-helper-base.h"
+
+#include <ns3/abort.h>
+#include <ns3/beam-manager.h>
+#include <ns3/log.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/nr-gnb-net-device.h>
+#include <ns3/nr-gnb-phy.h>
+#include <ns3/nr-spectrum-phy.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/nr-ue-phy.h>
+#include <ns3/phased-array-model.h>
+#include <ns3/simulator.h>
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrCheckpointHelper");
+NS_OBJECT_ENSURE_REGISTERED(NrCheckpointHelper);
+
+/// First line of the files written by NrCheckpointHelper
+static const std::string CHECKPOINT_HEADER = "NR-CHECKPOINT 2";
+
+/**
+ * \brief Write a beam: sector, elevation, size and elements of the vector
+ * \param os the stream
+ * \param bfv the beam
+ */
+static void
+WriteBeam(std::ostream& os, const BeamformingVector& bfv)
+{
+    os << " " << bfv.second.GetSector() << " " << bfv.second.GetElevation() << " "
+       << bfv.first.GetSize();
+    for (std::size_t i = 0; i < bfv.first.GetSize(); ++i)
+    {
+        os << " " << bfv.first[i].real() << " " << bfv.first[i].imag();
+    }
+}
+
+/**
+ * \brief Read a beam written by WriteBeam
+ * \param is the stream
+ * \param bfv the beam to fill
+ * \return false if the beam is malformed
+ */
+static bool
+ReadBeam(std::istream& is, BeamformingVector* bfv)
+{
+    uint16_t sector;
+    double elevation;
+    std::size_t size;
+    if (!(is >> sector >> elevation >> size))
+    {
+        return false;
+    }
+    PhasedArrayModel::ComplexVector vector(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        double re;
+        double im;
+        if (!(is >> re >> im))
+        {
+            return false;
+        }
+        vector[i] = std::complex<double>(re, im);
+    }
+    *bfv = std::make_pair(vector, BeamId(sector, elevation));
+    return true;
+}
+
+/**
+ * \brief Read a number of values, followed by the values (e.g., the MCSs of the streams)
+ * \param is the stream
+ * \param values the values to fill
+ * \return false if the values are malformed
+ */
+static bool
+ReadValues(std::istream& is, std::vector<uint8_t>* values)
+{
+    std::size_t size;
+    if (!(is >> size))
+    {
+        return false;
+    }
+    values->clear();
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        uint32_t value;
+        if (!(is >> value))
+        {
+            return false;
+        }
+        values->push_back(static_cast<uint8_t>(value));
+    }
+    return true;
+}
+
+NrCheckpointHelper::NrCheckpointHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrCheckpointHelper::~NrCheckpointHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+NrCheckpointHelper::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrCheckpointHelper")
+                            .SetParent<Object>()
+                            .SetGroupName("nr")
+                            .AddConstructor<NrCheckpointHelper>();
+    return tid;
+}
+
+void
+NrCheckpointHelper::Save(const std::string& fileName,
+                         const NetDeviceContainer& gnbDevs,
+                         const NetDeviceContainer& ueDevs) const
+{
+    NS_LOG_FUNCTION(this << fileName);
+
+    std::ofstream file(fileName);
+    NS_ABORT_MSG_IF(!file.is_open(), "Can't open the checkpoint file " << fileName);
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << CHECKPOINT_HEADER << "\n";
+
+    uint32_t numBeams = 0;
+    uint32_t numLinks = 0;
+    for (auto gnbIt = gnbDevs.Begin(); gnbIt != gnbDevs.End(); ++gnbIt)
+    {
+        Ptr<NrGnbNetDevice> gnbDev = DynamicCast<NrGnbNetDevice>(*gnbIt);
+        NS_ABORT_MSG_IF(gnbDev == nullptr, "Not a NrGnbNetDevice");
+        for (auto ueIt = ueDevs.Begin(); ueIt != ueDevs.End(); ++ueIt)
+        {
+            Ptr<NrUeNetDevice> ueDev = DynamicCast<NrUeNetDevice>(*ueIt);
+            NS_ABORT_MSG_IF(ueDev == nullptr, "Not a NrUeNetDevice");
+            if (ueDev->GetTargetEnb() != gnbDev)
+            {
+                continue;
+            }
+
+            const uint64_t imsi = ueDev->GetImsi();
+            for (uint8_t ccId = 0; ccId < gnbDev->GetCcMapSize(); ++ccId)
+            {
+                const uint8_t arrays = std::min(gnbDev->GetPhy(ccId)->GetNumberOfStreams(),
+                                                ueDev->GetPhy(ccId)->GetNumberOfStreams());
+                for (uint8_t array = 0; array < arrays; ++array)
+                {
+                    Ptr<BeamManager> gnbBm =
+                        gnbDev->GetPhy(ccId)->GetSpectrumPhy(array)->GetBeamManager();
+                    Ptr<BeamManager> ueBm =
+                        ueDev->GetPhy(ccId)->GetSpectrumPhy(array)->GetBeamManager();
+                    if (gnbBm->GetPeerIndex(ueDev) == BeamManager::NO_PEER ||
+                        ueBm->GetPeerIndex(gnbDev) == BeamManager::NO_PEER)
+                    {
+                        continue;
+                    }
+                    file << "BEAM " << gnbDev->GetCellId() << " " << +ccId << " " << +array
+                         << " " << imsi;
+                    WriteBeam(file,
+                              std::make_pair(gnbBm->GetBeamformingVector(ueDev),
+                                             gnbBm->GetBeamId(ueDev)));
+                    WriteBeam(file,
+                              std::make_pair(ueBm->GetBeamformingVector(gnbDev),
+                                             ueBm->GetBeamId(gnbDev)));
+                    file << "\n";
+                    ++numBeams;
+                }
+
+                Ptr<NrMacSchedulerNs3> sched =
+                    DynamicCast<NrMacSchedulerNs3>(gnbDev->GetScheduler(ccId));
+                NrMacSchedulerNs3::UeLinkState state;
+                if (sched != nullptr &&
+                    sched->GetUeLinkState(ueDev->GetRrc()->GetRnti(), &state))
+                {
+                    file << "LINK " << gnbDev->GetCellId() << " " << +ccId << " " << imsi << " "
+                         << +state.m_ulMcs << " " << +state.m_ulCqi << " " << state.m_ulCqiTimer
+                         << " " << +state.m_dlRi << " " << state.m_dlCqiTimer << " "
+                         << state.m_dlMcs.size();
+                    for (const auto& mcs : state.m_dlMcs)
+                    {
+                        file << " " << +mcs;
+                    }
+                    file << " " << state.m_dlWbCqi.size();
+                    for (const auto& cqi : state.m_dlWbCqi)
+                    {
+                        file << " " << +cqi;
+                    }
+                    file << "\n";
+                    ++numLinks;
+                }
+            }
+        }
+    }
+
+    NS_LOG_INFO("Saved " << numBeams << " beams and " << numLinks << " link states in "
+                         << fileName << " at " << Simulator::Now().As(Time::S));
+}
+
+void
+NrCheckpointHelper::ScheduleSave(const Time& time,
+                                 const std::string& fileName,
+                                 const NetDeviceContainer& gnbDevs,
+                                 const NetDeviceContainer& ueDevs)
+{
+    NS_LOG_FUNCTION(this << time << fileName);
+    Simulator::Schedule(time - Simulator::Now(),
+                        &NrCheckpointHelper::Save,
+                        this,
+                        fileName,
+                        gnbDevs,
+                        ueDevs);
+}
+
+void
+NrCheckpointHelper::Load(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+
+    std::ifstream file(fileName);
+    NS_ABORT_MSG_IF(!file.is_open(), "Can't open the checkpoint file " << fileName);
+
+    std::string line;
+    NS_ABORT_MSG_IF(!std::getline(file, line) || line != CHECKPOINT_HEADER,
+                    fileName << " is not a checkpoint file");
+
+    m_beams.clear();
+    m_linkStates.clear();
+    uint32_t lineNum = 1;
+    while (std::getline(file, line))
+    {
+        ++lineNum;
+        std::istringstream is(line);
+        std::string type;
+        uint16_t cellId;
+        uint32_t ccId;
+        uint64_t imsi;
+        if (!(is >> type))
+        {
+            continue;
+        }
+        if (type == "BEAM")
+        {
+            uint32_t array;
+            BeamformingVectorPair bfPair;
+            NS_ABORT_MSG_IF(!(is >> cellId >> ccId >> array >> imsi) ||
+                                !ReadBeam(is, &bfPair.first) || !ReadBeam(is, &bfPair.second),
+                            "Malformed beam at line " << lineNum << " of " << fileName);
+            m_beams[BeamKey(cellId, ccId, array, imsi)] = bfPair;
+        }
+        else if (type == "LINK")
+        {
+            uint32_t ulMcs;
+            uint32_t ulCqi;
+            uint32_t dlRi;
+            NrMacSchedulerNs3::UeLinkState state;
+            NS_ABORT_MSG_IF(!(is >> cellId >> ccId >> imsi >> ulMcs >> ulCqi >>
+                              state.m_ulCqiTimer >> dlRi >> state.m_dlCqiTimer) ||
+                                !ReadValues(is, &state.m_dlMcs) ||
+                                !ReadValues(is, &state.m_dlWbCqi) || state.m_dlMcs.empty() ||
+                                state.m_dlWbCqi.size() > state.m_dlMcs.size(),
+                            "Malformed link state at line " << lineNum << " of " << fileName);
+            state.m_ulMcs = static_cast<uint8_t>(ulMcs);
+            state.m_ulCqi = static_cast<uint8_t>(ulCqi);
+            state.m_dlRi = static_cast<uint8_t>(dlRi);
+            m_linkStates[LinkKey(cellId, ccId, imsi)] = state;
+        }
+        else
+        {
+            NS_FATAL_ERROR("Unknown record " << type << " at line " << lineNum << " of "
+                                             << fileName);
+        }
+    }
+
+    NS_LOG_INFO("Loaded " << m_beams.size() << " beams and " << m_linkStates.size()
+                          << " link states from " << fileName);
+}
+
+uint32_t
+NrCheckpointHelper::RestoreBeams(const NetDeviceContainer& gnbDevs,
+                                 const NetDeviceContainer& ueDevs,
+                                 const Ptr<BeamformingHelperBase>& beamformingHelper) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(beamformingHelper == nullptr, "The beams need a beamforming helper");
+
+    uint32_t restored = 0;
+    for (auto gnbIt = gnbDevs.Begin(); gnbIt != gnbDevs.End(); ++gnbIt)
+    {
+        Ptr<NrGnbNetDevice> gnbDev = DynamicCast<NrGnbNetDevice>(*gnbIt);
+        NS_ABORT_MSG_IF(gnbDev == nullptr, "Not a NrGnbNetDevice");
+        for (auto ueIt = ueDevs.Begin(); ueIt != ueDevs.End(); ++ueIt)
+        {
+            Ptr<NrUeNetDevice> ueDev = DynamicCast<NrUeNetDevice>(*ueIt);
+            NS_ABORT_MSG_IF(ueDev == nullptr, "Not a NrUeNetDevice");
+            for (uint8_t ccId = 0; ccId < gnbDev->GetCcMapSize(); ++ccId)
+            {
+                const uint8_t arrays = std::min(gnbDev->GetPhy(ccId)->GetNumberOfStreams(),
+                                                ueDev->GetPhy(ccId)->GetNumberOfStreams());
+                for (uint8_t array = 0; array < arrays; ++array)
+                {
+                    auto it =
+                        m_beams.find(BeamKey(gnbDev->GetCellId(), ccId, array, ueDev->GetImsi()));
+                    if (it == m_beams.end())
+                    {
+                        continue;
+                    }
+                    Ptr<NrSpectrumPhy> gnbSpectrumPhy = gnbDev->GetPhy(ccId)->GetSpectrumPhy(array);
+                    Ptr<NrSpectrumPhy> ueSpectrumPhy = ueDev->GetPhy(ccId)->GetSpectrumPhy(array);
+                    CheckBeamSize(it->second.first, gnbSpectrumPhy, it->first);
+                    CheckBeamSize(it->second.second, ueSpectrumPhy, it->first);
+                    beamformingHelper->SetInitialBeamformingVectors(gnbSpectrumPhy,
+                                                                    ueSpectrumPhy,
+                                                                    it->second);
+                    ++restored;
+                }
+            }
+        }
+    }
+
+    NS_LOG_INFO("Restored " << restored << " of " << m_beams.size() << " beams");
+    return restored;
+}
+
+void
+NrCheckpointHelper::CheckBeamSize(const BeamformingVector& bfv,
+                                  const Ptr<NrSpectrumPhy>& spectrumPhy,
+                                  const BeamKey& key)
+{
+    const auto elements =
+        spectrumPhy->GetAntenna()->GetObject<PhasedArrayModel>()->GetNumberOfElements();
+    NS_ABORT_MSG_IF(bfv.first.GetSize() != elements,
+                    "The beam of cell " << std::get<0>(key) << ", BWP " << +std::get<1>(key)
+                                        << ", array " << +std::get<2>(key) << ", IMSI "
+                                        << std::get<3>(key) << " has " << bfv.first.GetSize()
+                                        << " elements, but the antenna array has " << elements
+                                        << ": the deployment is not the one of the checkpoint");
+}
+
+void
+NrCheckpointHelper::ScheduleRestoreLinkState(const Time& time, const NetDeviceContainer& ueDevs)
+{
+    NS_LOG_FUNCTION(this << time);
+    Simulator::Schedule(time - Simulator::Now(),
+                        &NrCheckpointHelper::RestoreLinkState,
+                        this,
+                        ueDevs);
+}
+
+void
+NrCheckpointHelper::RestoreLinkState(const NetDeviceContainer& ueDevs) const
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t restored = 0;
+    for (auto ueIt = ueDevs.Begin(); ueIt != ueDevs.End(); ++ueIt)
+    {
+        Ptr<NrUeNetDevice> ueDev = DynamicCast<NrUeNetDevice>(*ueIt);
+        NS_ABORT_MSG_IF(ueDev == nullptr, "Not a NrUeNetDevice");
+        Ptr<const NrGnbNetDevice> gnbDev = ueDev->GetTargetEnb();
+        if (gnbDev == nullptr)
+        {
+            NS_LOG_WARN("UE " << ueDev->GetImsi() << " is not attached");
+            continue;
+        }
+        for (uint8_t ccId = 0; ccId < gnbDev->GetCcMapSize(); ++ccId)
+        {
+            auto it = m_linkStates.find(LinkKey(gnbDev->GetCellId(), ccId, ueDev->GetImsi()));
+            Ptr<NrMacSchedulerNs3> sched =
+                DynamicCast<NrMacSchedulerNs3>(gnbDev->GetScheduler(ccId));
+            if (it == m_linkStates.end() || sched == nullptr)
+            {
+                continue;
+            }
+            if (sched->SetUeLinkState(ueDev->GetRrc()->GetRnti(), it->second))
+            {
+                ++restored;
+            }
+            else
+            {
+                NS_LOG_WARN("UE " << ueDev->GetImsi() << " is not connected to cell "
+                                  << gnbDev->GetCellId());
+            }
+        }
+    }
+
+    NS_LOG_INFO("Restored " << restored << " of " << m_linkStates.size() << " link states");
+}
+
+} // namespace ns3
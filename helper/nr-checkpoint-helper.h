@@ -0,0 +1,157 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_CHECKPOINT_HELPER_H
+#define NR_CHECKPOINT_HELPER_H
+
+#include <ns3/beamforming-vector.h>
+#include <ns3/net-device-container.h>
+#include <ns3/nr-mac-scheduler-ns3.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace ns3
+{
+
+class BeamformingHelperBase;
+class NrSpectrumPhy;
+
+/**
+ * \ingroup helper
+ * \brief Save the state of the NR devices at the end of the warm-up of a
+ * simulation, and restore it at the beginning of another one
+ *
+ * Many simulations of a campaign share the same deployment, and spend their
+ * first part computing the same state before the measurements start. The
+ * helper saves in a text file the part of this state that the NR module
+ * computes, for each pair of gNB and attached UE:
+ *
+ * - the beams of the gNB toward the UE, and of the UE toward the gNB, for each
+ *   BWP and antenna array;
+ * - the link adaptation state of the UE in the scheduler of each BWP: the DL
+ *   MCS per stream and the UL MCS, with the CQIs they were computed from and
+ *   the timers of the CQIs.
+ *
+ * The gNBs are identified by their cell ID, and the UEs by their IMSI, so the
+ * devices must be installed in the same order in the two simulations.
+ *
+ * In the simulation that restores the state, the file is read with Load. The
+ * beams are passed to the beamforming helper with RestoreBeams, before the UEs
+ * are attached, so that the beamforming tasks created at the attachment use
+ * them instead of running the beamforming algorithm. The beams must have an
+ * element for each element of the antenna arrays of the devices. The link
+ * adaptation state is restored with ScheduleRestoreLinkState, at a time when
+ * the UEs are connected: it is used until the next CQI of each UE, or until
+ * the timer of the CQI expires, as in the saved simulation (see
+ * NrMacSchedulerNs3::SetUeLinkState).
+ *
+ * The state that the NR module does not own is not saved: the RRC connection
+ * (use the ideal RRC to shorten it), the RLC and PDCP buffers, the HARQ
+ * processes in progress and the channel realizations. The random variables
+ * are not restored either; use the RngRun and AssignStreams to make them
+ * independent from the warm-up.
+ */
+class NrCheckpointHelper : public Object
+{
+  public:
+    /**
+     * \brief NrCheckpointHelper constructor
+     */
+    NrCheckpointHelper();
+
+    /**
+     * \brief ~NrCheckpointHelper
+     */
+    ~NrCheckpointHelper() override;
+
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Save the state of the devices in a file
+     * \param fileName the name of the file
+     * \param gnbDevs the gNB devices
+     * \param ueDevs the UE devices
+     */
+    void Save(const std::string& fileName,
+              const NetDeviceContainer& gnbDevs,
+              const NetDeviceContainer& ueDevs) const;
+
+    /**
+     * \brief Schedule the save of the state of the devices
+     * \param time the (absolute) time of the save
+     * \param fileName the name of the file
+     * \param gnbDevs the gNB devices
+     * \param ueDevs the UE devices
+     */
+    void ScheduleSave(const Time& time,
+                      const std::string& fileName,
+                      const NetDeviceContainer& gnbDevs,
+                      const NetDeviceContainer& ueDevs);
+
+    /**
+     * \brief Read the state saved in a file
+     * \param fileName the name of the file
+     */
+    void Load(const std::string& fileName);
+
+    /**
+     * \brief Pass the beams loaded to the beamforming helper
+     *
+     * It must be called before the UEs are attached.
+     *
+     * \param gnbDevs the gNB devices
+     * \param ueDevs the UE devices
+     * \param beamformingHelper the beamforming helper of the NrHelper
+     * \return the number of pairs of spectrum phys whose beams are restored
+     */
+    uint32_t RestoreBeams(const NetDeviceContainer& gnbDevs,
+                          const NetDeviceContainer& ueDevs,
+                          const Ptr<BeamformingHelperBase>& beamformingHelper) const;
+
+    /**
+     * \brief Schedule the restore of the link adaptation state loaded
+     * \param time the (absolute) time of the restore, when the UEs are connected
+     * \param ueDevs the UE devices
+     */
+    void ScheduleRestoreLinkState(const Time& time, const NetDeviceContainer& ueDevs);
+
+  private:
+    /**
+     * \brief Restore the link adaptation state loaded, in the gNBs of the UEs
+     * \param ueDevs the UE devices
+     */
+    void RestoreLinkState(const NetDeviceContainer& ueDevs) const;
+
+    /// Key of the beams: cell ID, BWP index, antenna array, IMSI
+    using BeamKey = std::tuple<uint16_t, uint8_t, uint8_t, uint64_t>;
+
+    /**
+     * \brief Abort if a beam loaded does not have an element for each antenna element
+     * \param bfv the beam
+     * \param spectrumPhy the spectrum phy whose antenna array will use the beam
+     * \param key the key of the beam
+     */
+    static void CheckBeamSize(const BeamformingVector& bfv,
+                              const Ptr<NrSpectrumPhy>& spectrumPhy,
+                              const BeamKey& key);
+    /// Key of the link adaptation state: cell ID, BWP index, IMSI
+    using LinkKey = std::tuple<uint16_t, uint8_t, uint64_t>;
+
+    std::map<BeamKey, BeamformingVectorPair> m_beams; //!< Beams loaded
+    std::map<LinkKey, NrMacSchedulerNs3::UeLinkState> m_linkStates; //!< Link states loaded
+};
+
+} // namespace ns3
+
+#endif // NR_CHECKPOINT_HELPER_H
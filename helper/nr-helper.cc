@@ -26,12 +26,15 @@
 #include <ns3/multi-model-spectrum-channel.h>
 #include <ns3/names.h>
 #include <ns3/nr-ch-access-manager.h>
+#include <ns3/nr-fh-control.h>
 #include <ns3/nr-gnb-mac.h>
 #include <ns3/nr-gnb-net-device.h>
 #include <ns3/nr-gnb-phy.h>
 #include <ns3/nr-mac-rx-trace.h>
 #include <ns3/nr-mac-scheduler-tdma-rr.h>
+#include <ns3/nr-parallel-slot-executor.h>
 #include <ns3/nr-phy-rx-trace.h>
+#include <ns3/nr-profiler.h>
 #include <ns3/nr-rrc-protocol-ideal.h>
 #include <ns3/nr-ue-mac.h>
 #include <ns3/nr-ue-net-device.h>
@@ -41,7 +44,10 @@
 #include <ns3/three-gpp-spectrum-propagation-loss-model.h>
 #include <ns3/three-gpp-v2v-channel-condition-model.h>
 #include <ns3/three-gpp-v2v-propagation-loss-model.h>
+#include <ns3/uinteger.h>
 #include <ns3/uniform-planar-array.h>
+#include <ns3/wrap-around-propagation-loss-model.h>
+#include <ns3/wrap-around-spectrum-propagation-loss-model.h>
 
 #include <algorithm>
 
@@ -76,6 +82,7 @@ NrHelper::NrHelper()
     m_gnbDlAmcFactory.SetTypeId(NrAmc::GetTypeId());
     m_gnbBeamManagerFactory.SetTypeId(BeamManager::GetTypeId());
     m_ueBeamManagerFactory.SetTypeId(BeamManager::GetTypeId());
+    m_fhControlFactory.SetTypeId(NrFhControl::GetTypeId());
     m_spectrumPropagationFactory.SetTypeId(ThreeGppSpectrumPropagationLossModel::GetTypeId());
 
     // Initialization that is there just because the user can configure attribute
@@ -88,6 +95,9 @@ NrHelper::NrHelper()
 
     m_phyStats = CreateObject<NrPhyRxTrace>();
     m_macSchedStats = CreateObject<NrMacSchedulingStats>();
+
+    // Create the profiler, that will start if the attribute NrProfiler::Enabled is true
+    NrProfiler::Get();
 }
 
 NrHelper::~NrHelper()
@@ -768,6 +778,11 @@ NrHelper::CreateGnbPhy(const Ptr<Node>& n,
     phy->SetCam(cam);
     phy->SetDevice(dev);
 
+    if (m_slotExecutor != nullptr)
+    {
+        phy->SetSlotExecutor(m_slotExecutor);
+    }
+
     Ptr<MobilityModel> mm = n->GetObject<MobilityModel>();
     NS_ASSERT_MSG(
         mm,
@@ -825,6 +840,8 @@ NrHelper::CreateGnbPhy(const Ptr<Node>& n,
 
         Ptr<BeamManager> beamManager = m_gnbBeamManagerFactory.Create<BeamManager>();
         beamManager->Configure(antenna);
+        beamManager->SetBeamChangeCallback(
+            MakeCallback(&NrGnbPhy::ReportBeamChange, phy)); // notify the MAC of new beams
         channelPhy->SetBeamManager(beamManager);
         phy->InstallSpectrumPhy(channelPhy); // finally let know phy that there is this spectrum phy
     }
@@ -853,6 +870,16 @@ NrHelper::CreateGnbSched()
     sched->InstallDlAmc(dlAmc);
     sched->InstallUlAmc(ulAmc);
 
+    if (m_fhControlEnabled)
+    {
+        sched->SetFhControl(m_fhControlFactory.Create<NrFhControl>());
+    }
+
+    if (m_slotExecutor != nullptr)
+    {
+        sched->SetSlotExecutor(m_slotExecutor);
+    }
+
     return sched;
 }
 
@@ -1405,9 +1432,10 @@ NrHelper::AssignStreams(NetDeviceContainer c, int64_t stream)
 int64_t
 NrHelper::DoAssignStreamsToChannelObjects(Ptr<NrSpectrumPhy> phy, int64_t currentStream)
 {
+    // With the wrap-around, the streams go to the 3GPP models that the channel wraps
     Ptr<ThreeGppPropagationLossModel> propagationLossModel =
-        DynamicCast<ThreeGppPropagationLossModel>(
-            phy->GetSpectrumChannel()->GetPropagationLossModel());
+        DynamicCast<ThreeGppPropagationLossModel>(WrapAroundPropagationLossModel::Unwrap(
+            phy->GetSpectrumChannel()->GetPropagationLossModel()));
     NS_ASSERT(propagationLossModel != nullptr);
 
     int64_t initialStream = currentStream;
@@ -1433,7 +1461,8 @@ NrHelper::DoAssignStreamsToChannelObjects(Ptr<NrSpectrumPhy> phy, int64_t curren
 
     Ptr<ThreeGppSpectrumPropagationLossModel> spectrumLossModel =
         DynamicCast<ThreeGppSpectrumPropagationLossModel>(
-            phy->GetSpectrumChannel()->GetPhasedArraySpectrumPropagationLossModel());
+            WrapAroundSpectrumPropagationLossModel::Unwrap(
+                phy->GetSpectrumChannel()->GetPhasedArraySpectrumPropagationLossModel()));
 
     if (spectrumLossModel)
     {
@@ -1465,6 +1494,29 @@ NrHelper::SetGnbBwpManagerAlgorithmAttribute(const std::string& n, const Attribu
     m_gnbBwpManagerAlgoFactory.Set(n, v);
 }
 
+void
+NrHelper::EnableFhControl()
+{
+    NS_LOG_FUNCTION(this);
+    m_fhControlEnabled = true;
+}
+
+void
+NrHelper::SetFhControlAttribute(const std::string& n, const AttributeValue& v)
+{
+    NS_LOG_FUNCTION(this);
+    m_fhControlFactory.Set(n, v);
+}
+
+void
+NrHelper::EnableParallelSlotProcessing(uint32_t numThreads)
+{
+    NS_LOG_FUNCTION(this << numThreads);
+    m_slotExecutor = CreateObjectWithAttributes<NrParallelSlotExecutor>(
+        "NumThreads",
+        UintegerValue(numThreads));
+}
+
 void
 NrHelper::DoDeActivateDedicatedEpsBearer(Ptr<NetDevice> ueDevice,
                                          Ptr<NetDevice> enbDevice,
@@ -37,6 +37,7 @@ class NrPhyRxTrace;
 class ComponentCarrierEnb;
 class ComponentCarrier;
 class NrMacScheduler;
+class NrParallelSlotExecutor;
 class NrGnbNetDevice;
 class NrUeNetDevice;
 class NrUeMac;
@@ -594,6 +595,43 @@ class NrHelper : public Object
      */
     void SetGnbBwpManagerAlgorithmAttribute(const std::string& n, const AttributeValue& v);
 
+    /**
+     * \brief Enable the fronthaul control in the schedulers of the gNBs
+     * installed afterwards
+     *
+     * Each scheduler (i.e., each BWP of each gNB) gets its own fronthaul link.
+     *
+     * \see NrFhControl
+     */
+    void EnableFhControl();
+
+    /**
+     * \brief Set an attribute for the fronthaul control, before it is created.
+     *
+     * \param n the name of the attribute
+     * \param v the value of the attribute
+     *
+     * \see NrFhControl
+     */
+    void SetFhControlAttribute(const std::string& n, const AttributeValue& v);
+
+    /**
+     * \brief Run the slot indications of the gNBs installed afterwards in a
+     * NrParallelSlotExecutor, shared by all of them
+     *
+     * At each slot boundary, the schedulers of the cells (the gNBs, and the
+     * BWPs of different gNBs) run concurrently, and each gNB PHY commits the
+     * decisions of its scheduler to the MAC before it continues its slot. The
+     * schedulers fire their trace sources at the commit, in the main thread. The
+     * results do not depend on the number of threads, and they are the same as
+     * without the executor.
+     *
+     * \param numThreads the number of threads, including the main one
+     *
+     * \see NrParallelSlotExecutor
+     */
+    void EnableParallelSlotProcessing(uint32_t numThreads);
+
     /**
      * \brief Set the TypeId of the UE BWP Manager. Works only before it is created.
      * \param typeId Type of the object
@@ -934,14 +972,17 @@ class NrHelper : public Object
     ObjectFactory m_gnbUlAmcFactory;                //!< UL AMC factory
     ObjectFactory m_gnbBeamManagerFactory;          //!< gNb Beam manager factory
     ObjectFactory m_ueBeamManagerFactory;           //!< UE beam manager factory
+    ObjectFactory m_fhControlFactory;               //!< Fronthaul control factory
 
     uint64_t m_imsiCounter{0};   //!< Imsi counter
     uint16_t m_cellIdCounter{1}; //!< CellId Counter
 
     Ptr<EpcHelper> m_epcHelper{nullptr};                     //!< Ptr to the EPC helper (optional)
     Ptr<BeamformingHelperBase> m_beamformingHelper{nullptr}; //!< Ptr to the beamforming helper
+    Ptr<NrParallelSlotExecutor> m_slotExecutor{nullptr};     //!< Executor of the slots, if any
 
     bool m_harqEnabled{false};
+    bool m_fhControlEnabled{false}; //!< Whether the schedulers get a fronthaul control
     bool m_snrTest{false};
 
     Ptr<NrPhyRxTrace> m_phyStats; //!< Pointer to the PhyRx stats
@@ -7,6 +7,7 @@
 #include "nr-mac-rx-trace.h"
 
 #include <ns3/log.h>
+#include <ns3/nr-profiler.h>
 #include <ns3/simulator.h>
 
 #include <fstream>
@@ -73,6 +74,7 @@ NrMacRxTrace::RxedGnbMacCtrlMsgsCallback(Ptr<NrMacRxTrace> macStats,
                                          uint8_t bwpId,
                                          Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxedGnbMacCtrlMsgsFile.is_open())
     {
         m_rxedGnbMacCtrlMsgsFileName = "RxedGnbMacCtrlMsgsTrace.txt";
@@ -146,6 +148,7 @@ NrMacRxTrace::TxedGnbMacCtrlMsgsCallback(Ptr<NrMacRxTrace> macStats,
                                          uint8_t bwpId,
                                          Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_txedGnbMacCtrlMsgsFile.is_open())
     {
         m_txedGnbMacCtrlMsgsFileName = "TxedGnbMacCtrlMsgsTrace.txt";
@@ -208,6 +211,7 @@ NrMacRxTrace::RxedUeMacCtrlMsgsCallback(Ptr<NrMacRxTrace> macStats,
                                         uint8_t bwpId,
                                         Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxedUeMacCtrlMsgsFile.is_open())
     {
         m_rxedUeMacCtrlMsgsFileName = "RxedUeMacCtrlMsgsTrace.txt";
@@ -273,6 +277,7 @@ NrMacRxTrace::TxedUeMacCtrlMsgsCallback(Ptr<NrMacRxTrace> macStats,
                                         uint8_t bwpId,
                                         Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_txedUeMacCtrlMsgsFile.is_open())
     {
         m_txedUeMacCtrlMsgsFileName = "TxedUeMacCtrlMsgsTrace.txt";
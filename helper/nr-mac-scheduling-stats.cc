@@ -8,6 +8,7 @@
 
 #include "ns3/string.h"
 #include <ns3/log.h>
+#include <ns3/nr-profiler.h>
 #include <ns3/simulator.h>
 
 namespace ns3
@@ -188,6 +189,7 @@ NrMacSchedulingStats::DlSchedulingCallback(Ptr<NrMacSchedulingStats> macStats,
                                            NrSchedulingCallbackInfo traceInfo)
 {
     NS_LOG_FUNCTION(macStats << path);
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     uint64_t imsi = 0;
     std::ostringstream pathAndRnti;
     std::string pathGnb = path.substr(0, path.find("/BandwidthPartMap"));
@@ -221,6 +223,7 @@ NrMacSchedulingStats::UlSchedulingCallback(Ptr<NrMacSchedulingStats> macStats,
                                            NrSchedulingCallbackInfo traceInfo)
 {
     NS_LOG_FUNCTION(macStats << path);
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
 
     uint64_t imsi = 0;
     std::ostringstream pathAndRnti;
@@ -9,6 +9,7 @@
 
 #include <ns3/log.h>
 #include <ns3/nr-gnb-net-device.h>
+#include <ns3/nr-profiler.h>
 #include <ns3/nr-ue-net-device.h>
 #include <ns3/simulator.h>
 #include <ns3/string.h>
@@ -160,6 +161,7 @@ NrPhyRxTrace::DlDataSinrCallback([[maybe_unused]] Ptr<NrPhyRxTrace> phyStats,
                                  uint16_t bwpId,
                                  uint8_t streamId)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     NS_LOG_INFO("UE" << rnti << "of " << cellId << " over bwp ID " << bwpId
                      << "->Generate RsrpSinrTrace");
     if (!m_dlDataSinrFile.is_open())
@@ -200,6 +202,7 @@ NrPhyRxTrace::DlCtrlSinrCallback([[maybe_unused]] Ptr<NrPhyRxTrace> phyStats,
                                  uint16_t bwpId,
                                  uint8_t streamId)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     NS_LOG_INFO("UE" << rnti << "of " << cellId << " over bwp ID " << bwpId
                      << "->Generate DlCtrlSinrTrace");
 
@@ -239,6 +242,7 @@ NrPhyRxTrace::UlSinrTraceCallback(Ptr<NrPhyRxTrace> phyStats,
                                   SpectrumValue& sinr,
                                   SpectrumValue& power)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     NS_LOG_INFO("UE" << imsi << "->Generate UlSinrTrace");
     uint64_t tti_count = Now().GetMicroSeconds() / 125;
     uint32_t rb_count = 1;
@@ -274,6 +278,7 @@ NrPhyRxTrace::RxedGnbPhyCtrlMsgsCallback(Ptr<NrPhyRxTrace> phyStats,
                                          uint8_t bwpId,
                                          Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxedGnbPhyCtrlMsgsFile.is_open())
     {
         std::ostringstream oss;
@@ -352,6 +357,7 @@ NrPhyRxTrace::TxedGnbPhyCtrlMsgsCallback(Ptr<NrPhyRxTrace> phyStats,
                                          uint8_t bwpId,
                                          Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_txedGnbPhyCtrlMsgsFile.is_open())
     {
         std::ostringstream oss;
@@ -426,6 +432,7 @@ NrPhyRxTrace::RxedUePhyCtrlMsgsCallback(Ptr<NrPhyRxTrace> phyStats,
                                         uint8_t bwpId,
                                         Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxedUePhyCtrlMsgsFile.is_open())
     {
         std::ostringstream oss;
@@ -500,6 +507,7 @@ NrPhyRxTrace::TxedUePhyCtrlMsgsCallback(Ptr<NrPhyRxTrace> phyStats,
                                         uint8_t bwpId,
                                         Ptr<const NrControlMessage> msg)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_txedUePhyCtrlMsgsFile.is_open())
     {
         std::ostringstream oss;
@@ -579,6 +587,7 @@ NrPhyRxTrace::RxedUePhyDlDciCallback(Ptr<NrPhyRxTrace> phyStats,
                                      uint8_t harqId,
                                      uint32_t k1Delay)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxedUePhyDlDciFile.is_open())
     {
         std::ostringstream oss;
@@ -631,6 +640,7 @@ NrPhyRxTrace::TxedUePhyHarqFeedbackCallback(Ptr<NrPhyRxTrace> phyStats,
                                             uint8_t harqId,
                                             uint32_t k1Delay)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxedUePhyDlDciFile.is_open())
     {
         std::ostringstream oss;
@@ -729,6 +739,7 @@ NrPhyRxTrace::ReportPacketCountUeCallback(Ptr<NrPhyRxTrace> phyStats,
                                           std::string path,
                                           UePhyPacketCountParameter param)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     phyStats->ReportPacketCountUe(param);
 }
 
@@ -737,6 +748,7 @@ NrPhyRxTrace::ReportPacketCountEnbCallback(Ptr<NrPhyRxTrace> phyStats,
                                            std::string path,
                                            GnbPhyPacketCountParameter param)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     phyStats->ReportPacketCountEnb(param);
 }
 
@@ -746,6 +758,7 @@ NrPhyRxTrace::ReportDownLinkTBSize(Ptr<NrPhyRxTrace> phyStats,
                                    uint64_t imsi,
                                    uint64_t tbSize)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     phyStats->ReportDLTbSize(imsi, tbSize);
 }
 
@@ -814,6 +827,7 @@ NrPhyRxTrace::RxPacketTraceUeCallback(Ptr<NrPhyRxTrace> phyStats,
                                       std::string path,
                                       RxPacketTraceParams params)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxPacketTraceFile.is_open())
     {
         std::ostringstream oss;
@@ -893,6 +907,7 @@ NrPhyRxTrace::RxPacketTraceEnbCallback(Ptr<NrPhyRxTrace> phyStats,
                                        std::string path,
                                        RxPacketTraceParams params)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     if (!m_rxPacketTraceFile.is_open())
     {
         std::ostringstream oss;
@@ -970,6 +985,7 @@ NrPhyRxTrace::PathlossTraceCallback(Ptr<NrPhyRxTrace> phyStats,
                                     Ptr<const SpectrumPhy> rxPhy,
                                     double lossDb)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     Ptr<NrSpectrumPhy> txNrSpectrumPhy = txPhy->GetObject<NrSpectrumPhy>();
     Ptr<NrSpectrumPhy> rxNrSpectrumPhy = rxPhy->GetObject<NrSpectrumPhy>();
     if (DynamicCast<NrGnbNetDevice>(txNrSpectrumPhy->GetDevice()) != nullptr)
@@ -1110,6 +1126,7 @@ NrPhyRxTrace::ReportDlCtrlPathloss([[maybe_unused]] Ptr<NrPhyRxTrace> phyStats,
                                    uint32_t ueNodeId,
                                    double lossDb)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     NS_LOG_INFO("UE node id:" << ueNodeId << "of " << cellId << " over bwp ID " << bwpId
                               << "->Generate DL CTRL pathloss record: " << lossDb);
 
@@ -1152,6 +1169,7 @@ NrPhyRxTrace::ReportDlDataPathloss([[maybe_unused]] Ptr<NrPhyRxTrace> phyStats,
                                    double lossDb,
                                    uint8_t cqi)
 {
+    NrProfiler::ScopedTimer timer(NrProfiler::TRACE_SINK);
     NS_LOG_INFO("UE node id:" << ueNodeId << "of " << cellId << " over bwp ID " << bwpId
                               << "->Generate DL DATA pathloss record: " << lossDb);
 
@@ -31,6 +31,7 @@ void
 BeamManager::Configure(const Ptr<UniformPlanarArray>& antennaArray)
 {
     m_antennaArray = antennaArray;
+    NotifyAntennaChanged();
     ChangeToQuasiOmniBeamformingVector();
 }
 
@@ -57,6 +58,17 @@ BeamManager::~BeamManager()
     // TODO Auto-generated destructor stub
 }
 
+void
+BeamManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_beamChangeCallback = MakeNullCallback<void, Ptr<const NetDevice>>();
+    m_peerIndex.clear();
+    m_peers.clear();
+    m_peerBeams.clear();
+    Object::DoDispose();
+}
+
 TypeId
 BeamManager::GetTypeId()
 {
@@ -74,6 +86,15 @@ BeamManager::SetPredefinedBeam(PhasedArrayModel::ComplexVector predefinedBeam)
                     "Cannot assign a predefined beamforming vector whose dimension is not "
                     "compatible with antenna array");
     m_predefinedDirTxRxW = std::make_pair(predefinedBeam, PREDEFINED_BEAM_ID);
+    if (m_currentBeam == PREDEFINED_BEAM)
+    {
+        m_currentBeam = UNKNOWN_BEAM;
+    }
+
+    if (!m_beamChangeCallback.IsNull())
+    {
+        m_beamChangeCallback(nullptr);
+    }
 }
 
 void
@@ -82,6 +103,15 @@ BeamManager::SetPredefinedBeam(uint16_t sector, double elevation)
     NS_LOG_FUNCTION(this);
     m_predefinedDirTxRxW = std::make_pair(CreateDirectionalBfv(m_antennaArray, sector, elevation),
                                           BeamId(sector, elevation));
+    if (m_currentBeam == PREDEFINED_BEAM)
+    {
+        m_currentBeam = UNKNOWN_BEAM;
+    }
+
+    if (!m_beamChangeCallback.IsNull())
+    {
+        m_beamChangeCallback(nullptr);
+    }
 }
 
 void
@@ -98,25 +128,58 @@ BeamManager::SaveBeamformingVector(const BeamformingVector& bfv, const Ptr<const
 
     if (device != nullptr)
     {
-        BeamformingStorage::iterator iter = m_beamformingVectorMap.find(device);
-        if (iter != m_beamformingVectorMap.end())
+        BeamId oldBeamId = GetBeamId(ConstCast<NetDevice>(device));
+
+        auto [it, inserted] =
+            m_peerIndex.emplace(PeekPointer(device), static_cast<uint32_t>(m_peers.size()));
+        if (inserted)
         {
-            (*iter).second = bfv;
+            m_peers.emplace_back(device);
+            m_peerBeams.emplace_back(bfv);
         }
         else
         {
-            m_beamformingVectorMap.insert(std::make_pair(device, bfv));
+            m_peerBeams[it->second] = bfv;
+            if (m_currentBeam == it->second)
+            {
+                m_currentBeam = UNKNOWN_BEAM;
+            }
+        }
+
+        if (oldBeamId != bfv.second && !m_beamChangeCallback.IsNull())
+        {
+            m_beamChangeCallback(device);
         }
     }
 }
 
+void
+BeamManager::SetBeamChangeCallback(const BeamChangeCallback& cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_beamChangeCallback = cb;
+}
+
 void
 BeamManager::ChangeBeamformingVector(const Ptr<const NetDevice>& device)
 {
     NS_LOG_FUNCTION(this);
+    ChangeBeamformingVector(GetPeerIndex(device));
+}
+
+uint32_t
+BeamManager::GetPeerIndex(const Ptr<const NetDevice>& device) const
+{
+    auto it = m_peerIndex.find(PeekPointer(device));
+    return it != m_peerIndex.end() ? it->second : NO_PEER;
+}
 
-    BeamformingStorage::iterator it = m_beamformingVectorMap.find(device);
-    if (it == m_beamformingVectorMap.end())
+void
+BeamManager::ChangeBeamformingVector(uint32_t peerIndex)
+{
+    NS_LOG_FUNCTION(this << peerIndex);
+
+    if (peerIndex == NO_PEER)
     {
         NS_LOG_INFO("Could not find the beamforming vector for the provided device");
 
@@ -124,7 +187,7 @@ BeamManager::ChangeBeamformingVector(const Ptr<const NetDevice>& device)
         // predefined beam if specified and if not, then use quasi omni
         if (m_predefinedDirTxRxW.first.GetSize() != 0)
         {
-            m_antennaArray->SetBeamformingVector(m_predefinedDirTxRxW.first);
+            SetAntennaBeam(PREDEFINED_BEAM, m_predefinedDirTxRxW.first);
         }
         else
         {
@@ -134,18 +197,33 @@ BeamManager::ChangeBeamformingVector(const Ptr<const NetDevice>& device)
     else
     {
         NS_LOG_INFO("Beamforming vector found");
-        m_antennaArray->SetBeamformingVector(it->second.first);
+        NS_ASSERT(peerIndex < m_peerBeams.size());
+        SetAntennaBeam(peerIndex, m_peerBeams[peerIndex].first);
     }
 }
 
-PhasedArrayModel::ComplexVector
-BeamManager::GetCurrentBeamformingVector()
+void
+BeamManager::SetAntennaBeam(uint32_t beam, const PhasedArrayModel::ComplexVector& vector) const
 {
-    return m_antennaArray->GetBeamformingVector();
+    // Copying the vector in the antenna array also invalidates the channel
+    // computations that depend on it: do it only if the beam changes
+    if (beam != m_currentBeam || m_antennaArray->GetNumberOfElements() != vector.GetSize())
+    {
+        m_antennaArray->SetBeamformingVector(vector);
+        m_currentBeam = beam;
+    }
 }
 
 void
-BeamManager::ChangeToQuasiOmniBeamformingVector()
+BeamManager::NotifyAntennaChanged()
+{
+    NS_LOG_FUNCTION(this);
+    m_currentBeam = UNKNOWN_BEAM;
+    UpdateAntennaDimensions();
+}
+
+void
+BeamManager::UpdateAntennaDimensions()
 {
     NS_LOG_FUNCTION(this);
 
@@ -154,21 +232,43 @@ BeamManager::ChangeToQuasiOmniBeamformingVector()
     m_antennaArray->GetAttribute("NumRows", numRows);
     m_antennaArray->GetAttribute("NumColumns", numColumns);
 
-    /**
-     * Before configuring omni beamforming vector,
-     * we want to make sure that it is being calculated
-     * with the actual number of antenna rows and columns.
-     * We want to avoid recalculations, if these numbers didn't
-     * change. Which will normally be the case.
-     */
+    // Avoid recalculating the quasi-omni beamforming vector if the number of
+    // antenna rows and columns did not change, which will normally be the case
     if (numRows.Get() != m_numRows || numColumns.Get() != m_numColumns)
     {
         m_numRows = numRows.Get();
         m_numColumns = numColumns.Get();
         m_omniTxRxW = std::make_pair(CreateQuasiOmniBfv(m_numRows, m_numColumns), OMNI_BEAM_ID);
+        if (m_currentBeam == OMNI_BEAM)
+        {
+            m_currentBeam = UNKNOWN_BEAM;
+        }
+    }
+}
+
+PhasedArrayModel::ComplexVector
+BeamManager::GetCurrentBeamformingVector()
+{
+    return m_antennaArray->GetBeamformingVector();
+}
+
+void
+BeamManager::ChangeToQuasiOmniBeamformingVector()
+{
+    NS_LOG_FUNCTION(this);
+
+    /**
+     * Before configuring omni beamforming vector, we want to make sure that it
+     * is being calculated with the actual number of antenna rows and columns.
+     * The dimensions are cached: they are read again only if the number of
+     * elements changes, or on NotifyAntennaChanged.
+     */
+    if (m_antennaArray->GetNumberOfElements() != m_omniTxRxW.first.GetSize())
+    {
+        UpdateAntennaDimensions();
     }
 
-    m_antennaArray->SetBeamformingVector(m_omniTxRxW.first);
+    SetAntennaBeam(OMNI_BEAM, m_omniTxRxW.first);
 }
 
 PhasedArrayModel::ComplexVector
@@ -176,10 +276,10 @@ BeamManager::GetBeamformingVector(const Ptr<NetDevice>& device) const
 {
     NS_LOG_FUNCTION(this);
     PhasedArrayModel::ComplexVector beamformingVector;
-    BeamformingStorage::const_iterator it = m_beamformingVectorMap.find(device);
-    if (it != m_beamformingVectorMap.end())
+    uint32_t peerIndex = GetPeerIndex(device);
+    if (peerIndex != NO_PEER)
     {
-        beamformingVector = it->second.first;
+        beamformingVector = m_peerBeams[peerIndex].first;
     }
     else
     {
@@ -201,10 +301,10 @@ BeamId
 BeamManager::GetBeamId(const Ptr<NetDevice>& device) const
 {
     BeamId beamId;
-    BeamformingStorage::const_iterator it = m_beamformingVectorMap.find(device);
-    if (it != m_beamformingVectorMap.end())
+    uint32_t peerIndex = GetPeerIndex(device);
+    if (peerIndex != NO_PEER)
     {
-        beamId = it->second.second;
+        beamId = m_peerBeams[peerIndex].second;
     }
     else
     {
@@ -227,6 +327,7 @@ BeamManager::SetSector(uint16_t sector, double elevation) const
 {
     NS_LOG_INFO("Set sector to : " << (unsigned)sector << ", and elevation to: " << elevation);
     m_antennaArray->SetBeamformingVector(CreateDirectionalBfv(m_antennaArray, sector, elevation));
+    m_currentBeam = UNKNOWN_BEAM;
 }
 
 void
@@ -234,6 +335,7 @@ BeamManager::SetSectorAz(double azimuth, double zenith) const
 {
     NS_LOG_INFO("Set azimuth to : " << (unsigned)azimuth << ", and zenith to:" << zenith);
     m_antennaArray->SetBeamformingVector(CreateDirectionalBfvAz(m_antennaArray, azimuth, zenith));
+    m_currentBeam = UNKNOWN_BEAM;
 }
 
 } /* namespace ns3 */
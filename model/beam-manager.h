@@ -10,9 +10,13 @@
 #include "beamforming-vector.h"
 
 #include "ns3/event-id.h"
+#include <ns3/callback.h>
 #include <ns3/net-device.h>
 #include <ns3/nstime.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace ns3
 {
 
@@ -89,9 +93,10 @@ class BeamManager : public Object
      */
     Ptr<const UniformPlanarArray> GetAntenna() const;
 
-    typedef std::map<const Ptr<const NetDevice>, BeamformingVector>
-        BeamformingStorage; //!< BeamformingStorage type used to save the map of beamforming vectors
-                            //!< per device
+    /**
+     * \brief Peer index returned by GetPeerIndex for devices without a saved beam
+     */
+    static constexpr uint32_t NO_PEER = UINT32_MAX;
 
     /**
      * \brief Function that saves the beamforming weights of the antenna
@@ -108,6 +113,24 @@ class BeamManager : public Object
      */
     virtual void ChangeBeamformingVector(const Ptr<const NetDevice>& device);
 
+    /**
+     * \brief Get the index of a device among the ones with a saved beam
+     *
+     * The index is assigned when the first beam toward the device is saved
+     * (normally, at attach time) and does not change afterwards.
+     *
+     * \param device the device
+     * \return the index of the device, or NO_PEER if no beam has been saved for it
+     */
+    uint32_t GetPeerIndex(const Ptr<const NetDevice>& device) const;
+
+    /**
+     * \brief Change the beamforming vector for tx/rx to/from the device with the specified index
+     * \param peerIndex the index of the device (see GetPeerIndex), or NO_PEER to use the
+     * predefined beam (if any) or the quasi-omni one
+     */
+    void ChangeBeamformingVector(uint32_t peerIndex);
+
     /**
      * \brief Change current beamforming vector to quasi-omni beamforming vector
      */
@@ -135,6 +158,37 @@ class BeamManager : public Object
      */
     virtual BeamId GetBeamId(const Ptr<NetDevice>& device) const;
 
+    /**
+     * \brief Callback invoked when the BeamId toward a device changes
+     *
+     * The parameter is the device whose beam has changed, or nullptr if the
+     * beam may have changed for all the devices (i.e., when a new predefined
+     * beam is configured).
+     */
+    typedef Callback<void, Ptr<const NetDevice>> BeamChangeCallback;
+
+    /**
+     * \brief Set the callback to invoke when the BeamId toward a device changes
+     *
+     * The callback is invoked only when the saved BeamId is different from the
+     * previous one, i.e., not every time a beamforming method runs.
+     *
+     * \param cb the callback
+     */
+    void SetBeamChangeCallback(const BeamChangeCallback& cb);
+
+    /**
+     * \brief Notify that the configuration of the antenna array has changed
+     *
+     * The BeamManager caches the dimensions of the antenna array, and does not
+     * set again on the antenna the beamforming vector that is already set. A
+     * change of the number of elements is detected automatically; any other
+     * change (e.g., of the number of rows and columns, keeping their product)
+     * or a beamforming vector set directly on the antenna array must be
+     * notified by calling this method.
+     */
+    void NotifyAntennaChanged();
+
     /**
      * \brief Set the Sector
      * \param sector sector
@@ -149,7 +203,29 @@ class BeamManager : public Object
      */
     void SetSectorAz(double azimuth, double zenith) const;
 
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object
+     */
+    void DoDispose() override;
+
   private:
+    /**
+     * \brief Set a beamforming vector on the antenna array, unless it is already set
+     * \param beam the beam: a peer index, OMNI_BEAM or PREDEFINED_BEAM
+     * \param vector the beamforming vector of the beam
+     */
+    void SetAntennaBeam(uint32_t beam, const PhasedArrayModel::ComplexVector& vector) const;
+
+    /**
+     * \brief Read the dimensions of the antenna array, and update the quasi-omni beam
+     */
+    void UpdateAntennaDimensions();
+
+    static constexpr uint32_t OMNI_BEAM = UINT32_MAX - 1;       //!< Quasi-omni current beam
+    static constexpr uint32_t PREDEFINED_BEAM = UINT32_MAX - 2; //!< Predefined current beam
+    static constexpr uint32_t UNKNOWN_BEAM = UINT32_MAX;        //!< Unknown current beam
+
     Ptr<UniformPlanarArray>
         m_antennaArray;    //!< the antenna array instance for which is responsible this BeamManager
     uint32_t m_numRows{0}; //!< Number of rows of antenna array for which is calculated current
@@ -158,9 +234,15 @@ class BeamManager : public Object
                                    //!< current quasi omni beamforming vector
     BeamformingVector m_omniTxRxW; //!< Beamforming vector that emulates omnidirectional
                                    //!< transmission and reception
-    BeamformingStorage m_beamformingVectorMap; //!< device to beamforming vector mapping
     BeamformingVector m_predefinedDirTxRxW;    //!< A predefined vector that is used for directional
                                                //!< transmission and reception to any device
+    BeamChangeCallback m_beamChangeCallback;   //!< Callback to notify a change of BeamId
+
+    std::unordered_map<const NetDevice*, uint32_t>
+        m_peerIndex;                              //!< Index of each device with a saved beam
+    std::vector<Ptr<const NetDevice>> m_peers;    //!< Devices with a saved beam, by index
+    std::vector<BeamformingVector> m_peerBeams;   //!< Saved beams, by index of the device
+    mutable uint32_t m_currentBeam{UNKNOWN_BEAM}; //!< Beam currently set on the antenna array
 };
 
 } /* namespace ns3 */
@@ -6,7 +6,12 @@
 
 #include "bwp-manager-algorithm.h"
 
+#include <ns3/abort.h>
+#include <ns3/double.h>
 #include <ns3/log.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
 
 namespace ns3
 {
@@ -22,6 +27,21 @@ BwpManagerAlgorithm::GetTypeId()
     return tid;
 }
 
+uint8_t
+BwpManagerAlgorithm::GetBwpForBearer(const EpsBearer::Qci& qci,
+                                     uint8_t currentBwp,
+                                     uint32_t backlog,
+                                     const std::vector<BwpLoad>& loads) const
+{
+    return GetBwpForEpsBearer(qci);
+}
+
+bool
+BwpManagerAlgorithm::IsLoadAware() const
+{
+    return false;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(BwpManagerAlgorithmStatic);
 
 #define DECLARE_ATTR(NAME, DESC, GETTER, SETTER)                                                   \
@@ -244,4 +264,118 @@ BwpManagerAlgorithmStatic::GetBwpForEpsBearer(const EpsBearer::Qci& v) const
     return m_qciToBwpMap.at(v);
 }
 
+NS_OBJECT_ENSURE_REGISTERED(BwpManagerAlgorithmLoadAware);
+
+TypeId
+BwpManagerAlgorithmLoadAware::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::BwpManagerAlgorithmLoadAware")
+            .SetParent<BwpManagerAlgorithmStatic>()
+            .SetGroupName("nr")
+            .AddConstructor<BwpManagerAlgorithmLoadAware>()
+            .AddAttribute("Hysteresis",
+                          "Minimum decrease of the load (PRB occupancy plus normalized backlog) "
+                          "that moves a bearer to another BWP",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&BwpManagerAlgorithmLoadAware::m_hysteresis),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute(
+                "BacklogNormalization",
+                "Backlog, in bytes, that counts as much as a fully occupied BWP in "
+                "the load of a BWP. If 0, the backlog is not considered",
+                UintegerValue(100000),
+                MakeUintegerAccessor(&BwpManagerAlgorithmLoadAware::m_backlogNormalization),
+                MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+void
+BwpManagerAlgorithmLoadAware::SetAllowedBwps(EpsBearer::Qci qci, const std::vector<uint8_t>& bwps)
+{
+    NS_LOG_FUNCTION(this << qci);
+    NS_ABORT_MSG_IF(bwps.empty(), "At least one BWP must be allowed for QCI " << +qci);
+    m_allowedBwps[qci] = bwps;
+}
+
+std::vector<uint8_t>
+BwpManagerAlgorithmLoadAware::GetAllowedBwps(EpsBearer::Qci qci) const
+{
+    auto it = m_allowedBwps.find(qci);
+    if (it == m_allowedBwps.end())
+    {
+        return {GetBwpForEpsBearer(qci)};
+    }
+    return it->second;
+}
+
+double
+BwpManagerAlgorithmLoadAware::GetLoad(const std::vector<BwpLoad>& loads, uint8_t bwp) const
+{
+    if (bwp >= loads.size())
+    {
+        return 0.0;
+    }
+    double load = loads[bwp].m_prbOccupancy;
+    if (m_backlogNormalization > 0)
+    {
+        load += static_cast<double>(loads[bwp].m_backlog) / m_backlogNormalization;
+    }
+    return load;
+}
+
+bool
+BwpManagerAlgorithmLoadAware::IsLoadAware() const
+{
+    return true;
+}
+
+uint8_t
+BwpManagerAlgorithmLoadAware::GetBwpForBearer(const EpsBearer::Qci& qci,
+                                              uint8_t currentBwp,
+                                              uint32_t backlog,
+                                              const std::vector<BwpLoad>& loads) const
+{
+    auto it = m_allowedBwps.find(qci);
+    if (it == m_allowedBwps.end())
+    {
+        return GetBwpForEpsBearer(qci);
+    }
+    const auto& allowed = it->second;
+
+    uint8_t best = allowed.front();
+    double bestLoad = GetLoad(loads, best);
+    if (currentBwp == NO_BWP ||
+        std::find(allowed.begin(), allowed.end(), currentBwp) == allowed.end())
+    {
+        // A new bearer, or a bearer on a BWP not allowed anymore: no hysteresis
+        for (const auto bwp : allowed)
+        {
+            if (GetLoad(loads, bwp) < bestLoad)
+            {
+                best = bwp;
+                bestLoad = GetLoad(loads, bwp);
+            }
+        }
+        return best;
+    }
+
+    // The load of the current BWP includes the backlog of the bearer, that
+    // would be added to the load of the new one
+    const double ownLoad =
+        m_backlogNormalization > 0 ? static_cast<double>(backlog) / m_backlogNormalization : 0.0;
+    best = currentBwp;
+    bestLoad = GetLoad(loads, currentBwp) - ownLoad - m_hysteresis;
+    for (const auto bwp : allowed)
+    {
+        const double load = GetLoad(loads, bwp) + ownLoad;
+        if (bwp != currentBwp && load < bestLoad)
+        {
+            best = bwp;
+            bestLoad = load;
+        }
+    }
+    return best;
+}
+
 } // namespace ns3
@@ -10,6 +10,9 @@
 #include <ns3/eps-bearer.h>
 #include <ns3/object.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace ns3
 {
 
@@ -18,8 +21,9 @@ namespace ns3
  * \brief Interface for a Bwp selection algorithm based on the bearer
  *
  *
- * At the moment, we provide only a static algorithm that has to be configured
- * before the simulation starts (BwpManagerAlgorithmStatic).
+ * We provide a static algorithm that has to be configured before the simulation
+ * starts (BwpManagerAlgorithmStatic), and an algorithm that moves the bearers
+ * among a set of BWPs depending on their load (BwpManagerAlgorithmLoadAware).
  *
  *
  * \section bwp_manager_conf Configuration
@@ -33,11 +37,23 @@ namespace ns3
  *
  *
  * \see GetBwpForEpsBearer
+ * \see GetBwpForBearer
  * \see BwpManagerAlgorithmStatic
  */
 class BwpManagerAlgorithm : public Object
 {
   public:
+    /**
+     * \brief The load of a BWP, as seen by the BWP manager
+     */
+    struct BwpLoad
+    {
+        double m_prbOccupancy{0.0}; //!< Average fraction of the PRBs used by the scheduler
+        uint32_t m_backlog{0};      //!< Bytes waiting in the RLC queues of the bearers of the BWP
+    };
+
+    static constexpr uint8_t NO_BWP{UINT8_MAX}; //!< The bearer does not have a BWP yet
+
     /**
      * \brief GetTypeId
      * \return The TypeId of the object
@@ -58,6 +74,34 @@ class BwpManagerAlgorithm : public Object
      * \return the bwp id that the algorithm selects for the qci specified
      */
     virtual uint8_t GetBwpForEpsBearer(const EpsBearer::Qci& v) const = 0;
+
+    /**
+     * \brief Get the bandwidth part id for a bearer, given the load of the BWPs
+     * \param qci the qci of the bearer
+     * \param currentBwp the BWP of the bearer, or NO_BWP for a new bearer
+     * \param backlog the bytes waiting in the RLC queues of the bearer
+     * \param loads the load of each BWP, indexed by BWP id
+     * \return the bwp id that the algorithm selects for the bearer
+     *
+     * The default implementation ignores the load, and returns GetBwpForEpsBearer.
+     * The subclasses that override it to use the load, the backlog or the
+     * current BWP must override IsLoadAware as well.
+     */
+    virtual uint8_t GetBwpForBearer(const EpsBearer::Qci& qci,
+                                    uint8_t currentBwp,
+                                    uint32_t backlog,
+                                    const std::vector<BwpLoad>& loads) const;
+
+    /**
+     * \brief Check if the BWP selected for a bearer can change during its life
+     * \return true if GetBwpForBearer uses the load, the backlog or the current
+     * BWP, false if it depends only on the QCI
+     *
+     * When it returns false, the BWP manager keeps the BWP selected for a
+     * bearer when its route is resolved, without asking the algorithm again.
+     * The default implementation returns false.
+     */
+    virtual bool IsLoadAware() const;
 };
 
 /**
@@ -634,5 +678,79 @@ class BwpManagerAlgorithmStatic : public BwpManagerAlgorithm
     std::unordered_map<uint8_t, uint8_t> m_qciToBwpMap;
 };
 
+/**
+ * \ingroup bwp
+ * \brief A BWP manager algorithm that balances the bearers among BWPs
+ *
+ * Each QCI can be served by a set of BWPs (SetAllowedBwps). A new bearer goes
+ * to the least loaded of them, and an existing bearer moves to the least
+ * loaded one only when the move decreases its load by more than the attribute
+ * Hysteresis, so that the bearers do not flap between two BWPs with similar
+ * load. The load of a BWP is its average PRB occupancy plus its backlog
+ * divided by the attribute BacklogNormalization, i.e., the backlog that counts
+ * as much as a fully occupied BWP. The comparison takes into account that the
+ * backlog of the bearer moves with it.
+ *
+ * The QCIs without allowed BWPs are served by the BWP configured through the
+ * attributes of BwpManagerAlgorithmStatic, that is also the only allowed BWP
+ * by default. Note that only BWPs that carry the traffic direction of the
+ * manager (e.g., not the UL BWP of a FDD pair for the gNB) should be allowed.
+ */
+class BwpManagerAlgorithmLoadAware : public BwpManagerAlgorithmStatic
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief constructor
+     */
+    BwpManagerAlgorithmLoadAware() = default;
+    /**
+     * \brief deconstructor
+     */
+    ~BwpManagerAlgorithmLoadAware() override = default;
+
+    // inherited
+    uint8_t GetBwpForBearer(const EpsBearer::Qci& qci,
+                            uint8_t currentBwp,
+                            uint32_t backlog,
+                            const std::vector<BwpLoad>& loads) const override;
+    bool IsLoadAware() const override;
+
+    /**
+     * \brief Set the BWPs that can serve the bearers of a QCI
+     * \param qci the QCI
+     * \param bwps the BWP indexes
+     */
+    void SetAllowedBwps(EpsBearer::Qci qci, const std::vector<uint8_t>& bwps);
+
+    /**
+     * \brief Get the BWPs that can serve the bearers of a QCI
+     * \param qci the QCI
+     * \return the BWP indexes set with SetAllowedBwps, or the static BWP of the QCI
+     */
+    std::vector<uint8_t> GetAllowedBwps(EpsBearer::Qci qci) const;
+
+  private:
+    /**
+     * \brief Get the load of a BWP
+     * \param loads the load of each BWP
+     * \param bwp the BWP index
+     * \return the load of the BWP
+     */
+    double GetLoad(const std::vector<BwpLoad>& loads, uint8_t bwp) const;
+
+    /**
+     * \brief Allowed BWPs of each QCI
+     */
+    std::unordered_map<uint8_t, std::vector<uint8_t>> m_allowedBwps;
+    double m_hysteresis{0.1};                //!< Minimum load decrease to move a bearer
+    uint32_t m_backlogNormalization{100000}; //!< Backlog that counts as a fully occupied BWP
+};
+
 } // namespace ns3
 #endif // BWPMANAGERALGORITHM_H
@@ -6,12 +6,13 @@
 
 #include "bwp-manager-gnb.h"
 
-#include "bwp-manager-algorithm.h"
 #include "nr-control-messages.h"
 
+#include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/object-map.h>
 #include <ns3/pointer.h>
+#include <ns3/simulator.h>
 #include <ns3/uinteger.h>
 
 namespace ns3
@@ -34,15 +35,29 @@ BwpManagerGnb::~BwpManagerGnb()
 TypeId
 BwpManagerGnb::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::BwpManagerGnb")
-                            .SetParent<NoOpComponentCarrierManager>()
-                            .SetGroupName("nr")
-                            .AddConstructor<BwpManagerGnb>()
-                            .AddAttribute("BwpManagerAlgorithm",
-                                          "The algorithm pointer",
-                                          PointerValue(),
-                                          MakePointerAccessor(&BwpManagerGnb::m_algorithm),
-                                          MakePointerChecker<BwpManagerAlgorithm>());
+    static TypeId tid =
+        TypeId("ns3::BwpManagerGnb")
+            .SetParent<NoOpComponentCarrierManager>()
+            .SetGroupName("nr")
+            .AddConstructor<BwpManagerGnb>()
+            .AddAttribute("BwpManagerAlgorithm",
+                          "The algorithm pointer",
+                          PointerValue(),
+                          MakePointerAccessor(&BwpManagerGnb::m_algorithm),
+                          MakePointerChecker<BwpManagerAlgorithm>())
+            .AddAttribute("PrbOccupancyAveraging",
+                          "Weight of the PRB occupancy of the last slot in the average PRB "
+                          "occupancy of a BWP",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&BwpManagerGnb::m_prbOccupancyAveraging),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("MinBwpSwitchInterval",
+                          "Minimum time between two selections of the BWP of a bearer: the "
+                          "algorithm is asked the BWP of a bearer at most once per interval, "
+                          "and then the bearer changes BWP at most once per interval",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&BwpManagerGnb::m_minBwpSwitchInterval),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -81,32 +96,79 @@ BwpManagerGnb::DoSetupDataRadioBearer(EpsBearer bearer,
                                                           lcid,
                                                           lcGroup,
                                                           msu);
+    ResolveBearerRoute(rnti, lcid);
     return lcsConfig;
 }
 
-uint8_t
-BwpManagerGnb::GetBwpIndex(uint16_t rnti, uint8_t lcid)
+std::vector<uint8_t>
+BwpManagerGnb::DoReleaseDataRadioBearer(uint16_t rnti, uint8_t lcid)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << rnti << +lcid);
+
+    if (rnti < m_bearerRoutes.size() && lcid < m_bearerRoutes[rnti].size())
+    {
+        InvalidateBearerRoute(m_bearerRoutes[rnti][lcid]);
+    }
+    return RrComponentCarrierManager::DoReleaseDataRadioBearer(rnti, lcid);
+}
+
+BwpManagerGnb::BearerRoute&
+BwpManagerGnb::ResolveBearerRoute(uint16_t rnti, uint8_t lcid)
+{
+    NS_LOG_FUNCTION(this << rnti << +lcid);
     NS_ASSERT(m_algorithm != nullptr);
-    NS_ASSERT_MSG(m_ueInfo.find(rnti) != m_ueInfo.end(), "Unknown UE");
-    NS_ASSERT_MSG(m_ueInfo.at(rnti).m_rlcLcInstantiated.find(lcid) !=
-                      m_ueInfo.at(rnti).m_rlcLcInstantiated.end(),
+
+    auto ueIt = m_ueInfo.find(rnti);
+    NS_ASSERT_MSG(ueIt != m_ueInfo.end(), "could not find RNTI " << rnti);
+    auto rlcIt = ueIt->second.m_ueAttached.find(lcid);
+    NS_ASSERT_MSG(rlcIt != ueIt->second.m_ueAttached.end(), "could not find LCID " << +lcid);
+    auto lcIt = ueIt->second.m_rlcLcInstantiated.find(lcid);
+    NS_ASSERT_MSG(lcIt != ueIt->second.m_rlcLcInstantiated.end(),
                   "Unknown logical channel of UE");
 
-    uint8_t qci = m_ueInfo[rnti].m_rlcLcInstantiated[lcid].qci;
+    if (m_bearerRoutes.size() <= rnti)
+    {
+        m_bearerRoutes.resize(rnti + 1);
+    }
+    if (m_bearerRoutes[rnti].size() <= lcid)
+    {
+        m_bearerRoutes[rnti].resize(lcid + 1);
+    }
+    BearerRoute& route = m_bearerRoutes[rnti][lcid];
+    InvalidateBearerRoute(route);
 
     // Force a conversion between the uint8_t type that comes from the LcInfo
     // struct (yeah, using the EpsBearer::Qci type was too hard ...)
-    return m_algorithm->GetBwpForEpsBearer(static_cast<EpsBearer::Qci>(qci));
+    route.m_qci = static_cast<EpsBearer::Qci>(lcIt->second.qci);
+    route.m_bwpId =
+        m_algorithm->GetBwpForBearer(route.m_qci, BwpManagerAlgorithm::NO_BWP, 0, m_bwpLoads);
+    auto macIt = m_macSapProvidersMap.find(route.m_bwpId);
+    NS_ABORT_MSG_IF(macIt == m_macSapProvidersMap.end(),
+                    "Bwp index " << +route.m_bwpId << " not valid.");
+    route.m_macSapProvider = macIt->second;
+    route.m_macSapUser = rlcIt->second;
+    route.m_lastSelection = Simulator::Now();
+    if (m_bwpLoads.size() <= route.m_bwpId)
+    {
+        m_bwpLoads.resize(route.m_bwpId + 1);
+    }
+    return route;
+}
+
+void
+BwpManagerGnb::InvalidateBearerRoute(BearerRoute& route)
+{
+    if (route.m_macSapUser != nullptr)
+    {
+        m_bwpLoads.at(route.m_bwpId).m_backlog -= route.m_backlog;
+    }
+    route = BearerRoute();
 }
 
 uint8_t
-BwpManagerGnb::PeekBwpIndex(uint16_t rnti, uint8_t lcid) const
+BwpManagerGnb::SelectBwp(uint16_t rnti, uint8_t lcid, uint8_t currentBwp, uint32_t backlog) const
 {
-    NS_LOG_FUNCTION(this);
     NS_ASSERT(m_algorithm != nullptr);
-    // For the moment, Get and Peek are the same, but they'll change
     NS_ASSERT_MSG(m_ueInfo.find(rnti) != m_ueInfo.end(), "Unknown UE");
     NS_ASSERT_MSG(m_ueInfo.at(rnti).m_rlcLcInstantiated.find(lcid) !=
                       m_ueInfo.at(rnti).m_rlcLcInstantiated.end(),
@@ -116,7 +178,30 @@ BwpManagerGnb::PeekBwpIndex(uint16_t rnti, uint8_t lcid) const
 
     // Force a conversion between the uint8_t type that comes from the LcInfo
     // struct (yeah, using the EpsBearer::Qci type was too hard ...)
-    return m_algorithm->GetBwpForEpsBearer(static_cast<EpsBearer::Qci>(qci));
+    return m_algorithm->GetBwpForBearer(static_cast<EpsBearer::Qci>(qci),
+                                        currentBwp,
+                                        backlog,
+                                        m_bwpLoads);
+}
+
+uint8_t
+BwpManagerGnb::GetBwpIndex(uint16_t rnti, uint8_t lcid)
+{
+    NS_LOG_FUNCTION(this);
+    return PeekBwpIndex(rnti, lcid);
+}
+
+uint8_t
+BwpManagerGnb::PeekBwpIndex(uint16_t rnti, uint8_t lcid) const
+{
+    NS_LOG_FUNCTION(this);
+
+    if (rnti < m_bearerRoutes.size() && lcid < m_bearerRoutes[rnti].size() &&
+        m_bearerRoutes[rnti][lcid].m_macSapUser != nullptr)
+    {
+        return m_bearerRoutes[rnti][lcid].m_bwpId;
+    }
+    return SelectBwp(rnti, lcid, BwpManagerAlgorithm::NO_BWP, 0);
 }
 
 uint8_t
@@ -166,31 +251,88 @@ BwpManagerGnb::DoReportBufferStatus(LteMacSapProvider::ReportBufferStatusParamet
 {
     NS_LOG_FUNCTION(this);
 
-    uint8_t bwpIndex = GetBwpIndex(params.rnti, params.lcid);
+    const uint32_t backlog = params.txQueueSize + params.retxQueueSize + params.statusPduSize;
+    BearerRoute& route = GetBearerRoute(params.rnti, params.lcid);
 
-    if (m_macSapProvidersMap.find(bwpIndex) != m_macSapProvidersMap.end())
+    // The algorithms that ignore the load keep the BWP selected when the route
+    // was resolved
+    if (m_algorithm->IsLoadAware() &&
+        Simulator::Now() - route.m_lastSelection >= m_minBwpSwitchInterval)
     {
-        m_macSapProvidersMap.find(bwpIndex)->second->ReportBufferStatus(params);
+        route.m_lastSelection = Simulator::Now();
+        const uint8_t bwpIndex =
+            m_algorithm->GetBwpForBearer(route.m_qci, route.m_bwpId, route.m_backlog, m_bwpLoads);
+
+        if (bwpIndex != route.m_bwpId)
+        {
+            auto macIt = m_macSapProvidersMap.find(bwpIndex);
+            NS_ABORT_MSG_IF(macIt == m_macSapProvidersMap.end(),
+                            "Bwp index " << +bwpIndex << " not valid.");
+            NS_LOG_INFO("Moving LCID " << +params.lcid << " of RNTI " << params.rnti
+                                       << " from BWP " << +route.m_bwpId << " to BWP "
+                                       << +bwpIndex);
+            // The scheduler of the old BWP must stop serving the bearer. The
+            // PDUs already scheduled there are still delivered to the RLC
+            LteMacSapProvider::ReportBufferStatusParameters empty = params;
+            empty.txQueueSize = 0;
+            empty.txQueueHolDelay = 0;
+            empty.retxQueueSize = 0;
+            empty.retxQueueHolDelay = 0;
+            empty.statusPduSize = 0;
+            route.m_macSapProvider->ReportBufferStatus(empty);
+
+            m_bwpLoads.at(route.m_bwpId).m_backlog -= route.m_backlog;
+            route.m_bwpId = bwpIndex;
+            route.m_macSapProvider = macIt->second;
+            route.m_backlog = 0;
+            if (m_bwpLoads.size() <= bwpIndex)
+            {
+                m_bwpLoads.resize(bwpIndex + 1);
+            }
+        }
     }
-    else
+
+    auto& bwpLoad = m_bwpLoads[route.m_bwpId];
+    bwpLoad.m_backlog = bwpLoad.m_backlog - route.m_backlog + backlog;
+    route.m_backlog = backlog;
+
+    route.m_macSapProvider->ReportBufferStatus(params);
+}
+
+void
+BwpManagerGnb::DoNotifyPrbOccupancy(double prbOccupancy, uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(this << prbOccupancy << +componentCarrierId);
+
+    if (m_bwpLoads.size() <= componentCarrierId)
     {
-        NS_ABORT_MSG("Bwp index " << +bwpIndex << " not valid.");
+        m_bwpLoads.resize(componentCarrierId + 1);
     }
+    auto& average = m_bwpLoads.at(componentCarrierId).m_prbOccupancy;
+    average += m_prbOccupancyAveraging * (prbOccupancy - average);
 }
 
 void
-BwpManagerGnb::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParams)
+BwpManagerGnb::DoRemoveUe(uint16_t rnti)
 {
-    NS_LOG_FUNCTION(this);
-    std::map<uint16_t, UeInfo>::iterator rntiIt = m_ueInfo.find(txOpParams.rnti);
-    NS_ASSERT_MSG(rntiIt != m_ueInfo.end(), "could not find RNTI" << txOpParams.rnti);
+    NS_LOG_FUNCTION(this << rnti);
 
-    std::map<uint8_t, LteMacSapUser*>::iterator lcidIt =
-        rntiIt->second.m_ueAttached.find(txOpParams.lcid);
-    NS_ASSERT_MSG(lcidIt != rntiIt->second.m_ueAttached.end(),
-                  "could not find LCID " << (uint16_t)txOpParams.lcid);
+    if (rnti < m_bearerRoutes.size())
+    {
+        for (auto& route : m_bearerRoutes[rnti])
+        {
+            InvalidateBearerRoute(route);
+        }
+        m_bearerRoutes[rnti].clear();
+    }
+    RrComponentCarrierManager::DoRemoveUe(rnti);
+}
 
-    (*lcidIt).second->NotifyTxOpportunity(txOpParams);
+void
+BwpManagerGnb::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParams)
+{
+    NS_LOG_FUNCTION(this);
+    GetBearerRoute(txOpParams.rnti, txOpParams.lcid).m_macSapUser->NotifyTxOpportunity(txOpParams);
 }
 
 void
@@ -7,24 +7,38 @@
 #ifndef BWP_MANAGER_H
 #define BWP_MANAGER_H
 
+#include "bwp-manager-algorithm.h"
+
 #include <ns3/eps-bearer.h>
 #include <ns3/lte-ccm-rrc-sap.h>
 #include <ns3/lte-rlc.h>
 #include <ns3/lte-rrc-sap.h>
 #include <ns3/no-op-component-carrier-manager.h>
+#include <ns3/nstime.h>
 
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
 class UeManager;
 class LteCcmRrcSapProvider;
-class BwpManagerAlgorithm;
 class NrControlMessage;
 
 /**
  * \ingroup gnb-bwp
  * \brief Bandwidth part manager that coordinates traffic over different bandwidth parts.
+ *
+ * The RLC buffer status of each bearer is forwarded to the MAC of the BWP
+ * that the BwpManagerAlgorithm selects for it. The manager keeps the load of
+ * each BWP (the PRB occupancy notified by its MAC, averaged with the attribute
+ * PrbOccupancyAveraging, and the backlog of its bearers) for the algorithms
+ * that take it into account, e.g. BwpManagerAlgorithmLoadAware. The BWP of a
+ * bearer is selected again (i.e., the algorithm is asked again) at most once
+ * every MinBwpSwitchInterval, whether the selection changes it or not; when it
+ * changes, the MAC of the old BWP receives an empty buffer status for the
+ * bearer, so that its scheduler stops serving it, and the new one the actual
+ * buffer status.
  */
 class BwpManagerGnb : public RrComponentCarrierManager
 {
@@ -95,6 +109,29 @@ class BwpManagerGnb : public RrComponentCarrierManager
     void SetOutputLink(uint32_t sourceBwp, uint32_t outputBwp);
 
   protected:
+    /**
+     * \brief Update the average PRB occupancy of a BWP, called by its MAC
+     * \param prbOccupancy the fraction of PRBs used by DL data in the last slot with DL
+     * data symbols
+     * \param componentCarrierId the BWP id
+     */
+    void DoNotifyPrbOccupancy(double prbOccupancy, uint8_t componentCarrierId) override;
+
+    /**
+     * \brief Remove the UE, its bearer routes, and the backlog of its bearers
+     * from the load of the BWPs
+     * \param rnti the RNTI of the UE
+     */
+    void DoRemoveUe(uint16_t rnti) override;
+
+    /**
+     * \brief Release a data radio bearer, and invalidate its route
+     * \param rnti the RNTI of the UE
+     * \param lcid the LCID of the bearer
+     * \return the component carriers of the bearer
+     */
+    std::vector<uint8_t> DoReleaseDataRadioBearer(uint16_t rnti, uint8_t lcid) override;
+
     /*
      * \brief This function contains most of the BwpManager logic.
      */
@@ -123,6 +160,9 @@ class BwpManagerGnb : public RrComponentCarrierManager
 
     /**
      * \brief Overload DoSetupBadaRadioBearer to connect directly to Rlc retransmission buffer size.
+     *
+     * The route of the bearer (its BWP, the MAC of the BWP and the RLC of the
+     * bearer) is resolved here, once, and not for each PDU.
      */
     std::vector<LteCcmRrcSapProvider::LcsConfig> DoSetupDataRadioBearer(
         EpsBearer bearer,
@@ -139,9 +179,76 @@ class BwpManagerGnb : public RrComponentCarrierManager
      */
     uint8_t GetResourceType(LteMacSapProvider::ReportBufferStatusParameters params);
 
+    /**
+     * \brief Ask the algorithm the BWP of a bearer
+     * \param rnti The RNTI of the user
+     * \param lcid The LCID of the bearer
+     * \param currentBwp the current BWP of the bearer, or BwpManagerAlgorithm::NO_BWP
+     * \param backlog the bytes in the RLC queues of the bearer
+     * \return the BWP index selected by the algorithm
+     */
+    uint8_t SelectBwp(uint16_t rnti, uint8_t lcid, uint8_t currentBwp, uint32_t backlog) const;
+
+    /**
+     * \brief The route of a bearer, resolved once and used for each PDU
+     *
+     * A route without RLC (m_macSapUser is nullptr) is not resolved yet.
+     */
+    struct BearerRoute
+    {
+        LteMacSapProvider* m_macSapProvider{nullptr}; //!< The MAC of the BWP of the bearer
+        LteMacSapUser* m_macSapUser{nullptr};         //!< The RLC of the bearer
+
+        EpsBearer::Qci m_qci{EpsBearer::NGBR_VIDEO_TCP_DEFAULT}; //!< The QCI of the bearer
+
+        uint8_t m_bwpId{0};    //!< The BWP that receives the buffer status of the bearer
+        uint32_t m_backlog{0}; //!< The backlog last reported by the RLC
+        Time m_lastSelection;  //!< When the BWP was last selected
+    };
+
+    /**
+     * \brief Get the route of a bearer, resolving it if it is not resolved yet
+     * \param rnti The RNTI of the user
+     * \param lcid The LCID of the bearer
+     * \return the route of the bearer
+     */
+    BearerRoute& GetBearerRoute(uint16_t rnti, uint8_t lcid)
+    {
+        if (rnti < m_bearerRoutes.size() && lcid < m_bearerRoutes[rnti].size() &&
+            m_bearerRoutes[rnti][lcid].m_macSapUser != nullptr)
+        {
+            return m_bearerRoutes[rnti][lcid];
+        }
+        return ResolveBearerRoute(rnti, lcid);
+    }
+
+    /**
+     * \brief Resolve the route of a bearer: select its BWP, and store the MAC
+     * of the BWP and the RLC of the bearer
+     * \param rnti The RNTI of the user
+     * \param lcid The LCID of the bearer
+     * \return the route of the bearer
+     */
+    BearerRoute& ResolveBearerRoute(uint16_t rnti, uint8_t lcid);
+
+    /**
+     * \brief Invalidate the route of a bearer, and remove its backlog from the
+     * load of its BWP
+     * \param route the route of the bearer
+     */
+    void InvalidateBearerRoute(BearerRoute& route);
+
+    friend class NrBwpManagerRoutingTest;
+
     Ptr<BwpManagerAlgorithm> m_algorithm; //!< The BWP selection algorithm.
 
     std::unordered_map<uint32_t, uint32_t> m_outputLinks; //!< Mapping between BWP.
+
+    std::vector<std::vector<BearerRoute>> m_bearerRoutes; //!< Routes, indexed by RNTI and LCID
+    std::vector<BwpManagerAlgorithm::BwpLoad> m_bwpLoads; //!< Load of each BWP
+
+    double m_prbOccupancyAveraging{0.01}; //!< Weight of a new PRB occupancy in its average
+    Time m_minBwpSwitchInterval;          //!< Minimum time between two BWP selections
 };
 
 } // end of namespace ns3
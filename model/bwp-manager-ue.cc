@@ -9,6 +9,7 @@
 #include "bwp-manager-algorithm.h"
 #include "nr-control-messages.h"
 
+#include <ns3/abort.h>
 #include <ns3/log.h>
 #include <ns3/pointer.h>
 
@@ -55,16 +56,36 @@ void
 BwpManagerUe::DoReportBufferStatus(LteMacSapProvider::ReportBufferStatusParameters params)
 {
     NS_LOG_FUNCTION(this);
-    NS_ASSERT(m_algorithm != nullptr);
 
-    uint8_t bwpIndex = m_algorithm->GetBwpForEpsBearer(m_lcToBearerMap.at(params.lcid));
+    LteMacSapProvider* macSapProvider = params.lcid < m_lcRoutes.size()
+                                            ? m_lcRoutes[params.lcid].m_macSapProvider
+                                            : nullptr;
+    if (macSapProvider == nullptr)
+    {
+        macSapProvider = ResolveLcRoute(params.lcid).m_macSapProvider;
+    }
 
     NS_LOG_DEBUG("BSR of size " << params.txQueueSize
                                 << " from RLC for LCID = " << static_cast<uint32_t>(params.lcid)
-                                << " traffic type " << m_lcToBearerMap.at(params.lcid)
-                                << " reported to CcId " << static_cast<uint32_t>(bwpIndex));
+                                << " traffic type " << m_lcRoutes[params.lcid].m_qci
+                                << " reported to CcId "
+                                << static_cast<uint32_t>(m_lcRoutes[params.lcid].m_bwpId));
+
+    macSapProvider->ReportBufferStatus(params);
+}
 
-    m_componentCarrierLcMap.at(bwpIndex).at(params.lcid)->ReportBufferStatus(params);
+BwpManagerUe::LcRoute&
+BwpManagerUe::ResolveLcRoute(uint8_t lcid)
+{
+    NS_LOG_FUNCTION(this << +lcid);
+    NS_ASSERT(m_algorithm != nullptr);
+    NS_ABORT_MSG_IF(lcid >= m_lcRoutes.size() || !m_lcRoutes[lcid].m_added,
+                    "Unknown LCID " << +lcid);
+
+    LcRoute& route = m_lcRoutes[lcid];
+    route.m_bwpId = m_algorithm->GetBwpForEpsBearer(route.m_qci);
+    route.m_macSapProvider = m_componentCarrierLcMap.at(route.m_bwpId).at(lcid);
+    return route;
 }
 
 std::vector<LteUeCcmRrcSapProvider::LcsConfig>
@@ -78,8 +99,14 @@ BwpManagerUe::DoAddLc(uint8_t lcId,
                              << static_cast<uint32_t>(lcConfig.priority) << " from priority "
                              << static_cast<uint32_t>(lcConfig.priority));
 
-    // see lte-enb-rrc.cc:453
-    m_lcToBearerMap.insert(std::make_pair(lcId, static_cast<EpsBearer::Qci>(lcConfig.priority)));
+    // see lte-enb-rrc.cc:453. The route is resolved again at the next BSR
+    if (m_lcRoutes.size() <= lcId)
+    {
+        m_lcRoutes.resize(lcId + 1);
+    }
+    m_lcRoutes[lcId] = LcRoute();
+    m_lcRoutes[lcId].m_added = true;
+    m_lcRoutes[lcId].m_qci = static_cast<EpsBearer::Qci>(lcConfig.priority);
 
     return SimpleUeComponentCarrierManager::DoAddLc(lcId, lcConfig, msu);
 }
@@ -92,8 +119,7 @@ BwpManagerUe::DoConfigureSignalBearer(uint8_t lcId,
     NS_LOG_FUNCTION(this);
 
     // Ignore signaling bearers for the moment. These are for an advanced use.
-    // m_lcToBearerMap.insert (std::make_pair (lcId, EpsBearer::FromPriority
-    // (lcConfig.priority).qci));
+    // m_lcRoutes[lcId].m_qci = EpsBearer::FromPriority (lcConfig.priority).qci;
 
     return SimpleUeComponentCarrierManager::DoConfigureSignalBearer(lcId, lcConfig, msu);
 }
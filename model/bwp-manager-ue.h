@@ -101,8 +101,26 @@ class BwpManagerUe : public SimpleUeComponentCarrierManager
                                            LteMacSapUser* msu) override;
 
   private:
+    /**
+     * \brief The route of a logical channel, resolved once and used for each PDU
+     */
+    struct LcRoute
+    {
+        bool m_added{false};                             //!< Whether the LC has been added
+        EpsBearer::Qci m_qci{EpsBearer::GBR_CONV_VOICE}; //!< The QCI of the LC
+        uint8_t m_bwpId{0};                              //!< The BWP of the LC
+        LteMacSapProvider* m_macSapProvider{nullptr};    //!< The MAC of the BWP, if resolved
+    };
+
+    /**
+     * \brief Resolve the BWP of a logical channel, and the MAC of the BWP
+     * \param lcid the LCID
+     * \return the route of the logical channel
+     */
+    LcRoute& ResolveLcRoute(uint8_t lcid);
+
     Ptr<BwpManagerAlgorithm> m_algorithm;
-    std::unordered_map<uint8_t, EpsBearer::Qci> m_lcToBearerMap; //!< Map from LCID to bearer ID
+    std::vector<LcRoute> m_lcRoutes; //!< Route of each LC, indexed by LCID
 
     std::unordered_map<uint32_t, uint32_t> m_outputLinks; //!< Mapping between BWP.
 };
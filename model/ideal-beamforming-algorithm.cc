@@ -21,6 +21,7 @@
 #include <ns3/nr-spectrum-value-helper.h>
 #include <ns3/uinteger.h>
 #include <ns3/uniform-planar-array.h>
+#include <ns3/wrap-around-spectrum-propagation-loss-model.h>
 
 namespace ns3
 {
@@ -32,6 +33,23 @@ NS_OBJECT_ENSURE_REGISTERED(DirectPathBeamforming);
 NS_OBJECT_ENSURE_REGISTERED(QuasiOmniDirectPathBeamforming);
 NS_OBJECT_ENSURE_REGISTERED(OptimalCovMatrixBeamforming);
 
+/**
+ * \brief Get the mobility models of the link between a gNB and a UE, as the
+ * channel sees it
+ * \param gnbSpectrumPhy the spectrum phy of the gNB
+ * \param ueSpectrumPhy the spectrum phy of the UE
+ * \return the mobility models of the gNB (or of its closest copy, with the
+ * wrap-around) and of the UE
+ */
+static std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>
+GetChannelLink(const Ptr<NrSpectrumPhy>& gnbSpectrumPhy, const Ptr<NrSpectrumPhy>& ueSpectrumPhy)
+{
+    return WrapAroundSpectrumPropagationLossModel::GetWrappedLink(
+        gnbSpectrumPhy->GetSpectrumChannel()->GetPhasedArraySpectrumPropagationLossModel(),
+        gnbSpectrumPhy->GetMobility(),
+        ueSpectrumPhy->GetMobility());
+}
+
 TypeId
 IdealBeamformingAlgorithm::GetTypeId()
 {
@@ -516,16 +534,16 @@ DirectPathBeamforming::GetBeamformingVectors(const Ptr<NrSpectrumPhy>& gnbSpectr
     Ptr<const UniformPlanarArray> ueAntenna =
         ueSpectrumPhy->GetAntenna()->GetObject<UniformPlanarArray>();
 
+    const auto [gnbMobility, ueMobility] = GetChannelLink(gnbSpectrumPhy, ueSpectrumPhy);
+
     PhasedArrayModel::ComplexVector gNbAntennaWeights =
-        CreateDirectPathBfv(gnbSpectrumPhy->GetMobility(),
-                            ueSpectrumPhy->GetMobility(),
-                            gnbAntenna);
+        CreateDirectPathBfv(gnbMobility, ueMobility, gnbAntenna);
     // store the antenna weights
     BeamformingVector gnbBfv =
         BeamformingVector(std::make_pair(gNbAntennaWeights, BeamId::GetEmptyBeamId()));
 
     PhasedArrayModel::ComplexVector ueAntennaWeights =
-        CreateDirectPathBfv(ueSpectrumPhy->GetMobility(), gnbSpectrumPhy->GetMobility(), ueAntenna);
+        CreateDirectPathBfv(ueMobility, gnbMobility, ueAntenna);
     // store the antenna weights
     BeamformingVector ueBfv =
         BeamformingVector(std::make_pair(ueAntennaWeights, BeamId::GetEmptyBeamId()));
@@ -561,8 +579,9 @@ QuasiOmniDirectPathBeamforming::GetBeamformingVectors(const Ptr<NrSpectrumPhy>&
         std::make_pair(CreateQuasiOmniBfv(numRows.Get(), numColumns.Get()), OMNI_BEAM_ID);
 
     // configure UE beamforming vector to be directed towards gNB
+    const auto [gnbMobility, ueMobility] = GetChannelLink(gnbSpectrumPhy, ueSpectrumPhy);
     PhasedArrayModel::ComplexVector ueAntennaWeights =
-        CreateDirectPathBfv(ueSpectrumPhy->GetMobility(), gnbSpectrumPhy->GetMobility(), ueAntenna);
+        CreateDirectPathBfv(ueMobility, gnbMobility, ueAntenna);
     // store the antenna weights
     BeamformingVector ueBfv =
         BeamformingVector(std::make_pair(ueAntennaWeights, BeamId::GetEmptyBeamId()));
@@ -598,10 +617,9 @@ DirectPathQuasiOmniBeamforming::GetBeamformingVectors(const Ptr<NrSpectrumPhy>&
         std::make_pair(CreateQuasiOmniBfv(numRows.Get(), numColumns.Get()), OMNI_BEAM_ID);
 
     // configure gNB beamforming vector to be directed towards UE
+    const auto [gnbMobility, ueMobility] = GetChannelLink(gnbSpectrumPhy, ueSpectrumPhy);
     PhasedArrayModel::ComplexVector gnbAntennaWeights =
-        CreateDirectPathBfv(gnbSpectrumPhy->GetMobility(),
-                            ueSpectrumPhy->GetMobility(),
-                            gnbAntenna);
+        CreateDirectPathBfv(gnbMobility, ueMobility, gnbAntenna);
     // store the antenna weights
     BeamformingVector gnbBfv =
         BeamformingVector(std::make_pair(gnbAntennaWeights, BeamId::GetEmptyBeamId()));
@@ -308,6 +308,13 @@ NrAmc::GetMaxMcs() const
     return m_errorModel->GetMaxMcs();
 }
 
+uint8_t
+NrAmc::GetModulationOrder(uint8_t mcs) const
+{
+    NS_LOG_FUNCTION(this);
+    return m_errorModel->GetModulationOrder(mcs);
+}
+
 void
 NrAmc::SetAmcModel(NrAmc::AmcModel m)
 {
@@ -144,6 +144,13 @@ class NrAmc : public Object
      */
     uint32_t GetMaxMcs() const;
 
+    /**
+     * \brief Get the modulation order of a MCS (depends on the underlying error model)
+     * \param mcs the MCS
+     * \return the modulation order (bits per modulation symbol)
+     */
+    uint8_t GetModulationOrder(uint8_t mcs) const;
+
     /**
      * \brief Set the AMC model type
      * \param m the AMC model
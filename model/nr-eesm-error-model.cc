@@ -418,4 +418,14 @@ NrEesmErrorModel::GetMaxMcs() const
     return static_cast<uint8_t>(GetMcsEcrTable()->size() - 1);
 }
 
+uint8_t
+NrEesmErrorModel::GetModulationOrder(uint8_t mcs) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(GetMcsMTable() != nullptr);
+    NS_ABORT_IF(mcs > GetMaxMcs());
+
+    return GetMcsMTable()->at(mcs);
+}
+
 } // namespace ns3
@@ -156,6 +156,11 @@ class NrEesmErrorModel : public NrErrorModel
      * \brief Get the maximum MCS. It depends on NR tables being used
      */
     uint8_t GetMaxMcs() const override;
+    /**
+     * \brief Get the modulation order of a MCS, following the MCSs in NR
+     * Table1/Table2 in TS38.214
+     */
+    uint8_t GetModulationOrder(uint8_t mcs) const override;
 
     typedef std::vector<double> DoubleVector;
     typedef std::tuple<DoubleVector, DoubleVector> DoubleTuple;
@@ -184,6 +184,14 @@ class NrErrorModel : public Object
      * \return the maximum MCS that is permitted with the error model
      */
     virtual uint8_t GetMaxMcs() const = 0;
+
+    /**
+     * \brief Get the modulation order (bits per modulation symbol) of a MCS
+     *
+     * \param mcs MCS
+     * \return the modulation order of the MCS
+     */
+    virtual uint8_t GetModulationOrder(uint8_t mcs) const = 0;
 };
 
 } // namespace ns3
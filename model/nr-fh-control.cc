@@ -0,0 +1,172 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-fh-control.h"
+
+#include "nr-parallel-slot-executor.h"
+#include "nr-phy-mac-common.h"
+
+#include <ns3/abort.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
+#include <ns3/log.h>
+#include <ns3/nr-spectrum-value-helper.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrFhControl");
+NS_OBJECT_ENSURE_REGISTERED(NrFhControl);
+
+TypeId
+NrFhControl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrFhControl")
+            .SetParent<Object>()
+            .SetGroupName("nr")
+            .AddConstructor<NrFhControl>()
+            .AddAttribute("FhCapacity",
+                          "The capacity of the fronthaul link of the cell",
+                          DataRateValue(DataRate("10Gbps")),
+                          MakeDataRateAccessor(&NrFhControl::m_capacity),
+                          MakeDataRateChecker())
+            .AddAttribute("ControlMethod",
+                          "How the scheduler fits the DL allocations in the fronthaul capacity",
+                          EnumValue(NrFhControl::NONE),
+                          MakeEnumAccessor(&NrFhControl::m_method),
+                          MakeEnumChecker(NrFhControl::NONE,
+                                          "None",
+                                          NrFhControl::DROPPING,
+                                          "Dropping",
+                                          NrFhControl::OPTIMIZE_MCS,
+                                          "OptimizeMcs",
+                                          NrFhControl::OPTIMIZE_RBS,
+                                          "OptimizeRbs"))
+            .AddAttribute("Compression",
+                          "The compression of the IQ samples",
+                          EnumValue(NrFhControl::BLOCK_FLOATING_POINT),
+                          MakeEnumAccessor(&NrFhControl::m_compression),
+                          MakeEnumChecker(NrFhControl::BLOCK_FLOATING_POINT,
+                                          "BlockFloatingPoint",
+                                          NrFhControl::MODULATION_COMPRESSION,
+                                          "ModulationCompression"))
+            .AddAttribute("IqBitWidth",
+                          "The bits of an I or Q sample, with the block floating point "
+                          "compression",
+                          UintegerValue(9),
+                          MakeUintegerAccessor(&NrFhControl::m_iqBitWidth),
+                          MakeUintegerChecker<uint8_t>(1, 16))
+            .AddAttribute("CompressionParamBits",
+                          "The bits of the compression parameters of a RB, for each layer "
+                          "and symbol",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&NrFhControl::m_compressionParamBits),
+                          MakeUintegerChecker<uint8_t>())
+            .AddAttribute("TransportOverhead",
+                          "The overhead of the transport, relative to the bits of the samples",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&NrFhControl::m_transportOverhead),
+                          MakeDoubleChecker<double>(0.0))
+            .AddTraceSource("FhLoad",
+                            "The fronthaul rate requested and allocated in each slot.",
+                            MakeTraceSourceAccessor(&NrFhControl::m_fhLoadTrace),
+                            "ns3::NrFhControl::FhLoadTracedCallback");
+    return tid;
+}
+
+NrFhControl::NrFhControl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrFhControl::~NrFhControl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrFhControl::FhControlMethod
+NrFhControl::GetControlMethod() const
+{
+    return m_method;
+}
+
+bool
+NrFhControl::DependsOnModulation() const
+{
+    return m_compression == MODULATION_COMPRESSION;
+}
+
+uint64_t
+NrFhControl::GetAllocationBits(uint32_t numRbSym, uint8_t modulationOrder, uint8_t numLayers) const
+{
+    uint32_t sampleBits = m_iqBitWidth;
+    if (m_compression == MODULATION_COMPRESSION)
+    {
+        sampleBits = std::max(1, modulationOrder / 2);
+    }
+    const uint64_t rbBits =
+        NrSpectrumValueHelper::SUBCARRIERS_PER_RB * 2 * sampleBits + m_compressionParamBits;
+    const uint64_t bits = static_cast<uint64_t>(numRbSym) * numLayers * rbBits;
+    return static_cast<uint64_t>(std::ceil(bits * (1.0 + m_transportOverhead)));
+}
+
+void
+NrFhControl::StartSlot(const SfnSf& sfn, const Time& slotPeriod)
+{
+    NS_LOG_FUNCTION(this << sfn);
+    NS_ABORT_MSG_IF(m_slotStarted, "The slot " << m_sfn << " did not end");
+
+    m_sfn = sfn;
+    m_slotPeriod = slotPeriod;
+    m_slotCapacity = static_cast<uint64_t>(m_capacity.GetBitRate() * slotPeriod.GetSeconds());
+    m_requestedBits = 0;
+    m_allocatedBits = 0;
+    m_slotStarted = true;
+}
+
+uint64_t
+NrFhControl::GetAvailableBits() const
+{
+    NS_ASSERT(m_slotStarted);
+    return m_allocatedBits < m_slotCapacity ? m_slotCapacity - m_allocatedBits : 0;
+}
+
+void
+NrFhControl::AddAllocation(uint64_t requestedBits, uint64_t allocatedBits)
+{
+    NS_LOG_FUNCTION(this << requestedBits << allocatedBits);
+    NS_ASSERT(m_slotStarted);
+
+    m_requestedBits += requestedBits;
+    m_allocatedBits += allocatedBits;
+}
+
+void
+NrFhControl::EndSlot()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_slotStarted);
+
+    m_slotStarted = false;
+    const double seconds = m_slotPeriod.GetSeconds();
+    NS_LOG_DEBUG("FH load in " << m_sfn << ": requested " << m_requestedBits << " bits, allocated "
+                               << m_allocatedBits << " bits, capacity " << m_slotCapacity
+                               << " bits");
+    // With a slot executor, the trace is fired at the commit of the slot
+    NrParallelSlotExecutor::RunAtCommit([this,
+                                         sfn = m_sfn,
+                                         requested = m_requestedBits / seconds,
+                                         allocated = m_allocatedBits / seconds]() {
+        m_fhLoadTrace(sfn, requested, allocated);
+    });
+}
+
+} // namespace ns3
@@ -0,0 +1,167 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_FH_CONTROL_H
+#define NR_FH_CONTROL_H
+
+#include "sfnsf.h"
+
+#include <ns3/data-rate.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/traced-callback.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief The fronthaul (FH) link of a cell, with a split 7.2 interface
+ *
+ * With the split 7.2, the FH carries the frequency-domain IQ samples of the
+ * allocated RBs: for each RB, layer and symbol, an I and a Q sample for each
+ * of the 12 subcarriers, and the compression parameters of the RB. The bits of
+ * each sample depend on the compression:
+ *
+ * - BLOCK_FLOATING_POINT: IqBitWidth bits, independently of the modulation;
+ * - MODULATION_COMPRESSION: half of the modulation order of the MCS (e.g., 3
+ *   bits for 64-QAM), as only the constellation points are sent.
+ *
+ * The transport (e.g., eCPRI and Ethernet headers) adds TransportOverhead to
+ * the bits of the samples.
+ *
+ * The scheduler starts a slot with StartSlot, adds the bits of each allocation
+ * with AddAllocation, and ends the slot with EndSlot, which fires the FhLoad
+ * trace with the FH rate that the allocations requested, and the one that was
+ * allocated. With a FhControlMethod other than NONE, the scheduler reduces the
+ * allocations that do not fit in the bits left in the slot (GetAvailableBits):
+ *
+ * - DROPPING: the UE is not scheduled;
+ * - OPTIMIZE_MCS: the MCS of the UE is lowered, down to the lowest MCS, if it
+ *   lowers the bits of the samples (i.e., with MODULATION_COMPRESSION); if the
+ *   allocation still does not fit, its RBs are reduced;
+ * - OPTIMIZE_RBS: the RBs of the UE are reduced.
+ *
+ * The capacity is the one of the FH link of the cell, and only the DL data is
+ * considered. The HARQ retransmissions are never reduced, but they use the
+ * capacity of the slot.
+ */
+class NrFhControl : public Object
+{
+  public:
+    /**
+     * \brief How the scheduler fits the allocations in the FH capacity
+     */
+    enum FhControlMethod
+    {
+        NONE,         //!< The allocations are not limited, the load is only measured
+        DROPPING,     //!< The UEs whose allocation does not fit are not scheduled
+        OPTIMIZE_MCS, //!< The MCS is lowered, and then the RBs are reduced
+        OPTIMIZE_RBS, //!< The RBs are reduced
+    };
+
+    /**
+     * \brief The compression of the IQ samples
+     */
+    enum Compression
+    {
+        BLOCK_FLOATING_POINT,   //!< Samples of IqBitWidth bits
+        MODULATION_COMPRESSION, //!< Samples of half the modulation order bits
+    };
+
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrFhControl constructor
+     */
+    NrFhControl();
+
+    /**
+     * \brief ~NrFhControl
+     */
+    ~NrFhControl() override;
+
+    /**
+     * \brief Get the method used to fit the allocations in the FH capacity
+     * \return the FH control method
+     */
+    FhControlMethod GetControlMethod() const;
+
+    /**
+     * \brief Check if the FH bits of an allocation depend on its modulation
+     * \return true with MODULATION_COMPRESSION
+     */
+    bool DependsOnModulation() const;
+
+    /**
+     * \brief Get the FH bits of an allocation
+     * \param numRbSym the number of RBs times the number of symbols
+     * \param modulationOrder the modulation order of the MCS
+     * \param numLayers the number of layers
+     * \return the bits sent on the FH, including the transport overhead
+     */
+    uint64_t GetAllocationBits(uint32_t numRbSym, uint8_t modulationOrder, uint8_t numLayers) const;
+
+    /**
+     * \brief Start the accounting of a slot
+     * \param sfn the slot
+     * \param slotPeriod the duration of the slot
+     */
+    void StartSlot(const SfnSf& sfn, const Time& slotPeriod);
+
+    /**
+     * \brief Get the bits that can still be sent in the current slot
+     * \return the capacity of the slot, minus the bits already allocated
+     */
+    uint64_t GetAvailableBits() const;
+
+    /**
+     * \brief Add an allocation to the current slot
+     * \param requestedBits the bits of the allocation, before fitting it in the capacity
+     * \param allocatedBits the bits of the allocation that is scheduled
+     */
+    void AddAllocation(uint64_t requestedBits, uint64_t allocatedBits);
+
+    /**
+     * \brief End the accounting of the current slot, and fire the FhLoad trace
+     */
+    void EndSlot();
+
+    /**
+     * \brief TracedCallback signature for the FH load of a slot
+     * \param [in] sfn the slot
+     * \param [in] requestedRate the FH rate (bps) requested by the allocations
+     * \param [in] allocatedRate the FH rate (bps) of the scheduled allocations
+     */
+    typedef void (*FhLoadTracedCallback)(const SfnSf& sfn,
+                                         double requestedRate,
+                                         double allocatedRate);
+
+  private:
+    DataRate m_capacity;                             //!< Capacity of the FH link
+    FhControlMethod m_method{NONE};                  //!< How the allocations are fit
+    Compression m_compression{BLOCK_FLOATING_POINT}; //!< Compression of the samples
+    uint8_t m_iqBitWidth{9};                         //!< Bits of a BFP sample
+    uint8_t m_compressionParamBits{8};               //!< Bits of the parameters of a RB
+    double m_transportOverhead{0.0};                 //!< Overhead, relative to the samples
+
+    SfnSf m_sfn;                 //!< The current slot
+    Time m_slotPeriod;           //!< The duration of the current slot
+    uint64_t m_slotCapacity{0};  //!< The capacity of the current slot (bits)
+    uint64_t m_requestedBits{0}; //!< The bits requested in the current slot
+    uint64_t m_allocatedBits{0}; //!< The bits allocated in the current slot
+    bool m_slotStarted{false};   //!< Whether a slot is being accounted
+
+    TracedCallback<const SfnSf&, double, double> m_fhLoadTrace; //!< FH load of each slot
+};
+
+} // namespace ns3
+
+#endif // NR_FH_CONTROL_H
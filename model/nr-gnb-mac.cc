@@ -16,11 +16,16 @@
 #include "nr-control-messages.h"
 #include "nr-mac-header-fs-ul.h"
 #include "nr-mac-header-vs.h"
+#include "nr-mac-long-bsr-ce.h"
 #include "nr-mac-pdu-info.h"
 #include "nr-mac-sched-sap.h"
 #include "nr-mac-scheduler.h"
 #include "nr-mac-short-bsr-ce.h"
+#include "nr-mac-short-truncated-bsr-ce.h"
+#include "nr-parallel-slot-executor.h"
 #include "nr-phy-mac-common.h"
+#include "nr-profiler.h"
+#include "nr-trace-guard.h"
 
 #include <ns3/log.h>
 #include <ns3/lte-common.h>
@@ -143,7 +148,9 @@ class NrMacEnbMemberPhySapUser : public NrGnbPhySapUser
 
     void UlHarqFeedback(UlHarqInfo params) override;
 
-    void BeamChangeReport(BeamConfId beamConfId, uint8_t rnti) override;
+    void BeamChangeReport(BeamConfId beamConfId, uint16_t rnti) override;
+
+    bool HasRachPreambles() const override;
 
     uint32_t GetNumRbPerRbg() const override;
 
@@ -152,6 +159,8 @@ class NrMacEnbMemberPhySapUser : public NrGnbPhySapUser
 
     uint8_t GetDlCtrlSymbols() const override;
 
+    void SetUlAllocationHorizon(uint32_t numSlots) override;
+
   private:
     NrGnbMac* m_mac;
 };
@@ -210,11 +219,17 @@ NrMacEnbMemberPhySapUser::UlHarqFeedback(UlHarqInfo params)
 }
 
 void
-NrMacEnbMemberPhySapUser::BeamChangeReport(BeamConfId beamConfId, uint8_t rnti)
+NrMacEnbMemberPhySapUser::BeamChangeReport(BeamConfId beamConfId, uint16_t rnti)
 {
     m_mac->BeamChangeReport(beamConfId, rnti);
 }
 
+bool
+NrMacEnbMemberPhySapUser::HasRachPreambles() const
+{
+    return !m_mac->m_receivedRachPreambleCount.empty();
+}
+
 uint32_t
 NrMacEnbMemberPhySapUser::GetNumRbPerRbg() const
 {
@@ -239,6 +254,12 @@ NrMacEnbMemberPhySapUser::GetDlCtrlSymbols() const
     return m_mac->GetDlCtrlSyms();
 }
 
+void
+NrMacEnbMemberPhySapUser::SetUlAllocationHorizon(uint32_t numSlots)
+{
+    m_mac->m_macSchedSapProvider->SchedSetUlAllocationHorizon(numSlots);
+}
+
 // MAC Sched
 
 class NrMacMemberMacSchedSapUser : public NrMacSchedSapUser
@@ -509,9 +530,12 @@ NrGnbMac::GetUlCtrlSyms() const
 void
 NrGnbMac::ReceiveRachPreamble(uint32_t raId)
 {
-    Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage>();
-    rachMsg->SetSourceBwp(GetBwpId());
-    m_macRxedCtrlMsgsTrace(m_currentSlot, GetCellId(), raId, GetBwpId(), rachMsg);
+    if (NR_TRACE_ENABLED(m_macRxedCtrlMsgsTrace))
+    {
+        Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage>();
+        rachMsg->SetSourceBwp(GetBwpId());
+        m_macRxedCtrlMsgsTrace(m_currentSlot, GetCellId(), raId, GetBwpId(), rachMsg);
+    }
 
     ++m_receivedRachPreambleCount[raId];
 }
@@ -558,6 +582,7 @@ void
 NrGnbMac::DoSlotDlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::GNB_MAC_SLOT_DL);
     NS_LOG_INFO("Perform things on DL, slot on the air: " << sfnSf);
 
     // --- DOWNLINK ---
@@ -573,11 +598,18 @@ NrGnbMac::DoSlotDlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
 
         m_macSchedSapProvider->SchedDlCqiInfoReq(dlCqiInfoReq);
 
-        for (const auto& v : dlCqiInfoReq.m_cqiList)
+        if (NR_TRACE_ENABLED(m_macRxedCtrlMsgsTrace))
         {
-            Ptr<NrDlCqiMessage> msg = Create<NrDlCqiMessage>();
-            msg->SetDlCqi(v);
-            m_macRxedCtrlMsgsTrace(m_currentSlot, GetCellId(), v.m_rnti, GetBwpId(), msg);
+            // With a slot executor, the trace is fired at the commit of the slot
+            NrParallelSlotExecutor::RunAtCommit(
+                [this, slot = m_currentSlot, list = dlCqiInfoReq.m_cqiList]() {
+                    for (const auto& v : list)
+                    {
+                        Ptr<NrDlCqiMessage> msg = Create<NrDlCqiMessage>();
+                        msg->SetDlCqi(v);
+                        m_macRxedCtrlMsgsTrace(slot, GetCellId(), v.m_rnti, GetBwpId(), msg);
+                    }
+                });
         }
     }
 
@@ -616,25 +648,35 @@ NrGnbMac::DoSlotDlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
         // empty local buffer
         m_dlHarqInfoReceived.clear();
 
-        for (const auto& v : dlParams.m_dlHarqInfoList)
+        if (NR_TRACE_ENABLED(m_macRxedCtrlMsgsTrace))
         {
-            Ptr<NrDlHarqFeedbackMessage> msg = Create<NrDlHarqFeedbackMessage>();
-            msg->SetDlHarqFeedback(v);
-            m_macRxedCtrlMsgsTrace(m_currentSlot, GetCellId(), v.m_rnti, GetBwpId(), msg);
+            NrParallelSlotExecutor::RunAtCommit(
+                [this, slot = m_currentSlot, list = dlParams.m_dlHarqInfoList]() {
+                    for (const auto& v : list)
+                    {
+                        Ptr<NrDlHarqFeedbackMessage> msg = Create<NrDlHarqFeedbackMessage>();
+                        msg->SetDlHarqFeedback(v);
+                        m_macRxedCtrlMsgsTrace(slot, GetCellId(), v.m_rnti, GetBwpId(), msg);
+                    }
+                });
         }
     }
 
+    // Only the UEs whose beam has changed since the last DL slot
+    for (const auto& beamChange : m_beamChanges)
     {
-        for (const auto& ue : m_rlcAttached)
+        if (m_rlcAttached.find(beamChange.first) == m_rlcAttached.end())
         {
-            NrMacCschedSapProvider::CschedUeConfigReqParameters params;
-            params.m_rnti = ue.first;
-            params.m_beamConfId = m_phySapProvider->GetBeamConfId(ue.first);
-            params.m_transmissionMode = 0; // set to default value (SISO) for avoiding random
-                                           // initialization (valgrind error)
-            m_macCschedSapProvider->CschedUeConfigReq(params);
+            continue; // removed in the meantime
         }
+        NrMacCschedSapProvider::CschedUeConfigReqParameters params;
+        params.m_rnti = beamChange.first;
+        params.m_beamConfId = beamChange.second;
+        params.m_transmissionMode = 0; // set to default value (SISO) for avoiding random
+                                       // initialization (valgrind error)
+        m_macCschedSapProvider->CschedUeConfigReq(params);
     }
+    m_beamChanges.clear();
 
     m_macSchedSapProvider->SchedDlTriggerReq(dlParams);
 }
@@ -643,6 +685,7 @@ void
 NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::GNB_MAC_SLOT_UL);
     NS_LOG_INFO("Perform things on UL, slot on the air: " << sfnSf);
 
     // --- UPLINK ---
@@ -664,11 +707,18 @@ NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
 
         m_macSchedSapProvider->SchedUlSrInfoReq(params);
 
-        for (const auto& v : params.m_srList)
+        if (NR_TRACE_ENABLED(m_macRxedCtrlMsgsTrace))
         {
-            Ptr<NrSRMessage> msg = Create<NrSRMessage>();
-            msg->SetRNTI(v);
-            m_macRxedCtrlMsgsTrace(m_currentSlot, GetCellId(), v, GetBwpId(), msg);
+            // With a slot executor, the trace is fired at the commit of the slot
+            NrParallelSlotExecutor::RunAtCommit(
+                [this, slot = m_currentSlot, list = params.m_srList]() {
+                    for (const auto& v : list)
+                    {
+                        Ptr<NrSRMessage> msg = Create<NrSRMessage>();
+                        msg->SetRNTI(v);
+                        m_macRxedCtrlMsgsTrace(slot, GetCellId(), v, GetBwpId(), msg);
+                    }
+                });
         }
     }
 
@@ -683,11 +733,17 @@ NrGnbMac::DoSlotUlIndication(const SfnSf& sfnSf, LteNrTddSlotType type)
         m_ulCeReceived.erase(m_ulCeReceived.begin(), m_ulCeReceived.end());
         m_macSchedSapProvider->SchedUlMacCtrlInfoReq(ulMacReq);
 
-        for (const auto& v : ulMacReq.m_macCeList)
+        if (NR_TRACE_ENABLED(m_macRxedCtrlMsgsTrace))
         {
-            Ptr<NrBsrMessage> msg = Create<NrBsrMessage>();
-            msg->SetBsr(v);
-            m_macRxedCtrlMsgsTrace(m_currentSlot, GetCellId(), v.m_rnti, GetBwpId(), msg);
+            NrParallelSlotExecutor::RunAtCommit(
+                [this, slot = m_currentSlot, list = ulMacReq.m_macCeList]() {
+                    for (const auto& v : list)
+                    {
+                        Ptr<NrBsrMessage> msg = Create<NrBsrMessage>();
+                        msg->SetBsr(v);
+                        m_macRxedCtrlMsgsTrace(slot, GetCellId(), v.m_rnti, GetBwpId(), msg);
+                    }
+                });
         }
     }
 
@@ -829,6 +885,40 @@ NrGnbMac::DoReceivePhyPdu(Ptr<Packet> p)
         ReceiveBsrMessage(bsr); // Here it will be converted again, but our job is done.
         return;
     }
+    else if (header.GetLcId() == NrMacHeaderVsUl::LONG_BSR)
+    {
+        NrMacLongBsrCe bsrHeader;
+        p->RemoveHeader(bsrHeader);
+
+        // The scheduler recognizes the LONG_BSR from the number of levels,
+        // which have to be converted with NrMacLongBsrCe::FromLevelToBytes
+        MacCeElement bsr;
+
+        bsr.m_macCeType = MacCeElement::BSR;
+        bsr.m_rnti = rnti;
+        bsr.m_macCeValue.m_bufferStatus.assign(bsrHeader.m_bufferSizeLevel.begin(),
+                                               bsrHeader.m_bufferSizeLevel.end());
+
+        ReceiveBsrMessage(bsr);
+        return;
+    }
+    else if (header.GetLcId() == NrMacHeaderFsUl::SHORT_TRUNCATED_BSR)
+    {
+        NrMacShortTruncatedBsrCe bsrHeader;
+        p->RemoveHeader(bsrHeader);
+
+        // The scheduler receives it as a LONG_BSR, and updates only the
+        // reported LCG: the others keep their last known size
+        MacCeElement bsr;
+
+        bsr.m_macCeType = MacCeElement::BSR;
+        bsr.m_rnti = rnti;
+        bsr.m_macCeValue.m_bufferStatus = bsrHeader.ToLongBsrLevels();
+        bsr.m_macCeValue.m_truncatedLcg = bsrHeader.m_lcg;
+
+        ReceiveBsrMessage(bsr);
+        return;
+    }
 
     // Ok, we know it is data, so let's extract and pass to RLC.
 
@@ -954,9 +1044,8 @@ NrGnbMac::DoDlHarqFeedback(const DlHarqInfo& params)
         if (params.m_harqStatus.at(stream) == DlHarqInfo::ACK)
         {
             // discard buffer
-            Ptr<PacketBurst> emptyBuf = CreateObject<PacketBurst>();
             (*it).second.at(params.m_harqProcessId).m_infoPerStream.at(stream).m_pktBurst =
-                emptyBuf;
+                nullptr;
             NS_LOG_DEBUG(this << " HARQ-ACK UE " << params.m_rnti << " harqId "
                               << (uint16_t)params.m_harqProcessId << " stream id " << stream);
         }
@@ -1021,18 +1110,19 @@ NrGnbMac::DoTransmitPdu(LteMacSapProvider::TransmitPduParameters params)
     LteRadioBearerTag bearerTag(params.rnti, params.lcid, params.layer);
     params.pdu->AddPacketTag(bearerTag);
 
-    harqIt->second.at(params.harqProcessId)
-        .m_infoPerStream.at(params.layer)
-        .m_pktBurst->AddPacket(params.pdu);
+    // The PDUs are collected in the HARQ buffer, and sent to the PHY all
+    // together once the RLC entities have been notified (DoSchedConfigIndication)
+    Ptr<PacketBurst>& pb =
+        harqIt->second.at(params.harqProcessId).m_infoPerStream.at(params.layer).m_pktBurst;
+    if (pb == nullptr)
+    {
+        pb = CreateObject<PacketBurst>();
+    }
+    pb->AddPacket(params.pdu);
 
     it->second.m_used += params.pdu->GetSize();
     NS_ASSERT_MSG(it->second.m_maxBytes >= it->second.m_used,
                   "DCI OF " << it->second.m_maxBytes << " total used " << it->second.m_used);
-
-    m_phySapProvider->SendMacPdu(params.pdu,
-                                 it->second.m_sfnSf,
-                                 it->second.m_dci->m_symStart,
-                                 params.layer);
 }
 
 void
@@ -1055,11 +1145,14 @@ NrGnbMac::SendRar(const std::vector<BuildRarListElement_s>& rarList)
         rarMsg->AddRar(rar);
         NS_LOG_INFO("In slot " << m_currentSlot << " send to PHY the RAR message for RNTI "
                                << rarAllocation.m_rnti << " rapId " << itRapId->second);
-        m_macTxedCtrlMsgsTrace(m_currentSlot,
-                               GetCellId(),
-                               rarAllocation.m_rnti,
-                               GetBwpId(),
-                               rarMsg);
+        if (NR_TRACE_ENABLED(m_macTxedCtrlMsgsTrace))
+        {
+            m_macTxedCtrlMsgsTrace(m_currentSlot,
+                                   GetCellId(),
+                                   rarAllocation.m_rnti,
+                                   GetBwpId(),
+                                   rarMsg);
+        }
     }
 
     if (rarList.size() > 0)
@@ -1078,10 +1171,29 @@ NrGnbMac::DoSchedConfigIndication(NrMacSchedSapUser::SchedConfigIndParameters in
 
     NS_LOG_DEBUG("Received from scheduler a new allocation: " << ind.m_slotAllocInfo);
 
-    m_phySapProvider->SetSlotAllocInfo(ind.m_slotAllocInfo);
-
     SendRar(ind.m_buildRarList);
 
+    // Report to the CCM the fraction of the RBG-symbols of the slot used by DL
+    // data. The allocations of the UL triggers are skipped: a UL slot has no
+    // DL data symbols, and the DL part of a F slot is in the DL allocation
+    if (m_ccmMacSapUser != nullptr && ind.m_slotAllocInfo.m_type == SlotAllocInfo::DL)
+    {
+        uint32_t usedRbgSymbols = 0;
+        uint32_t rbgSymbols = 0;
+        for (const auto& varTtiAllocInfo : ind.m_slotAllocInfo.m_varTtiAllocInfo)
+        {
+            const auto& dci = varTtiAllocInfo.m_dci;
+            if (dci->m_type == DciInfoElementTdma::DATA && dci->m_format == DciInfoElementTdma::DL)
+            {
+                const auto rbgs = std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 1);
+                usedRbgSymbols += static_cast<uint32_t>(rbgs) * dci->m_numSym;
+                rbgSymbols = dci->m_rbgBitmask.size() * m_phySapProvider->GetSymbolsPerSlot();
+            }
+        }
+        const double occupancy = rbgSymbols > 0 ? 1.0 * usedRbgSymbols / rbgSymbols : 0.0;
+        m_ccmMacSapUser->NotifyPrbOccupancy(occupancy, GetBwpId());
+    }
+
     for (unsigned islot = 0; islot < ind.m_slotAllocInfo.m_varTtiAllocInfo.size(); islot++)
     {
         VarTtiAllocInfo& varTtiAllocInfo = ind.m_slotAllocInfo.m_varTtiAllocInfo[islot];
@@ -1114,8 +1226,7 @@ NrGnbMac::DoSchedConfigIndication(NrMacSchedSapUser::SchedConfigIndParameters in
                     // HARQ buffer.
                     for (auto& it : harqIt->second.at(tbUid).m_infoPerStream)
                     {
-                        Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
-                        it.m_pktBurst = pb;
+                        it.m_pktBurst = nullptr; // created by DoTransmitPdu, if needed
                         it.m_lcidList.clear();
                     }
                     // now push the NrMacPduInfo into m_macPduMap
@@ -1166,48 +1277,61 @@ NrGnbMac::DoSchedConfigIndication(NrMacSchedSapUser::SchedConfigIndParameters in
                     }
                     else
                     {
-                        if (varTtiAllocInfo.m_dci->m_tbSize.at(k) > 0)
+                        const Ptr<PacketBurst>& pb =
+                            harqIt->second.at(tbUid).m_infoPerStream.at(k).m_pktBurst;
+                        if (varTtiAllocInfo.m_dci->m_tbSize.at(k) > 0 && pb != nullptr)
                         {
-                            Ptr<PacketBurst> pb =
-                                harqIt->second.at(tbUid).m_infoPerStream.at(k).m_pktBurst;
-                            for (std::list<Ptr<Packet>>::const_iterator j = pb->Begin();
-                                 j != pb->End();
-                                 ++j)
-                            {
-                                Ptr<Packet> pkt = (*j)->Copy();
-                                m_phySapProvider->SendMacPdu(pkt,
-                                                             ind.m_sfnSf,
-                                                             dciElem->m_symStart,
-                                                             k);
-                            }
+                            // The PHY does not modify the burst: it can be
+                            // retransmitted as it is, without copying it
+                            m_phySapProvider->SendMacPduBurst(pb,
+                                                              ind.m_sfnSf,
+                                                              dciElem->m_symStart,
+                                                              k);
                         }
                     }
                 }
             }
 
+            // Send to the PHY the PDUs that the RLC entities generated for the new data
+            for (std::size_t stream = 0; stream < dciElem->m_ndi.size(); stream++)
+            {
+                const Ptr<PacketBurst>& pb =
+                    harqIt->second.at(tbUid).m_infoPerStream.at(stream).m_pktBurst;
+                if (dciElem->m_ndi.at(stream) == 1 && pb != nullptr)
+                {
+                    m_phySapProvider->SendMacPduBurst(pb,
+                                                      ind.m_sfnSf,
+                                                      dciElem->m_symStart,
+                                                      static_cast<uint8_t>(stream));
+                }
+            }
+
             if (mapRet.second)
             {
                 m_macPduMap.erase(mapRet.first); // delete map entry
             }
 
-            for (std::size_t stream = 0; stream < dciElem->m_tbSize.size(); stream++)
+            if (NR_TRACE_ENABLED(m_dlScheduling))
             {
-                NrSchedulingCallbackInfo traceInfo;
-                traceInfo.m_frameNum = ind.m_sfnSf.GetFrame();
-                traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe();
-                traceInfo.m_slotNum = ind.m_sfnSf.GetSlot();
-                traceInfo.m_symStart = dciElem->m_symStart;
-                traceInfo.m_numSym = dciElem->m_numSym;
-                traceInfo.m_streamId = static_cast<uint8_t>(stream);
-                traceInfo.m_tbSize = dciElem->m_tbSize.at(stream);
-                traceInfo.m_mcs = dciElem->m_mcs.at(stream);
-                traceInfo.m_rnti = dciElem->m_rnti;
-                traceInfo.m_bwpId = GetBwpId();
-                traceInfo.m_ndi = dciElem->m_ndi.at(stream);
-                traceInfo.m_rv = dciElem->m_rv.at(stream);
-                traceInfo.m_harqId = dciElem->m_harqProcess;
-
-                m_dlScheduling(traceInfo);
+                for (std::size_t stream = 0; stream < dciElem->m_tbSize.size(); stream++)
+                {
+                    NrSchedulingCallbackInfo traceInfo;
+                    traceInfo.m_frameNum = ind.m_sfnSf.GetFrame();
+                    traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe();
+                    traceInfo.m_slotNum = ind.m_sfnSf.GetSlot();
+                    traceInfo.m_symStart = dciElem->m_symStart;
+                    traceInfo.m_numSym = dciElem->m_numSym;
+                    traceInfo.m_streamId = static_cast<uint8_t>(stream);
+                    traceInfo.m_tbSize = dciElem->m_tbSize.at(stream);
+                    traceInfo.m_mcs = dciElem->m_mcs.at(stream);
+                    traceInfo.m_rnti = dciElem->m_rnti;
+                    traceInfo.m_bwpId = GetBwpId();
+                    traceInfo.m_ndi = dciElem->m_ndi.at(stream);
+                    traceInfo.m_rv = dciElem->m_rv.at(stream);
+                    traceInfo.m_harqId = dciElem->m_harqProcess;
+
+                    m_dlScheduling(traceInfo);
+                }
             }
         }
         else if (varTtiAllocInfo.m_dci->m_type != DciInfoElementTdma::CTRL &&
@@ -1217,27 +1341,33 @@ NrGnbMac::DoSchedConfigIndication(NrMacSchedSapUser::SchedConfigIndParameters in
             // UL scheduling info trace
             //  Call RLC entities to generate RLC PDUs
             auto dciElem = varTtiAllocInfo.m_dci;
-            for (std::size_t stream = 0; stream < dciElem->m_tbSize.size(); stream++)
+            if (NR_TRACE_ENABLED(m_ulScheduling))
             {
-                NrSchedulingCallbackInfo traceInfo;
-                traceInfo.m_frameNum = ind.m_sfnSf.GetFrame();
-                traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe();
-                traceInfo.m_slotNum = ind.m_sfnSf.GetSlot();
-                traceInfo.m_symStart = dciElem->m_symStart;
-                traceInfo.m_numSym = dciElem->m_numSym;
-                traceInfo.m_streamId = static_cast<uint8_t>(stream);
-                traceInfo.m_tbSize = dciElem->m_tbSize.at(stream);
-                traceInfo.m_mcs = dciElem->m_mcs.at(stream);
-                traceInfo.m_rnti = dciElem->m_rnti;
-                traceInfo.m_bwpId = GetBwpId();
-                traceInfo.m_ndi = dciElem->m_ndi.at(stream);
-                traceInfo.m_rv = dciElem->m_rv.at(stream);
-                traceInfo.m_harqId = dciElem->m_harqProcess;
-
-                m_ulScheduling(traceInfo);
+                for (std::size_t stream = 0; stream < dciElem->m_tbSize.size(); stream++)
+                {
+                    NrSchedulingCallbackInfo traceInfo;
+                    traceInfo.m_frameNum = ind.m_sfnSf.GetFrame();
+                    traceInfo.m_subframeNum = ind.m_sfnSf.GetSubframe();
+                    traceInfo.m_slotNum = ind.m_sfnSf.GetSlot();
+                    traceInfo.m_symStart = dciElem->m_symStart;
+                    traceInfo.m_numSym = dciElem->m_numSym;
+                    traceInfo.m_streamId = static_cast<uint8_t>(stream);
+                    traceInfo.m_tbSize = dciElem->m_tbSize.at(stream);
+                    traceInfo.m_mcs = dciElem->m_mcs.at(stream);
+                    traceInfo.m_rnti = dciElem->m_rnti;
+                    traceInfo.m_bwpId = GetBwpId();
+                    traceInfo.m_ndi = dciElem->m_ndi.at(stream);
+                    traceInfo.m_rv = dciElem->m_rv.at(stream);
+                    traceInfo.m_harqId = dciElem->m_harqProcess;
+
+                    m_ulScheduling(traceInfo);
+                }
             }
         }
     }
+
+    // The allocation is not needed anymore here: move it to the PHY
+    m_phySapProvider->SetSlotAllocInfo(std::move(ind.m_slotAllocInfo));
 }
 
 // ////////////////////////////////////////////
@@ -1273,14 +1403,15 @@ NrGnbMac::DoConfigureMac(uint16_t ulBandwidth, uint16_t dlBandwidth)
 }
 
 void
-NrGnbMac::BeamChangeReport(BeamConfId beamConfId, uint8_t rnti)
+NrGnbMac::BeamChangeReport(BeamConfId beamConfId, uint16_t rnti)
 {
-    NrMacCschedSapProvider::CschedUeConfigReqParameters params;
-    params.m_rnti = rnti;
-    params.m_beamConfId = beamConfId;
-    params.m_transmissionMode =
-        0; // set to default value (SISO) for avoiding random initialization (valgrind error)
-    m_macCschedSapProvider->CschedUeConfigReq(params);
+    NS_LOG_FUNCTION(this << beamConfId << rnti);
+    if (m_rlcAttached.find(rnti) == m_rlcAttached.end())
+    {
+        NS_LOG_INFO("Ignoring the beam change of the not attached RNTI " << rnti);
+        return;
+    }
+    m_beamChanges.insert_or_assign(rnti, beamConfId);
 }
 
 uint16_t
@@ -1369,8 +1500,6 @@ NrGnbMac::DoAddUe(uint16_t rnti)
         for (uint16_t stream = 0; stream < numStreams; stream++)
         {
             HarqProcessInfoSingleStream info;
-            Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
-            info.m_pktBurst = pb;
             buf.at(i).m_infoPerStream.push_back(info);
         }
     }
@@ -7,6 +7,7 @@
 #ifndef NR_ENB_MAC_H
 #define NR_ENB_MAC_H
 
+#include "beam-conf-id.h"
 #include "nr-mac-pdu-info.h"
 #include "nr-mac-sched-sap.h"
 #include "nr-mac-scheduler.h"
@@ -172,8 +173,12 @@ class NrGnbMac : public Object
      * \brief A BeamConf for a user has changed
      * \param beamConfId new beam ID
      * \param rnti RNTI of the user
+     *
+     * The change is stored, and passed to the scheduler at the next DL slot
+     * indication, before the scheduling. Changes for UEs that are not (yet)
+     * attached are ignored, as the beam is asked to the PHY when the UE is added.
      */
-    void BeamChangeReport(BeamConfId beamConfId, uint8_t rnti);
+    void BeamChangeReport(BeamConfId beamConfId, uint16_t rnti);
 
     /**
      * TracedCallback signature for DL and UL data scheduling events.
@@ -333,6 +338,9 @@ class NrGnbMac : public Object
   private:
     struct HarqProcessInfoSingleStream
     {
+        // PDUs of the TB, shared with the PHY. Created only when the RLC
+        // entities send the first PDU, and never modified after it has been
+        // sent to the PHY.
         Ptr<PacketBurst> m_pktBurst;
         // maintain list of LCs contained in this TB
         // used to signal HARQ failure to RLC handlers
@@ -358,8 +366,8 @@ class NrGnbMac : public Object
     NrMacCschedSapUser* m_macCschedSapUser;
 
     // Sap For ComponentCarrierManager 'Uplink case'
-    LteCcmMacSapProvider* m_ccmMacSapProvider; ///< CCM MAC SAP provider
-    LteCcmMacSapUser* m_ccmMacSapUser;         ///< CCM MAC SAP user
+    LteCcmMacSapProvider* m_ccmMacSapProvider;  ///< CCM MAC SAP provider
+    LteCcmMacSapUser* m_ccmMacSapUser{nullptr}; ///< CCM MAC SAP user
 
     int32_t m_numRbPerRbg{-1}; //!< number of resource blocks within the channel bandwidth
 
@@ -377,6 +385,8 @@ class NrGnbMac : public Object
 
     std::unordered_map<uint16_t, std::unordered_map<uint8_t, LteMacSapUser*>> m_rlcAttached;
 
+    std::unordered_map<uint16_t, BeamConfId> m_beamChanges; //!< Beam changes not yet notified
+
     std::vector<DlHarqInfo> m_dlHarqInfoReceived; // DL HARQ feedback received
     std::vector<UlHarqInfo> m_ulHarqInfoReceived; // UL HARQ feedback received
     std::unordered_map<uint16_t, NrDlHarqProcessesBuffer_t>
@@ -16,6 +16,7 @@
 #include "nr-ch-access-manager.h"
 #include "nr-gnb-net-device.h"
 #include "nr-net-device.h"
+#include "nr-parallel-slot-executor.h"
 #include "nr-radio-bearer-tag.h"
 #include "nr-ue-net-device.h"
 #include "nr-ue-phy.h"
@@ -409,7 +410,7 @@ NrGnbPhy::PushDlAllocation(const SfnSf& sfnSf) const
     slotAllocInfo.m_type = SlotAllocInfo::DL;
     slotAllocInfo.m_varTtiAllocInfo.emplace_back(dlCtrlVarTti);
 
-    m_phySapProvider->SetSlotAllocInfo(slotAllocInfo);
+    m_phySapProvider->SetSlotAllocInfo(std::move(slotAllocInfo));
 }
 
 void
@@ -427,7 +428,41 @@ NrGnbPhy::PushUlAllocation(const SfnSf& sfnSf) const
     slotAllocInfo.m_type = SlotAllocInfo::UL;
     slotAllocInfo.m_varTtiAllocInfo.emplace_back(ulCtrlVarTti);
 
-    m_phySapProvider->SetSlotAllocInfo(slotAllocInfo);
+    m_phySapProvider->SetSlotAllocInfo(std::move(slotAllocInfo));
+}
+
+uint32_t
+NrGnbPhy::GetUlAllocationHorizon() const
+{
+    uint32_t maxK2 = 0;
+    std::vector<uint32_t> generationSlots;
+    for (const auto& slot : m_generateUl)
+    {
+        if (!slot.second.empty())
+        {
+            generationSlots.push_back(slot.first);
+            maxK2 = std::max(maxK2, slot.second.back()); // sorted
+        }
+    }
+    if (generationSlots.empty())
+    {
+        return 0;
+    }
+
+    // The longest wait for the next slot that generates UL allocations
+    const auto n = static_cast<uint32_t>(m_tddPattern.size());
+    uint32_t maxGap = generationSlots.front() + n - generationSlots.back();
+    for (std::size_t i = 1; i < generationSlots.size(); ++i)
+    {
+        maxGap = std::max(maxGap, generationSlots.at(i) - generationSlots.at(i - 1));
+    }
+
+    const int64_t slotNs = GetSlotPeriod().GetNanoSeconds();
+    const auto decodeSlots =
+        static_cast<uint32_t>((GetTbDecodeLatency().GetNanoSeconds() + slotNs - 1) / slotNs);
+
+    // The scheduled slot itself, then the decode and the wait for the MAC
+    return maxK2 + 1 + decodeSlots + maxGap;
 }
 
 void
@@ -461,6 +496,26 @@ NrGnbPhy::SetTddPattern(const std::vector<LteNrTddSlotType>& pattern)
                                   GetN2Delay(),
                                   GetN1Delay(),
                                   GetL1L2CtrlLatency());
+
+    // The allocations are generated at most L1L2CtrlLatency + K0/K2 slots in advance
+    uint32_t horizon = 0;
+    for (const auto* generate : {&m_generateDl, &m_generateUl})
+    {
+        for (const auto& slot : *generate)
+        {
+            for (const auto k : slot.second)
+            {
+                horizon = std::max(horizon, k);
+            }
+        }
+    }
+    SetSlotAllocHorizon(horizon);
+
+    // Without the MAC, the horizon is given at the start of the event loop
+    if (m_phySapUser != nullptr)
+    {
+        m_phySapUser->SetUlAllocationHorizon(GetUlAllocationHorizon());
+    }
 }
 
 void
@@ -498,6 +553,7 @@ NrGnbPhy::StartEventLoop(uint16_t frame, uint8_t subframe, uint16_t slot)
                  << "\t Num. RB: " << GetRbNum());
     SfnSf startSlot(frame, subframe, slot, GetNumerology());
     InitializeMessageList();
+    m_phySapUser->SetUlAllocationHorizon(GetUlAllocationHorizon());
     StartSlot(startSlot);
 }
 
@@ -570,20 +626,65 @@ NrGnbPhy::GetBeamConfId(uint16_t rnti) const
 
         if (ueRnti == rnti)
         {
-            NS_ASSERT(m_spectrumPhys[0]->GetBeamManager());
-            BeamId beamId1 = m_spectrumPhys[0]->GetBeamManager()->GetBeamId(m_deviceMap.at(i));
-            BeamId beamId2 = BeamId::GetEmptyBeamId();
-
-            if (m_spectrumPhys.size() > 1)
-            {
-                m_spectrumPhys[1]->GetBeamManager()->GetBeamId(m_deviceMap.at(i));
-            }
-            return BeamConfId(beamId1, beamId2);
+            return GetBeamConfId(ueDev);
         }
     }
+    // The UE PHY does not know its RNTI yet: report the real beam when it does
+    m_unresolvedBeamRntis.insert(rnti);
     return BeamConfId(BeamId(0, 0), BeamId::GetEmptyBeamId());
 }
 
+BeamConfId
+NrGnbPhy::GetBeamConfId(const Ptr<NrUeNetDevice>& ueDevice) const
+{
+    NS_ASSERT(m_spectrumPhys[0]->GetBeamManager());
+    BeamId beamId1 = m_spectrumPhys[0]->GetBeamManager()->GetBeamId(ueDevice);
+    BeamId beamId2 = BeamId::GetEmptyBeamId();
+
+    if (m_spectrumPhys.size() > 1)
+    {
+        m_spectrumPhys[1]->GetBeamManager()->GetBeamId(ueDevice);
+    }
+    return BeamConfId(beamId1, beamId2);
+}
+
+void
+NrGnbPhy::ReportBeamChange(Ptr<const NetDevice> ueDevice)
+{
+    NS_LOG_FUNCTION(this << ueDevice);
+
+    if (m_phySapUser == nullptr)
+    {
+        return; // Not connected to the MAC yet: it will ask the beam when the UE is added
+    }
+
+    for (const auto& ueDev : m_deviceMap)
+    {
+        if (ueDevice == nullptr || PeekPointer(ueDev) == PeekPointer(ueDevice))
+        {
+            uint16_t rnti = DynamicCast<NrUePhy>(ueDev->GetPhy(GetBwpId()))->GetRnti();
+            m_phySapUser->BeamChangeReport(GetBeamConfId(ueDev), rnti);
+        }
+    }
+}
+
+void
+NrGnbPhy::ResolveBeamRntis()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (const auto& ueDev : m_deviceMap)
+    {
+        uint16_t rnti = DynamicCast<NrUePhy>(ueDev->GetPhy(GetBwpId()))->GetRnti();
+        auto it = m_unresolvedBeamRntis.find(rnti);
+        if (it != m_unresolvedBeamRntis.end())
+        {
+            m_phySapUser->BeamChangeReport(GetBeamConfId(ueDev), rnti);
+            m_unresolvedBeamRntis.erase(it);
+        }
+    }
+}
+
 void
 NrGnbPhy::SetCam(const Ptr<NrChAccessManager>& cam)
 {
@@ -602,6 +703,13 @@ NrGnbPhy::GetCam() const
     return m_cam;
 }
 
+void
+NrGnbPhy::SetSlotExecutor(const Ptr<NrParallelSlotExecutor>& executor)
+{
+    NS_LOG_FUNCTION(this << executor);
+    m_slotExecutor = executor;
+}
+
 void
 NrGnbPhy::SetTxPower(double pow)
 {
@@ -650,12 +758,29 @@ NrGnbPhy::QueueSib()
 
 void
 NrGnbPhy::CallMacForSlotIndication(const SfnSf& currentSlot)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_slotExecutor != nullptr && m_slotExecutor->RunSlotStart(this))
+    {
+        return;
+    }
+    DoCallMacForSlotIndication(currentSlot);
+}
+
+void
+NrGnbPhy::DoCallMacForSlotIndication(const SfnSf& currentSlot)
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(!m_generateDl.empty() || !m_generateUl.empty());
 
     m_phySapUser->SetCurrentSfn(currentSlot);
 
+    if (!m_unresolvedBeamRntis.empty())
+    {
+        ResolveBeamRntis();
+    }
+
     uint64_t currentSlotN = currentSlot.Normalize() % m_tddPattern.size();
 
     NS_LOG_INFO("Start Slot " << currentSlot << ". In position " << currentSlotN
@@ -793,7 +918,7 @@ NrGnbPhy::StartSlot(const SfnSf& startSlot)
                 NS_LOG_INFO("Reason: CTRL message list is not empty");
             }
 
-            PushFrontSlotAllocInfo(newSfnSf, slotAllocCopy);
+            PushFrontSlotAllocInfo(newSfnSf, std::move(slotAllocCopy));
         }
         else
         {
@@ -1508,6 +1633,18 @@ NrGnbPhy::EndSlot()
 
     NS_LOG_DEBUG("Slot started at " << m_lastSlotStart << " ended");
     m_currentSlot.Add(1);
+
+    if (m_slotExecutor != nullptr && slotStart.IsZero())
+    {
+        // The MAC can be called before the slot start only if it will be called
+        // then (the channel is granted), and if the call touches only the MAC
+        // and its scheduler (the RACH preambles are notified to the RRC)
+        m_slotExecutor->AddSlotStart(
+            this,
+            PeekPointer(m_netDevice),
+            [this]() { DoCallMacForSlotIndication(m_currentSlot); },
+            [this]() { return m_channelStatus == GRANTED && !m_phySapUser->HasRachPreambles(); });
+    }
     Simulator::Schedule(slotStart, &NrGnbPhy::StartSlot, this, m_currentSlot);
 }
 
@@ -17,6 +17,7 @@
 #include <ns3/nr-harq-phy.h>
 
 #include <functional>
+#include <unordered_set>
 
 namespace ns3
 {
@@ -27,6 +28,7 @@ class PacketBurst;
 class NrUePhy;
 class NrGnbMac;
 class NrChAccessManager;
+class NrParallelSlotExecutor;
 class BeamManager;
 
 /**
@@ -183,6 +185,15 @@ class NrGnbPhy : public NrPhy
      */
     BeamConfId GetBeamConfId(uint16_t rnti) const override;
 
+    /**
+     * \brief Notify the MAC that the beam toward a UE has changed
+     * \param ueDevice the UE device, or nullptr if the beam of all the UEs may have changed
+     *
+     * Usually connected by the helper to the BeamManager of each NrSpectrumPhy,
+     * see BeamManager::SetBeamChangeCallback.
+     */
+    void ReportBeamChange(Ptr<const NetDevice> ueDevice);
+
     /**
      * \brief Set the channel access manager interface for this instance of the PHY
      * \param s the pointer to the interface
@@ -195,6 +206,19 @@ class NrGnbPhy : public NrPhy
      */
     Ptr<NrChAccessManager> GetCam() const;
 
+    /**
+     * \brief Set the executor that runs the slot indications of the MAC
+     * \param executor the executor, or nullptr to call the MAC in the slot start
+     *
+     * The PHY announces each slot start at the end of the previous slot. If the
+     * channel is granted, and the MAC has no RACH preambles to notify to the
+     * RRC, the slot indication may run during the slot start of another cell,
+     * and its decisions are committed to the MAC in the slot start of this PHY.
+     *
+     * \see NrParallelSlotExecutor
+     */
+    void SetSlotExecutor(const Ptr<NrParallelSlotExecutor>& executor);
+
     /**
      * \brief Set the transmission power for the UE
      *
@@ -418,6 +442,19 @@ class NrGnbPhy : public NrPhy
     void DoDispose() override;
 
   private:
+    /**
+     * \brief Get the BeamConfId toward a UE device
+     * \param ueDevice the UE device
+     * \return the BeamConfId of the UE
+     */
+    BeamConfId GetBeamConfId(const Ptr<NrUeNetDevice>& ueDevice) const;
+
+    /**
+     * \brief Report to the MAC the beam of the RNTIs that GetBeamConfId could not
+     * find, if their UE PHY has received the RNTI in the meantime
+     */
+    void ResolveBeamRntis();
+
     /**
      * \brief Set the current slot pattern (better to call it only once..)
      * \param pattern the pattern
@@ -644,10 +681,20 @@ class NrGnbPhy : public NrPhy
 
     /**
      * \brief Call MAC for retrieve the slot indication. Currently calls UL and DL.
+     *
+     * With a slot executor, the indication may have already run during the slot
+     * start of another cell: then, only its decisions are committed to the MAC.
+     *
      * \param currentSlot Current slot
      */
     void CallMacForSlotIndication(const SfnSf& currentSlot);
 
+    /**
+     * \brief Call the MAC for the UL and DL slot indications
+     * \param currentSlot Current slot
+     */
+    void DoCallMacForSlotIndication(const SfnSf& currentSlot);
+
     /**
      * \brief Retrieve a DCI list for the allocation passed as parameter
      * \param alloc The allocation we are searching in
@@ -681,6 +728,17 @@ class NrGnbPhy : public NrPhy
      */
     void PushUlAllocation(const SfnSf& sfnSf) const;
 
+    /**
+     * \brief Get the number of slots that the UL allocations wait in the
+     * scheduler for their UL CQI
+     * \return the number of slots, from the scheduling of a slot to its UL CQI
+     *
+     * A slot is scheduled at most L1L2CtrlLatency + K2 slots before it. Its UL
+     * CQI is ready after the TB decode latency, and the MAC gives it to the
+     * scheduler in the next slot that generates UL allocations.
+     */
+    uint32_t GetUlAllocationHorizon() const;
+
     /**
      * \brief Start the processing event loop
      * \param frame Frame number
@@ -730,6 +788,8 @@ class NrGnbPhy : public NrPhy
     std::set<uint64_t> m_ueAttached;             //!< Set of attached UE (by IMSI)
     std::set<uint16_t> m_ueAttachedRnti;         //!< Set of attached UE (by RNTI)
     std::vector<Ptr<NrUeNetDevice>> m_deviceMap; //!< Vector of UE devices
+    mutable std::unordered_set<uint16_t>
+        m_unresolvedBeamRntis; //!< RNTIs asked to GetBeamConfId before their UE PHY knew them
 
     LteRrcSap::SystemInformationBlockType1 m_sib1; //!< SIB1 message
     Time m_lastSlotStart;                          //!< Time at which the last slot started
@@ -812,7 +872,8 @@ class NrGnbPhy : public NrPhy
     ChannelStatus m_channelStatus{NONE}; //!< The channel status
     EventId m_channelLostTimer; //!< Timer that, when expires, indicates that the channel is lost
 
-    Ptr<NrChAccessManager> m_cam; //!< Channel Access Manager
+    Ptr<NrChAccessManager> m_cam;               //!< Channel Access Manager
+    Ptr<NrParallelSlotExecutor> m_slotExecutor; //!< Executor of the slot indications, if any
 
     friend class LtePatternTestCase;
 
@@ -6,6 +6,8 @@
 
 #include "nr-interference.h"
 
+#include "nr-profiler.h"
+
 #include <ns3/log.h>
 #include <ns3/lte-chunk-processor.h>
 #include <ns3/simulator.h>
@@ -122,6 +124,7 @@ void
 NrInterference::ConditionallyEvaluateChunk()
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::INTERFERENCE_CHUNK);
     if (m_receiving)
     {
         NS_LOG_DEBUG(this << " Receiving");
@@ -9,7 +9,9 @@
 #include <ns3/log.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <vector>
 
 namespace ns3
 {
@@ -27,6 +29,14 @@ const uint16_t MI_64QAM_MAX_ID = 28; // 29,30 and 31 are reserved
 // const uint16_t MI_QPSK_BLER_MAX_ID = 12;   // MI_QPSK_MAX_ID + 3 RETX
 // const uint16_t MI_16QAM_BLER_MAX_ID = 22;
 const uint16_t MI_64QAM_BLER_MAX_ID = 37;
+const uint16_t MI_CB_SIZES = 9;
+
+// number of RBs whose SINR is mapped to MI in a batch
+static constexpr std::size_t MI_BATCH_SIZE = 16;
+// range of the tabulated BLER curve, in standard deviations around its center
+static constexpr double BLER_CURVE_RANGE = 8.0;
+// points of the tabulated BLER curve per standard deviation
+static constexpr double BLER_CURVE_RESOLUTION = 256.0;
 
 // global table of the effective code rates (ECR)s that have BLER performance curves
 static const double BlerCurvesEcrMap[38] = {
@@ -899,6 +909,123 @@ static const uint8_t ModulationSchemeForMcs[32] = {
     6, // reserved
 };
 
+/**
+ * \brief The MI map of a modulation, whose SINR values are uniformly spaced
+ */
+struct MiMap
+{
+    const double* m_mi; //!< MI of each SINR value
+    uint16_t m_size;    //!< Number of SINR values
+    double m_sinrMin;   //!< First SINR value (linear)
+    double m_sinrMax;   //!< Last SINR value (linear)
+    double m_scale;     //!< Number of SINR values per unit of (linear) SINR
+};
+
+/**
+ * \brief Get the MI map of the modulation of a MCS
+ * \param mcs the MCS
+ * \return the MI map
+ */
+static const MiMap&
+GetMiMap(uint8_t mcs)
+{
+    // since the SINR values of the maps are uniformly spaced, we have
+    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+    // the scaling coefficient is always the same, so it is computed once
+    auto makeMap = [](const double* mi, const double* axis, uint16_t size) {
+        return MiMap{mi, size, axis[0], axis[size - 1], (size - 1) / (axis[size - 1] - axis[0])};
+    };
+    static const MiMap qpsk = makeMap(MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE);
+    static const MiMap qam16 = makeMap(MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE);
+    static const MiMap qam64 = makeMap(MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE);
+
+    if (mcs <= MI_QPSK_MAX_ID)
+    {
+        return qpsk;
+    }
+    return mcs <= MI_16QAM_MAX_ID ? qam16 : qam64;
+}
+
+/**
+ * \brief The parameters of the BLER curve of an ECR and a CB size
+ */
+struct BlerCurve
+{
+    double m_b{0.0};    //!< Center of the curve (MIB)
+    double m_invC{0.0}; //!< Inverse of the spread of the curve
+};
+
+/**
+ * \brief Get the BLER curve of an ECR and a CB size
+ * \param cbIndex the index of the CB size in cbMiSizeTable
+ * \param ecrId the ECR id
+ * \return the BLER curve
+ */
+static const BlerCurve&
+GetBlerCurve(uint8_t cbIndex, uint8_t ecrId)
+{
+    using CurveTable = std::array<std::array<BlerCurve, MI_64QAM_BLER_MAX_ID + 1>, MI_CB_SIZES>;
+    static const CurveTable curves = []() {
+        CurveTable ret;
+        for (uint8_t cb = 0; cb < MI_CB_SIZES; ++cb)
+        {
+            for (uint8_t ecr = 0; ecr <= MI_64QAM_BLER_MAX_ID; ++ecr)
+            {
+                // take the lowest CB size including this CB for removing CB size
+                // quatization errors
+                double b = bEcrTable[cb][ecr];
+                for (uint8_t i = cb; (i < MI_CB_SIZES) && (b < 0); ++i)
+                {
+                    b = bEcrTable[i][ecr];
+                }
+                double c = cEcrTable[cb][ecr];
+                for (uint8_t i = cb; (i < MI_CB_SIZES) && (c < 0); ++i)
+                {
+                    c = cEcrTable[i][ecr];
+                }
+                ret[cb][ecr] = {b, 1.0 / c};
+            }
+        }
+        return ret;
+    }();
+    return curves[cbIndex][ecrId];
+}
+
+/**
+ * \brief Get the tail of the standard normal distribution, 0.5 * erfc (z / sqrt (2)),
+ * interpolated from a table
+ * \param z the number of standard deviations from the center
+ * \return the probability of a value greater than z
+ *
+ * The interpolation error is below 1e-6.
+ */
+static double
+GetNormalTail(double z)
+{
+    static const std::vector<double> table = []() {
+        std::vector<double> ret(
+            static_cast<std::size_t>(2 * BLER_CURVE_RANGE * BLER_CURVE_RESOLUTION) + 1);
+        for (std::size_t i = 0; i < ret.size(); ++i)
+        {
+            double x = i / BLER_CURVE_RESOLUTION - BLER_CURVE_RANGE;
+            ret[i] = 0.5 * std::erfc(x / std::sqrt(2.0));
+        }
+        return ret;
+    }();
+
+    const double pos = (z + BLER_CURVE_RANGE) * BLER_CURVE_RESOLUTION;
+    if (pos <= 0.0)
+    {
+        return 1.0;
+    }
+    if (pos >= table.size() - 1)
+    {
+        return 0.0;
+    }
+    const auto i = static_cast<std::size_t>(pos);
+    return table[i] + (pos - i) * (table[i + 1] - table[i]);
+}
+
 NrLteMiErrorModel::NrLteMiErrorModel()
     : NrErrorModel()
 {
@@ -930,94 +1057,41 @@ NrLteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, u
 {
     NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
 
-    double MI;
+    if (map.empty())
+    {
+        return 0.0;
+    }
+
+    // The modulation is selected once for all the RBs, which are processed in
+    // batches: their SINR is gathered, and then converted to an index of the MI
+    // map without branches, so that the conversion can be vectorized
+    const MiMap& miMap = GetMiMap(mcs);
+    const double maxIndex = miMap.m_size - 1;
+    std::array<double, MI_BATCH_SIZE> sinrLin;
+    std::array<uint32_t, MI_BATCH_SIZE> sinrIndex;
     double MIsum = 0.0;
 
-    for (uint32_t i = 0; i < map.size(); i++)
+    for (std::size_t first = 0; first < map.size(); first += MI_BATCH_SIZE)
     {
-        double sinrLin = sinr[map.at(i)];
-        if (mcs <= MI_QPSK_MAX_ID) // QPSK
+        const std::size_t num = std::min(MI_BATCH_SIZE, map.size() - first);
+        for (std::size_t i = 0; i < num; ++i)
         {
-            if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-            {
-                MI = 1;
-            }
-            else
-            {
-                // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-                // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                // the scaling coefficient is always the same, so we use a static const
-                // to speed up the calculation
-                static const double scalingCoeffQpsk =
-                    (MI_MAP_QPSK_SIZE - 1) /
-                    (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-                double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-                uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-                MI = MI_map_qpsk[sinrIndex];
-            }
+            sinrLin[i] = sinr[map[first + i]];
         }
-        else
+        for (std::size_t i = 0; i < num; ++i)
         {
-            if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID) // 16-QAM
-            {
-                if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff16qam =
-                        (MI_MAP_16QAM_SIZE - 1) /
-                        (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                    MI = MI_map_16qam[sinrIndex];
-                }
-            }
-            else // 64-QAM
-            {
-                if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff64qam =
-                        (MI_MAP_64QAM_SIZE - 1) /
-                        (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                    MI = MI_map_64qam[sinrIndex];
-                }
-            }
+            // the index is not negative, so the truncation is its floor
+            double sinrIndexDouble = (sinrLin[i] - miMap.m_sinrMin) * miMap.m_scale + 1;
+            sinrIndex[i] = static_cast<uint32_t>(std::clamp(sinrIndexDouble, 0.0, maxIndex));
+        }
+        for (std::size_t i = 0; i < num; ++i)
+        {
+            MIsum += sinrLin[i] > miMap.m_sinrMax ? 1.0 : miMap.m_mi[sinrIndex[i]];
         }
-        NS_LOG_LOGIC(" RB " << map.at(i) << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
-                            << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-        MIsum += MI;
-    }
-    if (map.size() == 0)
-    {
-        MI = 0;
-    }
-    else
-    {
-        MI = MIsum / map.size();
     }
 
-    NS_LOG_LOGIC(" MI = " << MI);
+    double MI = MIsum / map.size();
+    NS_LOG_LOGIC(" MCS = " << (uint16_t)mcs << " RBs = " << map.size() << " MI = " << MI);
     return MI;
 }
 
@@ -1025,12 +1099,9 @@ double
 NrLteMiErrorModel::MappingMiBler(double mib, uint8_t ecrId, uint32_t cbSize)
 {
     NS_LOG_FUNCTION(mib << (uint32_t)ecrId << (uint32_t)cbSize);
-    double b = 0;
-    double c = 0;
-
     NS_ASSERT_MSG(ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t)ecrId);
     int cbIndex = 1;
-    while ((cbIndex < 9) && (cbMiSizeTable[cbIndex] <= cbSize))
+    while ((cbIndex < MI_CB_SIZES) && (cbMiSizeTable[cbIndex] <= cbSize))
     {
         cbIndex++;
     }
@@ -1038,31 +1109,12 @@ NrLteMiErrorModel::MappingMiBler(double mib, uint8_t ecrId, uint32_t cbSize)
     NS_LOG_LOGIC(" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size "
                            << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-    b = bEcrTable[cbIndex][ecrId];
-    if (b < 0.0)
-    {
-        // take the lowest CB size including this CB for removing CB size
-        // quatization errors
-        int i = cbIndex;
-        while ((i < 9) && (b < 0))
-        {
-            b = bEcrTable[i++][ecrId];
-        }
-    }
-    c = cEcrTable[cbIndex][ecrId];
-    if (c < 0.0)
-    {
-        // take the lowest CB size including this CB for removing CB size
-        // quatization errors
-        int i = cbIndex;
-        while ((i < 9) && (c < 0))
-        {
-            c = cEcrTable[i++][ecrId];
-        }
-    }
-    // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-    double bler = 0.5 * (1 - erf((mib - b) / (sqrt(2) * c)));
-    NS_LOG_LOGIC("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+    // see IEEE802.16m EMD formula 55 of section 4.3.2.1: the BLER is the tail of
+    // a normal distribution centered in b, with standard deviation c
+    const BlerCurve& curve = GetBlerCurve(cbIndex, ecrId);
+    double bler = GetNormalTail((mib - curve.m_b) * curve.m_invC);
+    NS_LOG_LOGIC("MIB: " << mib << " BLER:" << bler << " b:" << curve.m_b
+                         << " c:" << 1.0 / curve.m_invC);
     return bler;
 }
 
@@ -1291,4 +1343,13 @@ NrLteMiErrorModel::GetMaxMcs() const
     return 28;
 }
 
+uint8_t
+NrLteMiErrorModel::GetModulationOrder(uint8_t mcs) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_IF(mcs > GetMaxMcs());
+
+    return ModulationSchemeForMcs[mcs];
+}
+
 } // namespace ns3
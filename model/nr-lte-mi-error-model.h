@@ -122,6 +122,10 @@ class NrLteMiErrorModel : public NrErrorModel
      */
     uint32_t GetMaxCbSize(uint32_t tbSize, uint8_t mcs) const override;
     uint8_t GetMaxMcs() const override;
+    /**
+     * \brief Get the modulation order of a MCS, following the MCSs in LTE
+     */
+    uint8_t GetModulationOrder(uint8_t mcs) const override;
 
   private:
     /**
@@ -147,6 +151,9 @@ class NrLteMiErrorModel : public NrErrorModel
      * \brief compute the mmib (mean mutual information per bit) for the
      * specified MCS and SINR, according to the MIESM method
      *
+     * The MI map of the modulation is selected once, and the RBs are mapped in
+     * batches.
+     *
      * \param sinr the perceived SINRs in the whole bandwidth
      * \param map the actives RBs for the TB
      * \param mcs the MCS of the TB
@@ -158,6 +165,8 @@ class NrLteMiErrorModel : public NrErrorModel
      * \brief map the mmib (mean mutual information per bit) into CBLER for
      * the specified MCS and CB size, according to the MIESM method
      *
+     * The BLER curve is interpolated from a table, instead of evaluating erf.
+     *
      * \param mib mean mutual information per bit of a code-block
      * \param ecrId Effective Code Rate ID
      * \param cbSize the size of the CB
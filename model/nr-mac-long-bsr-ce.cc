@@ -0,0 +1,197 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-long-bsr-ce.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(NrMacLongBsrCe);
+NS_LOG_COMPONENT_DEFINE("NrMacLongBsrCe");
+
+// Table 6.1.3.1-2 TS 38.321 V15.3.0: upper bound (in bytes) of each 8-bit level
+static const std::vector<uint64_t> g_longBsrLookupVector = {
+        0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 22, 23, 25, 26, 28, 30, 32, 34, 36, 38, 40,
+        43, 46, 49, 52, 55, 59, 62, 66, 71, 75, 80, 85, 91, 97, 103, 110, 117, 124, 132, 141, 150,
+        160, 170, 181, 193, 205, 218, 233, 248, 264, 281, 299, 318, 339, 361, 384, 409, 436, 464,
+        494, 526, 560, 597, 635, 677, 720, 767, 817, 870, 926, 987, 1051, 1119, 1191, 1269, 1351,
+        1439, 1532, 1631, 1737, 1850, 1970, 2098, 2234, 2379, 2533, 2698, 2873, 3059, 3258, 3469,
+        3694, 3934, 4189, 4461, 4751, 5059, 5387, 5737, 6109, 6506, 6928, 7378, 7857, 8367, 8910,
+        9488, 10104, 10760, 11458, 12202, 12994, 13838, 14736, 15692, 16711, 17795, 18951, 20181,
+        21491, 22885, 24371, 25953, 27638, 29431, 31342, 33376, 35543, 37850, 40307, 42923, 45709,
+        48676, 51836, 55200, 58784, 62599, 66663, 70990, 75598, 80505, 85730, 91295, 97221, 103532,
+        110252, 117409, 125030, 133146, 141789, 150992, 160793, 171231, 182345, 194182, 206786,
+        220209, 234503, 249725, 265935, 283197, 301579, 321155, 342002, 364202, 387842, 413018,
+        439827, 468377, 498780, 531156, 565634, 602350, 641449, 683087, 727427, 774645, 824928,
+        878475, 935498, 996222, 1060888, 1129752, 1203085, 1281179, 1364342, 1452903, 1547213,
+        1647644, 1754595, 1868488, 1989774, 2118933, 2256475, 2402946, 2558924, 2725027, 2901912,
+        3090279, 3290873, 3504487, 3731968, 3974215, 4232186, 4506902, 4799451, 5110989, 5442750,
+        5796046, 6172275, 6572925, 6999582, 7453933, 7937777, 8453028, 9001725, 9586039, 10208280,
+        10870913, 11576557, 12328006, 13128233, 13980403, 14887889, 15854280, 16883401, 17979324,
+        19146385, 20389201, 21712690, 23122088, 24622972, 26221280, 27923336, 29735875, 31666069,
+        33721553, 35910462, 38241455, 40723756, 43367187, 46182206, 49179951, 52372284, 55771835,
+        59392055, 63247269, 67352729, 71724679, 76380419, 81338368
+};
+
+TypeId
+NrMacLongBsrCe::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrMacLongBsrCe").SetParent<Header>().AddConstructor<NrMacLongBsrCe>();
+    return tid;
+}
+
+TypeId
+NrMacLongBsrCe::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+NrMacLongBsrCe::NrMacLongBsrCe()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrMacLongBsrCe::Serialize(Buffer::Iterator start) const
+{
+    NS_LOG_FUNCTION(this);
+
+    NrMacHeaderVsUl header;
+    header.SetLcId(NrMacHeaderVsUl::LONG_BSR);
+    header.SetSize(1 + GetNumReportedLcg());
+
+    header.Serialize(start);
+    start.Next(header.GetSerializedSize());
+
+    uint8_t bitmap = 0;
+    for (uint8_t lcg = 0; lcg < MAX_LCG; ++lcg)
+    {
+        NS_ASSERT(m_bufferSizeLevel[lcg] <= 254);
+        if (m_bufferSizeLevel[lcg] > 0)
+        {
+            bitmap |= (1 << lcg);
+        }
+    }
+    start.WriteU8(bitmap);
+
+    for (uint8_t lcg = 0; lcg < MAX_LCG; ++lcg)
+    {
+        if (m_bufferSizeLevel[lcg] > 0)
+        {
+            start.WriteU8(m_bufferSizeLevel[lcg]);
+        }
+    }
+}
+
+uint32_t
+NrMacLongBsrCe::Deserialize(Buffer::Iterator start)
+{
+    NS_LOG_FUNCTION(this);
+
+    NrMacHeaderVsUl header;
+    auto readBytes = header.Deserialize(start);
+    start.Next(readBytes);
+    NS_ASSERT(header.GetLcId() == NrMacHeaderVsUl::LONG_BSR);
+
+    uint8_t bitmap = start.ReadU8();
+    for (uint8_t lcg = 0; lcg < MAX_LCG; ++lcg)
+    {
+        m_bufferSizeLevel[lcg] = (bitmap & (1 << lcg)) ? start.ReadU8() : 0;
+    }
+
+    NS_ASSERT(header.GetSize() == 1 + GetNumReportedLcg());
+
+    return GetSerializedSize();
+}
+
+uint32_t
+NrMacLongBsrCe::GetSerializedSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return GetSerializedSizeFor(GetNumReportedLcg());
+}
+
+void
+NrMacLongBsrCe::Print(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    for (uint8_t lcg = 0; lcg < MAX_LCG; ++lcg)
+    {
+        os << "LCG" << +lcg << ": " << +m_bufferSizeLevel[lcg] << " ";
+    }
+}
+
+bool
+NrMacLongBsrCe::operator==(const NrMacLongBsrCe& o) const
+{
+    return m_bufferSizeLevel == o.m_bufferSizeLevel;
+}
+
+uint8_t
+NrMacLongBsrCe::GetNumReportedLcg() const
+{
+    uint8_t num = 0;
+    for (const auto& level : m_bufferSizeLevel)
+    {
+        if (level > 0)
+        {
+            ++num;
+        }
+    }
+    return num;
+}
+
+uint32_t
+NrMacLongBsrCe::GetSerializedSizeFor(uint8_t numLcg)
+{
+    NS_ASSERT(numLcg <= MAX_LCG);
+    // The L field fits in one byte (at most 1 + 8 bytes follow), so the
+    // subheader is always 2 bytes long. Then, the bitmap and one byte per LCG.
+    return 2 + 1 + numLcg;
+}
+
+uint8_t
+NrMacLongBsrCe::FromBytesToLevel(uint64_t bufferSize)
+{
+    NS_ASSERT(g_longBsrLookupVector.size() == 254);
+
+    uint8_t index = 0;
+    if (bufferSize > g_longBsrLookupVector.back())
+    {
+        index = 254;
+    }
+    else if (bufferSize > 0)
+    {
+        auto it = std::lower_bound(g_longBsrLookupVector.begin(),
+                                   g_longBsrLookupVector.end(),
+                                   bufferSize);
+        index = static_cast<uint8_t>(std::distance(g_longBsrLookupVector.begin(), it));
+    }
+
+    NS_ASSERT(index <= 254);
+
+    return index;
+}
+
+uint64_t
+NrMacLongBsrCe::FromLevelToBytes(uint8_t bufferLevel)
+{
+    if (bufferLevel > g_longBsrLookupVector.size() - 1)
+    {
+        // The value is > 81338368. As in the short BSR, we cannot return
+        // exactly the last value of the table, so we return something big...
+        return g_longBsrLookupVector.back() * 2;
+    }
+
+    return g_longBsrLookupVector[bufferLevel];
+}
+
+} // namespace ns3
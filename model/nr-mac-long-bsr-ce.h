@@ -0,0 +1,135 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_MAC_LONG_BSR_CE_H
+#define NR_MAC_LONG_BSR_CE_H
+
+#include "nr-mac-header-vs-ul.h"
+
+#include "ns3/packet.h"
+
+#include <array>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ue-mac
+ * \ingroup gnb-mac
+ * \brief Long BSR control element
+ *
+ * This is the long BSR control element, meant to be written after a
+ * variable-size subHeader (LCID 62), within a NR subPDU. Differently from
+ * NrMacShortBsrCe, it follows the standard format: the first octet is a
+ * bitmap that indicates which LCG is reporting a buffer, and then follows
+ * one octet for each LCG that has the bit set, in increasing LCG order.
+ *
+ * The serialization looks like the following:
+ *
+ * \verbatim
+ +-----+-----+-----+-----+-----+-----+-----+-----+
+ | LCG7| LCG6| LCG5| LCG4| LCG3| LCG2| LCG1| LCG0|   Oct 1
+ +-----+-----+-----+-----+-----+-----+-----+-----+
+ |               Buffer Size 1                   |   Oct 2
+ +-----------------------------------------------+
+ |                    ...                        |
+ +-----------------------------------------------+
+ |               Buffer Size m                   |   Oct m+1
+ +-----------------------------------------------+
+\endverbatim
+ *
+ * The buffer size is expressed with the 8-bit levels of Table 6.1.3.1-2 of
+ * TS 38.321. Please use the conversion function to write or read them.
+ * An LCG with a buffer level of 0 is not included in the serialization, so
+ * that after a Deserialize its level will be read as 0.
+ *
+ * Please refer to TS 38.321 section 6.1.3.1 for more information.
+ */
+class NrMacLongBsrCe : public Header
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+    /**
+     * \brief GetInstanceTypeId
+     * \return the instance type id
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrMacLongBsrCe constructor
+     */
+    NrMacLongBsrCe();
+
+    /**
+     * \brief Serialize on a buffer
+     * \param start start position
+     */
+    void Serialize(Buffer::Iterator start) const override;
+    /**
+     * \brief Deserialize from a buffer
+     * \param start start position
+     * \return the number of bytes read from the buffer
+     */
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    /**
+     * \brief Get the serialized size
+     * \return the size of the subheader, plus the bitmap, plus one byte for
+     * each LCG with a buffer level greater than zero
+     */
+    uint32_t GetSerializedSize() const override;
+    /**
+     * \brief Print the struct on a ostream
+     * \param os ostream
+     */
+    void Print(std::ostream& os) const override;
+
+    /**
+     * \brief IsEqual
+     * \param o another instance
+     * \return true if this and o are equal, false otherwise
+     */
+    bool operator==(const NrMacLongBsrCe& o) const;
+
+    /**
+     * \brief Get the number of LCG that are reported (i.e., with a level greater than 0)
+     * \return the number of LCG that will be serialized
+     */
+    uint8_t GetNumReportedLcg() const;
+
+    /**
+     * \brief Get the serialized size of a long BSR that reports a given number of LCG
+     * \param numLcg the number of LCG with data
+     * \return the size of the CE, including the subheader
+     */
+    static uint32_t GetSerializedSizeFor(uint8_t numLcg);
+
+    /**
+     * \brief Convert a bytes value into the 3GPP-standard level to write in the BSR
+     * \param bufferSize The buffer size
+     * \return a number between 0 and 254 that represents the buffer level as specified in the
+     * standard
+     */
+    static uint8_t FromBytesToLevel(uint64_t bufferSize);
+
+    /**
+     * \brief Convert a buffer level into a buffer size
+     * \param bufferLevel The buffer level
+     * \return the buffer size
+     */
+    static uint64_t FromLevelToBytes(uint8_t bufferLevel);
+
+    static const uint8_t MAX_LCG = 8; //!< Maximum number of LCG that a long BSR can report
+
+    std::array<uint8_t, MAX_LCG> m_bufferSizeLevel{}; //!< Buffer size level for each LCG
+};
+
+} // namespace ns3
+
+#endif /* NR_MAC_LONG_BSR_CE_H */
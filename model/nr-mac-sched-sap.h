@@ -155,6 +155,12 @@ class NrMacSchedSapProvider
 
     virtual void SchedSetMcs(uint32_t mcs) = 0;
 
+    /**
+     * \brief Set the number of slots that the UL allocations wait for their UL CQI
+     * \param numSlots the number of slots, from the scheduling of a slot to its UL CQI
+     */
+    virtual void SchedSetUlAllocationHorizon(uint32_t numSlots) = 0;
+
     /**
      * \brief SCHED_DL_RACH_INFO_REQ
      *
@@ -61,129 +61,99 @@ NrMacSchedulerLcQos::AssignBytesToDlLC(const std::unordered_map<uint8_t, LCGPtr>
     uint32_t bytesAssigned = 0;
     uint64_t sumErabGueanteedBitRate = 0;
 
-    std::vector<std::pair<uint8_t, uint8_t>>
-        gbrActiveLCs; // vector that stores the LCG ID and the LC ID of the gbr active LCs
-    std::vector<std::pair<uint8_t, uint8_t>>
-        restActiveLCs; // vector that stores the LCG ID and the LC ID of the rest active LCs
-
-    std::vector<std::pair<uint8_t, uint32_t>>
-        AssignedBytesToGbrLCsList; // vector that stores the LC ID with the bytes assigned for the
-                                   // case of GBR LCs
+    // The scratch lists are reused across the calls, to avoid allocating them at every slot.
+    // They are filled following the LCG/LC order, so they are already in the order in
+    // which the bytes are distributed.
+    m_gbrActiveLCs.clear();
+    m_restActiveLCs.clear();
+    m_assignedBytesToGbrLCs.clear();
 
     for (const auto& lcg : ueLCG)
     {
-        std::vector<uint8_t> ueActiveLCs = GetLCG(lcg)->GetActiveLCIds();
-        for (const auto lcId : ueActiveLCs)
+        for (const auto& [lcId, lc] : GetLCG(lcg)->GetLCs())
         {
-            if ((GetLCG(lcg)->GetLC(lcId)->m_resourceType ==
-                     LogicalChannelConfigListElement_s::QBT_DGBR ||
-                 GetLCG(lcg)->GetLC(lcId)->m_resourceType ==
-                     LogicalChannelConfigListElement_s::QBT_GBR) &&
-                GetLCG(lcg)->GetLC(lcId)->m_eRabGuaranteedBitrateDl != UINT64_MAX)
+            if (lc->GetTotalSize() == 0)
+            {
+                continue;
+            }
+            if ((lc->m_resourceType == LogicalChannelConfigListElement_s::QBT_DGBR ||
+                 lc->m_resourceType == LogicalChannelConfigListElement_s::QBT_GBR) &&
+                lc->m_eRabGuaranteedBitrateDl != UINT64_MAX)
             {
-                gbrActiveLCs.emplace_back(std::make_pair(GetLCGID(lcg), lcId));
-                sumErabGueanteedBitRate +=
-                    (GetLCG(lcg)->GetLC(lcId)->m_eRabGuaranteedBitrateDl / 8);
+                m_gbrActiveLCs.push_back({GetLCGID(lcg), lcId, lc.get()});
+                sumErabGueanteedBitRate += (lc->m_eRabGuaranteedBitrateDl / 8);
             }
-            restActiveLCs.emplace_back(std::make_pair(GetLCGID(lcg), lcId));
+            m_restActiveLCs.push_back({GetLCGID(lcg), lcId, lc.get()});
         }
     }
 
-    if (gbrActiveLCs.size() > 1 && sumErabGueanteedBitRate >= tbs)
+    if (m_gbrActiveLCs.size() > 1 && sumErabGueanteedBitRate >= tbs)
     {
         uint32_t bytesPerLcGbr;
 
         if (bytesLeftToBeAssigned > 0)
         {
-            NS_ASSERT(gbrActiveLCs.size() != 0);
-            bytesPerLcGbr = bytesLeftToBeAssigned / gbrActiveLCs.size();
+            bytesPerLcGbr = bytesLeftToBeAssigned / m_gbrActiveLCs.size();
 
-            for (const auto& lcg : ueLCG)
+            for (const auto& gbrLc : m_gbrActiveLCs)
             {
-                for (auto& itGbrActiveLCs : gbrActiveLCs)
-                {
-                    if (itGbrActiveLCs.first == GetLCGID(lcg))
-                    {
-                        AssignedBytesToGbrLCsList.emplace_back(
-                            std::make_pair(itGbrActiveLCs.second, bytesPerLcGbr));
-                    }
-                }
+                m_assignedBytesToGbrLCs.emplace_back(gbrLc.m_lcId, bytesPerLcGbr);
             }
             bytesLeftToBeAssigned = 0;
         }
     }
-    else if (gbrActiveLCs.size() > 0)
+    else if (m_gbrActiveLCs.size() > 0)
     {
-        for (const auto& lcg : ueLCG)
+        for (const auto& gbrLc : m_gbrActiveLCs)
         {
-            for (auto& itGbrActiveLCs : gbrActiveLCs)
-            {
-                if (itGbrActiveLCs.first == GetLCGID(lcg))
-                {
-                    NS_ASSERT_MSG(
-                        GetLCG(lcg)->GetLC(itGbrActiveLCs.second)->m_eRabGuaranteedBitrateDl !=
-                            UINT64_MAX,
-                        "LC is not guaranteed bit rate!");
+            NS_ASSERT_MSG(gbrLc.m_lc->m_eRabGuaranteedBitrateDl != UINT64_MAX,
+                          "LC is not guaranteed bit rate!");
 
-                    uint32_t bytes = std::min(
-                        static_cast<uint32_t>(
-                            slotPeriod.GetSeconds() *
-                            (GetLCG(lcg)->GetLC(itGbrActiveLCs.second)->m_eRabGuaranteedBitrateDl /
-                             8)),
-                        GetLCG(lcg)->GetLC(itGbrActiveLCs.second)->GetTotalSize());
+            uint32_t bytes = std::min(
+                static_cast<uint32_t>(slotPeriod.GetSeconds() *
+                                      (gbrLc.m_lc->m_eRabGuaranteedBitrateDl / 8)),
+                gbrLc.m_lc->GetTotalSize());
 
-                    bytesAssigned = bytes >= bytesLeftToBeAssigned ? bytesLeftToBeAssigned : bytes;
+            bytesAssigned = bytes >= bytesLeftToBeAssigned ? bytesLeftToBeAssigned : bytes;
 
-                    AssignedBytesToGbrLCsList.emplace_back(
-                        std::make_pair(itGbrActiveLCs.second, bytesAssigned));
+            m_assignedBytesToGbrLCs.emplace_back(gbrLc.m_lcId, bytesAssigned);
 
-                    NS_ASSERT(bytesLeftToBeAssigned >= bytesAssigned); // check
-                    bytesLeftToBeAssigned -= bytesAssigned;
-                }
-            }
+            NS_ASSERT(bytesLeftToBeAssigned >= bytesAssigned); // check
+            bytesLeftToBeAssigned -= bytesAssigned;
         }
     }
 
+    ret.reserve(m_restActiveLCs.size() + m_assignedBytesToGbrLCs.size());
+
     uint32_t bytesPerLc;
 
-    if (restActiveLCs.size() != 0 && bytesLeftToBeAssigned > 0)
+    if (m_restActiveLCs.size() != 0 && bytesLeftToBeAssigned > 0)
     {
-        NS_ASSERT(restActiveLCs.size() != 0);
-        bytesPerLc = bytesLeftToBeAssigned / restActiveLCs.size();
+        bytesPerLc = bytesLeftToBeAssigned / m_restActiveLCs.size();
 
-        for (const auto& lcg : ueLCG)
+        for (const auto& restLc : m_restActiveLCs)
         {
-            for (auto& itRestActiveLCs : restActiveLCs)
+            bool erabGbrTrue = false;
+
+            for (auto& gbrAssigned : m_assignedBytesToGbrLCs)
             {
-                if (itRestActiveLCs.first == GetLCGID(lcg))
+                if (gbrAssigned.first == restLc.m_lcId && restLc.m_lcg == 1)
                 {
-                    bool erabGbrTrue = false;
-
-                    for (auto it = AssignedBytesToGbrLCsList.begin();
-                         it != AssignedBytesToGbrLCsList.end();
-                         it++)
-                    {
-                        if (it->first == itRestActiveLCs.second && GetLCGID(lcg) == 1)
-                        {
-                            it->second += bytesPerLc;
-                            erabGbrTrue = true;
-                            break;
-                        }
-                    }
-
-                    if (erabGbrTrue == false)
-                    {
-                        NS_LOG_DEBUG("LC : " << +itRestActiveLCs.second
-                                             << " bytes: " << bytesPerLc);
-                        ret.emplace_back(
-                            Assignation(GetLCGID(lcg), itRestActiveLCs.second, bytesPerLc));
-                    }
+                    gbrAssigned.second += bytesPerLc;
+                    erabGbrTrue = true;
+                    break;
                 }
             }
+
+            if (erabGbrTrue == false)
+            {
+                NS_LOG_DEBUG("LC : " << +restLc.m_lcId << " bytes: " << bytesPerLc);
+                ret.emplace_back(Assignation(restLc.m_lcg, restLc.m_lcId, bytesPerLc));
+            }
         }
     }
 
-    for (auto& it : AssignedBytesToGbrLCsList)
+    for (auto& it : m_assignedBytesToGbrLCs)
     {
         NS_LOG_DEBUG("LC : " << +it.first << " bytes: " << it.second);
         ret.emplace_back(Assignation(1, it.first, it.second));
@@ -205,10 +175,9 @@ NrMacSchedulerLcQos::AssignBytesToUlLC(const std::unordered_map<uint8_t, LCGPtr>
     uint32_t activeLc = 0;
     for (const auto& lcg : ueLCG)
     {
-        std::vector<uint8_t> lcs = GetLCG(lcg)->GetLCId();
-        for (const auto& lcId : lcs)
+        for (const auto& lc : GetLCG(lcg)->GetLCs())
         {
-            if (GetLCG(lcg)->GetTotalSizeOfLC(lcId) > 0)
+            if (lc.second->GetTotalSize() > 0)
             {
                 ++activeLc;
             }
@@ -223,12 +192,12 @@ NrMacSchedulerLcQos::AssignBytesToUlLC(const std::unordered_map<uint8_t, LCGPtr>
     uint32_t amountPerLC = tbs / activeLc;
     NS_LOG_INFO("Total LC: " << activeLc << " each one will receive " << amountPerLC << " bytes");
 
+    ret.reserve(activeLc);
     for (const auto& lcg : ueLCG)
     {
-        std::vector<uint8_t> lcs = GetLCG(lcg)->GetLCId();
-        for (const auto& lcId : lcs)
+        for (const auto& [lcId, lc] : GetLCG(lcg)->GetLCs())
         {
-            if (GetLCG(lcg)->GetTotalSizeOfLC(lcId) > 0)
+            if (lc->GetTotalSize() > 0)
             {
                 NS_LOG_INFO("Assigned to LCID " << static_cast<uint32_t>(lcId) << " inside LCG "
                                                 << static_cast<uint32_t>(GetLCGID(lcg))
@@ -79,6 +79,23 @@ class NrMacSchedulerLcQos : public NrMacSchedulerLcAlgorithm
      */
     std::vector<Assignation> AssignBytesToUlLC(const std::unordered_map<uint8_t, LCGPtr>& ueLCG,
                                                uint32_t tbs) const override;
+
+  private:
+    /**
+     * \brief An active LC, with the LCG it belongs to
+     */
+    struct ActiveLc
+    {
+        uint8_t m_lcg{0};                      //!< LCG ID
+        uint8_t m_lcId{0};                     //!< LC ID
+        const NrMacSchedulerLC* m_lc{nullptr}; //!< The LC
+    };
+
+    // Scratch lists of AssignBytesToDlLC, kept to reuse their memory across the calls
+    mutable std::vector<ActiveLc> m_gbrActiveLCs;  //!< GBR LCs with a guaranteed bit rate set
+    mutable std::vector<ActiveLc> m_restActiveLCs; //!< All the active LCs
+    mutable std::vector<std::pair<uint8_t, uint32_t>>
+        m_assignedBytesToGbrLCs; //!< LC ID and bytes assigned to the GBR LCs
 };
 } // namespace ns3
 
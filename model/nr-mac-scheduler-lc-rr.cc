@@ -69,10 +69,9 @@ NrMacSchedulerLcRR::AssignBytesToLC(const std::unordered_map<uint8_t, LCGPtr>& u
     uint32_t activeLc = 0;
     for (const auto& lcg : ueLCG)
     {
-        std::vector<uint8_t> lcs = GetLCG(lcg)->GetLCId();
-        for (const auto& lcId : lcs)
+        for (const auto& lc : GetLCG(lcg)->GetLCs())
         {
-            if (GetLCG(lcg)->GetTotalSizeOfLC(lcId) > 0)
+            if (lc.second->GetTotalSize() > 0)
             {
                 ++activeLc;
             }
@@ -87,12 +86,12 @@ NrMacSchedulerLcRR::AssignBytesToLC(const std::unordered_map<uint8_t, LCGPtr>& u
     uint32_t amountPerLC = tbs / activeLc;
     NS_LOG_INFO("Total LC: " << activeLc << " each one will receive " << amountPerLC << " bytes");
 
+    ret.reserve(activeLc);
     for (const auto& lcg : ueLCG)
     {
-        std::vector<uint8_t> lcs = GetLCG(lcg)->GetLCId();
-        for (const auto& lcId : lcs)
+        for (const auto& [lcId, lc] : GetLCG(lcg)->GetLCs())
         {
-            if (GetLCG(lcg)->GetTotalSizeOfLC(lcId) > 0)
+            if (lc->GetTotalSize() > 0)
             {
                 NS_LOG_INFO("Assigned to LCID " << static_cast<uint32_t>(lcId) << " inside LCG "
                                                 << static_cast<uint32_t>(GetLCGID(lcg))
@@ -145,6 +145,12 @@ NrMacSchedulerLCG::GetActiveLCIds() const
     return ret;
 }
 
+const std::unordered_map<uint8_t, LCPtr>&
+NrMacSchedulerLCG::GetLCs() const
+{
+    return m_lcMap;
+}
+
 uint8_t
 NrMacSchedulerLCG::GetQci(uint8_t lcId) const
 {
@@ -12,6 +12,7 @@
 #include <ns3/nstime.h>
 
 #include <memory>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -180,6 +181,13 @@ class NrMacSchedulerLCG
      */
     std::vector<uint8_t> GetActiveLCIds() const;
 
+    /**
+     * \brief Get the LCs of this LCG
+     * \return the map between the LC ids and the LCs, to iterate over them without
+     * building a vector of IDs (same order of GetLCId and GetActiveLCIds)
+     */
+    const std::unordered_map<uint8_t, LCPtr>& GetLCs() const;
+
     /**
      * \brief Get the QoS Class Identifier of the flow
      * \param lcId LC ID
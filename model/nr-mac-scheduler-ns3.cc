@@ -13,9 +13,11 @@
 #include "nr-mac-scheduler-ns3.h"
 
 #include "nr-mac-scheduler-harq-rr.h"
+#include "nr-mac-long-bsr-ce.h"
 #include "nr-mac-scheduler-lc-rr.h"
 #include "nr-mac-scheduler-srs-default.h"
 #include "nr-mac-short-bsr-ce.h"
+#include "nr-profiler.h"
 
 #include <ns3/boolean.h>
 #include <ns3/eps-bearer.h>
@@ -54,6 +56,9 @@ NrMacSchedulerNs3::NrMacSchedulerNs3()
 
     // If more Srs allocators will be created, then we will add an attribute
     m_schedulerSrs = CreateObject<NrMacSchedulerSrsDefault>();
+
+    // Enlarged by the gNB PHY, with DoSchedSetUlAllocationHorizon
+    m_ulAllocationRing.Reserve(8);
 }
 
 NrMacSchedulerNs3::~NrMacSchedulerNs3()
@@ -177,6 +182,12 @@ NrMacSchedulerNs3::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&NrMacSchedulerNs3::m_ulAmc),
                           MakePointerChecker<NrAmc>())
+            .AddAttribute("FhControl",
+                          "The fronthaul control of the cell (nullptr to disable it)",
+                          PointerValue(),
+                          MakePointerAccessor(&NrMacSchedulerNs3::SetFhControl,
+                                              &NrMacSchedulerNs3::GetFhControl),
+                          MakePointerChecker<NrFhControl>())
             .AddAttribute("MaxDlMcs",
                           "Maximum MCS index for DL",
                           IntegerValue(-1),
@@ -217,6 +228,20 @@ NrMacSchedulerNs3::DoSchedSetMcs(uint32_t mcs)
     m_startMcsUl = static_cast<uint8_t>(mcs);
 }
 
+/**
+ * \brief Set the number of slots that the UL allocations wait for their UL CQI
+ * \param numSlots the number of slots, from the scheduling of a slot to its UL CQI
+ *
+ * The ring of the UL allocations holds the slots of this horizon, plus the
+ * slot that is being scheduled: it is never reduced.
+ */
+void
+NrMacSchedulerNs3::DoSchedSetUlAllocationHorizon(uint32_t numSlots)
+{
+    NS_LOG_FUNCTION(this << numSlots);
+    m_ulAllocationRing.Reserve(numSlots + 1);
+}
+
 void
 NrMacSchedulerNs3::DoSchedDlRachInfoReq(
     const NrMacSchedSapProvider::SchedDlRachInfoReqParameters& params)
@@ -430,6 +455,76 @@ NrMacSchedulerNs3::IsHarqReTxEnable() const
     return m_enableHarqReTx;
 }
 
+void
+NrMacSchedulerNs3::SetFhControl(const Ptr<NrFhControl>& fhControl)
+{
+    NS_LOG_FUNCTION(this << fhControl);
+    m_fhControl = fhControl;
+}
+
+Ptr<NrFhControl>
+NrMacSchedulerNs3::GetFhControl() const
+{
+    return m_fhControl;
+}
+
+bool
+NrMacSchedulerNs3::GetUeLinkState(uint16_t rnti, UeLinkState* state) const
+{
+    NS_LOG_FUNCTION(this << rnti);
+    auto itUe = m_ueMap.find(rnti);
+    if (itUe == m_ueMap.end())
+    {
+        return false;
+    }
+    const auto& ue = itUe->second;
+    state->m_dlMcs = ue->m_dlMcs;
+    state->m_dlWbCqi = ue->m_dlCqi.m_wbCqi;
+    state->m_dlRi = ue->m_dlCqi.m_ri;
+    state->m_dlCqiTimer = ue->m_dlCqi.m_timer;
+    state->m_ulMcs = ue->m_ulMcs;
+    state->m_ulCqi = ue->m_ulCqi.m_cqi;
+    state->m_ulCqiTimer = ue->m_ulCqi.m_timer;
+    return true;
+}
+
+bool
+NrMacSchedulerNs3::SetUeLinkState(uint16_t rnti, const UeLinkState& state)
+{
+    NS_LOG_FUNCTION(this << rnti);
+    auto itUe = m_ueMap.find(rnti);
+    if (itUe == m_ueMap.end())
+    {
+        return false;
+    }
+    NS_ABORT_MSG_IF(state.m_dlMcs.empty() || state.m_dlWbCqi.size() > state.m_dlMcs.size(),
+                    "Invalid DL link state of UE " << rnti << ": " << state.m_dlMcs.size()
+                                                   << " MCSs and " << state.m_dlWbCqi.size()
+                                                   << " CQIs");
+    const auto& ue = itUe->second;
+    if (!m_fixedMcsDl)
+    {
+        // As in NrMacSchedulerCQIManagement::DlWBCQIReported
+        ue->m_dlCqi.m_cqiType = NrMacSchedulerUeInfo::DlCqiInfo::WB;
+        ue->m_dlCqi.m_wbCqi = state.m_dlWbCqi;
+        ue->m_dlCqi.m_ri = state.m_dlRi;
+        ue->m_dlCqi.m_timer = state.m_dlCqiTimer;
+        ue->m_dlMcs = state.m_dlMcs;
+        if (ue->m_dlTbSize.size() < ue->m_dlMcs.size())
+        {
+            ue->m_dlTbSize.resize(ue->m_dlMcs.size(), 0);
+        }
+    }
+    if (!m_fixedMcsUl)
+    {
+        ue->m_ulCqi.m_cqiType = NrMacSchedulerUeInfo::CqiInfo::WB;
+        ue->m_ulCqi.m_cqi = state.m_ulCqi;
+        ue->m_ulCqi.m_timer = state.m_ulCqiTimer;
+        ue->m_ulMcs = state.m_ulMcs;
+    }
+    return true;
+}
+
 uint8_t
 NrMacSchedulerNs3::ScheduleDlHarq(PointInFTPlane* startingPoint,
                                   uint8_t symAvail,
@@ -767,9 +862,13 @@ NrMacSchedulerNs3::DoSchedDlRlcBufferReq(
  * \param bsr BSR received
  *
  * The UE notifies the buffer size as a sum of all the components. The BSR
- * is a vector of 4 uint8_t that represents the amount of data in each
- * LCG. A call to NrMacSchedulerLCG::UpdateInfo is then issued with
- * the amount of data as parameter.
+ * is a vector of uint8_t that represents the amount of data in each
+ * LCG: 4 levels of 5 bits if it comes from a SHORT_BSR (NrMacShortBsrCe),
+ * or NrMacLongBsrCe::MAX_LCG levels of 8 bits if it comes from a LONG_BSR
+ * (or from a SHORT_TRUNCATED_BSR, converted by the gNB MAC).
+ * A call to NrMacSchedulerLCG::UpdateInfo is then issued with
+ * the amount of data as parameter. A SHORT_TRUNCATED_BSR updates only the LCG
+ * it reports: the others keep their last known amount of data.
  */
 void
 NrMacSchedulerNs3::BSRReceivedFromUe(const MacCeElement& bsr)
@@ -781,11 +880,23 @@ NrMacSchedulerNs3::BSRReceivedFromUe(const MacCeElement& bsr)
     NS_ABORT_IF(itUe == m_ueMap.end());
 
     // The UE only notifies the buf size as sum of all components.
-    // see nr-ue-mac.cc:395
-    for (uint8_t lcg = 0; lcg < 4; ++lcg)
+    // see NrUeMac::SendReportBufferStatus
+    const auto& levels = bsr.m_macCeValue.m_bufferStatus;
+    bool isLongBsr = levels.size() == NrMacLongBsrCe::MAX_LCG;
+    NS_ASSERT(isLongBsr || levels.size() == 4);
+
+    const uint8_t truncatedLcg = bsr.m_macCeValue.m_truncatedLcg;
+
+    for (uint8_t lcg = 0; lcg < levels.size(); ++lcg)
     {
-        uint8_t bsrId = bsr.m_macCeValue.m_bufferStatus.at(lcg);
-        uint32_t bufSize = NrMacShortBsrCe::FromLevelToBytes(bsrId);
+        if (truncatedLcg != UINT8_MAX && lcg != truncatedLcg)
+        {
+            continue;
+        }
+
+        uint8_t bsrId = levels.at(lcg);
+        uint32_t bufSize = isLongBsr ? NrMacLongBsrCe::FromLevelToBytes(bsrId)
+                                     : NrMacShortBsrCe::FromLevelToBytes(bsrId);
 
         auto itLcg = UeInfoOf(*itUe)->m_ulLCG.find(lcg);
         if (itLcg == UeInfoOf(*itUe)->m_ulLCG.end())
@@ -884,7 +995,7 @@ NrMacSchedulerNs3::DoSchedDlCqiInfoReq(
  *
  * In UL, we have to know the previously allocated symbols and the total TBS
  * to be able to calculate CQI and MCS, so a special stack is maintained
- * (m_ulAllocationMap).
+ * (m_ulAllocationRing).
  *
  * Only UlCqiInfo::PUSCH is currently supported.
  */
@@ -916,9 +1027,9 @@ NrMacSchedulerNs3::DoSchedUlCqiInfoReq(
                                            << " modified allocation " << ulSfnSf << " sym Start "
                                            << static_cast<uint32_t>(symStart));
 
-        auto itAlloc = m_ulAllocationMap.find(ulSfnSf.GetEncoding());
-        NS_ASSERT_MSG(itAlloc != m_ulAllocationMap.end(), "Can't find allocation for " << ulSfnSf);
-        std::vector<AllocElem>& ulAllocations = itAlloc->second.m_ulAllocations;
+        SlotElem* slotAllocations = FindUlAllocations(ulSfnSf);
+        NS_ASSERT_MSG(slotAllocations != nullptr, "Can't find allocation for " << ulSfnSf);
+        std::vector<AllocElem>& ulAllocations = slotAllocations->m_ulAllocations;
 
         for (auto it = ulAllocations.cbegin(); it != ulAllocations.cend(); /* NO INC */)
         {
@@ -951,7 +1062,7 @@ NrMacSchedulerNs3::DoSchedUlCqiInfoReq(
         {
             // remove obsolete info on allocation; we already processed all the CQI
             NS_LOG_INFO("Removing allocation for " << ulSfnSf);
-            m_ulAllocationMap.erase(itAlloc);
+            ReleaseUlAllocations(ulSfnSf);
         }
     }
     break;
@@ -1328,6 +1439,113 @@ NrMacSchedulerNs3::ComputeActiveUe(ActiveUeMap* activeUe,
     }
 }
 
+uint64_t
+NrMacSchedulerNs3::GetDlFhBits(const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo) const
+{
+    const auto numRbSym = static_cast<uint32_t>(ueInfo->m_dlRBG * GetNumRbPerRbg());
+    uint64_t bits = 0;
+    for (std::size_t stream = 0; stream < ueInfo->m_dlTbSize.size(); ++stream)
+    {
+        if (ueInfo->m_dlTbSize.at(stream) > 0)
+        {
+            const uint8_t qm = m_dlAmc->GetModulationOrder(ueInfo->m_dlMcs.at(stream));
+            bits += m_fhControl->GetAllocationBits(numRbSym, qm, 1);
+        }
+    }
+    return bits;
+}
+
+uint64_t
+NrMacSchedulerNs3::GetDlFhBits(const DciInfoElementTdma& dci) const
+{
+    const auto numRbg = std::count(dci.m_rbgBitmask.begin(), dci.m_rbgBitmask.end(), 1);
+    const auto numRbSym = static_cast<uint32_t>(numRbg * GetNumRbPerRbg() * dci.m_numSym);
+    uint64_t bits = 0;
+    for (std::size_t stream = 0; stream < dci.m_tbSize.size(); ++stream)
+    {
+        if (dci.m_tbSize.at(stream) > 0)
+        {
+            const uint8_t qm = m_dlAmc->GetModulationOrder(dci.m_mcs.at(stream));
+            bits += m_fhControl->GetAllocationBits(numRbSym, qm, 1);
+        }
+    }
+    return bits;
+}
+
+/**
+ * \brief Fit the new DL data of a UE in the fronthaul capacity of the slot
+ * \param ueInfo the UE, whose MCS, RBGs and TB sizes may be reduced
+ * \param maxSym the symbols assigned to the beam of the UE
+ * \return true if the UE can be scheduled, false if it has to be dropped
+ *
+ * Each stream is a layer on the fronthaul. The MCS is lowered only while
+ * it lowers the modulation order, as the lower MCSs with the same modulation
+ * order would only reduce the TB size. The RBGs are reduced by the step
+ * of the subclass (GetDlRbgGranularity), down to a single step. The RBGs
+ * released are not assigned to other UEs.
+ */
+bool
+NrMacSchedulerNs3::FitDlFhCapacity(const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+                                   uint32_t maxSym) const
+{
+    NS_LOG_FUNCTION(this << ueInfo->m_rnti << maxSym);
+    const uint64_t availableBits = m_fhControl->GetAvailableBits();
+    if (m_fhControl->GetControlMethod() == NrFhControl::NONE ||
+        GetDlFhBits(ueInfo) <= availableBits)
+    {
+        return true;
+    }
+    if (m_fhControl->GetControlMethod() == NrFhControl::DROPPING)
+    {
+        return false;
+    }
+
+    auto updateTbSize = [this, &ueInfo]() {
+        for (std::size_t stream = 0; stream < ueInfo->m_dlTbSize.size(); ++stream)
+        {
+            if (ueInfo->m_dlTbSize.at(stream) > 0)
+            {
+                ueInfo->m_dlTbSize.at(stream) =
+                    m_dlAmc->CalculateTbSize(ueInfo->m_dlMcs.at(stream),
+                                             ueInfo->m_dlRBG * GetNumRbPerRbg());
+            }
+        }
+    };
+
+    if (m_fhControl->GetControlMethod() == NrFhControl::OPTIMIZE_MCS &&
+        m_fhControl->DependsOnModulation())
+    {
+        const uint8_t minQm = m_dlAmc->GetModulationOrder(0);
+        bool lowered = true;
+        while (lowered && GetDlFhBits(ueInfo) > availableBits)
+        {
+            lowered = false;
+            for (std::size_t stream = 0; stream < ueInfo->m_dlTbSize.size(); ++stream)
+            {
+                uint8_t& mcs = ueInfo->m_dlMcs.at(stream);
+                if (ueInfo->m_dlTbSize.at(stream) > 0 &&
+                    m_dlAmc->GetModulationOrder(mcs) > minQm)
+                {
+                    --mcs;
+                    lowered = true;
+                }
+            }
+        }
+        NS_LOG_DEBUG("FH control lowered the DL MCS of UE " << ueInfo->m_rnti);
+    }
+
+    const uint32_t step = GetDlRbgGranularity(maxSym);
+    while (ueInfo->m_dlRBG > step && GetDlFhBits(ueInfo) > availableBits)
+    {
+        ueInfo->m_dlRBG -= step;
+    }
+    updateTbSize();
+    NS_LOG_DEBUG("FH control reduced the DL RBG of UE " << ueInfo->m_rnti << " to "
+                                                        << ueInfo->m_dlRBG);
+
+    return GetDlFhBits(ueInfo) <= availableBits;
+}
+
 /**
  * \brief Scheduling new DL data
  * \param spoint Starting point of the blocks to add to the allocation list
@@ -1401,8 +1619,32 @@ NrMacSchedulerNs3::DoScheduleDlData(PointInFTPlane* spoint,
                 continue;
             }
 
-            std::shared_ptr<DciInfoElementTdma> dci =
-                CreateDlDci(spoint, ue.first, symPerBeam.at(GetBeam(beam)));
+            std::shared_ptr<DciInfoElementTdma> dci;
+            if (m_fhControl == nullptr)
+            {
+                dci = CreateDlDci(spoint, ue.first, symPerBeam.at(GetBeam(beam)));
+            }
+            else
+            {
+                // The MCS is lowered only for this slot
+                const std::vector<uint8_t> dlMcs = ue.first->m_dlMcs;
+                const uint64_t requestedBits = GetDlFhBits(ue.first);
+                if (FitDlFhCapacity(ue.first, symPerBeam.at(GetBeam(beam))))
+                {
+                    if (GetDlFhBits(ue.first) < requestedBits)
+                    {
+                        // The metrics were updated with the TB sizes before the fit
+                        ue.first->UpdateDlMetricAfterReduction();
+                    }
+                    dci = CreateDlDci(spoint, ue.first, symPerBeam.at(GetBeam(beam)));
+                }
+                else
+                {
+                    NS_LOG_INFO("UE " << ue.first->m_rnti << " does not fit in the FH capacity");
+                }
+                m_fhControl->AddAllocation(requestedBits, dci ? GetDlFhBits(*dci) : 0);
+                ue.first->m_dlMcs = dlMcs;
+            }
             if (dci == nullptr)
             {
                 // By continuing to the next UE means that we are
@@ -1812,21 +2054,14 @@ NrMacSchedulerNs3::ScheduleDl(const NrMacSchedSapProvider::SchedDlTriggerReqPara
                               const std::vector<DlHarqInfo>& dlHarqFeedback)
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::SCHEDULER_DL);
     NS_LOG_INFO("Scheduling invoked for slot " << params.m_snfSf << " of type "
                                                << params.m_slotType);
 
     NrMacSchedSapUser::SchedConfigIndParameters dlSlot(params.m_snfSf);
     dlSlot.m_slotAllocInfo.m_sfnSf = params.m_snfSf;
     dlSlot.m_slotAllocInfo.m_type = SlotAllocInfo::DL;
-    auto ulAllocationIt =
-        m_ulAllocationMap.find(params.m_snfSf.GetEncoding()); // UL allocations for this slot
-    if (ulAllocationIt == m_ulAllocationMap.end())
-    {
-        ulAllocationIt =
-            m_ulAllocationMap.insert(std::make_pair(params.m_snfSf.GetEncoding(), SlotElem(0)))
-                .first;
-    }
-    auto& ulAllocations = ulAllocationIt->second;
+    auto& ulAllocations = GetUlAllocations(params.m_snfSf); // UL allocations for this slot
 
     // add slot for DL control, at symbol 0
     PrependCtrlSym(0,
@@ -1874,19 +2109,19 @@ NrMacSchedulerNs3::ScheduleDl(const NrMacSchedSapProvider::SchedDlTriggerReqPara
                  ulAllocations,
                  &dlSlot.m_slotAllocInfo);
 
-    // if the number of allocated symbols is greater than GetUlCtrlSymbols (), then don't delete
-    // the allocation, as it will be removed when the CQI will be processed.
-    // Otherwise, delete the allocation history for the slot.
-    if (ulAllocations.m_totUlSym <= GetUlCtrlSyms())
+    // if there are UL data allocations in the slot, then don't delete them, as they
+    // will be removed when the CQI will be processed. Otherwise, no CQI will arrive
+    // for the slot: delete the allocation history for the slot.
+    if (ulAllocations.m_ulAllocations.empty())
     {
         NS_LOG_INFO("Removing UL allocation for slot " << params.m_snfSf << " size "
-                                                       << m_ulAllocationMap.size());
-        m_ulAllocationMap.erase(ulAllocationIt);
+                                                       << m_ulAllocationRing.GetSize());
+        ReleaseUlAllocations(params.m_snfSf);
     }
 
     NS_LOG_INFO("Total DCI for DL : " << dlSlot.m_slotAllocInfo.m_varTtiAllocInfo.size()
                                       << " including DL CTRL");
-    m_macSchedSapUser->SchedConfigInd(dlSlot);
+    SendSchedConfigInd(std::move(dlSlot));
 }
 
 /**
@@ -1930,6 +2165,7 @@ NrMacSchedulerNs3::ScheduleUl(const NrMacSchedSapProvider::SchedUlTriggerReqPara
                               const std::vector<UlHarqInfo>& ulHarqFeedback)
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::SCHEDULER_UL);
     NS_LOG_INFO("Scheduling invoked for slot " << params.m_snfSf);
 
     NrMacSchedSapUser::SchedConfigIndParameters ulSlot(params.m_snfSf);
@@ -1948,7 +2184,7 @@ NrMacSchedulerNs3::ScheduleUl(const NrMacSchedSapProvider::SchedUlTriggerReqPara
 
     NS_LOG_INFO("Total DCI for UL : " << ulSlot.m_slotAllocInfo.m_varTtiAllocInfo.size()
                                       << " including UL CTRL");
-    m_macSchedSapUser->SchedConfigInd(ulSlot);
+    SendSchedConfigInd(std::move(ulSlot));
 }
 
 /**
@@ -1980,7 +2216,7 @@ NrMacSchedulerNs3::ScheduleUl(const NrMacSchedSapProvider::SchedUlTriggerReqPara
  * have been selected by the function ComputeActiveUe and the ones that does not
  * have already a grant for HARQ (or SR).
  *
- * If any assignation is made, then the member variable m_ulAllocationMap (SlotElem)
+ * If any assignation is made, then the member variable m_ulAllocationRing (SlotElem)
  * is updated by storing the total UL symbols used in this slot, and
  * the details of each assignation, which include TBS, symStart, numSym, and
  * MCS. The assignations are stored as a list of AllocElem.
@@ -2013,8 +2249,8 @@ NrMacSchedulerNs3::DoScheduleUl(const std::vector<UlHarqInfo>& ulHarqFeedback,
     PointInFTPlane ulAssignationStartPoint(0, lastSym);
     uint8_t ulSymAvail = dataSymPerSlot;
 
-    // Create the UL allocation map entry
-    m_ulAllocationMap.emplace(ulSfn.GetEncoding(), SlotElem(0));
+    // Create the UL allocation entry
+    GetUlAllocations(ulSfn);
 
     if ((m_enableSrsInFSlots == true && type == LteNrTddSlotType::F) ||
         (m_enableSrsInUlSlots == true && type == LteNrTddSlotType::UL))
@@ -2105,8 +2341,9 @@ NrMacSchedulerNs3::DoScheduleUl(const std::vector<UlHarqInfo>& ulHarqFeedback,
     std::vector<uint32_t> symToAl;
     symToAl.resize(15, 0);
 
-    auto& totUlSym = m_ulAllocationMap.at(ulSfn.GetEncoding()).m_totUlSym;
-    auto& allocations = m_ulAllocationMap.at(ulSfn.GetEncoding()).m_ulAllocations;
+    SlotElem& slotAllocations = GetUlAllocations(ulSfn);
+    auto& totUlSym = slotAllocations.m_totUlSym;
+    auto& allocations = slotAllocations.m_ulAllocations;
     for (const auto& alloc : allocInfo->m_varTtiAllocInfo)
     {
         if (alloc.m_dci->m_format == DciInfoElementTdma::UL)
@@ -2149,11 +2386,40 @@ NrMacSchedulerNs3::DoScheduleUl(const std::vector<UlHarqInfo>& ulHarqFeedback,
                                 << static_cast<uint32_t>(totUlSym) << " symbols and "
                                 << allocations.size() << " data allocations, with a total of "
                                 << allocInfo->m_varTtiAllocInfo.size());
-    NS_ASSERT(m_ulAllocationMap.at(ulSfn.GetEncoding()).m_totUlSym == totUlSym);
+    NS_ASSERT(FindUlAllocations(ulSfn)->m_totUlSym == totUlSym);
+
+    // Without data allocations, no UL CQI will arrive for the slot. The UL symbols
+    // of a F slot are still needed by its DL scheduling, that comes later and
+    // releases them; the other slots are released here.
+    if (allocations.empty() && type != LteNrTddSlotType::F)
+    {
+        NS_LOG_INFO("Removing UL allocation for slot " << ulSfn << " without data");
+        ReleaseUlAllocations(ulSfn);
+    }
 
     return dataSymPerSlot - ulSymAvail;
 }
 
+NrMacSchedulerNs3::SlotElem*
+NrMacSchedulerNs3::FindUlAllocations(const SfnSf& sfn)
+{
+    return m_ulAllocationRing.Find(sfn);
+}
+
+NrMacSchedulerNs3::SlotElem&
+NrMacSchedulerNs3::GetUlAllocations(const SfnSf& sfn)
+{
+    return m_ulAllocationRing.Get(sfn, uint8_t{0});
+}
+
+void
+NrMacSchedulerNs3::ReleaseUlAllocations(const SfnSf& sfn)
+{
+    SlotElem& elem = m_ulAllocationRing.Release(sfn);
+    elem.m_totUlSym = 0;
+    elem.m_ulAllocations.clear(); // keeps the capacity
+}
+
 uint8_t
 NrMacSchedulerNs3::DoScheduleSrs(PointInFTPlane* spoint, SlotAllocInfo* allocInfo)
 {
@@ -2300,6 +2566,11 @@ NrMacSchedulerNs3::DoScheduleDl(const std::vector<DlHarqInfo>& dlHarqFeedback,
                  << " sym available: " << static_cast<uint32_t>(dlSymAvail) << " starting from sym "
                  << static_cast<uint32_t>(m_dlCtrlSymbols));
 
+    if (m_fhControl != nullptr)
+    {
+        m_fhControl->StartSlot(dlSfnSf, m_macSchedSapUser->GetSlotPeriod());
+    }
+
     if (activeDlHarq.size() > 0)
     {
         uint8_t usedHarq = ScheduleDlHarq(&dlAssignationStartPoint,
@@ -2313,6 +2584,20 @@ NrMacSchedulerNs3::DoScheduleDl(const std::vector<DlHarqInfo>& dlHarqFeedback,
         dlSymAvail -= usedHarq;
     }
 
+    if (m_fhControl != nullptr)
+    {
+        // The retransmissions are not reduced, but they use the FH capacity
+        for (const auto& alloc : allocInfo->m_varTtiAllocInfo)
+        {
+            if (alloc.m_dci->m_type == DciInfoElementTdma::DATA &&
+                alloc.m_dci->m_format == DciInfoElementTdma::DL)
+            {
+                const uint64_t bits = GetDlFhBits(*alloc.m_dci);
+                m_fhControl->AddAllocation(bits, bits);
+            }
+        }
+    }
+
     GetSecond GetUeInfoList;
 
     for (const auto& alloc : allocInfo->m_varTtiAllocInfo)
@@ -2358,6 +2643,11 @@ NrMacSchedulerNs3::DoScheduleDl(const std::vector<DlHarqInfo>& dlHarqFeedback,
         dlSymAvail -= usedDl;
     }
 
+    if (m_fhControl != nullptr)
+    {
+        m_fhControl->EndSlot();
+    }
+
     return (dataSymPerSlot - ulAllocations.m_totUlSym) - dlSymAvail;
 }
 
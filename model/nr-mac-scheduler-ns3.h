@@ -7,12 +7,14 @@
 #pragma once
 
 #include "nr-amc.h"
+#include "nr-fh-control.h"
 #include "nr-mac-harq-vector.h"
 #include "nr-mac-scheduler-cqi-management.h"
 #include "nr-mac-scheduler-lcg.h"
 #include "nr-mac-scheduler-ue-info.h"
 #include "nr-mac-scheduler.h"
 #include "nr-phy-mac-common.h"
+#include "nr-slot-ring.h"
 
 #include <functional>
 #include <list>
@@ -22,6 +24,7 @@ namespace ns3
 {
 
 class NrSchedGeneralTestCase;
+class NrMacSchedulerUlAllocationRingTestCase;
 class NrMacSchedulerHarqRr;
 class NrMacSchedulerSrsDefault;
 class NrMacSchedulerLcAlgorithm;
@@ -330,6 +333,7 @@ class NrMacSchedulerNs3 : public NrMacScheduler
     void DoSchedUlSrInfoReq(
         const NrMacSchedSapProvider::SchedUlSrInfoReqParameters& params) override;
     void DoSchedSetMcs(uint32_t mcs) override;
+    void DoSchedSetUlAllocationHorizon(uint32_t numSlots) override;
     void DoSchedDlRachInfoReq(
         const NrMacSchedSapProvider::SchedDlRachInfoReqParameters& params) override;
     uint8_t GetDlCtrlSyms() const override;
@@ -534,6 +538,61 @@ class NrMacSchedulerNs3 : public NrMacScheduler
      */
     bool IsHarqReTxEnable() const;
 
+    /**
+     * \brief Set the fronthaul control of the cell
+     *
+     * With a fronthaul control, the scheduler measures the fronthaul load of
+     * the DL allocations and, depending on its FhControlMethod, fits the new
+     * DL data allocations in the fronthaul capacity of the slot.
+     *
+     * \param fhControl the fronthaul control, or nullptr to disable it
+     */
+    void SetFhControl(const Ptr<NrFhControl>& fhControl);
+
+    /**
+     * \brief Get the fronthaul control of the cell
+     * \return the fronthaul control, or nullptr if it is disabled
+     */
+    Ptr<NrFhControl> GetFhControl() const;
+
+    /**
+     * \brief The link adaptation state of a UE, that can be saved at the end of
+     * the warm-up of a simulation, and restored in another one
+     */
+    struct UeLinkState
+    {
+        std::vector<uint8_t> m_dlMcs;   //!< DL MCS per stream
+        std::vector<uint8_t> m_dlWbCqi; //!< DL wide-band CQI per stream (empty without CQI)
+        uint8_t m_dlRi{0};              //!< DL rank indicator
+        uint32_t m_dlCqiTimer{0};       //!< Slots before the DL CQI expires
+        uint8_t m_ulMcs{0};             //!< UL MCS
+        uint8_t m_ulCqi{0};             //!< UL CQI
+        uint32_t m_ulCqiTimer{0};       //!< Slots before the UL CQI expires
+    };
+
+    /**
+     * \brief Get the link adaptation state of a UE
+     * \param rnti the RNTI of the UE
+     * \param state the state to fill
+     * \return false if the UE is not known by the scheduler
+     */
+    bool GetUeLinkState(uint16_t rnti, UeLinkState* state) const;
+
+    /**
+     * \brief Restore the link adaptation state of a UE
+     *
+     * The MCSs are restored with the CQIs they were computed from and the
+     * timers of the CQIs, so that they are not reset to the starting MCSs
+     * before the timers expire. As in the saved simulation, the next CQI of the
+     * UE replaces them. The fixed MCSs (attributes FixedMcsDl and FixedMcsUl)
+     * are not changed.
+     *
+     * \param rnti the RNTI of the UE
+     * \param state the state to restore
+     * \return false if the UE is not known by the scheduler
+     */
+    bool SetUeLinkState(uint16_t rnti, const UeLinkState& state);
+
   protected:
     /**
      * \brief Create an UE representation for the scheduler.
@@ -651,6 +710,17 @@ class NrMacSchedulerNs3 : public NrMacScheduler
         const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
         uint32_t maxSym) const = 0;
 
+    /**
+     * \brief Get the step by which the DL RBGs of a UE can be reduced
+     * \param maxSym the symbols assigned to the beam of the UE
+     * \return the step, in the unit of NrMacSchedulerUeInfo::m_dlRBG
+     *
+     * The fronthaul control reduces the DL RBGs of a UE, assigned by AssignDLRBG,
+     * to fit the allocation in the fronthaul capacity. The result must still be
+     * a valid input for CreateDlDci.
+     */
+    virtual uint32_t GetDlRbgGranularity(uint32_t maxSym) const = 0;
+
     /**
      * \brief Perform a custom operation on the starting point each time all the UE of a DL beam
      * have been scheduled \param spoint starting point for the next beam to modify \param symOfBeam
@@ -833,6 +903,53 @@ class NrMacSchedulerNs3 : public NrMacScheduler
                          LteNrTddSlotType type);
     uint8_t DoScheduleSrs(PointInFTPlane* spoint, SlotAllocInfo* allocInfo);
 
+    /**
+     * \brief Find the UL allocations of a slot
+     * \param sfn the slot
+     * \return the UL allocations of the slot, or nullptr if they are not stored
+     */
+    SlotElem* FindUlAllocations(const SfnSf& sfn);
+
+    /**
+     * \brief Get the UL allocations of a slot, storing empty ones if there are none
+     * \param sfn the slot
+     * \return the UL allocations of the slot
+     *
+     * The allocations are kept until their UL CQI arrives: the ring holds the
+     * slots of the horizon given by DoSchedSetUlAllocationHorizon, and aborts
+     * if the position of the slot is taken by the allocations of another slot.
+     */
+    SlotElem& GetUlAllocations(const SfnSf& sfn);
+
+    /**
+     * \brief Release the UL allocations of a slot, keeping their storage
+     * \param sfn the slot
+     */
+    void ReleaseUlAllocations(const SfnSf& sfn);
+
+    /**
+     * \brief Get the fronthaul bits of the new DL data of a UE
+     * \param ueInfo the UE, with its RBGs, MCS and TB sizes for the slot
+     * \return the fronthaul bits of the streams with data
+     */
+    uint64_t GetDlFhBits(const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo) const;
+
+    /**
+     * \brief Get the fronthaul bits of a DL DCI
+     * \param dci the DCI
+     * \return the fronthaul bits of the streams with data
+     */
+    uint64_t GetDlFhBits(const DciInfoElementTdma& dci) const;
+
+    /**
+     * \brief Fit the new DL data of a UE in the fronthaul capacity of the slot
+     * \param ueInfo the UE, whose MCS, RBGs and TB sizes may be reduced
+     * \param maxSym the symbols assigned to the beam of the UE
+     * \return true if the UE can be scheduled, false if it has to be dropped
+     */
+    bool FitDlFhCapacity(const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+                         uint32_t maxSym) const;
+
     static const unsigned m_macHdrSize = 0; //!< Mac Header size
     static const uint32_t m_subHdrSize = 4; //!< Sub Header size (?)
     static const unsigned m_rlcHdrSize = 3; //!< RLC Header size
@@ -860,10 +977,10 @@ class NrMacSchedulerNs3 : public NrMacScheduler
         m_ueMap; //!< The map of between RNTI and their data
 
     /**
-     * Map of previous allocated UE per RBG
-     * (used to retrieve info from UL-CQI)
+     * Previous UL allocations (used to retrieve info from UL-CQI), in a ring
+     * indexed by the slot number
      */
-    std::map<uint64_t, SlotElem> m_ulAllocationMap;
+    NrSlotRing<SlotElem> m_ulAllocationRing;
 
     bool m_fixedMcsDl{false};  //!< Fixed MCS for *all* UE in DL
     bool m_fixedMcsUl{false};  //!< Fixed MCS for *all* UE in UL
@@ -903,8 +1020,11 @@ class NrMacSchedulerNs3 : public NrMacScheduler
     uint32_t m_srsSlotCounter{0}; //!< Counter for UL slots
 
     friend NrSchedGeneralTestCase;
+    friend NrMacSchedulerUlAllocationRingTestCase;
 
     bool m_enableHarqReTx{true}; //!< Flag to enable or disable HARQ ReTx (attribute)
+
+    Ptr<NrFhControl> m_fhControl; //!< Fronthaul control of the cell, if any (attribute)
 };
 
 } // namespace ns3
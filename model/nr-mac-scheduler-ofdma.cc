@@ -12,6 +12,8 @@
 
 #include "nr-mac-scheduler-ofdma.h"
 
+#include "nr-parallel-slot-executor.h"
+
 #include <ns3/log.h>
 
 #include <algorithm>
@@ -113,10 +115,13 @@ NrMacSchedulerOfdma::GetSymPerBeam(uint32_t symAvail,
     }
 
     // Trigger the trace source firing, using const_cast as we don't change
-    // the internal state of the class
+    // the internal state of the class. With a slot executor, it is fired at
+    // the commit of the slot
+    auto self = const_cast<NrMacSchedulerOfdma*>(this);
     for (const auto& v : ret)
     {
-        const_cast<NrMacSchedulerOfdma*>(this)->m_tracedValueSymPerBeam = v.second;
+        const uint32_t sym = v.second;
+        NrParallelSlotExecutor::RunAtCommit([self, sym]() { self->m_tracedValueSymPerBeam = sym; });
     }
 
     return ret;
@@ -519,6 +524,13 @@ NrMacSchedulerOfdma::CreateDlDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
     return dci;
 }
 
+uint32_t
+NrMacSchedulerOfdma::GetDlRbgGranularity(uint32_t maxSym) const
+{
+    // The UEs of a beam get RBGs on all the symbols of the beam
+    return maxSym;
+}
+
 std::shared_ptr<DciInfoElementTdma>
 NrMacSchedulerOfdma::CreateUlDci(PointInFTPlane* spoint,
                                  const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
@@ -82,6 +82,7 @@ class NrMacSchedulerOfdma : public NrMacSchedulerTdma
         PointInFTPlane* spoint,
         const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
         uint32_t maxSym) const override;
+    uint32_t GetDlRbgGranularity(uint32_t maxSym) const override;
 
     /**
      * \brief Advance the starting point by the number of symbols specified,
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 
 namespace ns3
 {
@@ -44,6 +45,12 @@ std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>
 NrMacSchedulerTdma::GetUeVectorFromActiveUeMap(const NrMacSchedulerNs3::ActiveUeMap& activeUes)
 {
     std::vector<UePtrAndBufferReq> ueVector;
+    std::size_t numUes = 0;
+    for (const auto& el : activeUes)
+    {
+        numUes += el.second.size();
+    }
+    ueVector.reserve(numUes);
     for (const auto& el : activeUes)
     {
         uint64_t size = ueVector.size();
@@ -57,6 +64,55 @@ NrMacSchedulerTdma::GetUeVectorFromActiveUeMap(const NrMacSchedulerNs3::ActiveUe
     return ueVector;
 }
 
+void
+NrMacSchedulerTdma::RepairUeOrder(std::vector<UePtrAndBufferReq>& ueVector,
+                                  const CompareUeFn& compare)
+{
+    for (auto it = ueVector.begin(); it != ueVector.end(); ++it)
+    {
+        if (it != ueVector.begin() && compare(*it, *std::prev(it)))
+        {
+            auto pos = std::upper_bound(ueVector.begin(), it, *it, compare);
+            std::rotate(pos, it, std::next(it));
+        }
+    }
+}
+
+void
+NrMacSchedulerTdma::SortUeVector(std::vector<UePtrAndBufferReq>& ueVector,
+                                 const CompareUeFn& compare,
+                                 std::vector<UePtrAndBufferReq>& previousOrder)
+{
+    // std::sort is an insertion sort up to this number of elements (in other
+    // standard libraries, it may not be stable with any number of elements)
+#ifdef __GLIBCXX__
+    static const std::size_t INSERTION_SORT_THRESHOLD = 16;
+#else
+    static const std::size_t INSERTION_SORT_THRESHOLD = 1;
+#endif
+
+    if (ueVector.size() <= INSERTION_SORT_THRESHOLD)
+    {
+        std::sort(ueVector.begin(), ueVector.end(), compare);
+        return;
+    }
+
+    previousOrder.assign(ueVector.begin(), ueVector.end());
+    RepairUeOrder(ueVector, compare);
+
+    // Without UEs that compare equal the sorted order is unique, otherwise
+    // std::sort may give another order for them
+    for (auto it = std::next(ueVector.begin()); it != ueVector.end(); ++it)
+    {
+        if (!compare(*std::prev(it), *it))
+        {
+            ueVector.swap(previousOrder);
+            std::sort(ueVector.begin(), ueVector.end(), compare);
+            return;
+        }
+    }
+}
+
 /**
  * \brief Assign the available RBG in a TDMA fashion
  * \param symAvail Number of available symbols
@@ -89,6 +145,10 @@ NrMacSchedulerTdma::GetUeVectorFromActiveUeMap(const NrMacSchedulerNs3::ActiveUe
  * </pre>
  *
  * To sort the UEs, the method uses the function returned by GetUeCompareDlFn().
+ * The vector is sorted at each iteration, starting from the order of the
+ * previous one (the order of activeUe, in the first one), and the result is
+ * the one of std::sort. Since only the metrics of the UEs that got resources
+ * change, the sort usually moves only these UEs (see SortUeVector).
  * Two fairness helper are hard-coded in the method: the first one is avoid
  * to assign resources to UEs that already have their buffer requirement covered,
  * and the other one is avoid to assign symbols when all the UEs have their
@@ -138,13 +198,17 @@ NrMacSchedulerTdma::AssignRBGTDMA(
         BeforeSchedFn(ue, FTResources(numOfAssignableRbgs, 1));
     }
 
+    const auto compare = GetCompareFn();
+    std::vector<UePtrAndBufferReq> previousOrder;
+    previousOrder.reserve(ueVector.size());
+
     while (resources > 0)
     {
         GetFirst GetUe;
 
-        auto schedInfoIt = ueVector.begin();
+        SortUeVector(ueVector, compare, previousOrder);
 
-        std::sort(ueVector.begin(), ueVector.end(), GetCompareFn());
+        auto schedInfoIt = ueVector.begin();
 
         // Ensure fairness: pass over UEs which already has enough resources to transmit
         while (schedInfoIt != ueVector.end())
@@ -438,6 +502,15 @@ NrMacSchedulerTdma::CreateDlDci(PointInFTPlane* spoint,
     return dci;
 }
 
+uint32_t
+NrMacSchedulerTdma::GetDlRbgGranularity([[maybe_unused]] uint32_t maxSym) const
+{
+    // The UEs get all the assignable RBGs of their symbols
+    const std::vector<uint8_t> notchedRBGsMask = GetDlNotchedRbgMask();
+    int zeroes = std::count(notchedRBGsMask.begin(), notchedRBGsMask.end(), 0);
+    return GetBandwidthInRbg() - zeroes;
+}
+
 /**
  * \brief Create a UL DCI starting from spoint and spanning maxSym symbols
  * \param spoint Starting point of the DCI
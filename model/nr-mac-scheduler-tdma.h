@@ -79,6 +79,31 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
      */
     ~NrMacSchedulerTdma() override;
 
+    /**
+     * \brief Function to compare two UEs, as returned by GetUeCompareDlFn()
+     */
+    typedef std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
+                               const NrMacSchedulerNs3::UePtrAndBufferReq& rhs)>
+        CompareUeFn;
+
+    /**
+     * \brief Sort the UEs of an iteration, with the same result of std::sort
+     * \param ueVector the UEs, ordered as in the previous iteration
+     * \param compare the comparison function of the scheduler
+     * \param previousOrder a buffer, to avoid an allocation at each iteration
+     *
+     * When std::sort is an insertion sort (up to 16 UEs, in libstdc++), the
+     * vector is sorted with it. Otherwise, the UEs out of place are moved to
+     * their place (see RepairUeOrder), which gives the result of std::sort when
+     * no UEs compare equal (the sorted order is unique). If some do, the vector
+     * is sorted again with std::sort, starting from the previous order, so that
+     * the UEs with the same metric get the same order, and then the same
+     * resources, as when the vector was always sorted with std::sort.
+     */
+    static void SortUeVector(std::vector<UePtrAndBufferReq>& ueVector,
+                             const CompareUeFn& compare,
+                             std::vector<UePtrAndBufferReq>& previousOrder);
+
   protected:
     BeamSymbolMap AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl) const override;
 
@@ -91,6 +116,7 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
         PointInFTPlane* spoint,
         const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
         uint32_t maxSym) const override;
+    uint32_t GetDlRbgGranularity(uint32_t maxSym) const override;
 
     /**
      * \brief Not doing anything, moving forward the spoint is done by CreateDci
@@ -235,11 +261,24 @@ class NrMacSchedulerTdma : public NrMacSchedulerNs3
     typedef std::function<uint32_t(const UePtr& ue)> GetTBSFn;  //!< Getter for the TBS of an UE
     typedef std::function<uint8_t&(const UePtr& ue)>
         GetSymFn; //!< Getter for the number of symbols of an UE
-    typedef std::function<bool(const NrMacSchedulerNs3::UePtrAndBufferReq& lhs,
-                               const NrMacSchedulerNs3::UePtrAndBufferReq& rhs)>
-        CompareUeFn;
     typedef std::function<CompareUeFn()> GetCompareUeFn;
 
+    /**
+     * \brief Sort the UEs, keeping the previous order of the UEs that compare equal
+     * \param ueVector the UEs, ordered as in the previous iteration
+     * \param compare the comparison function of the scheduler
+     *
+     * Between two iterations only the metrics of few UEs change (the UE that got
+     * the symbol, and the UEs that got symbols in previous iterations, for
+     * schedulers whose metric depends on the total assigned resources), so the
+     * vector is almost sorted. The UEs out of place are found with a linear scan,
+     * and each one is moved with a binary search to its place, after the UEs
+     * that compare equal to it: the cost is linear in the number of UEs, instead
+     * of the O(U log U) of sorting the vector from scratch at each iteration, and
+     * the result is the one of an insertion sort (i.e., of std::stable_sort).
+     */
+    static void RepairUeOrder(std::vector<UePtrAndBufferReq>& ueVector, const CompareUeFn& compare);
+
     BeamSymbolMap AssignRBGTDMA(
         uint32_t symAvail,
         const ActiveUeMap& activeUe,
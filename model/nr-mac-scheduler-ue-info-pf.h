@@ -83,6 +83,14 @@ class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
         m_avgTputDl = m_lastAvgTputDl;
     }
 
+    /**
+     * \brief Update the DL throughputs with the reduced TB sizes
+     *
+     * It uses the symbols and the time window of the last call to
+     * UpdateDlPFMetric.
+     */
+    void UpdateDlMetricAfterReduction() override;
+
     /**
      * \brief Reset the UL avg Th to the last value
      */
@@ -199,6 +207,8 @@ class NrMacSchedulerUeInfoPF : public NrMacSchedulerUeInfo
     double m_lastAvgTputDl{0.0};   //!< Last average throughput in downlink
     double m_potentialTputDl{0.0}; //!< Potential throughput in downlink in one assignable resource
                                    //!< (can be a symbol or a RBG)
+    uint32_t m_dlTputSym{0};       //!< Symbols of the last update of the DL throughputs
+    double m_dlTimeWindow{1.0};    //!< Time window of the last update of the DL throughputs
     float m_alpha{0.0};            //!< PF fairness metric
 
     double m_currTputUl{0.0};      //!< Current slot throughput in uplink
@@ -21,6 +21,8 @@ NrMacSchedulerUeInfoQos::UpdateDlQosMetric(const NrMacSchedulerNs3::FTResources&
     NS_LOG_FUNCTION(this);
 
     NrMacSchedulerUeInfo::UpdateDlMetric(amc);
+    m_dlTputSym = totAssigned.m_sym;
+    m_dlTimeWindow = timeWindow;
     uint32_t tbSize = 0;
     for (const auto& it : m_dlTbSize)
     {
@@ -38,6 +40,24 @@ NrMacSchedulerUeInfoQos::UpdateDlQosMetric(const NrMacSchedulerNs3::FTResources&
                  << " updated DL metric: " << m_potentialTputDl / std::max(1E-9, m_avgTputDl));
 }
 
+void
+NrMacSchedulerUeInfoQos::UpdateDlMetricAfterReduction()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t tbSize = 0;
+    for (const auto& it : m_dlTbSize)
+    {
+        tbSize += it;
+    }
+    m_currTputDl = static_cast<double>(tbSize) / m_dlTputSym;
+    m_avgTputDl = ((1.0 - (1.0 / m_dlTimeWindow)) * m_lastAvgTputDl) +
+                  ((1.0 / m_dlTimeWindow) * m_currTputDl);
+
+    NS_LOG_DEBUG("Reduced DL TBS of UE " << m_rnti << ": " << tbSize << " Updated currTputDl "
+                                         << m_currTputDl << " avgTputDl " << m_avgTputDl);
+}
+
 void
 NrMacSchedulerUeInfoQos::UpdateUlQosMetric(const NrMacSchedulerNs3::FTResources& totAssigned,
                                            double timeWindow,
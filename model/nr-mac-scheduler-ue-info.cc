@@ -231,6 +231,11 @@ NrMacSchedulerUeInfo::ResetDlMetric()
     }
 }
 
+void
+NrMacSchedulerUeInfo::UpdateDlMetricAfterReduction()
+{
+}
+
 void
 NrMacSchedulerUeInfo::UpdateUlMetric(const Ptr<const NrAmc>& amc)
 {
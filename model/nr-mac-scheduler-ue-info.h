@@ -202,6 +202,15 @@ class NrMacSchedulerUeInfo
      */
     virtual void ResetDlMetric();
 
+    /**
+     * \brief Update the DL metrics after the TB sizes have been reduced
+     *
+     * Called when the scheduler reduces the MCS or the RBGs of the UE (and
+     * m_dlTbSize with them) after the metrics have been updated, e.g., to fit
+     * the new data in the fronthaul capacity. By default, it does nothing.
+     */
+    virtual void UpdateDlMetricAfterReduction();
+
     /**
      * \brief Update UL metrics after resources have been assigned
      *
@@ -32,31 +32,41 @@ class NrMacGeneralCschedSapProvider : public NrMacCschedSapProvider
     void CschedCellConfigReq(
         const NrMacCschedSapProvider::CschedCellConfigReqParameters& params) override
     {
-        m_scheduler->DoCschedCellConfigReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoCschedCellConfigReq,
+                              params,
+                              NrMacScheduler::MAIN_THREAD);
     }
 
     void CschedUeConfigReq(
         const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) override
     {
-        m_scheduler->DoCschedUeConfigReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoCschedUeConfigReq,
+                              params,
+                              NrMacScheduler::MAIN_THREAD);
     }
 
     void CschedLcConfigReq(
         const NrMacCschedSapProvider::CschedLcConfigReqParameters& params) override
     {
-        m_scheduler->DoCschedLcConfigReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoCschedLcConfigReq,
+                              params,
+                              NrMacScheduler::MAIN_THREAD);
     }
 
     void CschedLcReleaseReq(
         const NrMacCschedSapProvider::CschedLcReleaseReqParameters& params) override
     {
-        m_scheduler->DoCschedLcReleaseReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoCschedLcReleaseReq,
+                              params,
+                              NrMacScheduler::MAIN_THREAD);
     }
 
     void CschedUeReleaseReq(
         const NrMacCschedSapProvider::CschedUeReleaseReqParameters& params) override
     {
-        m_scheduler->DoCschedUeReleaseReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoCschedUeReleaseReq,
+                              params,
+                              NrMacScheduler::MAIN_THREAD);
     }
 
   private:
@@ -76,52 +86,77 @@ class NrMacGeneralSchedSapProvider : public NrMacSchedSapProvider
     void SchedDlRlcBufferReq(
         const NrMacSchedSapProvider::SchedDlRlcBufferReqParameters& params) override
     {
-        m_scheduler->DoSchedDlRlcBufferReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedDlRlcBufferReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedDlTriggerReq(
         const NrMacSchedSapProvider::SchedDlTriggerReqParameters& params) override
     {
-        m_scheduler->DoSchedDlTriggerReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedDlTriggerReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedUlTriggerReq(
         const NrMacSchedSapProvider::SchedUlTriggerReqParameters& params) override
     {
-        m_scheduler->DoSchedUlTriggerReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedUlTriggerReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedDlCqiInfoReq(
         const NrMacSchedSapProvider::SchedDlCqiInfoReqParameters& params) override
     {
-        m_scheduler->DoSchedDlCqiInfoReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedDlCqiInfoReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedUlCqiInfoReq(
         const NrMacSchedSapProvider::SchedUlCqiInfoReqParameters& params) override
     {
-        m_scheduler->DoSchedUlCqiInfoReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedUlCqiInfoReq,
+                              params,
+                              NrMacScheduler::MAIN_THREAD);
     }
 
     void SchedUlMacCtrlInfoReq(
         const NrMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params) override
     {
-        m_scheduler->DoSchedUlMacCtrlInfoReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedUlMacCtrlInfoReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedUlSrInfoReq(const SchedUlSrInfoReqParameters& params) override
     {
-        m_scheduler->DoSchedUlSrInfoReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedUlSrInfoReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedSetMcs(uint32_t mcs) override
     {
-        m_scheduler->DoSchedSetMcs(mcs);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedSetMcs,
+                              mcs,
+                              NrMacScheduler::CONCURRENT);
+    }
+
+    void SchedSetUlAllocationHorizon(uint32_t numSlots) override
+    {
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedSetUlAllocationHorizon,
+                              numSlots,
+                              NrMacScheduler::CONCURRENT);
     }
 
     void SchedDlRachInfoReq(const SchedDlRachInfoReqParameters& params) override
     {
-        m_scheduler->DoSchedDlRachInfoReq(params);
+        m_scheduler->Dispatch(&NrMacScheduler::DoSchedDlRachInfoReq,
+                              params,
+                              NrMacScheduler::CONCURRENT);
     }
 
     uint8_t GetDlCtrlSyms() const override
@@ -163,4 +198,32 @@ NrMacScheduler::~NrMacScheduler()
     m_macCschedSapProvider = nullptr;
 }
 
+void
+NrMacScheduler::SetSlotExecutor(const Ptr<NrParallelSlotExecutor>& executor)
+{
+    NS_LOG_FUNCTION(this << executor);
+    m_slotExecutor = executor;
+}
+
+Ptr<NrParallelSlotExecutor>
+NrMacScheduler::GetSlotExecutor() const
+{
+    return m_slotExecutor;
+}
+
+void
+NrMacScheduler::SendSchedConfigInd(NrMacSchedSapUser::SchedConfigIndParameters params)
+{
+    if (m_slotExecutor != nullptr)
+    {
+        NrParallelSlotExecutor::RunAtCommit([this, params = std::move(params)]() {
+            m_macSchedSapUser->SchedConfigInd(params);
+        });
+    }
+    else
+    {
+        m_macSchedSapUser->SchedConfigInd(params);
+    }
+}
+
 } // namespace ns3
@@ -8,6 +8,7 @@
 
 #include "nr-mac-csched-sap.h"
 #include "nr-mac-sched-sap.h"
+#include "nr-parallel-slot-executor.h"
 
 #include <ns3/object.h>
 
@@ -20,6 +21,15 @@ namespace ns3
  *
  * TODO: Add description of SAP user/providers
  *
+ * With a slot executor (SetSlotExecutor), the primitives received during the
+ * slot indication of the MAC are submitted to the lane of the cell, and run
+ * after the indication, in the order in which they were called, concurrently
+ * with the ones of the other cells. The primitives that configure the UEs and
+ * the UL CQI (which uses the spectrum model shared by the cells) run in the main
+ * thread. The decisions (SchedConfigInd) and the trace sources fired while
+ * scheduling are committed to the MAC by the slot start of the cell, before its
+ * PHY continues. The other primitives run immediately.
+ *
  * \see NrMacSchedulerNs3
  */
 class NrMacScheduler : public Object
@@ -77,6 +87,20 @@ class NrMacScheduler : public Object
         return m_macCschedSapProvider;
     }
 
+    /**
+     * \brief Set the executor that runs the scheduling requests of the slots
+     * \param executor the executor, or nullptr to run them immediately
+     *
+     * \see NrParallelSlotExecutor
+     */
+    void SetSlotExecutor(const Ptr<NrParallelSlotExecutor>& executor);
+
+    /**
+     * \brief Get the executor that runs the scheduling requests of the slots
+     * \return the executor, or nullptr if there is none
+     */
+    Ptr<NrParallelSlotExecutor> GetSlotExecutor() const;
+
     //
     // Implementation of the CSCHED API primitives
     // (See 4.1 for description of the primitives)
@@ -208,6 +232,12 @@ class NrMacScheduler : public Object
      */
     virtual void DoSchedSetMcs(uint32_t mcs) = 0;
 
+    /**
+     * \brief Set the number of slots that the UL allocations wait for their UL CQI
+     * \param numSlots the number of slots, from the scheduling of a slot to its UL CQI
+     */
+    virtual void DoSchedSetUlAllocationHorizon(uint32_t numSlots) = 0;
+
     /**
      * \brief RACH information
      *
@@ -239,10 +269,55 @@ class NrMacScheduler : public Object
     virtual int64_t AssignStreams(int64_t stream) = 0;
 
   protected:
+    /**
+     * \brief Send the decision of a slot to the MAC
+     *
+     * In the lane of a slot executor, the decision is sent at the commit of the
+     * lane (see NrParallelSlotExecutor::RunAtCommit).
+     *
+     * \param params the decision
+     */
+    void SendSchedConfigInd(NrMacSchedSapUser::SchedConfigIndParameters params);
+
     NrMacSchedSapUser* m_macSchedSapUser{nullptr};           //!< SAP user
     NrMacCschedSapUser* m_macCschedSapUser{nullptr};         //!< SAP User
     NrMacCschedSapProvider* m_macCschedSapProvider{nullptr}; //!< SAP Provider
     NrMacSchedSapProvider* m_macSchedSapProvider{nullptr};   //!< SAP Provider
+
+  private:
+    friend class NrMacGeneralSchedSapProvider;
+    friend class NrMacGeneralCschedSapProvider;
+
+    /**
+     * \brief How a primitive is run with a slot executor
+     */
+    enum PrimitiveKind
+    {
+        CONCURRENT,  //!< Run concurrently with the other cells
+        MAIN_THREAD, //!< Run in the main thread
+    };
+
+    /**
+     * \brief Run a primitive, or submit it to the lane of the slot indication
+     * \param primitive the primitive
+     * \param params the parameters of the primitive
+     * \param kind how the primitive is run with a slot executor
+     */
+    template <typename Param, typename T>
+    void Dispatch(void (NrMacScheduler::*primitive)(Param), const T& params, PrimitiveKind kind)
+    {
+        if (m_slotExecutor != nullptr && m_slotExecutor->IsRunningIndication())
+        {
+            m_slotExecutor->Submit([this, primitive, params]() { (this->*primitive)(params); },
+                                   kind == CONCURRENT);
+        }
+        else
+        {
+            (this->*primitive)(params);
+        }
+    }
+
+    Ptr<NrParallelSlotExecutor> m_slotExecutor; //!< Executor of the slot requests, if any
 };
 
 } // namespace ns3
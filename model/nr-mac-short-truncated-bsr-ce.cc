@@ -0,0 +1,100 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-short-truncated-bsr-ce.h"
+
+#include "nr-mac-long-bsr-ce.h"
+#include "nr-mac-short-bsr-ce.h"
+
+#include <ns3/log.h>
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(NrMacShortTruncatedBsrCe);
+NS_LOG_COMPONENT_DEFINE("NrMacShortTruncatedBsrCe");
+
+TypeId
+NrMacShortTruncatedBsrCe::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrMacShortTruncatedBsrCe")
+                            .SetParent<Header>()
+                            .AddConstructor<NrMacShortTruncatedBsrCe>();
+    return tid;
+}
+
+TypeId
+NrMacShortTruncatedBsrCe::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+NrMacShortTruncatedBsrCe::NrMacShortTruncatedBsrCe()
+{
+    NS_LOG_FUNCTION(this);
+    m_header.SetLcId(NrMacHeaderFsUl::SHORT_TRUNCATED_BSR);
+}
+
+void
+NrMacShortTruncatedBsrCe::Serialize(Buffer::Iterator start) const
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ASSERT(m_lcg <= 7);
+    NS_ASSERT(m_bufferSizeLevel <= 31);
+
+    m_header.Serialize(start);
+    start.Next(m_header.GetSerializedSize());
+
+    start.WriteU8((m_lcg << 5) | m_bufferSizeLevel);
+}
+
+uint32_t
+NrMacShortTruncatedBsrCe::Deserialize(Buffer::Iterator start)
+{
+    NS_LOG_FUNCTION(this);
+
+    auto readBytes = m_header.Deserialize(start);
+    start.Next(readBytes);
+    NS_ASSERT(m_header.GetLcId() == NrMacHeaderFsUl::SHORT_TRUNCATED_BSR);
+
+    uint8_t value = start.ReadU8();
+    m_lcg = value >> 5;
+    m_bufferSizeLevel = value & 0x1F;
+
+    return GetSerializedSize();
+}
+
+uint32_t
+NrMacShortTruncatedBsrCe::GetSerializedSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_header.GetSerializedSize() + 1;
+}
+
+void
+NrMacShortTruncatedBsrCe::Print(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    os << "LCG" << +m_lcg << ": " << +m_bufferSizeLevel;
+}
+
+bool
+NrMacShortTruncatedBsrCe::operator==(const NrMacShortTruncatedBsrCe& o) const
+{
+    return m_lcg == o.m_lcg && m_bufferSizeLevel == o.m_bufferSizeLevel;
+}
+
+std::vector<uint8_t>
+NrMacShortTruncatedBsrCe::ToLongBsrLevels() const
+{
+    std::vector<uint8_t> levels(NrMacLongBsrCe::MAX_LCG, 0);
+    levels.at(m_lcg) =
+        NrMacLongBsrCe::FromBytesToLevel(NrMacShortBsrCe::FromLevelToBytes(m_bufferSizeLevel));
+    return levels;
+}
+
+} // namespace ns3
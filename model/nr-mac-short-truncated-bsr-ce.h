@@ -0,0 +1,114 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_MAC_SHORT_TRUNCATED_BSR_CE_H
+#define NR_MAC_SHORT_TRUNCATED_BSR_CE_H
+
+#include "nr-mac-header-fs-ul.h"
+
+#include "ns3/packet.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ue-mac
+ * \ingroup gnb-mac
+ * \brief Short truncated BSR control element
+ *
+ * This is the one-octet BSR of TS 38.321, meant to be written after a
+ * fixed-size subHeader (LCID 59), within a NR subPDU. Differently from
+ * NrMacShortBsrCe, it reports only one LCG, which can be any of the
+ * NrMacLongBsrCe::MAX_LCG LCGs, with the 5-bit levels of NrMacShortBsrCe.
+ *
+ * The serialization looks like the following:
+ *
+ * \verbatim
+ +-----+-----+-----+-------------------------------------------+
+ |                 |                                           |
+ |    LCG ID       |         Buffer Level                      |   Oct 1
+ |                 |                                           |
+ +-----+-----+-----+-------------------------------------------+
+\endverbatim
+ *
+ * The UE sends it when a LONG_BSR can not be sent, and the SHORT_BSR can not
+ * report the LCG with data: i.e., when the data is in an LCG greater than 3,
+ * and it is the only LCG with data, or the LONG_BSR does not fit in the grant
+ * (in which case the LCG of the logical channel with the highest priority is
+ * reported). The standard uses LCID 61 for the first case, but in this module
+ * that LCID identifies the 4-octet NrMacShortBsrCe, so the CE is always sent
+ * with LCID 59; the format is the same.
+ *
+ * Please refer to TS 38.321 section 6.1.3.1 for more information.
+ */
+class NrMacShortTruncatedBsrCe : public Header
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+    /**
+     * \brief GetInstanceTypeId
+     * \return the instance type id
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrMacShortTruncatedBsrCe constructor
+     */
+    NrMacShortTruncatedBsrCe();
+
+    /**
+     * \brief Serialize on a buffer
+     * \param start start position
+     */
+    void Serialize(Buffer::Iterator start) const override;
+    /**
+     * \brief Deserialize from a buffer
+     * \param start start position
+     * \return the number of bytes read from the buffer
+     */
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    /**
+     * \brief Get the serialized size
+     * \return the size of the subheader, plus 1
+     */
+    uint32_t GetSerializedSize() const override;
+    /**
+     * \brief Print the struct on a ostream
+     * \param os ostream
+     */
+    void Print(std::ostream& os) const override;
+
+    /**
+     * \brief IsEqual
+     * \param o another instance
+     * \return true if this and o are equal, false otherwise
+     */
+    bool operator==(const NrMacShortTruncatedBsrCe& o) const;
+
+    /**
+     * \brief Convert the report into the levels of a LONG_BSR, which is how
+     * the scheduler receives it
+     * \return a vector with NrMacLongBsrCe::MAX_LCG levels of NrMacLongBsrCe,
+     * that are 0 except the one of the reported LCG
+     */
+    std::vector<uint8_t> ToLongBsrLevels() const;
+
+    uint8_t m_lcg{0};             //!< LCG reported (maximum value: 7)
+    uint8_t m_bufferSizeLevel{0}; //!< Buffer size level, as in NrMacShortBsrCe (maximum: 31)
+
+  private:
+    NrMacHeaderFsUl m_header; //!< Fixed-size header to prepend to the BSR
+};
+
+} // namespace ns3
+
+#endif /* NR_MAC_SHORT_TRUNCATED_BSR_CE_H */
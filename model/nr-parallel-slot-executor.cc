@@ -0,0 +1,343 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-parallel-slot-executor.h"
+
+#include "nr-profiler.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrParallelSlotExecutor");
+NS_OBJECT_ENSURE_REGISTERED(NrParallelSlotExecutor);
+
+thread_local NrParallelSlotExecutor::Lane* NrParallelSlotExecutor::s_taskLane = nullptr;
+thread_local NrParallelSlotExecutor::Lane* NrParallelSlotExecutor::s_indicationLane = nullptr;
+
+TypeId
+NrParallelSlotExecutor::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrParallelSlotExecutor")
+            .SetParent<Object>()
+            .SetGroupName("nr")
+            .AddConstructor<NrParallelSlotExecutor>()
+            .AddAttribute("NumThreads",
+                          "The number of threads that run the lanes, including the main one. "
+                          "The results do not depend on it.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&NrParallelSlotExecutor::m_numThreads),
+                          MakeUintegerChecker<uint32_t>(1, 256));
+    return tid;
+}
+
+NrParallelSlotExecutor::NrParallelSlotExecutor()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrParallelSlotExecutor::~NrParallelSlotExecutor()
+{
+    NS_LOG_FUNCTION(this);
+    StopWorkers();
+}
+
+void
+NrParallelSlotExecutor::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    StopWorkers();
+    m_slotStarts.clear();
+    m_lanes.clear();
+    Object::DoDispose();
+}
+
+void
+NrParallelSlotExecutor::AddSlotStart(const void* owner,
+                                     const void* group,
+                                     Task indication,
+                                     Check canRunEarly)
+{
+    NS_LOG_FUNCTION(this << owner << group);
+
+    if (m_boundary != Simulator::Now())
+    {
+        for (const auto& slotStart : m_slotStarts)
+        {
+            NS_ABORT_MSG_IF(slotStart.m_state == JOINED,
+                            "The slot start of " << slotStart.m_owner << " at " << m_boundary
+                                                 << " ran its indication, but not its commits");
+        }
+        m_slotStarts.clear();
+        m_boundary = Simulator::Now();
+    }
+
+    SlotStart slotStart;
+    slotStart.m_owner = owner;
+    slotStart.m_group = group;
+    slotStart.m_indication = std::move(indication);
+    slotStart.m_canRunEarly = std::move(canRunEarly);
+    m_slotStarts.emplace_back(std::move(slotStart));
+}
+
+bool
+NrParallelSlotExecutor::RunSlotStart(const void* owner)
+{
+    NS_LOG_FUNCTION(this << owner);
+
+    if (m_boundary != Simulator::Now())
+    {
+        return false;
+    }
+
+    size_t index = 0;
+    while (index < m_slotStarts.size() &&
+           (m_slotStarts[index].m_owner != owner || m_slotStarts[index].m_state == STARTED))
+    {
+        ++index;
+    }
+    if (index == m_slotStarts.size())
+    {
+        return false;
+    }
+
+    if (m_slotStarts[index].m_state == WAITING)
+    {
+        Join(index);
+    }
+
+    // The lane is released before the commits, which may call the owners
+    SlotStart& slotStart = m_slotStarts[index];
+    std::vector<Task> commits = std::move(slotStart.m_lane.m_commits);
+    slotStart.m_lane = Lane();
+    slotStart.m_state = STARTED;
+
+    for (auto& commit : commits)
+    {
+        commit();
+    }
+    return true;
+}
+
+bool
+NrParallelSlotExecutor::IsRunningIndication() const
+{
+    return m_indicationLane != nullptr;
+}
+
+void
+NrParallelSlotExecutor::Submit(Task task, bool concurrent)
+{
+    NS_LOG_FUNCTION(this << concurrent);
+    NS_ASSERT_MSG(m_indicationLane != nullptr, "Task submitted out of an indication");
+    m_indicationLane->m_tasks.push_back({std::move(task), concurrent});
+}
+
+void
+NrParallelSlotExecutor::RunAtCommit(Task commit)
+{
+    if (s_taskLane != nullptr)
+    {
+        s_taskLane->m_commits.emplace_back(std::move(commit));
+    }
+    else if (s_indicationLane != nullptr)
+    {
+        // A task keeps the commit in order with the ones of the tasks before
+        s_indicationLane->m_tasks.push_back(
+            {[commit = std::move(commit)]() { RunAtCommit(commit); }, true});
+    }
+    else
+    {
+        commit();
+    }
+}
+
+uint64_t
+NrParallelSlotExecutor::GetNumJoins() const
+{
+    return m_numJoins;
+}
+
+uint64_t
+NrParallelSlotExecutor::GetNumEarlyIndications() const
+{
+    return m_numEarlyIndications;
+}
+
+uint64_t
+NrParallelSlotExecutor::GetNumTasks() const
+{
+    return m_numTasks;
+}
+
+bool
+NrParallelSlotExecutor::CanRunEarly(size_t index) const
+{
+    const SlotStart& slotStart = m_slotStarts[index];
+    if (slotStart.m_state != WAITING || !slotStart.m_indication || !slotStart.m_canRunEarly)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < index; ++i)
+    {
+        if (m_slotStarts[i].m_group == slotStart.m_group && m_slotStarts[i].m_state != STARTED)
+        {
+            return false;
+        }
+    }
+    return slotStart.m_canRunEarly();
+}
+
+void
+NrParallelSlotExecutor::Join(size_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+
+    m_lanes.clear();
+    for (size_t i = 0; i < m_slotStarts.size(); ++i)
+    {
+        if (i != index && !CanRunEarly(i))
+        {
+            continue;
+        }
+        SlotStart& slotStart = m_slotStarts[i];
+        m_indicationLane = &slotStart.m_lane;
+        s_indicationLane = m_indicationLane;
+        slotStart.m_indication();
+        s_indicationLane = nullptr;
+        m_indicationLane = nullptr;
+        slotStart.m_state = JOINED;
+        m_lanes.push_back(&slotStart.m_lane);
+        m_numTasks += slotStart.m_lane.m_tasks.size();
+        if (i != index)
+        {
+            ++m_numEarlyIndications;
+        }
+    }
+    ++m_numJoins;
+
+    NS_LOG_DEBUG("Joining " << m_lanes.size() << " lanes on " << m_numThreads << " threads");
+
+    bool remaining = true;
+    while (remaining)
+    {
+        RunConcurrentTasks();
+
+        remaining = false;
+        for (auto& lane : m_lanes)
+        {
+            s_taskLane = lane;
+            while (lane->m_next < lane->m_tasks.size() && !lane->m_tasks[lane->m_next].m_concurrent)
+            {
+                lane->m_tasks[lane->m_next++].m_task();
+            }
+            s_taskLane = nullptr;
+            remaining = remaining || lane->m_next < lane->m_tasks.size();
+        }
+    }
+
+    for (auto& lane : m_lanes)
+    {
+        lane->m_tasks.clear();
+        lane->m_next = 0;
+    }
+    m_lanes.clear();
+}
+
+void
+NrParallelSlotExecutor::RunConcurrentTasks()
+{
+    m_nextLane.store(0);
+    if (m_numThreads > 1 && m_lanes.size() > 1)
+    {
+        while (m_workers.size() + 1 < m_numThreads)
+        {
+            m_workers.emplace_back(&NrParallelSlotExecutor::WorkerLoop, this, m_generation);
+        }
+        NrProfiler::SetConcurrent(true);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_generation;
+            m_busyWorkers = static_cast<uint32_t>(m_workers.size());
+        }
+        m_wakeUp.notify_all();
+        RunLanes();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+        }
+        NrProfiler::SetConcurrent(false);
+    }
+    else
+    {
+        RunLanes();
+    }
+}
+
+void
+NrParallelSlotExecutor::RunLanes()
+{
+    for (size_t i = m_nextLane.fetch_add(1); i < m_lanes.size(); i = m_nextLane.fetch_add(1))
+    {
+        Lane* lane = m_lanes[i];
+        s_taskLane = lane;
+        while (lane->m_next < lane->m_tasks.size() && lane->m_tasks[lane->m_next].m_concurrent)
+        {
+            lane->m_tasks[lane->m_next++].m_task();
+        }
+        s_taskLane = nullptr;
+    }
+}
+
+void
+NrParallelSlotExecutor::WorkerLoop(uint64_t lastGeneration)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this, lastGeneration] {
+                return m_stop || m_generation != lastGeneration;
+            });
+            if (m_stop)
+            {
+                return;
+            }
+            lastGeneration = m_generation;
+        }
+
+        RunLanes();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0)
+        {
+            m_done.notify_one();
+        }
+    }
+}
+
+void
+NrParallelSlotExecutor::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    m_stop = false;
+}
+
+} // namespace ns3
@@ -0,0 +1,284 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_PARALLEL_SLOT_EXECUTOR_H
+#define NR_PARALLEL_SLOT_EXECUTOR_H
+
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief Run the slot indications of independent cells concurrently, on a
+ * pool of threads, with the same result as running them one after the other
+ *
+ * The owners (e.g., the PHY of each BWP of each gNB) announce their slot start
+ * with AddSlotStart, in the event that precedes it at the same simulation time
+ * (e.g., the end of the previous slot). Each owner then calls RunSlotStart in
+ * its own slot start event, at the point where it notifies the slot to the
+ * upper layers. The first of these calls of a slot boundary runs the
+ * indications of the slot starts that can run before their event (see below),
+ * together with the one of the caller, in the main thread, in the order in
+ * which they were announced. The tasks that the indications submit (Submit)
+ * are collected in a lane for each owner. The lanes are then joined: they are
+ * distributed to the threads; the tasks of a lane run in the order in which
+ * they were submitted, and never concurrently with each other. A task that is
+ * not concurrent stops its lane: it is run in the main thread when all the
+ * lanes stopped, lane by lane, and then the lanes continue. The work that the
+ * tasks leave for later (RunAtCommit, e.g., notifying the MAC or firing a trace
+ * source) is committed by the RunSlotStart of each owner, in its own event and
+ * in the order in which it was left. So the owners continue their slot exactly
+ * as they would without the executor.
+ *
+ * The slot start of an owner other than the caller runs before its event only
+ * if its announcement allows it (i.e., its indication only touches its own
+ * state), and if all the slot starts of its group (e.g., the BWPs of a gNB),
+ * announced before it, have already run in their own event. So the indications
+ * of a group still run after the commits of the ones before them.
+ *
+ * The concurrent tasks must only touch the state of their owner: they must not
+ * schedule events, create packets, fire trace sources, or use objects shared
+ * with other lanes (including their reference count). The rest goes in a task
+ * that is not concurrent, or in RunAtCommit. Since the concurrent tasks of
+ * different lanes are independent, and the other tasks and the commits run in
+ * a fixed order, the results (including the random variables drawn and the
+ * order of the events scheduled by the commits) do not depend on NumThreads,
+ * and they are the ones of a simulation without the executor, as long as no
+ * event between the slot start events of the same time changes the state of an
+ * owner whose indication already ran.
+ * With NumThreads equal to 1 the lanes run one after the other, in the main
+ * thread.
+ *
+ * The NS_LOG output of the concurrent tasks of different lanes may interleave.
+ */
+class NrParallelSlotExecutor : public Object
+{
+  public:
+    /**
+     * \brief An indication, a task, or a commit
+     */
+    using Task = std::function<void()>;
+
+    /**
+     * \brief A check done before running an indication earlier than its event
+     */
+    using Check = std::function<bool()>;
+
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrParallelSlotExecutor constructor
+     */
+    NrParallelSlotExecutor();
+
+    /**
+     * \brief ~NrParallelSlotExecutor
+     */
+    ~NrParallelSlotExecutor() override;
+
+    /**
+     * \brief Announce the slot start of an owner, at the current time
+     *
+     * It must be called in an event that precedes the slot start event of the
+     * owner, at the same time, in the order of the slot start events.
+     *
+     * \param owner the owner of the lane
+     * \param group the group of the owner: the owners of a group never run
+     * their indication before the slot starts of the group announced before
+     * \param indication the indication, that submits the tasks of the lane
+     * \param canRunEarly the check, done when the indication would run before
+     * the event of the owner; if it is nullptr or it returns false, the
+     * indication only runs in the event of the owner
+     */
+    void AddSlotStart(const void* owner, const void* group, Task indication, Check canRunEarly);
+
+    /**
+     * \brief Run the slot start of an owner, in its slot start event
+     *
+     * If the indication of the owner did not run yet, it runs now, together with
+     * the ones that can run before their event, and the lanes are joined. Then,
+     * the commits of the lane of the owner are run.
+     *
+     * \param owner the owner of the lane
+     * \return true if the indication of the owner was run (now or before) and
+     * committed, false if the slot start of the owner was not announced
+     */
+    bool RunSlotStart(const void* owner);
+
+    /**
+     * \brief Check if an indication is running, so that its work must be
+     * submitted to the lane of its owner
+     * \return true if an indication is running
+     */
+    bool IsRunningIndication() const;
+
+    /**
+     * \brief Submit a task to the lane of the running indication
+     *
+     * It must be called from an indication (see IsRunningIndication).
+     *
+     * \param task the task
+     * \param concurrent false if the task must run in the main thread
+     */
+    void Submit(Task task, bool concurrent);
+
+    /**
+     * \brief Run a function at the commit of the current lane, or immediately
+     *
+     * From a task, the function is run by the RunSlotStart of the owner of the
+     * lane, after the ones left before. From an indication, it is run after the
+     * ones left by the tasks submitted before. Otherwise, it is run
+     * immediately.
+     *
+     * \param commit the function
+     */
+    static void RunAtCommit(Task commit);
+
+    /**
+     * \brief Get the number of joins of the lanes
+     * \return the number of joins
+     */
+    uint64_t GetNumJoins() const;
+
+    /**
+     * \brief Get the number of indications that ran before the event of their owner
+     * \return the number of indications run early
+     */
+    uint64_t GetNumEarlyIndications() const;
+
+    /**
+     * \brief Get the number of tasks run
+     * \return the number of tasks
+     */
+    uint64_t GetNumTasks() const;
+
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object: stop the worker threads
+     */
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief A task submitted to a lane
+     */
+    struct LaneTask
+    {
+        Task m_task;       //!< The task
+        bool m_concurrent; //!< Can it run out of the main thread?
+    };
+
+    /**
+     * \brief The tasks and the commits of an owner, in the current slot start
+     */
+    struct Lane
+    {
+        std::vector<LaneTask> m_tasks; //!< Tasks, in order of submission
+        std::vector<Task> m_commits;   //!< Commits, in the order they were left
+        size_t m_next{0};              //!< Next task to run
+    };
+
+    /**
+     * \brief The state of a slot start
+     */
+    enum SlotStartState
+    {
+        WAITING, //!< The indication did not run
+        JOINED,  //!< The indication ran, and the lane was joined
+        STARTED, //!< The owner reached its slot start event
+    };
+
+    /**
+     * \brief The slot start of an owner, at the current boundary
+     */
+    struct SlotStart
+    {
+        const void* m_owner{nullptr};    //!< The owner
+        const void* m_group{nullptr};    //!< The group of the owner
+        Task m_indication;               //!< The indication
+        Check m_canRunEarly;             //!< Can the indication run before the event?
+        SlotStartState m_state{WAITING}; //!< The state
+        Lane m_lane;                     //!< The lane of the owner
+    };
+
+    /**
+     * \brief Check if a slot start can run in the join started by another one
+     * \param index the index of the slot start
+     * \return true if it is waiting, its check allows it, and the slot starts
+     * of its group announced before it already started
+     */
+    bool CanRunEarly(size_t index) const;
+
+    /**
+     * \brief Run the indications of a slot start and of the ones that can run
+     * early, and join their lanes
+     * \param index the index of the slot start of the caller
+     */
+    void Join(size_t index);
+
+    /**
+     * \brief Run the concurrent tasks of the lanes, with the worker threads,
+     * until each lane ends or reaches a task that is not concurrent
+     */
+    void RunConcurrentTasks();
+
+    /**
+     * \brief Run the concurrent tasks of the lanes that are not taken by
+     * another thread
+     */
+    void RunLanes();
+
+    /**
+     * \brief The loop of a worker thread
+     * \param lastGeneration the last join given to the workers when the thread is created
+     */
+    void WorkerLoop(uint64_t lastGeneration);
+
+    /**
+     * \brief Stop and join the worker threads
+     */
+    void StopWorkers();
+
+    static thread_local Lane* s_taskLane;       //!< Lane of the task run by the thread
+    static thread_local Lane* s_indicationLane; //!< Lane of the indication run by the thread
+
+    uint32_t m_numThreads{1}; //!< Number of threads, including the main one
+
+    Time m_boundary{Time::Min()};        //!< Time of the slot starts announced
+    std::vector<SlotStart> m_slotStarts; //!< Slot starts, in order of announcement
+    std::vector<Lane*> m_lanes;          //!< Lanes of the current join
+    Lane* m_indicationLane{nullptr};     //!< Lane of the running indication
+    uint64_t m_numJoins{0};              //!< Number of joins
+    uint64_t m_numEarlyIndications{0};   //!< Number of indications run early
+    uint64_t m_numTasks{0};              //!< Number of tasks run
+
+    std::atomic<size_t> m_nextLane{0};  //!< Next lane to take, in the current join
+    std::vector<std::thread> m_workers; //!< Worker threads
+    std::mutex m_mutex;                 //!< Protects the fields below
+    std::condition_variable m_wakeUp;   //!< Signals a new join, or the stop
+    std::condition_variable m_done;     //!< Signals that the workers are done
+    uint64_t m_generation{0};           //!< Number of joins given to the workers
+    uint32_t m_busyWorkers{0};          //!< Workers running the current join
+    bool m_stop{false};                 //!< Whether the workers must exit
+};
+
+} // namespace ns3
+
+#endif // NR_PARALLEL_SLOT_EXECUTOR_H
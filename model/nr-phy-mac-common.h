@@ -428,13 +428,15 @@ struct MacCeValue
 {
     MacCeValue()
         : m_phr(0),
-          m_crnti(0)
+          m_crnti(0),
+          m_truncatedLcg(UINT8_MAX)
     {
     }
 
     uint8_t m_phr;
     uint8_t m_crnti;
-    std::vector<uint8_t> m_bufferStatus;
+    std::vector<uint8_t> m_bufferStatus; //!< 4 SHORT_BSR levels, or 8 LONG_BSR levels
+    uint8_t m_truncatedLcg;              //!< Only LCG of a truncated BSR, or UINT8_MAX
 };
 
 /**
@@ -57,6 +57,23 @@ class NrPhySapProvider
                             uint8_t symStart,
                             uint8_t streamId) = 0;
 
+    /**
+     * \brief Send all the MAC PDUs of a TB
+     * \param pb the MAC PDUs, each one with a LteRadioBearerTag and a NrMacPduHeader
+     * \param sfn SFN
+     * \param symStart symbol inside the SFN
+     * \param streamId The stream id through which the PDUs would be transmitted
+     *
+     * Equivalent to calling SendMacPdu for each packet of the burst. The PHY
+     * does not modify the burst nor the packets inside it, so the MAC can keep it
+     * (e.g., in the HARQ buffer) and send it again for a retransmission without
+     * copying it.
+     */
+    virtual void SendMacPduBurst(const Ptr<PacketBurst>& pb,
+                                 const SfnSf& sfn,
+                                 uint8_t symStart,
+                                 uint8_t streamId) = 0;
+
     /**
      * \brief Send a control message
      * \param msg the message to send
@@ -75,12 +92,12 @@ class NrPhySapProvider
 
     /**
      * \brief Set a SlotAllocInfo inside the PHY allocations
-     * \param slotAllocInfo the allocation
+     * \param slotAllocInfo the allocation (pass an rvalue to avoid copying it)
      *
      * Called by the MAC to install in the PHY the allocation that has been
      * prepared.
      */
-    virtual void SetSlotAllocInfo(const SlotAllocInfo& slotAllocInfo) = 0;
+    virtual void SetSlotAllocInfo(SlotAllocInfo slotAllocInfo) = 0;
 
     /**
      * \brief Notify PHY about the successful RRC connection
@@ -226,7 +243,14 @@ class NrGnbPhySapUser
      * \param beamConfId the new beam ID
      * \param rnti the RNTI of the user
      */
-    virtual void BeamChangeReport(BeamConfId beamConfId, uint8_t rnti) = 0;
+    virtual void BeamChangeReport(BeamConfId beamConfId, uint16_t rnti) = 0;
+
+    /**
+     * \brief Check if the MAC received RACH preambles, that the next slot
+     * indication notifies to the RRC
+     * \return true if there are RACH preambles not notified yet
+     */
+    virtual bool HasRachPreambles() const = 0;
 
     /**
      * \brief PHY requests information from MAC.
@@ -253,6 +277,12 @@ class NrGnbPhySapUser
      * \return the DL CTRL symbols
      */
     virtual uint8_t GetDlCtrlSymbols() const = 0;
+
+    /**
+     * \brief Set the number of slots that the UL allocations wait for their UL CQI
+     * \param numSlots the number of slots, from the scheduling of a slot to its UL CQI
+     */
+    virtual void SetUlAllocationHorizon(uint32_t numSlots) = 0;
 };
 
 /**
@@ -41,11 +41,16 @@ class NrMemberPhySapProvider : public NrPhySapProvider
                     uint8_t symStart,
                     uint8_t streamId) override;
 
+    void SendMacPduBurst(const Ptr<PacketBurst>& pb,
+                         const SfnSf& sfn,
+                         uint8_t symStart,
+                         uint8_t streamId) override;
+
     void SendControlMessage(Ptr<NrControlMessage> msg) override;
 
     void SendRachPreamble(uint8_t PreambleId, uint8_t Rnti) override;
 
-    void SetSlotAllocInfo(const SlotAllocInfo& slotAllocInfo) override;
+    void SetSlotAllocInfo(SlotAllocInfo slotAllocInfo) override;
 
     BeamConfId GetBeamConfId(uint8_t rnti) const override;
 
@@ -82,6 +87,15 @@ NrMemberPhySapProvider::SendMacPdu(const Ptr<Packet>& p,
     m_phy->SetMacPdu(p, sfn, symStart, streamId);
 }
 
+void
+NrMemberPhySapProvider::SendMacPduBurst(const Ptr<PacketBurst>& pb,
+                                        const SfnSf& sfn,
+                                        uint8_t symStart,
+                                        uint8_t streamId)
+{
+    m_phy->SetMacPduBurst(pb, sfn, symStart, streamId);
+}
+
 void
 NrMemberPhySapProvider::SendControlMessage(Ptr<NrControlMessage> msg)
 {
@@ -95,9 +109,9 @@ NrMemberPhySapProvider::SendRachPreamble(uint8_t PreambleId, uint8_t Rnti)
 }
 
 void
-NrMemberPhySapProvider::SetSlotAllocInfo(const SlotAllocInfo& slotAllocInfo)
+NrMemberPhySapProvider::SetSlotAllocInfo(SlotAllocInfo slotAllocInfo)
 {
-    m_phy->PushBackSlotAllocInfo(slotAllocInfo);
+    m_phy->PushBackSlotAllocInfo(std::move(slotAllocInfo));
 }
 
 BeamConfId
@@ -185,6 +199,7 @@ NrPhy::NrPhy()
 {
     NS_LOG_FUNCTION(this);
     m_phySapProvider = new NrMemberPhySapProvider(this);
+    m_slotAllocInfo.Reserve(8);
 }
 
 NrPhy::~NrPhy()
@@ -196,7 +211,7 @@ void
 NrPhy::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    m_slotAllocInfo.clear();
+    m_slotAllocInfo.Clear();
     m_controlMessageQueue.clear();
     m_packetBurstMap.clear();
     m_ctrlMsgs.clear();
@@ -343,13 +358,62 @@ NrPhy::SetMacPdu(const Ptr<Packet>& p, const SfnSf& sfn, uint8_t symStart, uint8
 
     if (it == m_packetBurstMap.end())
     {
-        it = m_packetBurstMap.insert(std::make_pair(key, CreateObject<PacketBurst>())).first;
+        PacketBurstEntry entry{CreateObject<PacketBurst>(), false};
+        it = m_packetBurstMap.insert(std::make_pair(key, entry)).first;
     }
-    it->second->AddPacket(p);
+    else
+    {
+        MakeBurstWritable(it->second);
+    }
+    it->second.m_burst->AddPacket(p);
     NS_LOG_INFO("Adding a packet for the Packet Burst of " << sfn << " at sym " << +symStart
                                                            << std::endl);
 }
 
+void
+NrPhy::SetMacPduBurst(const Ptr<PacketBurst>& pb,
+                      const SfnSf& sfn,
+                      uint8_t symStart,
+                      uint8_t streamId)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(sfn.GetNumerology() == GetNumerology());
+    uint64_t key = sfn.GetEncForStreamWithSymStart(streamId, symStart);
+    auto it = m_packetBurstMap.find(key);
+
+    if (it == m_packetBurstMap.end())
+    {
+        // The burst is shared with the MAC: it will be copied if some other
+        // PDU has to be added for the same symbol and stream
+        m_packetBurstMap.insert(std::make_pair(key, PacketBurstEntry{pb, true}));
+    }
+    else
+    {
+        MakeBurstWritable(it->second);
+        for (auto pkt = pb->Begin(); pkt != pb->End(); ++pkt)
+        {
+            it->second.m_burst->AddPacket(*pkt);
+        }
+    }
+    NS_LOG_INFO("Adding " << pb->GetNPackets() << " packets for the Packet Burst of " << sfn
+                          << " at sym " << +symStart);
+}
+
+void
+NrPhy::MakeBurstWritable(PacketBurstEntry& entry)
+{
+    if (entry.m_shared)
+    {
+        Ptr<PacketBurst> copy = CreateObject<PacketBurst>();
+        for (auto pkt = entry.m_burst->Begin(); pkt != entry.m_burst->End(); ++pkt)
+        {
+            copy->AddPacket(*pkt);
+        }
+        entry.m_burst = copy;
+        entry.m_shared = false;
+    }
+}
+
 void
 NrPhy::NotifyConnectionSuccessful()
 {
@@ -373,7 +437,7 @@ NrPhy::GetPacketBurst(SfnSf sfn, uint8_t sym, uint8_t streamId)
     }
     else
     {
-        pburst = it->second;
+        pburst = it->second.m_burst;
         m_packetBurstMap.erase(it);
     }
     return pburst;
@@ -697,46 +761,41 @@ NrPhy::GetPhySapProvider()
 }
 
 void
-NrPhy::PushBackSlotAllocInfo(const SlotAllocInfo& slotAllocInfo)
+NrPhy::PushBackSlotAllocInfo(SlotAllocInfo slotAllocInfo)
 {
     NS_LOG_FUNCTION(this);
 
     NS_LOG_DEBUG("setting info for slot " << slotAllocInfo.m_sfnSf);
 
-    // That's not so complex, as the list would typically be of 2 or 3 elements.
-    bool updated = false;
-    for (auto& alloc : m_slotAllocInfo)
-    {
-        if (alloc.m_sfnSf == slotAllocInfo.m_sfnSf)
-        {
-            NS_LOG_INFO("Merging inside existing allocation");
-            alloc.Merge(slotAllocInfo);
-            updated = true;
-            break;
-        }
-    }
-    if (!updated)
+    SlotAllocInfo* existing = m_slotAllocInfo.Find(slotAllocInfo.m_sfnSf);
+    if (existing != nullptr)
     {
-        m_slotAllocInfo.push_back(slotAllocInfo);
-        m_slotAllocInfo.sort();
-        NS_LOG_INFO("Pushing allocation at the end of the list");
+        NS_LOG_INFO("Merging inside existing allocation");
+        existing->Merge(slotAllocInfo);
+        NS_LOG_INFO(*existing);
     }
-
-    std::stringstream output;
-
-    for (const auto& alloc : m_slotAllocInfo)
+    else
     {
-        output << alloc;
+        NS_LOG_INFO("Storing a new allocation");
+        NS_LOG_INFO(slotAllocInfo);
+        StoreSlotAllocInfo(std::move(slotAllocInfo));
     }
-    NS_LOG_INFO(output.str());
 }
 
 void
-NrPhy::PushFrontSlotAllocInfo(const SfnSf& newSfnSf, const SlotAllocInfo& slotAllocInfo)
+NrPhy::PushFrontSlotAllocInfo(const SfnSf& newSfnSf, SlotAllocInfo slotAllocInfo)
 {
     NS_LOG_FUNCTION(this);
 
-    m_slotAllocInfo.push_front(slotAllocInfo);
+    // Take all the allocations out of the ring, in chronological order, after the new one
+    std::vector<SlotAllocInfo> allocations;
+    allocations.reserve(m_slotAllocInfo.GetSize() + 1);
+    allocations.emplace_back(std::move(slotAllocInfo));
+    while (m_slotAllocInfo.GetSize() > 0)
+    {
+        allocations.emplace_back(std::move(m_slotAllocInfo.ReleaseFirst()));
+    }
+
     SfnSf currentSfn = newSfnSf;
     std::unordered_map<uint64_t, Ptr<PacketBurst>>
         newBursts;                                 // map between new sfn and the packet burst
@@ -745,7 +804,7 @@ NrPhy::PushFrontSlotAllocInfo(const SfnSf& newSfnSf, const SlotAllocInfo& slotAl
     // all the slot allocations  (and their packet burst) have to be "adjusted":
     // directly modify the sfn for the allocation, and temporarly store the
     // burst (along with the new sfn) into newBursts.
-    for (auto it = m_slotAllocInfo.begin(); it != m_slotAllocInfo.end(); ++it)
+    for (auto it = allocations.begin(); it != allocations.end(); ++it)
     {
         auto slotSfn = it->m_sfnSf;
         for (const auto& alloc : it->m_varTtiAllocInfo)
@@ -781,13 +840,20 @@ NrPhy::PushFrontSlotAllocInfo(const SfnSf& newSfnSf, const SlotAllocInfo& slotAl
         currentSfn.Add(1);
     }
 
+    for (auto& allocation : allocations)
+    {
+        StoreSlotAllocInfo(std::move(allocation));
+    }
+
     for (const auto& burstPair : newBursts)
     {
         SfnSf old;
         SfnSf latest;
         old.Decode(sfnMap.at(burstPair.first));
         latest.Decode(burstPair.first);
-        m_packetBurstMap.insert(std::make_pair(burstPair.first, burstPair.second));
+        // We do not know anymore who holds the burst: consider it shared
+        m_packetBurstMap.insert(
+            std::make_pair(burstPair.first, PacketBurstEntry{burstPair.second, true}));
         NS_LOG_INFO("PacketBurst with " << burstPair.second->GetNPackets() << "packets for SFN "
                                         << old << " now moved to SFN " << latest);
     }
@@ -798,23 +864,15 @@ NrPhy::SlotAllocInfoExists(const SfnSf& retVal) const
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(retVal.GetNumerology() == GetNumerology());
-    for (const auto& alloc : m_slotAllocInfo)
-    {
-        if (alloc.m_sfnSf == retVal)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_slotAllocInfo.Find(retVal) != nullptr;
 }
 
 SlotAllocInfo
 NrPhy::RetrieveSlotAllocInfo()
 {
     NS_LOG_FUNCTION(this);
-    SlotAllocInfo ret = *m_slotAllocInfo.begin();
-    m_slotAllocInfo.erase(m_slotAllocInfo.begin());
-    return ret;
+    NS_ASSERT(m_slotAllocInfo.GetSize() > 0);
+    return std::move(m_slotAllocInfo.ReleaseFirst());
 }
 
 SlotAllocInfo
@@ -823,18 +881,11 @@ NrPhy::RetrieveSlotAllocInfo(const SfnSf& sfnsf)
     NS_LOG_FUNCTION(" slot " << sfnsf);
     NS_ASSERT(sfnsf.GetNumerology() == GetNumerology());
 
-    for (auto allocIt = m_slotAllocInfo.begin(); allocIt != m_slotAllocInfo.end(); ++allocIt)
+    if (m_slotAllocInfo.Find(sfnsf) == nullptr)
     {
-        if (allocIt->m_sfnSf == sfnsf)
-        {
-            SlotAllocInfo ret = *allocIt;
-            m_slotAllocInfo.erase(allocIt);
-            return ret;
-        }
+        NS_FATAL_ERROR("Didn't found the slot");
     }
-
-    NS_FATAL_ERROR("Didn't found the slot");
-    return SlotAllocInfo(sfnsf);
+    return std::move(m_slotAllocInfo.Release(sfnsf));
 }
 
 SlotAllocInfo&
@@ -842,22 +893,41 @@ NrPhy::PeekSlotAllocInfo(const SfnSf& sfnsf)
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(sfnsf.GetNumerology() == GetNumerology());
-    for (auto& alloc : m_slotAllocInfo)
+
+    SlotAllocInfo* alloc = m_slotAllocInfo.Find(sfnsf);
+    if (alloc == nullptr)
     {
-        if (alloc.m_sfnSf == sfnsf)
-        {
-            return alloc;
-        }
+        NS_FATAL_ERROR("Didn't found the slot");
     }
-
-    NS_FATAL_ERROR("Didn't found the slot");
+    return *alloc;
 }
 
 size_t
 NrPhy::SlotAllocInfoSize() const
 {
     NS_LOG_FUNCTION(this);
-    return m_slotAllocInfo.size();
+    return m_slotAllocInfo.GetSize();
+}
+
+void
+NrPhy::SetSlotAllocHorizon(uint32_t numSlots)
+{
+    NS_LOG_FUNCTION(this << numSlots);
+    // One slot more, for the allocation of the current slot that is still stored
+    m_slotAllocInfo.Reserve(numSlots + 1);
+}
+
+void
+NrPhy::StoreSlotAllocInfo(SlotAllocInfo slotAllocInfo)
+{
+    const SfnSf sfnSf = slotAllocInfo.m_sfnSf;
+    while (!m_slotAllocInfo.CanStore(sfnSf))
+    {
+        NS_LOG_INFO("The position of the slot " << sfnSf << " is taken by another slot, "
+                                                << "enlarging the slot allocation ring");
+        m_slotAllocInfo.Reserve(m_slotAllocInfo.GetCapacity() * 2);
+    }
+    m_slotAllocInfo.Get(sfnSf, sfnSf) = std::move(slotAllocInfo);
 }
 
 bool
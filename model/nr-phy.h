@@ -9,6 +9,7 @@
 
 #include "nr-phy-mac-common.h"
 #include "nr-phy-sap.h"
+#include "nr-slot-ring.h"
 
 #include <ns3/nr-spectrum-value-helper.h>
 
@@ -48,14 +49,22 @@ class BeamConfId;
  *
  * At the gNb, After the MAC does the slot allocation, it is saved in the PHY with the method
  * PushBackSlotAllocInfo(), and if an allocation for the same slot is already
- * present, the two will be merged together. The slot allocation is stored
- * inside the variable m_slotAllocInfo.
+ * present, the two will be merged together. The slot allocations are stored
+ * inside the variable m_slotAllocInfo, a NrSlotRing indexed by the slot number
+ * (SfnSf::Normalize) modulo its size. The size is a power of two, at least as
+ * large as the number of slots between the allocation and the transmission
+ * (see SetSlotAllocHorizon). Each allocation is retrieved in its slot, so the
+ * ring of the UE, which does not know the K0/K2 delays in advance, is doubled
+ * if two pending allocations fall in the same position. The allocations are
+ * moved in and out of the ring, without copies.
  *
  * \section phy_mac_pdu Management of the MAC PDU that waits to be transmitted
  *
  * With each allocation, will come also one (or more) MAC PDU, that are stored
  * within the method SetMacPdu(). The storage is based on the SfnSf inside the
- * variable m_packetBurstMap.
+ * variable m_packetBurstMap. A burst received with SetMacPduBurst() is stored
+ * by reference and marked as shared, because the MAC keeps it in its HARQ
+ * buffer: it is copied the first time another PDU has to be added to it.
  *
  * \section phy_numerology Configuration of the numerology and the related settings
  *
@@ -103,6 +112,21 @@ class NrPhy : public Object
      */
     void SetMacPdu(const Ptr<Packet>& p, const SfnSf& sfn, uint8_t symStart, uint8_t streamId);
 
+    /**
+     * \brief Store all the MAC PDUs of a TB
+     * \param pb the MAC PDUs
+     * \param sfn The SfnSf at which store the PDUs
+     * \param symStart The symbol inside the SfnSf at which the data will be transmitted
+     * \param streamId The stream id through which the PDUs would be transmitted
+     *
+     * The burst is stored by reference, and it is never modified: if other PDUs
+     * are added for the same SfnSf, symbol and stream, a new burst is created.
+     */
+    void SetMacPduBurst(const Ptr<PacketBurst>& pb,
+                        const SfnSf& sfn,
+                        uint8_t symStart,
+                        uint8_t streamId);
+
     /**
      * \brief Send the RachPreamble
      *
@@ -116,12 +140,12 @@ class NrPhy : public Object
 
     /**
      * \brief Store the slot allocation info
-     * \param slotAllocInfo the allocation to store
+     * \param slotAllocInfo the allocation to store (pass an rvalue to avoid copying it)
      *
      * This method expect that the sfn of the allocation will match the sfn
      * when the allocation will be retrieved.
      */
-    void PushBackSlotAllocInfo(const SlotAllocInfo& slotAllocInfo);
+    void PushBackSlotAllocInfo(SlotAllocInfo slotAllocInfo);
 
     /**
      * \brief Notify PHY about the successful RRC connection
@@ -492,7 +516,7 @@ class NrPhy : public Object
      *
      * Increase the sfn of all allocations to be chronologically "in order".
      */
-    void PushFrontSlotAllocInfo(const SfnSf& newSfnSf, const SlotAllocInfo& slotAllocInfo);
+    void PushFrontSlotAllocInfo(const SfnSf& newSfnSf, SlotAllocInfo slotAllocInfo);
 
     /**
      * \brief Check if the SlotAllocationInfo for that slot exists
@@ -532,6 +556,16 @@ class NrPhy : public Object
      */
     size_t SlotAllocInfoSize() const;
 
+    /**
+     * \brief Make room for the slot allocations of the next slots
+     * \param numSlots the maximum number of slots between the time an allocation
+     * is stored and its slot (e.g., the L1L2CtrlLatency plus the K0/K2 delay)
+     *
+     * The ring grows anyway when needed: this method only avoids to grow it
+     * during the simulation.
+     */
+    void SetSlotAllocHorizon(uint32_t numSlots);
+
     /**
      * \brief Check if there are no control messages queued for this slot
      * \return true if there are no control messages queued for this slot
@@ -568,7 +602,16 @@ class NrPhy : public Object
     double m_txPower{0.0};     //!< Transmission power (attribute)
     double m_noiseFigure{0.0}; //!< Noise figure (attribute)
 
-    std::unordered_map<uint64_t, Ptr<PacketBurst>>
+    /**
+     * \brief A burst waiting to be transmitted
+     */
+    struct PacketBurstEntry
+    {
+        Ptr<PacketBurst> m_burst; //!< The burst
+        bool m_shared{false};     //!< Is the burst held by someone else (e.g., the MAC HARQ)?
+    };
+
+    std::unordered_map<uint64_t, PacketBurstEntry>
         m_packetBurstMap; //!< Map between SfnSf and PacketBurst
 
     SlotAllocInfo m_currSlotAllocInfo; //!< Current slot allocation
@@ -582,7 +625,24 @@ class NrPhy : public Object
     std::vector<LteNrTddSlotType> m_tddPattern = {F, F, F, F, F, F, F, F, F, F}; //!< Pattern
 
   private:
-    std::list<SlotAllocInfo> m_slotAllocInfo; //!< slot allocation info list
+    /**
+     * \brief Make sure that a burst stored in m_packetBurstMap can be modified
+     * \param entry the burst, replaced by a copy (that the PHY owns) if it is shared
+     */
+    static void MakeBurstWritable(PacketBurstEntry& entry);
+
+    /**
+     * \brief Store a new allocation in m_slotAllocInfo
+     * \param slotAllocInfo the allocation, for a slot that is not stored
+     *
+     * If the position of the slot is taken by the allocation of another slot,
+     * the ring is doubled.
+     */
+    void StoreSlotAllocInfo(SlotAllocInfo slotAllocInfo);
+
+    friend class NrPhySlotAllocRingTestCase;
+
+    NrSlotRing<SlotAllocInfo> m_slotAllocInfo; //!< slot allocations, by slot number
     std::vector<std::list<Ptr<NrControlMessage>>> m_controlMessageQueue; //!< CTRL message queue
 
     Time m_tbDecodeLatencyUs{MicroSeconds(100)}; //!< transport block decode latency
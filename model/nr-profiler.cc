@@ -0,0 +1,240 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-profiler.h"
+
+#include <ns3/boolean.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+
+NS_LOG_COMPONENT_DEFINE("NrProfiler");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(NrProfiler);
+
+bool NrProfiler::s_enabled = false;
+std::array<NrProfiler::Counter, NrProfiler::NUM_SECTIONS> NrProfiler::s_interval{};
+std::array<NrProfiler::Counter, NrProfiler::NUM_SECTIONS> NrProfiler::s_total{};
+std::mutex NrProfiler::s_mutex;
+bool NrProfiler::s_concurrent = false;
+Ptr<NrProfiler> NrProfiler::s_instance = nullptr;
+
+NrProfiler::NrProfiler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrProfiler::~NrProfiler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+NrProfiler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrProfiler")
+            .SetParent<Object>()
+            .SetGroupName("nr")
+            .AddConstructor<NrProfiler>()
+            .AddAttribute("ReportInterval",
+                          "Simulated time between two reports of the counters",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&NrProfiler::m_reportInterval),
+                          MakeTimeChecker(MilliSeconds(1)))
+            .AddAttribute("OutputFilename",
+                          "Name of the file where the counters will be saved.",
+                          StringValue("NrProfiler.txt"),
+                          MakeStringAccessor(&NrProfiler::m_outputFilename),
+                          MakeStringChecker())
+            // Keep it as the last attribute: enabling the profiler needs the
+            // value of the other ones
+            .AddAttribute("Enabled",
+                          "Enable the collection of wall-clock time and event counters",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrProfiler::SetEnabled, &NrProfiler::GetEnabled),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+void
+NrProfiler::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_reportEvent.Cancel();
+    if (m_outFile.is_open())
+    {
+        m_outFile.close();
+    }
+    Object::DoDispose();
+}
+
+Ptr<NrProfiler>
+NrProfiler::Get()
+{
+    if (s_instance == nullptr)
+    {
+        s_instance = CreateObject<NrProfiler>();
+        Simulator::ScheduleDestroy(&NrProfiler::DestroyInstance);
+    }
+    return s_instance;
+}
+
+const char*
+NrProfiler::GetSectionName(Section section)
+{
+    switch (section)
+    {
+    case BEAMFORMING:
+        return "BEAMFORMING";
+    case SPECTRUM_START_RX:
+        return "SPECTRUM_START_RX";
+    case SPECTRUM_END_RX_DATA:
+        return "SPECTRUM_END_RX_DATA";
+    case INTERFERENCE_CHUNK:
+        return "INTERFERENCE_CHUNK";
+    case ERROR_MODEL:
+        return "ERROR_MODEL";
+    case SCHEDULER_DL:
+        return "SCHEDULER_DL";
+    case SCHEDULER_UL:
+        return "SCHEDULER_UL";
+    case GNB_MAC_SLOT_DL:
+        return "GNB_MAC_SLOT_DL";
+    case GNB_MAC_SLOT_UL:
+        return "GNB_MAC_SLOT_UL";
+    case TRACE_SINK:
+        return "TRACE_SINK";
+    case NUM_SECTIONS:
+        break;
+    }
+    NS_FATAL_ERROR("Unknown section " << +section);
+    return "";
+}
+
+uint64_t
+NrProfiler::GetTotalCount(Section section)
+{
+    return s_total.at(section).m_count;
+}
+
+uint64_t
+NrProfiler::GetTotalNs(Section section)
+{
+    return s_total.at(section).m_ns;
+}
+
+void
+NrProfiler::SetEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(this << enabled);
+    if (enabled == s_enabled)
+    {
+        return;
+    }
+
+    s_enabled = enabled;
+    m_reportEvent.Cancel();
+
+    if (enabled)
+    {
+        s_interval.fill(Counter());
+        m_lastEventCount = Simulator::GetEventCount();
+        m_lastWallTime = std::chrono::steady_clock::now();
+        if (!m_outFile.is_open())
+        {
+            m_firstEventCount = m_lastEventCount;
+            m_firstWallTime = m_lastWallTime;
+            m_outFile.open(m_outputFilename.c_str());
+            if (!m_outFile.is_open())
+            {
+                NS_FATAL_ERROR("Can't open file " << m_outputFilename.c_str());
+            }
+            m_outFile << "% time(s)\tsection\tcount\twallTime(ms)\tavg(us)" << std::endl;
+        }
+        m_reportEvent = Simulator::Schedule(m_reportInterval, &NrProfiler::Report, this);
+    }
+}
+
+bool
+NrProfiler::GetEnabled() const
+{
+    return s_enabled;
+}
+
+void
+NrProfiler::Report()
+{
+    NS_LOG_FUNCTION(this);
+
+    auto now = std::chrono::steady_clock::now();
+    uint64_t eventCount = Simulator::GetEventCount();
+    Write(Simulator::Now().GetSeconds(),
+          s_interval,
+          eventCount - m_lastEventCount,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastWallTime).count());
+
+    s_interval.fill(Counter());
+    m_lastEventCount = eventCount;
+    m_lastWallTime = now;
+
+    // Do not keep alive a simulation that has nothing else to do
+    if (!Simulator::IsFinished())
+    {
+        m_reportEvent = Simulator::Schedule(m_reportInterval, &NrProfiler::Report, this);
+    }
+}
+
+void
+NrProfiler::Write(double time,
+                  const std::array<Counter, NUM_SECTIONS>& counters,
+                  uint64_t events,
+                  uint64_t wallNs)
+{
+    NS_LOG_FUNCTION(this << time << events << wallNs);
+    NS_ASSERT(m_outFile.is_open());
+
+    m_outFile << time << "\tSIMULATOR\t" << events << "\t" << wallNs / 1e6 << "\t"
+              << (events > 0 ? wallNs / 1e3 / events : 0.0) << "\n";
+    for (uint8_t i = 0; i < NUM_SECTIONS; ++i)
+    {
+        const Counter& c = counters.at(i);
+        m_outFile << time << "\t" << GetSectionName(static_cast<Section>(i)) << "\t"
+                  << c.m_count << "\t" << c.m_ns / 1e6 << "\t"
+                  << (c.m_count > 0 ? c.m_ns / 1e3 / c.m_count : 0.0) << "\n";
+    }
+    m_outFile.flush();
+}
+
+void
+NrProfiler::DestroyInstance()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    if (s_instance == nullptr)
+    {
+        return;
+    }
+
+    if (s_instance->m_outFile.is_open())
+    {
+        auto elapsed = std::chrono::steady_clock::now() - s_instance->m_firstWallTime;
+        s_instance->Write(-1.0,
+                          s_total,
+                          Simulator::GetEventCount() - s_instance->m_firstEventCount,
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    s_enabled = false;
+    s_interval.fill(Counter());
+    s_total.fill(Counter());
+    s_instance->Dispose();
+    s_instance = nullptr;
+}
+
+} // namespace ns3
@@ -0,0 +1,293 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_PROFILER_H
+#define NR_PROFILER_H
+
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+namespace ns3
+{
+
+/**
+ * \ingroup utils
+ * \brief Wall-clock and event-count profiler for the NR module
+ *
+ * The profiler collects, for a fixed set of sections of the NR module, how
+ * many times the section has been entered and how much wall-clock time has
+ * been spent inside it. Every ReportInterval of simulated time, the counters
+ * are written in the output file and reset; at the end of the simulation
+ * (Simulator::Destroy) the totals are written as well, with a time of -1.
+ * The number of events executed by the simulator in the interval, and the
+ * wall-clock time that the interval took, are reported in the SIMULATOR line.
+ *
+ * The sections are instrumented with the NrProfiler::ScopedTimer class:
+ *
+ * \code{.cc}
+ * void
+ * NrSomething::DoExpensiveThing ()
+ * {
+ *   NrProfiler::ScopedTimer timer (NrProfiler::SCHEDULER_DL);
+ *   ...
+ * }
+ * \endcode
+ *
+ * The measurement is inclusive: if a section is entered while another
+ * one is running (e.g., the scheduler is called from inside the gNB MAC slot
+ * indication) its time is counted in both.
+ *
+ * The profiler is disabled by default. It is enabled through the attribute
+ * "Enabled", e.g. with Config::SetDefault ("ns3::NrProfiler::Enabled",
+ * BooleanValue (true)) before creating the NrHelper, or from the command
+ * line with --ns3::NrProfiler::Enabled=true. When disabled, the cost of
+ * a ScopedTimer is the check of a static boolean.
+ */
+class NrProfiler : public Object
+{
+  public:
+    /**
+     * \brief The instrumented sections
+     */
+    enum Section : uint8_t
+    {
+        BEAMFORMING,          //!< IdealBeamformingHelper::Run
+        SPECTRUM_START_RX,    //!< NrSpectrumPhy::StartRx
+        SPECTRUM_END_RX_DATA, //!< NrSpectrumPhy::EndRxData
+        INTERFERENCE_CHUNK,   //!< NrInterference::ConditionallyEvaluateChunk
+        ERROR_MODEL,          //!< NrErrorModel::GetTbDecodificationStats
+        SCHEDULER_DL,         //!< NrMacSchedulerNs3::ScheduleDl
+        SCHEDULER_UL,         //!< NrMacSchedulerNs3::ScheduleUl
+        GNB_MAC_SLOT_DL,      //!< NrGnbMac::DoSlotDlIndication
+        GNB_MAC_SLOT_UL,      //!< NrGnbMac::DoSlotUlIndication
+        TRACE_SINK,           //!< Trace sinks of NrPhyRxTrace and NrMacRxTrace
+        NUM_SECTIONS          //!< Not a section, only the number of them
+    };
+
+    /**
+     * \brief Get the type id
+     * \return the type id of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrProfiler constructor
+     */
+    NrProfiler();
+
+    /**
+     * \brief ~NrProfiler
+     */
+    ~NrProfiler() override;
+
+    /**
+     * \brief Get the profiler instance, creating it if needed
+     *
+     * The instance is destroyed at Simulator::Destroy, after writing the totals.
+     *
+     * \return the profiler instance
+     */
+    static Ptr<NrProfiler> Get();
+
+    /**
+     * \brief Is the profiling enabled?
+     * \return true if the profiling is enabled
+     */
+    static bool IsEnabled()
+    {
+        return s_enabled;
+    }
+
+    /**
+     * \brief Get the name of a section
+     * \param section the section
+     * \return the name of the section, as written in the output file
+     */
+    static const char* GetSectionName(Section section);
+
+    /**
+     * \brief Get the number of times a section has been entered since the start
+     * \param section the section
+     * \return the number of times the section has been entered
+     */
+    static uint64_t GetTotalCount(Section section);
+
+    /**
+     * \brief Get the wall-clock time spent in a section since the start
+     * \param section the section
+     * \return the wall-clock time spent in the section, in ns
+     */
+    static uint64_t GetTotalNs(Section section);
+
+    /**
+     * \brief Add a measurement to a section
+     *
+     * It can be called from the threads of the NrParallelSlotExecutor. The
+     * counters are protected by a mutex only while they are running (see
+     * SetConcurrent), so that the single-threaded runs do not pay for it.
+     *
+     * \param section the section
+     * \param ns the wall-clock time spent in the section, in ns
+     */
+    static void Add(Section section, uint64_t ns)
+    {
+        if (s_concurrent)
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            AddToCounters(section, ns);
+        }
+        else
+        {
+            AddToCounters(section, ns);
+        }
+    }
+
+    /**
+     * \brief Tell the profiler if Add can be called from more than one thread
+     *
+     * It is called by the NrParallelSlotExecutor, from the main thread, before
+     * waking up its threads and after they are done.
+     *
+     * \param concurrent true if more than one thread is running
+     */
+    static void SetConcurrent(bool concurrent)
+    {
+        s_concurrent = concurrent;
+    }
+
+    /**
+     * \brief Measure the wall-clock time between its construction and its destruction
+     *
+     * If the profiler is disabled when the timer is created, nothing is measured.
+     */
+    class ScopedTimer
+    {
+      public:
+        /**
+         * \brief ScopedTimer constructor
+         * \param section the section to which the measured time is added
+         */
+        explicit ScopedTimer(Section section)
+            : m_section(section),
+              m_active(s_enabled)
+        {
+            if (m_active)
+            {
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        /**
+         * \brief ~ScopedTimer: add the measured time to the section
+         */
+        ~ScopedTimer()
+        {
+            if (m_active)
+            {
+                auto elapsed = std::chrono::steady_clock::now() - m_start;
+                Add(m_section,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+      private:
+        Section m_section;                             //!< Section being measured
+        bool m_active;                                 //!< Was the profiler enabled at start?
+        std::chrono::steady_clock::time_point m_start; //!< Start of the measurement
+    };
+
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object
+     */
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Counters of a section
+     */
+    struct Counter
+    {
+        uint64_t m_count{0}; //!< Number of times the section has been entered
+        uint64_t m_ns{0};    //!< Wall-clock time spent in the section, in ns
+    };
+
+    /**
+     * \brief Enable or disable the profiling
+     * \param enabled true to enable the profiling
+     */
+    void SetEnabled(bool enabled);
+    /**
+     * \brief Get the value of the Enabled attribute
+     * \return true if the profiling is enabled
+     */
+    bool GetEnabled() const;
+
+    /**
+     * \brief Write the counters of the last interval, reset them, and
+     * schedule the next report
+     */
+    void Report();
+
+    /**
+     * \brief Write a set of counters in the output file
+     * \param time the time to write in the first column
+     * \param counters the counters to write
+     * \param events the number of simulator events
+     * \param wallNs the wall-clock time elapsed, in ns
+     */
+    void Write(double time,
+               const std::array<Counter, NUM_SECTIONS>& counters,
+               uint64_t events,
+               uint64_t wallNs);
+
+    /**
+     * \brief Write the totals, and release the instance
+     */
+    static void DestroyInstance();
+
+    /**
+     * \brief Add a measurement to the counters of a section
+     * \param section the section
+     * \param ns the wall-clock time spent in the section, in ns
+     */
+    static void AddToCounters(Section section, uint64_t ns)
+    {
+        s_interval[section].m_count++;
+        s_interval[section].m_ns += ns;
+        s_total[section].m_count++;
+        s_total[section].m_ns += ns;
+    }
+
+    static bool s_enabled;                               //!< Is the profiling enabled?
+    static std::array<Counter, NUM_SECTIONS> s_interval; //!< Counters of the current interval
+    static std::array<Counter, NUM_SECTIONS> s_total;    //!< Counters since the start
+    static Ptr<NrProfiler> s_instance;                   //!< The profiler instance
+    static std::mutex s_mutex;                           //!< Protects the counters in Add
+    static bool s_concurrent;                            //!< Can Add run in more threads?
+
+    Time m_reportInterval;              //!< Simulated time between two reports
+    std::string m_outputFilename;       //!< Name of the output file
+    std::ofstream m_outFile;            //!< Output file stream
+    EventId m_reportEvent;              //!< Next report event
+    uint64_t m_lastEventCount{0};       //!< Simulator event count at the last report
+    uint64_t m_firstEventCount{0};      //!< Simulator event count when enabled
+    std::chrono::steady_clock::time_point m_lastWallTime;  //!< Wall-clock at the last report
+    std::chrono::steady_clock::time_point m_firstWallTime; //!< Wall-clock when enabled
+};
+
+} // namespace ns3
+
+#endif /* NR_PROFILER_H */
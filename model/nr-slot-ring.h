@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_SLOT_RING_H
+#define NR_SLOT_RING_H
+
+#include "sfnsf.h"
+
+#include <ns3/abort.h>
+#include <ns3/assert.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup utils
+ * \brief A ring of values indexed by slot, for the slots of a bounded horizon
+ *
+ * The value of a slot is stored in the position SfnSf::Normalize() modulo the
+ * capacity of the ring, which is a power of two. The owner reserves the
+ * capacity for the number of slots that can be stored at the same time
+ * (Reserve): storing a slot whose position is taken by another stored slot
+ * means that the horizon is too short, and aborts the simulation.
+ *
+ * A released position keeps its value, as the owner left it, until another
+ * slot takes it: the owner can move the value out, or clear it and keep its
+ * storage for the next slot.
+ *
+ * \tparam T the type of the values
+ */
+template <typename T>
+class NrSlotRing
+{
+  public:
+    /**
+     * \brief Make room for a number of slots stored at the same time
+     * \param numSlots the number of slots
+     *
+     * The capacity is rounded up to a power of two, and never reduced. The
+     * stored values are kept: two slots in different positions are still in
+     * different positions in a larger ring.
+     */
+    void Reserve(std::size_t numSlots)
+    {
+        std::size_t capacity = 1;
+        while (capacity < numSlots)
+        {
+            capacity *= 2;
+        }
+        if (capacity <= m_entries.size())
+        {
+            return;
+        }
+
+        std::vector<Entry> entries(capacity);
+        for (auto& entry : m_entries)
+        {
+            if (entry.m_used)
+            {
+                entries[entry.m_slot & (capacity - 1)] = std::move(entry);
+            }
+        }
+        m_entries = std::move(entries);
+    }
+
+    /**
+     * \return the number of positions of the ring
+     */
+    std::size_t GetCapacity() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * \return the number of stored slots
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * \brief Check if a slot can be stored without overflowing the ring
+     * \param sfn the slot
+     * \return true if the slot is stored, or if its position is free
+     */
+    bool CanStore(const SfnSf& sfn) const
+    {
+        if (m_entries.empty())
+        {
+            return false;
+        }
+        const uint64_t slot = sfn.Normalize();
+        const auto& entry = m_entries[slot & (m_entries.size() - 1)];
+        return !entry.m_used || entry.m_slot == slot;
+    }
+
+    /**
+     * \brief Find the value of a slot
+     * \param sfn the slot
+     * \return the value of the slot, or nullptr if the slot is not stored
+     */
+    T* Find(const SfnSf& sfn)
+    {
+        return const_cast<T*>(static_cast<const NrSlotRing*>(this)->Find(sfn));
+    }
+
+    /**
+     * \copydoc Find
+     */
+    const T* Find(const SfnSf& sfn) const
+    {
+        if (m_entries.empty())
+        {
+            return nullptr;
+        }
+        const uint64_t slot = sfn.Normalize();
+        const auto& entry = m_entries[slot & (m_entries.size() - 1)];
+        if (entry.m_used && entry.m_slot == slot)
+        {
+            return &(*entry.m_value);
+        }
+        return nullptr;
+    }
+
+    /**
+     * \brief Get the value of a slot, storing the slot if it is not stored
+     * \param sfn the slot
+     * \param args the arguments to construct the value, if its position never had one
+     * \return the value of the slot
+     *
+     * A new slot gets the value left in its position by the last released slot.
+     */
+    template <typename... Args>
+    T& Get(const SfnSf& sfn, Args&&... args)
+    {
+        NS_ABORT_MSG_IF(m_entries.empty(), "The ring has no capacity");
+        const uint64_t slot = sfn.Normalize();
+        auto& entry = m_entries[slot & (m_entries.size() - 1)];
+        if (entry.m_used)
+        {
+            NS_ABORT_MSG_IF(entry.m_slot != slot,
+                            "The slot " << slot << " takes the position of the slot "
+                                        << entry.m_slot << ", still stored: a ring of "
+                                        << m_entries.size() << " slots is too short");
+            return *entry.m_value;
+        }
+
+        entry.m_used = true;
+        entry.m_slot = slot;
+        if (!entry.m_value.has_value())
+        {
+            entry.m_value.emplace(std::forward<Args>(args)...);
+        }
+        ++m_size;
+        return *entry.m_value;
+    }
+
+    /**
+     * \brief Release a stored slot
+     * \param sfn the slot
+     * \return the value of the slot, that stays in its position
+     */
+    T& Release(const SfnSf& sfn)
+    {
+        NS_ASSERT_MSG(Find(sfn) != nullptr, "The slot " << sfn.Normalize() << " is not stored");
+        auto& entry = m_entries[sfn.Normalize() & (m_entries.size() - 1)];
+        entry.m_used = false;
+        --m_size;
+        return *entry.m_value;
+    }
+
+    /**
+     * \brief Release the earliest stored slot
+     * \return the value of the slot, that stays in its position
+     */
+    T& ReleaseFirst()
+    {
+        NS_ASSERT(m_size > 0);
+        Entry* first = nullptr;
+        for (auto& entry : m_entries)
+        {
+            if (entry.m_used && (first == nullptr || entry.m_slot < first->m_slot))
+            {
+                first = &entry;
+            }
+        }
+        first->m_used = false;
+        --m_size;
+        return *first->m_value;
+    }
+
+    /**
+     * \brief Remove all the slots and the capacity of the ring
+     */
+    void Clear()
+    {
+        m_entries.clear();
+        m_size = 0;
+    }
+
+  private:
+    /**
+     * \brief A position of the ring
+     */
+    struct Entry
+    {
+        uint64_t m_slot{0};         //!< The slot (SfnSf::Normalize) stored in the position
+        bool m_used{false};         //!< Does the position hold the value of m_slot?
+        std::optional<T> m_value{}; //!< The value, kept after the release
+    };
+
+    std::vector<Entry> m_entries; //!< The positions, by slot number modulo their number
+    std::size_t m_size{0};        //!< Number of stored slots
+};
+
+} // namespace ns3
+
+#endif // NR_SLOT_RING_H
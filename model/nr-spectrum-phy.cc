@@ -9,6 +9,8 @@
 #include "nr-gnb-net-device.h"
 #include "nr-gnb-phy.h"
 #include "nr-lte-mi-error-model.h"
+#include "nr-profiler.h"
+#include "nr-trace-guard.h"
 #include "nr-ue-net-device.h"
 #include "nr-ue-phy.h"
 
@@ -98,6 +100,11 @@ NrSpectrumPhy::DoDispose()
         m_interferenceSrs = nullptr;
     }
 
+    if (m_beamManager)
+    {
+        m_beamManager->Dispose();
+    }
+
     m_interferenceData = nullptr;
     m_interferenceCtrl = nullptr;
     m_mobility = nullptr;
@@ -395,6 +402,7 @@ void
 NrSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::SPECTRUM_START_RX);
     Ptr<const SpectrumValue> rxPsd = params->psd;
     Time duration = params->duration;
     NS_LOG_INFO("Start receiving signal: " << rxPsd << " duration= " << duration);
@@ -1258,6 +1266,7 @@ void
 NrSpectrumPhy::EndRxData()
 {
     NS_LOG_FUNCTION(this);
+    NrProfiler::ScopedTimer timer(NrProfiler::SPECTRUM_END_RX_DATA);
     m_interferenceData->EndRx();
 
     Ptr<NrGnbNetDevice> enbRx = DynamicCast<NrGnbNetDevice>(GetDevice());
@@ -1326,13 +1335,15 @@ NrSpectrumPhy::EndRxData()
 
         // Output is the output of the error model. From the TBLER we decide
         // if the entire TB is corrupted or not
-
-        GetTBInfo(tbIt).m_outputOfEM =
-            m_errorModel->GetTbDecodificationStats(m_sinrPerceived,
-                                                   GetTBInfo(tbIt).m_expected.m_rbBitmap,
-                                                   GetTBInfo(tbIt).m_expected.m_tbSize,
-                                                   GetTBInfo(tbIt).m_expected.m_mcs,
-                                                   harqInfoList);
+        {
+            NrProfiler::ScopedTimer timer(NrProfiler::ERROR_MODEL);
+            GetTBInfo(tbIt).m_outputOfEM =
+                m_errorModel->GetTbDecodificationStats(m_sinrPerceived,
+                                                       GetTBInfo(tbIt).m_expected.m_rbBitmap,
+                                                       GetTBInfo(tbIt).m_expected.m_tbSize,
+                                                       GetTBInfo(tbIt).m_expected.m_mcs,
+                                                       harqInfoList);
+        }
         GetTBInfo(tbIt).m_isCorrupted =
             m_random->GetValue() > GetTBInfo(tbIt).m_outputOfEM->m_tbler ? false : true;
 
@@ -1383,47 +1394,54 @@ NrSpectrumPhy::EndRxData()
                 NS_LOG_INFO("TB failed");
             }
 
-            RxPacketTraceParams traceParams;
-            traceParams.m_tbSize = GetTBInfo(*itTb).m_expected.m_tbSize;
-            traceParams.m_frameNum = GetTBInfo(*itTb).m_expected.m_sfn.GetFrame();
-            traceParams.m_subframeNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSubframe();
-            traceParams.m_slotNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSlot();
-            traceParams.m_rnti = rnti;
-            traceParams.m_mcs = GetTBInfo(*itTb).m_expected.m_mcs;
-            traceParams.m_rv = GetTBInfo(*itTb).m_expected.m_rv;
-            traceParams.m_sinr = GetTBInfo(*itTb).m_sinrAvg;
-            traceParams.m_sinrMin = GetTBInfo(*itTb).m_sinrMin;
-            if (m_dataErrorModelEnabled)
+            // Fill the trace parameters (and compute the CQI, for the UE) only
+            // if someone is listening
+            const bool traced = enbRx ? NR_TRACE_ENABLED(m_rxPacketTraceEnb)
+                                      : (ueRx && NR_TRACE_ENABLED(m_rxPacketTraceUe));
+            if (traced)
             {
-                traceParams.m_tbler = GetTBInfo(*itTb).m_outputOfEM->m_tbler;
-                traceParams.m_corrupt = GetTBInfo(*itTb).m_isCorrupted;
-            }
-            else
-            {
-                // when error model is disabled a received TB has no
-                // error, thus, TBLER would be 0 and it would be
-                // considered as not corrupt.
-                traceParams.m_tbler = 0;
-                traceParams.m_corrupt = false;
-            }
-            traceParams.m_symStart = GetTBInfo(*itTb).m_expected.m_symStart;
-            traceParams.m_numSym = GetTBInfo(*itTb).m_expected.m_numSym;
-            traceParams.m_bwpId = GetBwpId();
-            traceParams.m_streamId = m_streamId;
-            traceParams.m_rbAssignedNum =
-                static_cast<uint32_t>(GetTBInfo(*itTb).m_expected.m_rbBitmap.size());
-
-            if (enbRx)
-            {
-                traceParams.m_cellId = enbRx->GetCellId();
-                m_rxPacketTraceEnb(traceParams);
-            }
-            else if (ueRx)
-            {
-                traceParams.m_cellId = ueRx->GetTargetEnb()->GetCellId();
-                Ptr<NrUePhy> phy = (DynamicCast<NrUePhy>(m_phy));
-                traceParams.m_cqi = phy->ComputeCqi(m_sinrPerceived);
-                m_rxPacketTraceUe(traceParams);
+                RxPacketTraceParams traceParams;
+                traceParams.m_tbSize = GetTBInfo(*itTb).m_expected.m_tbSize;
+                traceParams.m_frameNum = GetTBInfo(*itTb).m_expected.m_sfn.GetFrame();
+                traceParams.m_subframeNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSubframe();
+                traceParams.m_slotNum = GetTBInfo(*itTb).m_expected.m_sfn.GetSlot();
+                traceParams.m_rnti = rnti;
+                traceParams.m_mcs = GetTBInfo(*itTb).m_expected.m_mcs;
+                traceParams.m_rv = GetTBInfo(*itTb).m_expected.m_rv;
+                traceParams.m_sinr = GetTBInfo(*itTb).m_sinrAvg;
+                traceParams.m_sinrMin = GetTBInfo(*itTb).m_sinrMin;
+                if (m_dataErrorModelEnabled)
+                {
+                    traceParams.m_tbler = GetTBInfo(*itTb).m_outputOfEM->m_tbler;
+                    traceParams.m_corrupt = GetTBInfo(*itTb).m_isCorrupted;
+                }
+                else
+                {
+                    // when error model is disabled a received TB has no
+                    // error, thus, TBLER would be 0 and it would be
+                    // considered as not corrupt.
+                    traceParams.m_tbler = 0;
+                    traceParams.m_corrupt = false;
+                }
+                traceParams.m_symStart = GetTBInfo(*itTb).m_expected.m_symStart;
+                traceParams.m_numSym = GetTBInfo(*itTb).m_expected.m_numSym;
+                traceParams.m_bwpId = GetBwpId();
+                traceParams.m_streamId = m_streamId;
+                traceParams.m_rbAssignedNum =
+                    static_cast<uint32_t>(GetTBInfo(*itTb).m_expected.m_rbBitmap.size());
+
+                if (enbRx)
+                {
+                    traceParams.m_cellId = enbRx->GetCellId();
+                    m_rxPacketTraceEnb(traceParams);
+                }
+                else if (ueRx)
+                {
+                    traceParams.m_cellId = ueRx->GetTargetEnb()->GetCellId();
+                    Ptr<NrUePhy> phy = (DynamicCast<NrUePhy>(m_phy));
+                    traceParams.m_cqi = phy->ComputeCqi(m_sinrPerceived);
+                    m_rxPacketTraceUe(traceParams);
+                }
             }
 
             // send HARQ feedback (if not already done for this TB)
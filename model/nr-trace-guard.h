@@ -0,0 +1,43 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef NR_TRACE_GUARD_H
+#define NR_TRACE_GUARD_H
+
+#include <ns3/traced-callback.h>
+
+/**
+ * \ingroup utils
+ * \brief Check if a trace source has to be fired
+ *
+ * Many trace sources of the NR module need a payload (e.g., a control message,
+ * or a struct with the scheduling information) that is built only to fire the
+ * trace. To avoid paying for it when nobody listens, build the payload and fire
+ * the trace only when this predicate is true:
+ *
+ * \code{.cc}
+ * if (NR_TRACE_ENABLED (m_macRxedCtrlMsgsTrace))
+ *   {
+ *     Ptr<NrDlCqiMessage> msg = Create<NrDlCqiMessage> ();
+ *     ...
+ *     m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), rnti, GetBwpId (), msg);
+ *   }
+ * \endcode
+ *
+ * When the module is built with the CMake option NR_DISABLE_TRACES, the predicate
+ * is always false, and the compiler removes the guarded code. The trace sources
+ * are still registered, so connecting to them is not an error, but the guarded
+ * ones will never fire.
+ *
+ * \param trace the TracedCallback to check
+ */
+#ifdef NR_DISABLE_TRACES
+#define NR_TRACE_ENABLED(trace) false
+#else
+#define NR_TRACE_ENABLED(trace) (!(trace).IsEmpty())
+#endif
+
+#endif /* NR_TRACE_GUARD_H */
@@ -15,8 +15,11 @@
 
 #include "nr-control-messages.h"
 #include "nr-mac-header-vs.h"
+#include "nr-mac-long-bsr-ce.h"
 #include "nr-mac-short-bsr-ce.h"
+#include "nr-mac-short-truncated-bsr-ce.h"
 #include "nr-phy-sap.h"
+#include "nr-trace-guard.h"
 
 #include <ns3/boolean.h>
 #include <ns3/log.h>
@@ -24,6 +27,8 @@
 #include <ns3/random-variable-stream.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -216,6 +221,12 @@ NrUeMac::GetTypeId()
                 UintegerValue(20),
                 MakeUintegerAccessor(&NrUeMac::SetNumHarqProcess, &NrUeMac::GetNumHarqProcess),
                 MakeUintegerChecker<uint8_t>())
+            .AddAttribute("EnableLongBsr",
+                          "If true, a LONG_BSR is sent when more than one LCG has data "
+                          "(TS 38.321 5.4.5); if false, only the SHORT_BSR is used",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrUeMac::m_longBsrEnabled),
+                          MakeBooleanChecker())
             .AddTraceSource("UeMacRxedCtrlMsgsTrace",
                             "Ue MAC Control Messages Traces.",
                             MakeTraceSourceAccessor(&NrUeMac::m_macRxedCtrlMsgsTrace),
@@ -397,6 +408,111 @@ NrUeMac::DoReportBufferStatus(LteMacSapProvider::ReportBufferStatusParameters pa
     }
 }
 
+std::vector<uint32_t>
+NrUeMac::GetLcgBufferSizes() const
+{
+    std::vector<uint32_t> queue(NrMacLongBsrCe::MAX_LCG, 0);
+    for (const auto& itBsr : m_ulBsrReceived)
+    {
+        uint8_t lcid = itBsr.first;
+        const auto& bsr = itBsr.second;
+        auto lcInfoMapIt = m_lcInfoMap.find(lcid);
+        NS_ASSERT(lcInfoMapIt != m_lcInfoMap.end());
+        NS_ASSERT_MSG((lcid != 0) || ((bsr.txQueueSize == 0) && (bsr.retxQueueSize == 0) &&
+                                      (bsr.statusPduSize == 0)),
+                      "BSR should not be used for LCID 0");
+        uint8_t lcg = lcInfoMapIt->second.lcConfig.logicalChannelGroup;
+        NS_ABORT_MSG_IF(lcg >= NrMacLongBsrCe::MAX_LCG,
+                        "LCG " << +lcg << " not supported (max " << +NrMacLongBsrCe::MAX_LCG
+                               << ")");
+        queue.at(lcg) += (bsr.txQueueSize + bsr.retxQueueSize + bsr.statusPduSize);
+
+        if (bsr.txQueueSize > 0)
+        {
+            NS_LOG_DEBUG("Adding 3 bytes for TX subheader.");
+            queue.at(lcg) += 3;
+        }
+        if (bsr.retxQueueSize > 0)
+        {
+            NS_LOG_DEBUG("Adding 3 bytes for RX subheader.");
+            queue.at(lcg) += 3;
+        }
+    }
+    return queue;
+}
+
+NrUeMac::BsrFormat
+NrUeMac::SelectBsrFormat(const std::vector<uint32_t>& lcgBufferSizes,
+                         uint32_t availableBytes) const
+{
+    auto activeLcgs = static_cast<uint8_t>(
+        std::count_if(lcgBufferSizes.begin(), lcgBufferSizes.end(), [](uint32_t v) {
+            return v > 0;
+        }));
+
+    // TS 38.321 5.4.5: LONG_BSR if more than one LCG has data available for
+    // transmission, SHORT_BSR otherwise. When the LONG_BSR does not fit in the
+    // grant, the standard reports a truncated BSR; we fall back to our SHORT_BSR,
+    // which anyway carries the level of all our LCGs, if all of them are
+    // between 0 and 3, and to the one-octet truncated BSR otherwise.
+    if (m_longBsrEnabled && activeLcgs > 1 &&
+        NrMacLongBsrCe::GetSerializedSizeFor(activeLcgs) <= availableBytes)
+    {
+        return LONG_BSR;
+    }
+    if (std::none_of(lcgBufferSizes.begin() + 4, lcgBufferSizes.end(), [](uint32_t v) {
+            return v > 0;
+        }) &&
+        NrMacShortBsrCe().GetSerializedSize() <= availableBytes)
+    {
+        return SHORT_BSR;
+    }
+    return SHORT_TRUNCATED_BSR;
+}
+
+uint32_t
+NrUeMac::GetBsrSize(const std::vector<uint32_t>& lcgBufferSizes, uint32_t availableBytes) const
+{
+    switch (SelectBsrFormat(lcgBufferSizes, availableBytes))
+    {
+    case LONG_BSR:
+        return NrMacLongBsrCe::GetSerializedSizeFor(static_cast<uint8_t>(
+            std::count_if(lcgBufferSizes.begin(), lcgBufferSizes.end(), [](uint32_t v) {
+                return v > 0;
+            })));
+    case SHORT_BSR:
+        return NrMacShortBsrCe().GetSerializedSize();
+    case SHORT_TRUNCATED_BSR:
+        return NrMacShortTruncatedBsrCe().GetSerializedSize();
+    }
+    NS_FATAL_ERROR("Unknown BSR format");
+}
+
+uint8_t
+NrUeMac::GetHighestPriorityLcg() const
+{
+    // Lower values mean higher priorities; ties go to the lowest LCG
+    uint8_t bestPriority = UINT8_MAX;
+    uint8_t bestLcg = UINT8_MAX;
+    for (const auto& itBsr : m_ulBsrReceived)
+    {
+        const auto& bsr = itBsr.second;
+        if (bsr.txQueueSize + bsr.retxQueueSize + bsr.statusPduSize == 0)
+        {
+            continue;
+        }
+        const auto& lcConfig = m_lcInfoMap.at(itBsr.first).lcConfig;
+        if (lcConfig.priority < bestPriority ||
+            (lcConfig.priority == bestPriority && lcConfig.logicalChannelGroup < bestLcg))
+        {
+            bestPriority = lcConfig.priority;
+            bestLcg = lcConfig.logicalChannelGroup;
+        }
+    }
+    // Only the BSR overhead can be waiting: report it in the first LCG
+    return bestLcg == UINT8_MAX ? 0 : bestLcg;
+}
+
 void
 NrUeMac::SendReportBufferStatus(const SfnSf& dataSfn, uint8_t symStart)
 {
@@ -418,69 +534,85 @@ NrUeMac::SendReportBufferStatus(const SfnSf& dataSfn, uint8_t symStart)
     bsr.m_macCeType = MacCeElement::BSR;
 
     // BSR is reported for each LCG
-    std::unordered_map<uint8_t, LteMacSapProvider::ReportBufferStatusParameters>::iterator it;
-    std::vector<uint32_t> queue(4, 0); // one value per each of the 4 LCGs, initialized to 0
-    for (it = m_ulBsrReceived.begin(); it != m_ulBsrReceived.end(); it++)
+    std::vector<uint32_t> queue = GetLcgBufferSizes();
+
+    uint32_t availableBytes = m_ulDci->m_tbSize.at(0) - m_ulDciTotalUsed;
+    BsrFormat format = SelectBsrFormat(queue, availableBytes);
+    uint32_t bsrSize = GetBsrSize(queue, availableBytes);
+    static const char* const formatNames[] = {"SHORT_BSR", "LONG_BSR", "SHORT_TRUNCATED_BSR"};
+
+    // The BSR we are going to send now will be sent also in the next grant:
+    // take its overhead into account only once, in the first LCG with data
+    auto firstActiveLcg =
+        std::find_if(queue.begin(), queue.end(), [](uint32_t v) { return v > 0; });
+    if (firstActiveLcg != queue.end())
     {
-        uint8_t lcid = it->first;
-        std::unordered_map<uint8_t, LcInfo>::iterator lcInfoMapIt;
-        lcInfoMapIt = m_lcInfoMap.find(lcid);
-        NS_ASSERT(lcInfoMapIt != m_lcInfoMap.end());
-        NS_ASSERT_MSG((lcid != 0) ||
-                          (((*it).second.txQueueSize == 0) && ((*it).second.retxQueueSize == 0) &&
-                           ((*it).second.statusPduSize == 0)),
-                      "BSR should not be used for LCID 0");
-        uint8_t lcg = lcInfoMapIt->second.lcConfig.logicalChannelGroup;
-        queue.at(lcg) +=
-            ((*it).second.txQueueSize + (*it).second.retxQueueSize + (*it).second.statusPduSize);
+        NS_LOG_DEBUG("Adding " << bsrSize << " bytes for " << formatNames[format] << ".");
+        *firstActiveLcg += bsrSize;
+    }
 
-        if (queue.at(lcg) != 0)
-        {
-            NS_LOG_DEBUG("Adding 5 bytes for SHORT_BSR.");
-            queue.at(lcg) += 5;
-        }
-        if ((*it).second.txQueueSize > 0)
-        {
-            NS_LOG_DEBUG("Adding 3 bytes for TX subheader.");
-            queue.at(lcg) += 3;
-        }
-        if ((*it).second.retxQueueSize > 0)
+    NS_LOG_INFO("Sending " << formatNames[format] << " with this info for the LCG: "
+                           << queue.at(0) << " " << queue.at(1) << " " << queue.at(2) << " "
+                           << queue.at(3));
+
+    // Here we send the real BSR, as a subpdu.
+    Ptr<Packet> p = Create<Packet>();
+    uint8_t bsrLcId = NrMacHeaderFsUl::SHORT_BSR;
+
+    if (format == LONG_BSR)
+    {
+        // The scheduler recognizes the LONG_BSR (and its 8-bit levels) from
+        // the size of the buffer status vector.
+        NrMacLongBsrCe header;
+        for (uint8_t lcg = 0; lcg < NrMacLongBsrCe::MAX_LCG; ++lcg)
         {
-            NS_LOG_DEBUG("Adding 3 bytes for RX subheader.");
-            queue.at(lcg) += 3;
+            header.m_bufferSizeLevel[lcg] = NrMacLongBsrCe::FromBytesToLevel(queue.at(lcg));
+            bsr.m_macCeValue.m_bufferStatus.push_back(header.m_bufferSizeLevel[lcg]);
         }
+        p->AddHeader(header);
+        bsrLcId = NrMacHeaderVsUl::LONG_BSR;
+    }
+    else if (format == SHORT_BSR)
+    {
+        // Please note that the levels are defined from the standard. In this case,
+        // we have 5 bit available, so use such standard levels.
+        NrMacShortBsrCe header;
+        header.m_bufferSizeLevel_0 = NrMacShortBsrCe::FromBytesToLevel(queue.at(0));
+        header.m_bufferSizeLevel_1 = NrMacShortBsrCe::FromBytesToLevel(queue.at(1));
+        header.m_bufferSizeLevel_2 = NrMacShortBsrCe::FromBytesToLevel(queue.at(2));
+        header.m_bufferSizeLevel_3 = NrMacShortBsrCe::FromBytesToLevel(queue.at(3));
+
+        // FF API says that all 4 LCGs are always present
+        bsr.m_macCeValue.m_bufferStatus.push_back(header.m_bufferSizeLevel_0);
+        bsr.m_macCeValue.m_bufferStatus.push_back(header.m_bufferSizeLevel_1);
+        bsr.m_macCeValue.m_bufferStatus.push_back(header.m_bufferSizeLevel_2);
+        bsr.m_macCeValue.m_bufferStatus.push_back(header.m_bufferSizeLevel_3);
+        p->AddHeader(header);
+    }
+    else
+    {
+        // Only one LCG is reported: the one with the highest priority, if
+        // more than one has data
+        NrMacShortTruncatedBsrCe header;
+        header.m_lcg = GetHighestPriorityLcg();
+        header.m_bufferSizeLevel = NrMacShortBsrCe::FromBytesToLevel(queue.at(header.m_lcg));
+        bsr.m_macCeValue.m_bufferStatus = header.ToLongBsrLevels();
+        bsr.m_macCeValue.m_truncatedLcg = header.m_lcg;
+        p->AddHeader(header);
+        bsrLcId = NrMacHeaderFsUl::SHORT_TRUNCATED_BSR;
     }
-
-    NS_LOG_INFO("Sending BSR with this info for the LCG: "
-                << queue.at(0) << " " << queue.at(1) << " " << queue.at(2) << " " << queue.at(3));
-    // FF API says that all 4 LCGs are always present
-    bsr.m_macCeValue.m_bufferStatus.push_back(NrMacShortBsrCe::FromBytesToLevel(queue.at(0)));
-    bsr.m_macCeValue.m_bufferStatus.push_back(NrMacShortBsrCe::FromBytesToLevel(queue.at(1)));
-    bsr.m_macCeValue.m_bufferStatus.push_back(NrMacShortBsrCe::FromBytesToLevel(queue.at(2)));
-    bsr.m_macCeValue.m_bufferStatus.push_back(NrMacShortBsrCe::FromBytesToLevel(queue.at(3)));
 
     // create the message. It is used only for tracing, but we don't send it...
-    Ptr<NrBsrMessage> msg = Create<NrBsrMessage>();
-    msg->SetSourceBwp(GetBwpId());
-    msg->SetBsr(bsr);
-
-    m_macTxedCtrlMsgsTrace(m_currentSlot, GetCellId(), bsr.m_rnti, GetBwpId(), msg);
-
-    // Here we send the real SHORT_BSR, as a subpdu.
-    Ptr<Packet> p = Create<Packet>();
-
-    // Please note that the levels are defined from the standard. In this case,
-    // we have 5 bit available, so use such standard levels. In the future,
-    // when LONG BSR will be implemented, this have to change.
-    NrMacShortBsrCe header;
-    header.m_bufferSizeLevel_0 = NrMacShortBsrCe::FromBytesToLevel(queue.at(0));
-    header.m_bufferSizeLevel_1 = NrMacShortBsrCe::FromBytesToLevel(queue.at(1));
-    header.m_bufferSizeLevel_2 = NrMacShortBsrCe::FromBytesToLevel(queue.at(2));
-    header.m_bufferSizeLevel_3 = NrMacShortBsrCe::FromBytesToLevel(queue.at(3));
+    if (NR_TRACE_ENABLED(m_macTxedCtrlMsgsTrace))
+    {
+        Ptr<NrBsrMessage> msg = Create<NrBsrMessage>();
+        msg->SetSourceBwp(GetBwpId());
+        msg->SetBsr(bsr);
 
-    p->AddHeader(header);
+        m_macTxedCtrlMsgsTrace(m_currentSlot, GetCellId(), bsr.m_rnti, GetBwpId(), msg);
+    }
 
-    LteRadioBearerTag bearerTag(m_rnti, NrMacHeaderFsUl::SHORT_BSR, 0);
+    LteRadioBearerTag bearerTag(m_rnti, bsrLcId, 0);
     p->AddPacketTag(bearerTag);
 
     m_ulDciTotalUsed += p->GetSize();
@@ -710,6 +842,9 @@ NrUeMac::TransmitRetx()
         {
             NS_FATAL_ERROR("No radio bearer tag");
         }
+        // Keep track of the space used, so that the BSR that follows will
+        // fit in what was left of the original transmission
+        m_ulDciTotalUsed += pkt->GetSize();
         // MIMO is not supported for UL yet.
         // Therefore, there will be only
         // one stream with stream Id 0.
@@ -856,12 +991,15 @@ NrUeMac::SendNewData()
     // Of the TBS we received in the DCI, one part is gone for the status pdu,
     // where we didn't check much as it is the most important data, that has to go
     // out. For the rest that we have left, we can use only a part of it because of
-    // the overhead of the SHORT_BSR, which is 5 bytes.
-    NS_ASSERT_MSG(m_ulDciTotalUsed + 5 <= m_ulDci->m_tbSize.at(0),
+    // the overhead of the BSR. Sending data can only decrease the number of LCG
+    // with data, so the BSR that we will send at the end fits in this reservation.
+    uint32_t bsrSize =
+        GetBsrSize(GetLcgBufferSizes(), m_ulDci->m_tbSize.at(0) - m_ulDciTotalUsed);
+    NS_ASSERT_MSG(m_ulDciTotalUsed + bsrSize <= m_ulDci->m_tbSize.at(0),
                   "The StatusPDU used " << m_ulDciTotalUsed
-                                        << " B, we don't have any for the SHORT_BSR.");
-    // reserve some data for the SHORT_BSR
-    uint32_t usefulTbs = m_ulDci->m_tbSize.at(0) - m_ulDciTotalUsed - 5;
+                                        << " B, we don't have any for the BSR.");
+    // reserve some data for the BSR
+    uint32_t usefulTbs = m_ulDci->m_tbSize.at(0) - m_ulDciTotalUsed - bsrSize;
 
     // Now, we have 3 bytes of overhead for each subPDU. Let's try to serve all
     // the queues with some RETX data.
@@ -894,9 +1032,9 @@ NrUeMac::SendNewData()
     // Remember that m_ulDciTotalUsed keep count of data and overhead that we
     // used till now.
     NS_ASSERT_MSG(
-        m_ulDciTotalUsed + 5 <= m_ulDci->m_tbSize.at(0),
-        "The StatusPDU and RETX sending required all space, we don't have any for the SHORT_BSR.");
-    usefulTbs = m_ulDci->m_tbSize.at(0) - m_ulDciTotalUsed - 5; // Update the usefulTbs.
+        m_ulDciTotalUsed + bsrSize <= m_ulDci->m_tbSize.at(0),
+        "The StatusPDU and RETX sending required all space, we don't have any for the BSR.");
+    usefulTbs = m_ulDci->m_tbSize.at(0) - m_ulDciTotalUsed - bsrSize; // Update the usefulTbs.
 
     // The last part is for the queues with some non-RETX data. If there is no space left,
     // then nothing.
@@ -1059,9 +1197,12 @@ NrUeMac::SendRaPreamble([[maybe_unused]] bool contention)
     /*raRnti should be subframeNo -1 */
     m_raRnti = 1;
 
-    Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage>();
-    rachMsg->SetSourceBwp(GetBwpId());
-    m_macTxedCtrlMsgsTrace(m_currentSlot, GetCellId(), m_rnti, GetBwpId(), rachMsg);
+    if (NR_TRACE_ENABLED(m_macTxedCtrlMsgsTrace))
+    {
+        Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage>();
+        rachMsg->SetSourceBwp(GetBwpId());
+        m_macTxedCtrlMsgsTrace(m_currentSlot, GetCellId(), m_rnti, GetBwpId(), rachMsg);
+    }
 
     m_phySapProvider->SendRachPreamble(m_raPreambleId, m_raRnti);
 }
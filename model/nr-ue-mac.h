@@ -25,6 +25,7 @@ class NrControlMessage;
 class UniformRandomVariable;
 class PacketBurst;
 class NrUlDciMessage;
+class NrUeMacBsrFormatTest;
 
 /**
  * \ingroup ue-mac
@@ -45,13 +46,13 @@ class NrUlDciMessage;
  * the UE has some data to transmit (without indicating the precise quantity).
  *
  * The GNB then allocates some data (a quantity that is implementation-defined)
- * to the UE, in which it can transmit data and a SHORT_BSR.
+ * to the UE, in which it can transmit data and a BSR.
  *
  * \section ue_mac_response_to_dci Response to a DCI
  *
  * When the UE receives an UL_DCI, it can use a part of it to send a Control Element.
  * The most used control element (and, by the way, the only we support right now)
- * is SHORT_BSR, in which the UE informs the GNB of its buffer status. The rest
+ * is the BSR, in which the UE informs the GNB of its buffer status. The rest
  * of the bytes can be used to send data.
  *
  * In the standard, the UE is allowed to send a single PDU in response to a
@@ -78,17 +79,34 @@ class NrUlDciMessage;
  * The core of this small "scheduling" is done in method SendNewData(), in which
  * the MAC will try to send as many status-subPDUs as possible, then will try
  * to send as many as retx-subPDUs as possible, and finally as many as tx-subPDUs
- * as possible. At the end of all the subPDUs, it will be sent a SHORT_BSR, to
- * indicate to the GNB the new status of the RLC queues. As the SHORT_BSR is
+ * as possible. At the end of all the subPDUs, it will be sent a BSR, to
+ * indicate to the GNB the new status of the RLC queues. As the BSR is
  * a CE and is treated in the same way as data, it may be lost. Please note that
- * the code substract the amount of bytes devoted to the SHORT_BSR from the
+ * the code substract the amount of bytes devoted to the BSR from the
  * available ones, so there will always be a space to send it. The only
  * exception (theoretically possible) is when the status PDUs use all the
  * available space; in this case, a rework of the code will be needed.
  *
+ * \section ue_mac_bsr BSR format
+ *
+ * The format of the BSR is selected following the rules of TS 38.321
+ * section 5.4.5: if more than one LCG has data available for transmission
+ * when the MAC PDU containing the BSR is built, a LONG_BSR (NrMacLongBsrCe)
+ * is sent, reporting all the LCG with data with the 8-bit buffer levels.
+ * Otherwise, a SHORT_BSR (NrMacShortBsrCe) is sent. If the grant does not leave
+ * enough space for the LONG_BSR (e.g., in a retransmission), the UE falls back
+ * to the SHORT_BSR, as the standard does with the truncated BSR. The LONG_BSR
+ * can be disabled through the attribute EnableLongBsr.
+ *
+ * The SHORT_BSR reports only LCG 0 to 3. When there is data in the other
+ * LCGs, and the LONG_BSR is not sent (only one LCG has data, it does not fit,
+ * or it is disabled), or when the SHORT_BSR does not fit, the UE sends the
+ * one-octet NrMacShortTruncatedBsrCe, which reports the LCG of the logical
+ * channel with the highest priority. The gNB considers the other LCGs empty,
+ * until the next BSR.
+ *
  * The SHORT_BSR is not reflecting the standard, but it is the same data that
- * was sent in LENA, indicating the status of 4 LCG at once with an 8-bit value.
- * Making this part standard-compliant is a good novice exercise.
+ * was sent in LENA, indicating the status of 4 LCG at once with a 5-bit value.
  *
  * \section ue_mac_configuration Configuration
  *
@@ -108,6 +126,7 @@ class NrUeMac : public Object
     friend class UeMemberNrUeCmacSapProvider;
     friend class UeMemberNrMacSapProvider;
     friend class MacUeMemberPhySapUser;
+    friend class NrUeMacBsrFormatTest;
 
   public:
     /**
@@ -307,6 +326,51 @@ class NrUeMac : public Object
      * not get retransmitted.
      */
     void SendReportBufferStatus(const SfnSf& dataSfn, uint8_t symStart);
+
+    /**
+     * \brief Get the amount of bytes waiting in each LCG
+     * \return a vector with NrMacLongBsrCe::MAX_LCG values, each one being
+     * the amount of data (plus the MAC subheaders overhead) waiting in the LCG
+     */
+    std::vector<uint32_t> GetLcgBufferSizes() const;
+
+    /**
+     * \brief The format of a BSR
+     */
+    enum BsrFormat : uint8_t
+    {
+        SHORT_BSR,           //!< NrMacShortBsrCe, reporting LCG 0 to 3
+        LONG_BSR,            //!< NrMacLongBsrCe, reporting all the LCG with data
+        SHORT_TRUNCATED_BSR, //!< NrMacShortTruncatedBsrCe, reporting one LCG
+    };
+
+    /**
+     * \brief Select the BSR format, following TS 38.321 section 5.4.5
+     * \param lcgBufferSizes the amount of bytes waiting in each LCG
+     * \param availableBytes the bytes of the grant that can be used for the BSR
+     * \return LONG_BSR if more than one LCG has data and it fits in
+     * availableBytes; otherwise SHORT_BSR if all the data is in LCG 0 to 3 and
+     * it fits, or SHORT_TRUNCATED_BSR
+     */
+    BsrFormat SelectBsrFormat(const std::vector<uint32_t>& lcgBufferSizes,
+                              uint32_t availableBytes) const;
+
+    /**
+     * \brief Get the size of the BSR that will be sent in the current grant
+     * \param lcgBufferSizes the amount of bytes waiting in each LCG
+     * \param availableBytes the bytes of the grant that can be used for the BSR
+     * \return the size of the BSR selected by SelectBsrFormat()
+     */
+    uint32_t GetBsrSize(const std::vector<uint32_t>& lcgBufferSizes,
+                        uint32_t availableBytes) const;
+
+    /**
+     * \brief Get the LCG of the logical channel with the highest priority,
+     * among the ones with data
+     * \return the LCG to report in a SHORT_TRUNCATED_BSR
+     */
+    uint8_t GetHighestPriorityLcg() const;
+
     void RefreshHarqProcessesPacketBuffer();
 
     /**
@@ -391,6 +455,7 @@ class NrUeMac : public Object
         m_ulDci;                  //!< Received a DCI. While we process it, store it here.
     SfnSf m_ulDciSfnsf;           //!< Received a DCI for transmitting data in this slot.
     uint32_t m_ulDciTotalUsed{0}; //!< Received a DCI, put the total count of bytes we sent.
+    bool m_longBsrEnabled{true};  //!< Send a LONG_BSR when more than one LCG has data
 
     std::unordered_map<uint8_t, LteMacSapProvider::ReportBufferStatusParameters>
         m_ulBsrReceived; //!< BSR received from RLC (the last one)
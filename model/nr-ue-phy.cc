@@ -168,6 +168,14 @@ NrUePhy::GetTypeId()
                           TimeValue(MilliSeconds(200)),
                           MakeTimeAccessor(&NrUePhy::m_ueMeasurementsFilterPeriod),
                           MakeTimeChecker())
+            .AddAttribute("RsrpDetectionThreshold",
+                          "RSRP (dBm) below which a cell is not detected, and its PSS "
+                          "are not considered for the UE measurements. The default value "
+                          "is the lower bound of the RSRP reporting range of TS 38.133.",
+                          DoubleValue(-156.0),
+                          MakeDoubleAccessor(&NrUePhy::SetRsrpDetectionThreshold,
+                                             &NrUePhy::GetRsrpDetectionThreshold),
+                          MakeDoubleChecker<double>())
             .AddAttribute("NrSpectrumPhyList",
                           "List of all SpectrumPhy instances of this NrUePhy.",
                           ObjectVectorValue(),
@@ -465,8 +473,8 @@ NrUePhy::InsertFutureAllocation(const SfnSf& sfnSf, const std::shared_ptr<DciInf
     else
     {
         SlotAllocInfo slotAllocInfo = SlotAllocInfo(sfnSf);
-        slotAllocInfo.m_varTtiAllocInfo.push_back(varTtiInfo);
-        PushBackSlotAllocInfo(slotAllocInfo);
+        slotAllocInfo.m_varTtiAllocInfo.push_back(std::move(varTtiInfo));
+        PushBackSlotAllocInfo(std::move(slotAllocInfo));
     }
 }
 
@@ -801,10 +809,10 @@ NrUePhy::StartSlot(const SfnSf& s)
 
     TryToPerformLbt();
 
-    VarTtiAllocInfo allocation = m_currSlotAllocInfo.m_varTtiAllocInfo.front();
+    auto dci = std::move(m_currSlotAllocInfo.m_varTtiAllocInfo.front().m_dci);
     m_currSlotAllocInfo.m_varTtiAllocInfo.pop_front();
 
-    auto nextVarTtiStart = GetSymbolPeriod() * allocation.m_dci->m_symStart;
+    auto nextVarTtiStart = GetSymbolPeriod() * dci->m_symStart;
 
     auto ctrlMsgs = PopCurrentSlotCtrlMsgs();
     if (m_netDevice)
@@ -820,7 +828,7 @@ NrUePhy::StartSlot(const SfnSf& s)
         }
     }
 
-    Simulator::Schedule(nextVarTtiStart, &NrUePhy::StartVarTti, this, allocation.m_dci);
+    Simulator::Schedule(nextVarTtiStart, &NrUePhy::StartVarTti, this, dci);
 }
 
 Time
@@ -1125,15 +1133,15 @@ NrUePhy::EndVarTti(const std::shared_ptr<DciInfoElementTdma>& dci)
     }
     else
     {
-        VarTtiAllocInfo allocation = m_currSlotAllocInfo.m_varTtiAllocInfo.front();
+        auto nextDci = std::move(m_currSlotAllocInfo.m_varTtiAllocInfo.front().m_dci);
         m_currSlotAllocInfo.m_varTtiAllocInfo.pop_front();
 
-        Time nextVarTtiStart = GetSymbolPeriod() * allocation.m_dci->m_symStart;
+        Time nextVarTtiStart = GetSymbolPeriod() * nextDci->m_symStart;
 
         Simulator::Schedule(nextVarTtiStart + m_lastSlotStart - Simulator::Now(),
                             &NrUePhy::StartVarTti,
                             this,
-                            allocation.m_dci);
+                            nextDci);
     }
 
     m_receptionEnabled = false;
@@ -1403,6 +1411,8 @@ void
 NrUePhy::DoSetRsrpFilterCoefficient(uint8_t rsrpFilterCoefficient)
 {
     NS_LOG_FUNCTION(this << +rsrpFilterCoefficient);
+    // TS 36.331 section 5.5.3.2: a = 1/2^(k/4), and no filtering when k = 0
+    m_rsrpFilterAlpha = std::pow(0.5, rsrpFilterCoefficient / 4.0);
 }
 
 void
@@ -1411,6 +1421,7 @@ NrUePhy::DoSynchronizeWithEnb(uint16_t cellId)
     NS_LOG_FUNCTION(this << cellId);
     DoSetCellId(cellId);
     DoSetInitialBandwidth();
+    ReserveUeMeasurements(cellId);
 }
 
 BeamConfId
@@ -1453,59 +1464,54 @@ NrUePhy::ReportRsReceivedPower(const SpectrumValue& rsReceivedPower,
 }
 
 void
-NrUePhy::ReceivePss(uint16_t cellId, const Ptr<SpectrumValue>& p)
+NrUePhy::SetRsrpDetectionThreshold(double thresholdDbm)
 {
-    NS_LOG_FUNCTION(this);
-
-    double sum = 0.0;
-    uint16_t nRB = 0;
+    NS_LOG_FUNCTION(this << thresholdDbm);
+    m_rsrpDetectionThresholdW = std::pow(10.0, (thresholdDbm - 30) / 10.0);
+}
 
-    uint32_t subcarrierSpacing;
-    subcarrierSpacing = 15000 * static_cast<uint32_t>(std::pow(2, GetNumerology()));
+double
+NrUePhy::GetRsrpDetectionThreshold() const
+{
+    return 10 * log10(m_rsrpDetectionThresholdW) + 30;
+}
 
-    Values::const_iterator itPi;
-    for (itPi = p->ConstValuesBegin(); itPi != p->ConstValuesEnd(); itPi++)
+void
+NrUePhy::ReserveUeMeasurements(uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << cellId);
+    if (cellId >= m_ueMeasurements.size())
     {
-        // convert PSD [W/Hz] to linear power [W] for the single RE
-        double powerTxW = (*itPi) * subcarrierSpacing;
-        sum += powerTxW;
-        nRB++;
+        m_ueMeasurements.resize(cellId + 1);
     }
+}
 
-    // measure instantaneous RSRP now (in dBm)
-    double rsrp = 10 * log10(1000 * (sum / static_cast<double>(nRB)));
+void
+NrUePhy::ReceivePss(uint16_t cellId, const Ptr<SpectrumValue>& p)
+{
+    NS_LOG_FUNCTION(this);
 
-    NS_LOG_DEBUG("RSRP value updated: " << rsrp << " dBm"
-                                        << " for Cell Id: " << cellId << " RNTI: " << m_rnti);
+    // Average linear power [W] of a single RE, from the PSD [W/Hz]
+    double rsrp = Sum(*p) * GetSubcarrierSpacing() / static_cast<double>(p->GetValuesN());
 
-    // store RSRP measurements
-    std::map<uint16_t, UeMeasurementsElement>::iterator itMeasMap =
-        m_ueMeasurementsMap.find(cellId);
-    if (itMeasMap == m_ueMeasurementsMap.end())
+    if (rsrp < m_rsrpDetectionThresholdW)
     {
-        // insert new entry
-        UeMeasurementsElement newEl;
-        newEl.rsrpSum = rsrp;
-        newEl.rsrpNum = 1;
-        newEl.rsrqSum = 0;
-        newEl.rsrqNum = 0;
-
-        NS_LOG_DEBUG("New RSRP entry for Cell Id: " << cellId << " RNTI: " << m_rnti
-                                                    << " RSRP: " << newEl.rsrpSum << " dBm"
-                                                    << " number of entries: " << +newEl.rsrpNum);
-
-        m_ueMeasurementsMap.insert(std::pair<uint16_t, UeMeasurementsElement>(cellId, newEl));
+        NS_LOG_DEBUG("PSS of Cell Id: " << cellId << " below the detection threshold");
+        return;
     }
-    else
-    {
-        (*itMeasMap).second.rsrpSum += rsrp;
-        (*itMeasMap).second.rsrpNum++;
 
-        NS_LOG_DEBUG("Update RSRP entry for Cell Id: "
-                     << cellId << " RNTI: " << m_rnti
-                     << " RSRP Sum: " << (*itMeasMap).second.rsrpSum << " dBm"
-                     << " number of entries: " << +((*itMeasMap).second.rsrpNum));
+    if (cellId >= m_ueMeasurements.size())
+    {
+        ReserveUeMeasurements(cellId);
     }
+
+    UeMeasurementsElement& el = m_ueMeasurements[cellId];
+    el.rsrpSum += rsrp;
+    el.rsrpNum++;
+
+    NS_LOG_DEBUG("Update RSRP entry for Cell Id: " << cellId << " RNTI: " << m_rnti
+                                                   << " RSRP: " << rsrp << " W"
+                                                   << " number of entries: " << el.rsrpNum);
 }
 
 void
@@ -1515,40 +1521,52 @@ NrUePhy::ReportUeMeasurements()
 
     // LteUeCphySapUser::UeMeasurementsParameters ret;
 
-    std::map<uint16_t, UeMeasurementsElement>::iterator it;
-    for (it = m_ueMeasurementsMap.begin(); it != m_ueMeasurementsMap.end(); it++)
+    for (std::size_t i = 0; i < m_ueMeasurements.size(); ++i)
     {
-        double avg_rsrp;
-        // double avg_rsrq = 0;
-        if ((*it).second.rsrpNum != 0)
+        const auto cellId = static_cast<uint16_t>(i);
+        UeMeasurementsElement& el = m_ueMeasurements[i];
+        if (el.rsrpNum == 0)
         {
-            avg_rsrp = (*it).second.rsrpSum / static_cast<double>((*it).second.rsrpNum);
+            continue;
+        }
+
+        // Layer-1: linear average over the period, converted to dBm
+        double avgRsrp = 10 * log10(1000 * el.rsrpSum / el.rsrpNum);
+
+        // Layer-3: F_n = (1 - a) * F_n-1 + a * M_n, initialized with the first sample
+        if (el.rsrpFilterInit)
+        {
+            el.rsrpFilteredDbm =
+                (1 - m_rsrpFilterAlpha) * el.rsrpFilteredDbm + m_rsrpFilterAlpha * avgRsrp;
         }
         else
         {
-            NS_LOG_WARN(" RSRP nSamples is zero!");
-            avg_rsrp = 0;
+            el.rsrpFilteredDbm = avgRsrp;
+            el.rsrpFilterInit = true;
         }
 
         NS_LOG_DEBUG(" Report UE Measurements for CellId "
-                     << (*it).first << " Reporting UE " << m_rnti << " Av. RSRP " << avg_rsrp
-                     << " (nSamples " << +((*it).second.rsrpNum) << ")"
+                     << cellId << " Reporting UE " << m_rnti << " Av. RSRP " << avgRsrp
+                     << " Filtered RSRP " << el.rsrpFilteredDbm << " (nSamples " << el.rsrpNum
+                     << ")"
                      << " BwpID " << GetBwpId());
 
-        m_reportRsrpTrace(GetCellId(), m_imsi, m_rnti, avg_rsrp, GetBwpId());
+        m_reportRsrpTrace(cellId, m_imsi, m_rnti, el.rsrpFilteredDbm, GetBwpId());
 
         /*LteUeCphySapUser::UeMeasurementsElement newEl;
-        newEl.m_cellId = (*it).first;
-        newEl.m_rsrp = avg_rsrp;
+        newEl.m_cellId = cellId;
+        newEl.m_rsrp = el.rsrpFilteredDbm;
         newEl.m_rsrq = avg_rsrq;  //LEAVE IT 0 FOR THE MOMENT
         ret.m_ueMeasurementsList.push_back (newEl);
         ret.m_componentCarrierId = GetBwpId ();*/
+
+        el.rsrpSum = 0.0;
+        el.rsrpNum = 0;
     }
 
     // report to RRC
     // m_ueCphySapUser->ReportUeMeasurements (ret);
 
-    m_ueMeasurementsMap.clear();
     Simulator::Schedule(m_ueMeasurementsFilterPeriod, &NrUePhy::ReportUeMeasurements, this);
 }
 
@@ -479,7 +479,11 @@ class NrUePhy : public NrPhy
     uint8_t ComputeCqi(const SpectrumValue& sinr);
 
     /**
-     * \brief Receive PSS and calculate RSRQ in dBm
+     * \brief Receive PSS and accumulate the RSRP of the cell
+     *
+     * The RSRP is accumulated in linear unit, and converted in dBm only when
+     * the measurements are reported (see ReportUeMeasurements()). PSS with a
+     * RSRP below the attribute RsrpDetectionThreshold are ignored.
      *
      * \param cellId the cell ID
      * \param p PSS list
@@ -521,6 +525,12 @@ class NrUePhy : public NrPhy
      * Fo the moment we don't report to RRC but the function is prepared to be
      * extended once RRC is ported.
      *
+     * For each cell heard in the last period, the linear average of the RSRP
+     * samples is converted in dBm and passed through the layer-3 filter of
+     * TS 36.331 section 5.5.3.2, configured with the RSRP filter coefficient
+     * (see DoSetRsrpFilterCoefficient()). The filtered value is reported through
+     * the ReportRsrp trace.
+     *
      * Initially executed at +0.200s, and then repeatedly executed with
      * periodicity as indicated by the *UeMeasFilterPeriod* attribute.
      */
@@ -859,21 +869,41 @@ class NrUePhy : public NrPhy
 
     double m_rsrp{0}; //!< The latest measured RSRP value
 
-    /// Summary results of measuring a specific cell. Used for layer-1 filtering.
+    /// Summary results of measuring a specific cell. Used for layer-1 and layer-3 filtering.
     struct UeMeasurementsElement
     {
-        double rsrpSum;  //!< Sum of RSRP sample values in linear unit.
-        uint8_t rsrpNum; //!< Number of RSRP samples.
-        // For the moment rsrq is not supported so set to 0
-        double rsrqSum;  //!< Sum of RSRQ sample values in linear unit.
-        uint8_t rsrqNum; //!< Number of RSRQ samples.
+        double rsrpSum{0.0};         //!< Sum of RSRP sample values in linear unit (W).
+        uint32_t rsrpNum{0};         //!< Number of RSRP samples in the current period.
+        double rsrpFilteredDbm{0.0}; //!< Layer-3 filtered RSRP (dBm)
+        bool rsrpFilterInit{false};  //!< Has the layer-3 filter received its first value?
     };
 
     /**
-     * Store measurement results during the last layer-1 filtering period.
-     * Indexed by the physical cell ID where the measurements come from.
+     * \brief Make room in m_ueMeasurements for a cell ID
+     * \param cellId the cell ID
+     */
+    void ReserveUeMeasurements(uint16_t cellId);
+
+    /**
+     * \brief Set the RSRP detection threshold
+     * \param thresholdDbm the threshold, in dBm
+     */
+    void SetRsrpDetectionThreshold(double thresholdDbm);
+    /**
+     * \brief Get the RSRP detection threshold
+     * \return the threshold, in dBm
+     */
+    double GetRsrpDetectionThreshold() const;
+
+    /**
+     * Store measurement results during the last layer-1 filtering period, and
+     * the layer-3 filter state. Indexed by the physical cell ID where the
+     * measurements come from; it is resized when the UE synchronizes with a cell,
+     * or when it hears a cell with a higher ID for the first time.
      */
-    std::map<uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+    std::vector<UeMeasurementsElement> m_ueMeasurements;
+    double m_rsrpDetectionThresholdW{0.0}; //!< RSRP below which a PSS is ignored (W)
+    double m_rsrpFilterAlpha{0.5};         //!< Layer-3 filter weight of a new RSRP sample
     /**
      * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
      * measurements, i.e., the length of layer-1 filtering (default 200 ms).
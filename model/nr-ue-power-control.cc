@@ -201,6 +201,7 @@ NrUePowerControl::SetAlpha(double value)
     }
 
     m_alpha = value;
+    m_alphaPathLoss = m_alpha * m_pathLoss;
 }
 
 void
@@ -218,6 +219,7 @@ NrUePowerControl::SetRsrp(double value)
     double alphaRsrp = std::pow(0.5, m_pcRsrpFilterCoefficient / 4.0);
     m_rsrp = (1 - alphaRsrp) * m_rsrp + alphaRsrp * value;
     m_pathLoss = m_referenceSignalPower - m_rsrp;
+    m_alphaPathLoss = m_alpha * m_pathLoss;
     NS_LOG_INFO("Pathloss updated to: " << m_pathLoss << " , rsrp updated to:" << m_rsrp
                                         << " for cellId/rnti: " << m_cellId << "," << m_rnti);
 }
@@ -591,6 +593,28 @@ NrUePowerControl::UpdateGc()
     m_deltaPucch.clear(); // we have used these values, no need to save them any more
 }
 
+double
+NrUePowerControl::GetBandwidthTerm(std::size_t rbNum)
+{
+    uint16_t numerology = m_nrUePhy->GetNumerology();
+    if (numerology != m_bandwidthTermNumerology)
+    {
+        m_bandwidthTerm.clear();
+        m_bandwidthTermNumerology = numerology;
+    }
+    if (rbNum >= m_bandwidthTerm.size())
+    {
+        m_bandwidthTerm.resize(rbNum + 1, -1.0);
+    }
+    // the term is at least 0 dB, a negative value marks an entry not computed yet
+    double& term = m_bandwidthTerm[rbNum];
+    if (term < 0)
+    {
+        term = 10 * log10(std::pow(2, numerology) * rbNum);
+    }
+    return term;
+}
+
 // TS 38.213 Table 7.1.1-1 and Table 7.2.1-1,  Mapping of TPC Command Field in DCI to accumulated
 // and absolute value
 
@@ -615,7 +639,7 @@ NrUePowerControl::CalculatePuschTxPowerNr(std::size_t rbNum)
 
     if (rbNum > 0)
     {
-        puschComponent = 10 * log10(std::pow(2, m_nrUePhy->GetNumerology()) * rbNum);
+        puschComponent = GetBandwidthTerm(rbNum);
     }
     else
     {
@@ -650,7 +674,7 @@ NrUePowerControl::CalculatePuschTxPowerNr(std::size_t rbNum)
         UpdateFc();
     }
 
-    double txPower = PoPusch + puschComponent + m_alpha * m_pathLoss + m_deltaTF + m_fc;
+    double txPower = PoPusch + puschComponent + m_alphaPathLoss + m_deltaTF + m_fc;
 
     NS_LOG_INFO("Calculated PUSCH power:" << txPower << " MinPower: " << m_Pcmin
                                           << " MaxPower:" << m_Pcmax);
@@ -679,7 +703,7 @@ NrUePowerControl::CalculatePucchTxPowerNr(std::size_t rbNum)
     double pucchComponent = 0;
     if (rbNum > 0)
     {
-        pucchComponent = 10 * log10(std::pow(2, m_nrUePhy->GetNumerology()) * rbNum);
+        pucchComponent = GetBandwidthTerm(rbNum);
     }
     else
     {
@@ -720,7 +744,7 @@ NrUePowerControl::CalculatePucchTxPowerNr(std::size_t rbNum)
                         << " PathLoss: " << m_pathLoss << " deltaTF: " << m_deltaTF_control
                         << " gc: " << m_gc << " numerology: " << m_nrUePhy->GetNumerology());
 
-    double txPower = PoPucch + pucchComponent + m_alpha * m_pathLoss + m_delta_F_Pucch +
+    double txPower = PoPucch + pucchComponent + m_alphaPathLoss + m_delta_F_Pucch +
                      m_deltaTF_control + m_gc;
 
     NS_LOG_INFO("Calculated PUCCH power: " << txPower << " MinPower: " << m_Pcmin
@@ -759,7 +783,7 @@ NrUePowerControl::CalculateSrsTxPowerNr(std::size_t rbNum)
 
     if (rbNum > 0)
     {
-        component = 10 * log10(std::pow(2, m_nrUePhy->GetNumerology()) * rbNum);
+        component = GetBandwidthTerm(rbNum);
     }
     else
     {
@@ -769,11 +793,11 @@ NrUePowerControl::CalculateSrsTxPowerNr(std::size_t rbNum)
     if (m_technicalSpec == TS_36_213)
     {
         double pSrsOffsetValue = -10.5 + m_PsrsOffset * 1.5;
-        txPower = pSrsOffsetValue + component + PoPusch + m_alpha * m_pathLoss + m_hc;
+        txPower = pSrsOffsetValue + component + PoPusch + m_alphaPathLoss + m_hc;
     }
     else if (m_technicalSpec == TS_38_213)
     {
-        txPower = m_P_0_SRS + component + m_alpha * m_pathLoss +
+        txPower = m_P_0_SRS + component + m_alphaPathLoss +
                   m_hc; // this formula also can apply for TS_36_213,
                         // See 5.1.3 Sounding Reference Symbol (SRS) 5.1.3.1 UE behavior
     }
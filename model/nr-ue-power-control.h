@@ -307,6 +307,14 @@ class NrUePowerControl : public Object
      * \param rbNum number of RBs
      */
     double CalculateSrsTxPowerNr(std::size_t rbNum);
+    /**
+     * \brief Get the bandwidth term of the transmit power formulas,
+     * 10 * log10(2^numerology * rbNum), from a table filled at the first use
+     * of each number of RBs. The table is cleared when the numerology changes.
+     * \param rbNum number of RBs, greater than 0
+     * \return the bandwidth term in dB
+     */
+    double GetBandwidthTerm(std::size_t rbNum);
 
     // general attributes
     bool m_closedLoop{true};          //!< is closed loop
@@ -365,6 +373,10 @@ class NrUePowerControl : public Object
     double m_hc{0.0}; //!< Is the current SRS power control adjustment state. This variable is used
                       //!< for calculation of SRS transmit power.
 
+    double m_alphaPathLoss{0.0};                    //!< m_alpha * m_pathLoss
+    std::vector<double> m_bandwidthTerm;            //!< bandwidth term per number of RBs
+    uint16_t m_bandwidthTermNumerology{UINT16_MAX}; //!< numerology of m_bandwidthTerm
+
     // another attributes needed for function calls
     Ptr<NrUePhy> m_nrUePhy; //!< NrUePhy instance owner
 
@@ -21,6 +21,7 @@
 #include <ns3/random-variable-stream.h>
 #include <ns3/three-gpp-spectrum-propagation-loss-model.h>
 #include <ns3/uinteger.h>
+#include <ns3/wrap-around-spectrum-propagation-loss-model.h>
 
 namespace ns3
 {
@@ -263,16 +264,23 @@ RealisticBeamformingAlgorithm::GetChannelMatrix() const
     Ptr<PhasedArraySpectrumPropagationLossModel> gnbThreeGppSpectrumPropModel =
         gnbSpectrumChannel->GetPhasedArraySpectrumPropagationLossModel();
     Ptr<ThreeGppSpectrumPropagationLossModel> threeGppSplm =
-        DynamicCast<ThreeGppSpectrumPropagationLossModel>(gnbThreeGppSpectrumPropModel);
+        DynamicCast<ThreeGppSpectrumPropagationLossModel>(
+            WrapAroundSpectrumPropagationLossModel::Unwrap(gnbThreeGppSpectrumPropModel));
+    NS_ASSERT(threeGppSplm != nullptr);
     Ptr<MatrixBasedChannelModel> matrixBasedChannelModel = threeGppSplm->GetChannelModel();
     Ptr<ThreeGppChannelModel> channelModel =
         DynamicCast<ThreeGppChannelModel>(matrixBasedChannelModel);
 
     NS_ASSERT(channelModel != nullptr);
 
+    // With the wrap-around, the channel of the closest copy of the gNB
+    const auto [gnbMobility, ueMobility] = WrapAroundSpectrumPropagationLossModel::GetWrappedLink(
+        gnbThreeGppSpectrumPropModel,
+        m_gnbDevice->GetNode()->GetObject<MobilityModel>(),
+        m_ueDevice->GetNode()->GetObject<MobilityModel>());
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> originalChannelMatrix =
-        channelModel->GetChannel(m_gnbDevice->GetNode()->GetObject<MobilityModel>(),
-                                 m_ueDevice->GetNode()->GetObject<MobilityModel>(),
+        channelModel->GetChannel(gnbMobility,
+                                 ueMobility,
                                  m_gnbSpectrumPhy->GetAntenna()->GetObject<PhasedArrayModel>(),
                                  m_ueSpectrumPhy->GetAntenna()->GetObject<PhasedArrayModel>());
 
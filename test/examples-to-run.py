@@ -70,6 +70,8 @@ cpp_examples = [
     ("cttc-nr-traffic-ngmn-mixed", "True", "True"),
     ("cttc-nr-traffic-3gpp-xr", "True", "True"),
     ("traffic-generator-example", "True", "True"),
+    ("nr-l2sm-benchmark --rbNums=25 --numerologies=1 --samples=20 --maxHistory=1", "True", "False"),
+    ("nr-sched-benchmark --ueNums=4 --rbgNums=10 --beamNums=2 --lcNums=2 --slots=50 --warmUpSlots=10", "True", "False"),
     ]
 
 # A list of Python examples to run in order to ensure that they remain
@@ -0,0 +1,152 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/beam-manager.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+#include <ns3/uniform-planar-array.h>
+
+/**
+ * \file nr-beam-manager-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the BeamManager
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check that the BeamManager sets on the antenna array the beam of the
+ * requested device, also when it skips setting a beam already set, and that
+ * it follows the changes of the antenna dimensions
+ */
+class NrBeamManagerTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrBeamManagerTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Check that the antenna array uses a beamforming vector
+     * \param antenna the antenna array
+     * \param expected the expected beamforming vector
+     * \param msg the message to print if the check fails
+     */
+    void CheckVector(const Ptr<UniformPlanarArray>& antenna,
+                     const PhasedArrayModel::ComplexVector& expected,
+                     const std::string& msg);
+};
+
+void
+NrBeamManagerTest::CheckVector(const Ptr<UniformPlanarArray>& antenna,
+                               const PhasedArrayModel::ComplexVector& expected,
+                               const std::string& msg)
+{
+    PhasedArrayModel::ComplexVector current = antenna->GetBeamformingVector();
+    NS_TEST_ASSERT_MSG_EQ(current.GetSize(), expected.GetSize(), msg << ": wrong size");
+    for (std::size_t i = 0; i < current.GetSize(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(current[i], expected[i], msg << ": wrong element " << i);
+    }
+}
+
+void
+NrBeamManagerTest::DoRun()
+{
+    Ptr<UniformPlanarArray> antenna = CreateObject<UniformPlanarArray>();
+    antenna->SetAttribute("NumRows", UintegerValue(2));
+    antenna->SetAttribute("NumColumns", UintegerValue(2));
+
+    Ptr<BeamManager> beamManager = CreateObject<BeamManager>();
+    beamManager->Configure(antenna);
+    CheckVector(antenna, CreateQuasiOmniBfv(2, 2), "Configure should set the quasi-omni beam");
+
+    Ptr<NetDevice> dev1 = CreateObject<SimpleNetDevice>();
+    Ptr<NetDevice> dev2 = CreateObject<SimpleNetDevice>();
+    Ptr<NetDevice> dev3 = CreateObject<SimpleNetDevice>();
+    BeamformingVector bfv1 = {CreateDirectionalBfv(antenna, 0, 90), BeamId(0, 90)};
+    BeamformingVector bfv2 = {CreateDirectionalBfv(antenna, 1, 60), BeamId(1, 60)};
+    beamManager->SaveBeamformingVector(bfv1, dev1);
+    beamManager->SaveBeamformingVector(bfv2, dev2);
+
+    NS_TEST_ASSERT_MSG_EQ(beamManager->GetPeerIndex(dev1), 0U, "Wrong index of the first peer");
+    NS_TEST_ASSERT_MSG_EQ(beamManager->GetPeerIndex(dev2), 1U, "Wrong index of the second peer");
+    NS_TEST_ASSERT_MSG_EQ(beamManager->GetPeerIndex(dev3),
+                          BeamManager::NO_PEER,
+                          "A device without a saved beam should have no index");
+
+    beamManager->ChangeBeamformingVector(dev1);
+    CheckVector(antenna, bfv1.first, "Beam toward the first device");
+    beamManager->ChangeBeamformingVector(dev2);
+    CheckVector(antenna, bfv2.first, "Beam toward the second device");
+    beamManager->ChangeBeamformingVector(beamManager->GetPeerIndex(dev1));
+    CheckVector(antenna, bfv1.first, "Beam toward the first device, by index");
+    beamManager->ChangeBeamformingVector(dev3);
+    CheckVector(antenna, CreateQuasiOmniBfv(2, 2), "Quasi-omni beam toward an unknown device");
+
+    // A sector set directly replaces the current beam: the beam of the
+    // device must be set again, even if it was the last one set
+    beamManager->ChangeBeamformingVector(dev1);
+    beamManager->SetSector(2, 45);
+    CheckVector(antenna, CreateDirectionalBfv(antenna, 2, 45), "Sector");
+    beamManager->ChangeBeamformingVector(dev1);
+    CheckVector(antenna, bfv1.first, "Beam toward the first device, after a sector");
+
+    // A new beam saved for the current device must be used
+    BeamformingVector bfv1b = {CreateDirectionalBfv(antenna, 3, 120), BeamId(3, 120)};
+    beamManager->SaveBeamformingVector(bfv1b, dev1);
+    NS_TEST_ASSERT_MSG_EQ(beamManager->GetPeerIndex(dev1), 0U, "The index should not change");
+    beamManager->ChangeBeamformingVector(dev1);
+    CheckVector(antenna, bfv1b.first, "Updated beam toward the first device");
+    NS_TEST_ASSERT_MSG_EQ(beamManager->GetBeamId(dev1), BeamId(3, 120), "Wrong updated BeamId");
+
+    // A predefined beam is used for the devices without a saved beam
+    PhasedArrayModel::ComplexVector predefined = CreateDirectionalBfv(antenna, 1, 30);
+    beamManager->SetPredefinedBeam(predefined);
+    beamManager->ChangeBeamformingVector(dev3);
+    CheckVector(antenna, predefined, "Predefined beam toward an unknown device");
+
+    // A change of the number of elements is detected without notification
+    antenna->SetAttribute("NumRows", UintegerValue(4));
+    beamManager->ChangeToQuasiOmniBeamformingVector();
+    CheckVector(antenna, CreateQuasiOmniBfv(4, 2), "Quasi-omni beam after adding rows");
+
+    // A change that keeps the number of elements needs a notification
+    antenna->SetAttribute("NumRows", UintegerValue(2));
+    antenna->SetAttribute("NumColumns", UintegerValue(4));
+    beamManager->NotifyAntennaChanged();
+    beamManager->ChangeToQuasiOmniBeamformingVector();
+    CheckVector(antenna, CreateQuasiOmniBfv(2, 4), "Quasi-omni beam after swapping dimensions");
+
+    beamManager->Dispose();
+}
+
+/**
+ * \brief Test suite for the BeamManager
+ */
+class NrBeamManagerTestSuite : public TestSuite
+{
+  public:
+    NrBeamManagerTestSuite()
+        : TestSuite("nr-beam-manager-test", UNIT)
+    {
+        AddTestCase(new NrBeamManagerTest("Beam storage and switching test"), QUICK);
+    }
+};
+
+static NrBeamManagerTestSuite nrBeamManagerTestSuite; //!< Beam manager test suite
+
+} // namespace ns3
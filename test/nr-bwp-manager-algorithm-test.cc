@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/bwp-manager-algorithm.h>
+#include <ns3/double.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+
+/**
+ * \file nr-bwp-manager-algorithm-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the BwpManagerAlgorithmLoadAware
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check that the BwpManagerAlgorithmLoadAware selects the least loaded
+ * of the allowed BWPs, and that it moves a bearer only when the load
+ * difference exceeds the hysteresis
+ */
+class NrBwpManagerAlgorithmTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrBwpManagerAlgorithmTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+NrBwpManagerAlgorithmTest::DoRun()
+{
+    using BwpLoad = BwpManagerAlgorithm::BwpLoad;
+    const uint8_t noBwp = BwpManagerAlgorithm::NO_BWP;
+
+    Ptr<BwpManagerAlgorithmLoadAware> algorithm = CreateObject<BwpManagerAlgorithmLoadAware>();
+    algorithm->SetAttribute("NGBR_VIDEO_TCP_DEFAULT", UintegerValue(1));
+    algorithm->SetAttribute("Hysteresis", DoubleValue(0.1));
+    algorithm->SetAttribute("BacklogNormalization", UintegerValue(1000));
+
+    const auto qci = EpsBearer::NGBR_VIDEO_TCP_DEFAULT;
+    const std::vector<BwpLoad> loads{{0.2, 0}, {0.9, 0}, {0.5, 0}};
+
+    // Without allowed BWPs, the static BWP is used
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, noBwp, 0, loads),
+                          1,
+                          "The static BWP should be used");
+
+    algorithm->SetAllowedBwps(qci, {1, 2});
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, noBwp, 0, loads),
+                          2,
+                          "A new bearer should go to the least loaded allowed BWP");
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, 1, 0, loads),
+                          2,
+                          "A bearer should leave a BWP much more loaded");
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, 0, 0, loads),
+                          2,
+                          "A bearer on a BWP not allowed should move");
+
+    const std::vector<BwpLoad> similarLoads{{0.0, 0}, {0.55, 0}, {0.5, 0}};
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, 1, 0, similarLoads),
+                          1,
+                          "A bearer should not move within the hysteresis");
+
+    // The backlog of the bearer moves with it: 0.3 + 0.3 is not less than
+    // 0.9 - 0.3 - 0.1
+    const std::vector<BwpLoad> backlogLoads{{0.0, 0}, {0.6, 300}, {0.3, 0}};
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, 1, 300, backlogLoads),
+                          1,
+                          "A bearer should not move if its backlog overloads the new BWP");
+    NS_TEST_ASSERT_MSG_EQ(+algorithm->GetBwpForBearer(qci, 1, 100, backlogLoads),
+                          2,
+                          "A bearer with a small backlog should move");
+
+    // Only the load-aware algorithm is asked again the BWP of a bearer
+    NS_TEST_ASSERT_MSG_EQ(algorithm->IsLoadAware(), true, "The algorithm uses the load");
+    NS_TEST_ASSERT_MSG_EQ(CreateObject<BwpManagerAlgorithmStatic>()->IsLoadAware(),
+                          false,
+                          "The static algorithm does not use the load");
+}
+
+/**
+ * \brief Test suite for the BWP manager algorithms
+ */
+class NrBwpManagerAlgorithmTestSuite : public TestSuite
+{
+  public:
+    NrBwpManagerAlgorithmTestSuite()
+        : TestSuite("nr-bwp-manager-algorithm-test", UNIT)
+    {
+        AddTestCase(new NrBwpManagerAlgorithmTest("Load-aware BWP selection test"), QUICK);
+    }
+};
+
+static NrBwpManagerAlgorithmTestSuite
+    nrBwpManagerAlgorithmTestSuite; //!< BWP manager algorithm test suite
+
+} // namespace ns3
@@ -0,0 +1,304 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/bwp-manager-algorithm.h>
+#include <ns3/bwp-manager-gnb.h>
+#include <ns3/bwp-manager-ue.h>
+#include <ns3/lte-enb-rrc.h>
+#include <ns3/lte-mac-sap.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+
+#include <array>
+
+/**
+ * \file nr-bwp-manager-routing-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the routes of the bearers of BwpManagerGnb and BwpManagerUe
+ */
+namespace ns3
+{
+
+/**
+ * \brief A MAC of a BWP, that counts the buffer status reports it receives
+ */
+class NrBwpTestMacSapProvider : public LteMacSapProvider
+{
+  public:
+    void TransmitPdu([[maybe_unused]] TransmitPduParameters params) override
+    {
+    }
+
+    void ReportBufferStatus(ReportBufferStatusParameters params) override
+    {
+        ++m_numReports;
+        m_lastReport = params;
+    }
+
+    uint32_t m_numReports{0};                    //!< Number of buffer status reports received
+    ReportBufferStatusParameters m_lastReport{}; //!< Last buffer status report received
+};
+
+/**
+ * \brief A RLC of a bearer, that counts the TX opportunities it receives
+ */
+class NrBwpTestMacSapUser : public LteMacSapUser
+{
+  public:
+    void NotifyTxOpportunity(TxOpportunityParameters params) override
+    {
+        ++m_numTxOpportunities;
+        m_lastBytes = params.bytes;
+    }
+
+    void NotifyHarqDeliveryFailure() override
+    {
+    }
+
+    void ReceivePdu([[maybe_unused]] ReceivePduParameters params) override
+    {
+    }
+
+    uint32_t m_numTxOpportunities{0}; //!< Number of TX opportunities received
+    uint32_t m_lastBytes{0};          //!< Bytes of the last TX opportunity
+};
+
+/**
+ * \brief Check the routes of the bearers of BwpManagerGnb and BwpManagerUe
+ *
+ * The static algorithm puts the QCI 9 in the BWP 1 and the QCI 1 in the
+ * BWP 0. A bearer with the QCI 9 is set up, released, and set up again with
+ * the same LCID, the QCI 1 and another RLC; then the UE is removed. The
+ * buffer status must reach the MAC of the BWP of the current bearer, the TX
+ * opportunities its RLC, and the backlog of each BWP must return to 0 when
+ * the bearer is released and when the UE is removed.
+ */
+class NrBwpManagerRoutingTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrBwpManagerRoutingTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Check the routes of BwpManagerGnb
+     * \param algorithm the BWP manager algorithm
+     */
+    void RunGnb(const Ptr<BwpManagerAlgorithm>& algorithm);
+
+    /**
+     * \brief Check the routes of BwpManagerUe
+     * \param algorithm the BWP manager algorithm
+     */
+    void RunUe(const Ptr<BwpManagerAlgorithm>& algorithm);
+
+    /**
+     * \brief Create a buffer status report
+     * \param rnti the RNTI
+     * \param lcid the LCID
+     * \param txQueueSize the size of the TX queue
+     * \return the report
+     */
+    static LteMacSapProvider::ReportBufferStatusParameters CreateReport(uint16_t rnti,
+                                                                       uint8_t lcid,
+                                                                       uint32_t txQueueSize);
+
+    /**
+     * \brief Create a TX opportunity
+     * \param rnti the RNTI
+     * \param lcid the LCID
+     * \param bwpId the BWP of the opportunity
+     * \param bytes the bytes of the opportunity
+     * \return the opportunity
+     */
+    static LteMacSapUser::TxOpportunityParameters CreateTxOpportunity(uint16_t rnti,
+                                                                      uint8_t lcid,
+                                                                      uint8_t bwpId,
+                                                                      uint32_t bytes);
+};
+
+LteMacSapProvider::ReportBufferStatusParameters
+NrBwpManagerRoutingTest::CreateReport(uint16_t rnti, uint8_t lcid, uint32_t txQueueSize)
+{
+    LteMacSapProvider::ReportBufferStatusParameters params{};
+    params.rnti = rnti;
+    params.lcid = lcid;
+    params.txQueueSize = txQueueSize;
+    return params;
+}
+
+LteMacSapUser::TxOpportunityParameters
+NrBwpManagerRoutingTest::CreateTxOpportunity(uint16_t rnti,
+                                             uint8_t lcid,
+                                             uint8_t bwpId,
+                                             uint32_t bytes)
+{
+    LteMacSapUser::TxOpportunityParameters params{};
+    params.bytes = bytes;
+    params.componentCarrierId = bwpId;
+    params.rnti = rnti;
+    params.lcid = lcid;
+    return params;
+}
+
+void
+NrBwpManagerRoutingTest::RunGnb(const Ptr<BwpManagerAlgorithm>& algorithm)
+{
+    const uint16_t rnti = 1;
+    const uint8_t lcid = 3;
+
+    std::array<NrBwpTestMacSapProvider, 2> macs;
+    NrBwpTestMacSapUser firstRlc;
+    NrBwpTestMacSapUser secondRlc;
+
+    Ptr<BwpManagerGnb> ccm = CreateObject<BwpManagerGnb>();
+    ccm->SetBwpManagerAlgorithm(algorithm);
+    ccm->SetNumberOfComponentCarriers(macs.size());
+    for (uint8_t bwpId = 0; bwpId < macs.size(); ++bwpId)
+    {
+        ccm->SetMacSapProvider(bwpId, &macs.at(bwpId));
+    }
+    LteCcmRrcSapProvider* rrcSap = ccm->GetLteCcmRrcSapProvider();
+    LteMacSapProvider* rlcSap = ccm->GetLteMacSapProvider();
+    rrcSap->AddUe(rnti, UeManager::CONNECTED_NORMALLY);
+
+    // Setup: the bearer goes in the BWP 1
+    auto lcsConfig = rrcSap->SetupDataRadioBearer(EpsBearer(EpsBearer::NGBR_VIDEO_TCP_DEFAULT),
+                                                  1,
+                                                  rnti,
+                                                  lcid,
+                                                  1,
+                                                  &firstRlc);
+    NS_TEST_ASSERT_MSG_EQ(lcsConfig.size(), macs.size(), "One configuration per BWP");
+    NS_TEST_ASSERT_MSG_EQ(+ccm->GetBwpIndex(rnti, lcid), 1, "The bearer should go in the BWP 1");
+    rlcSap->ReportBufferStatus(CreateReport(rnti, lcid, 1000));
+    NS_TEST_ASSERT_MSG_EQ(macs.at(1).m_numReports, 1U, "The BWP 1 should get the report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(1).m_lastReport.txQueueSize, 1000U, "Wrong report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(0).m_numReports, 0U, "The BWP 0 should not get the report");
+    NS_TEST_ASSERT_MSG_EQ(ccm->m_bwpLoads.at(1).m_backlog, 1000U, "Wrong backlog of the BWP 1");
+    lcsConfig.at(1).msu->NotifyTxOpportunity(CreateTxOpportunity(rnti, lcid, 1, 100));
+    NS_TEST_ASSERT_MSG_EQ(firstRlc.m_numTxOpportunities, 1U, "The RLC should get the TX op");
+    NS_TEST_ASSERT_MSG_EQ(firstRlc.m_lastBytes, 100U, "Wrong TX opportunity");
+
+    // Release: the backlog of the bearer leaves the BWP 1
+    rrcSap->ReleaseDataRadioBearer(rnti, lcid);
+    NS_TEST_ASSERT_MSG_EQ(ccm->m_bwpLoads.at(1).m_backlog, 0U, "The released backlog remains");
+
+    // Setup of the same LCID: the new QCI goes in the BWP 0, with the new RLC
+    lcsConfig = rrcSap->SetupDataRadioBearer(EpsBearer(EpsBearer::GBR_CONV_VOICE),
+                                             2,
+                                             rnti,
+                                             lcid,
+                                             1,
+                                             &secondRlc);
+    NS_TEST_ASSERT_MSG_EQ(+ccm->GetBwpIndex(rnti, lcid), 0, "The bearer should go in the BWP 0");
+    rlcSap->ReportBufferStatus(CreateReport(rnti, lcid, 500));
+    NS_TEST_ASSERT_MSG_EQ(macs.at(0).m_numReports, 1U, "The BWP 0 should get the report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(0).m_lastReport.txQueueSize, 500U, "Wrong report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(1).m_numReports, 1U, "The BWP 1 should not get the report");
+    NS_TEST_ASSERT_MSG_EQ(ccm->m_bwpLoads.at(0).m_backlog, 500U, "Wrong backlog of the BWP 0");
+    NS_TEST_ASSERT_MSG_EQ(ccm->m_bwpLoads.at(1).m_backlog, 0U, "Wrong backlog of the BWP 1");
+    lcsConfig.at(0).msu->NotifyTxOpportunity(CreateTxOpportunity(rnti, lcid, 0, 200));
+    NS_TEST_ASSERT_MSG_EQ(secondRlc.m_numTxOpportunities, 1U, "The new RLC should get the TX op");
+    NS_TEST_ASSERT_MSG_EQ(secondRlc.m_lastBytes, 200U, "Wrong TX opportunity");
+    NS_TEST_ASSERT_MSG_EQ(firstRlc.m_numTxOpportunities, 1U, "The old RLC should not get it");
+
+    // Removal of the UE: its backlog leaves the BWP 0, and its routes are removed
+    rrcSap->RemoveUe(rnti);
+    NS_TEST_ASSERT_MSG_EQ(ccm->m_bwpLoads.at(0).m_backlog, 0U, "The removed backlog remains");
+    NS_TEST_ASSERT_MSG_EQ(ccm->m_bearerRoutes.at(rnti).empty(),
+                          true,
+                          "The routes of the removed UE remain");
+
+    ccm->Dispose();
+}
+
+void
+NrBwpManagerRoutingTest::RunUe(const Ptr<BwpManagerAlgorithm>& algorithm)
+{
+    const uint16_t rnti = 1;
+    const uint8_t lcid = 3;
+
+    std::array<NrBwpTestMacSapProvider, 2> macs;
+    NrBwpTestMacSapUser firstRlc;
+    NrBwpTestMacSapUser secondRlc;
+
+    Ptr<BwpManagerUe> ccm = CreateObject<BwpManagerUe>();
+    ccm->SetBwpManagerAlgorithm(algorithm);
+    ccm->SetNumberOfComponentCarriers(macs.size());
+    for (uint8_t bwpId = 0; bwpId < macs.size(); ++bwpId)
+    {
+        ccm->SetComponentCarrierMacSapProviders(bwpId, &macs.at(bwpId));
+    }
+    LteUeCcmRrcSapProvider* rrcSap = ccm->GetLteCcmRrcSapProvider();
+    LteMacSapProvider* rlcSap = ccm->GetLteMacSapProvider();
+
+    // The UE takes the QCI of the LC from its priority
+    LteUeCmacSapProvider::LogicalChannelConfig lcConfig{};
+    lcConfig.priority = EpsBearer::NGBR_VIDEO_TCP_DEFAULT;
+    lcConfig.logicalChannelGroup = 1;
+
+    // Setup: the LC goes in the BWP 1
+    auto lcsConfig = rrcSap->AddLc(lcid, lcConfig, &firstRlc);
+    NS_TEST_ASSERT_MSG_EQ(lcsConfig.size(), macs.size(), "One configuration per BWP");
+    rlcSap->ReportBufferStatus(CreateReport(rnti, lcid, 1000));
+    NS_TEST_ASSERT_MSG_EQ(macs.at(1).m_numReports, 1U, "The BWP 1 should get the report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(0).m_numReports, 0U, "The BWP 0 should not get the report");
+    lcsConfig.at(1).msu->NotifyTxOpportunity(CreateTxOpportunity(rnti, lcid, 1, 100));
+    NS_TEST_ASSERT_MSG_EQ(firstRlc.m_numTxOpportunities, 1U, "The RLC should get the TX op");
+
+    // Release, and setup of the same LCID: the new QCI goes in the BWP 0
+    rrcSap->RemoveLc(lcid);
+    lcConfig.priority = EpsBearer::GBR_CONV_VOICE;
+    lcsConfig = rrcSap->AddLc(lcid, lcConfig, &secondRlc);
+    rlcSap->ReportBufferStatus(CreateReport(rnti, lcid, 500));
+    NS_TEST_ASSERT_MSG_EQ(macs.at(0).m_numReports, 1U, "The BWP 0 should get the report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(0).m_lastReport.txQueueSize, 500U, "Wrong report");
+    NS_TEST_ASSERT_MSG_EQ(macs.at(1).m_numReports, 1U, "The BWP 1 should not get the report");
+    lcsConfig.at(0).msu->NotifyTxOpportunity(CreateTxOpportunity(rnti, lcid, 0, 200));
+    NS_TEST_ASSERT_MSG_EQ(secondRlc.m_numTxOpportunities, 1U, "The new RLC should get the TX op");
+    NS_TEST_ASSERT_MSG_EQ(firstRlc.m_numTxOpportunities, 1U, "The old RLC should not get it");
+
+    ccm->Dispose();
+}
+
+void
+NrBwpManagerRoutingTest::DoRun()
+{
+    Ptr<BwpManagerAlgorithmStatic> algorithm = CreateObject<BwpManagerAlgorithmStatic>();
+    algorithm->SetAttribute("NGBR_VIDEO_TCP_DEFAULT", UintegerValue(1));
+    algorithm->SetAttribute("GBR_CONV_VOICE", UintegerValue(0));
+
+    RunGnb(algorithm);
+    RunUe(algorithm);
+}
+
+/**
+ * \brief Test suite for the routes of the bearers of the BWP managers
+ */
+class NrBwpManagerRoutingTestSuite : public TestSuite
+{
+  public:
+    NrBwpManagerRoutingTestSuite()
+        : TestSuite("nr-bwp-manager-routing-test", UNIT)
+    {
+        AddTestCase(new NrBwpManagerRoutingTest("Setup, release, setup again and UE removal"),
+                    QUICK);
+    }
+};
+
+static NrBwpManagerRoutingTestSuite
+    nrBwpManagerRoutingTestSuite; //!< BWP manager routing test suite
+
+} // namespace ns3
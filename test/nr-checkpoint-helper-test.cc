@@ -0,0 +1,287 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/antenna-module.h>
+#include <ns3/core-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/nr-module.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-checkpoint-helper-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the NrCheckpointHelper
+ */
+namespace ns3
+{
+
+/**
+ * \brief Save the state of a gNB and a UE, and restore it in another simulation
+ *
+ * The first simulation saves the state at the end of the warm-up. The second
+ * one, where the UE is in another position, loads the file and restores the
+ * beams before the UE is attached: the beams used by the devices are the
+ * saved ones, and not the ones of the beamforming algorithm for the new
+ * position. The link adaptation state is restored in the scheduler when the
+ * UE is connected.
+ */
+class NrCheckpointHelperTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrCheckpointHelperTest()
+        : TestCase("Save, load and restore the beams and the link adaptation state")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Create a gNB and a UE, with a direct path beamforming that runs
+     * only at the attachment
+     * \param uePosition the position of the UE
+     * \param beamformingHelper the beamforming helper to fill
+     * \param gnbDevs the gNB devices to fill
+     * \param ueDevs the UE devices to fill
+     * \return the NR helper
+     */
+    Ptr<NrHelper> Deploy(const Vector& uePosition,
+                         Ptr<IdealBeamformingHelper>* beamformingHelper,
+                         NetDeviceContainer* gnbDevs,
+                         NetDeviceContainer* ueDevs) const;
+
+    /**
+     * \brief Save the beams and the link adaptation state of the devices
+     * \param gnbDev the gNB device
+     * \param ueDev the UE device
+     */
+    void SaveState(const Ptr<NrGnbNetDevice>& gnbDev, const Ptr<NrUeNetDevice>& ueDev);
+
+    /**
+     * \brief Check that the link adaptation state of the UE is the saved one
+     * \param gnbDev the gNB device
+     * \param ueDev the UE device
+     */
+    void CheckLinkState(const Ptr<NrGnbNetDevice>& gnbDev, const Ptr<NrUeNetDevice>& ueDev);
+
+    /**
+     * \brief Check that two beamforming vectors are equal
+     * \param a the first vector
+     * \param b the second vector
+     * \return true if they have the same elements
+     */
+    static bool IsEqual(const PhasedArrayModel::ComplexVector& a,
+                        const PhasedArrayModel::ComplexVector& b);
+
+    BeamformingVector m_gnbBeam;                //!< Beam of the gNB at the save
+    BeamformingVector m_ueBeam;                 //!< Beam of the UE at the save
+    NrMacSchedulerNs3::UeLinkState m_linkState; //!< Link state of the UE at the save
+    bool m_saved{false};                        //!< Whether the state has been saved
+    bool m_linkStateChecked{false};             //!< Whether the restored link state is checked
+};
+
+Ptr<NrHelper>
+NrCheckpointHelperTest::Deploy(const Vector& uePosition,
+                               Ptr<IdealBeamformingHelper>* beamformingHelper,
+                               NetDeviceContainer* gnbDevs,
+                               NetDeviceContainer* ueDevs) const
+{
+    NodeContainer gnbNodes;
+    NodeContainer ueNodes;
+    gnbNodes.Create(1);
+    ueNodes.Create(1);
+
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 10.0));
+    positionAlloc->Add(uePosition);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(NodeContainer(gnbNodes, ueNodes));
+
+    Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper>();
+    idealBeamformingHelper->SetAttribute("BeamformingMethod",
+                                         TypeIdValue(DirectPathBeamforming::GetTypeId()));
+    idealBeamformingHelper->SetAttribute("BeamformingPeriodicity", TimeValue(Seconds(0)));
+    *beamformingHelper = idealBeamformingHelper;
+
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(idealBeamformingHelper);
+    nrHelper->SetPathlossAttribute("ShadowingEnabled", BooleanValue(false));
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(4));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(4));
+
+    CcBwpCreator::SimpleOperationBandConf bandConf(28e9,
+                                                   20e6,
+                                                   1,
+                                                   BandwidthPartInfo::UMi_StreetCanyon);
+    CcBwpCreator ccBwpCreator;
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    *gnbDevs = nrHelper->InstallGnbDevice(gnbNodes, allBwps);
+    *ueDevs = nrHelper->InstallUeDevice(ueNodes, allBwps);
+    for (auto it = gnbDevs->Begin(); it != gnbDevs->End(); ++it)
+    {
+        DynamicCast<NrGnbNetDevice>(*it)->UpdateConfig();
+    }
+    for (auto it = ueDevs->Begin(); it != ueDevs->End(); ++it)
+    {
+        DynamicCast<NrUeNetDevice>(*it)->UpdateConfig();
+    }
+    return nrHelper;
+}
+
+void
+NrCheckpointHelperTest::SaveState(const Ptr<NrGnbNetDevice>& gnbDev,
+                                  const Ptr<NrUeNetDevice>& ueDev)
+{
+    Ptr<BeamManager> gnbBm = gnbDev->GetPhy(0)->GetSpectrumPhy(0)->GetBeamManager();
+    Ptr<BeamManager> ueBm = ueDev->GetPhy(0)->GetSpectrumPhy(0)->GetBeamManager();
+    m_gnbBeam = std::make_pair(gnbBm->GetBeamformingVector(ueDev), gnbBm->GetBeamId(ueDev));
+    m_ueBeam = std::make_pair(ueBm->GetBeamformingVector(gnbDev), ueBm->GetBeamId(gnbDev));
+
+    Ptr<NrMacSchedulerNs3> sched = DynamicCast<NrMacSchedulerNs3>(gnbDev->GetScheduler(0));
+    m_saved = sched->GetUeLinkState(ueDev->GetRrc()->GetRnti(), &m_linkState);
+}
+
+void
+NrCheckpointHelperTest::CheckLinkState(const Ptr<NrGnbNetDevice>& gnbDev,
+                                       const Ptr<NrUeNetDevice>& ueDev)
+{
+    Ptr<NrMacSchedulerNs3> sched = DynamicCast<NrMacSchedulerNs3>(gnbDev->GetScheduler(0));
+    NrMacSchedulerNs3::UeLinkState state;
+    NS_TEST_ASSERT_MSG_EQ(sched->GetUeLinkState(ueDev->GetRrc()->GetRnti(), &state),
+                          true,
+                          "The UE should be connected");
+    NS_TEST_ASSERT_MSG_EQ((state.m_dlMcs == m_linkState.m_dlMcs), true, "Wrong DL MCS");
+    NS_TEST_ASSERT_MSG_EQ((state.m_dlWbCqi == m_linkState.m_dlWbCqi), true, "Wrong DL CQI");
+    NS_TEST_ASSERT_MSG_EQ(+state.m_dlRi, +m_linkState.m_dlRi, "Wrong DL rank indicator");
+    NS_TEST_ASSERT_MSG_EQ(state.m_dlCqiTimer, m_linkState.m_dlCqiTimer, "Wrong DL CQI timer");
+    NS_TEST_ASSERT_MSG_EQ(+state.m_ulMcs, +m_linkState.m_ulMcs, "Wrong UL MCS");
+    NS_TEST_ASSERT_MSG_EQ(+state.m_ulCqi, +m_linkState.m_ulCqi, "Wrong UL CQI");
+    NS_TEST_ASSERT_MSG_EQ(state.m_ulCqiTimer, m_linkState.m_ulCqiTimer, "Wrong UL CQI timer");
+    m_linkStateChecked = true;
+}
+
+bool
+NrCheckpointHelperTest::IsEqual(const PhasedArrayModel::ComplexVector& a,
+                                const PhasedArrayModel::ComplexVector& b)
+{
+    if (a.GetSize() != b.GetSize())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.GetSize(); ++i)
+    {
+        if (a[i] != b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+NrCheckpointHelperTest::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("nr-checkpoint.txt");
+
+    // Warm-up: save the state when the UE is connected
+    {
+        Ptr<IdealBeamformingHelper> beamformingHelper;
+        NetDeviceContainer gnbDevs;
+        NetDeviceContainer ueDevs;
+        Ptr<NrHelper> nrHelper =
+            Deploy(Vector(30.0, 30.0, 1.5), &beamformingHelper, &gnbDevs, &ueDevs);
+        nrHelper->AttachToEnb(ueDevs.Get(0), gnbDevs.Get(0));
+
+        Ptr<NrCheckpointHelper> checkpointHelper = CreateObject<NrCheckpointHelper>();
+        checkpointHelper->ScheduleSave(MilliSeconds(150), fileName, gnbDevs, ueDevs);
+        Simulator::Schedule(MilliSeconds(150),
+                            &NrCheckpointHelperTest::SaveState,
+                            this,
+                            DynamicCast<NrGnbNetDevice>(gnbDevs.Get(0)),
+                            DynamicCast<NrUeNetDevice>(ueDevs.Get(0)));
+        Simulator::Stop(MilliSeconds(200));
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_saved, true, "The UE should be connected at the save");
+
+    // Restore, with the UE in another position
+    Ptr<IdealBeamformingHelper> beamformingHelper;
+    NetDeviceContainer gnbDevs;
+    NetDeviceContainer ueDevs;
+    Ptr<NrHelper> nrHelper =
+        Deploy(Vector(-30.0, 10.0, 1.5), &beamformingHelper, &gnbDevs, &ueDevs);
+    Ptr<NrGnbNetDevice> gnbDev = DynamicCast<NrGnbNetDevice>(gnbDevs.Get(0));
+    Ptr<NrUeNetDevice> ueDev = DynamicCast<NrUeNetDevice>(ueDevs.Get(0));
+
+    Ptr<NrCheckpointHelper> checkpointHelper = CreateObject<NrCheckpointHelper>();
+    checkpointHelper->Load(fileName);
+    NS_TEST_ASSERT_MSG_EQ(checkpointHelper->RestoreBeams(gnbDevs, ueDevs, beamformingHelper),
+                          1U,
+                          "The beams of the pair should be restored");
+
+    // The beamforming task of the attachment uses the restored beams
+    nrHelper->AttachToEnb(ueDev, gnbDev);
+    Ptr<NrSpectrumPhy> gnbSpectrumPhy = gnbDev->GetPhy(0)->GetSpectrumPhy(0);
+    Ptr<NrSpectrumPhy> ueSpectrumPhy = ueDev->GetPhy(0)->GetSpectrumPhy(0);
+    Ptr<BeamManager> gnbBm = gnbSpectrumPhy->GetBeamManager();
+    Ptr<BeamManager> ueBm = ueSpectrumPhy->GetBeamManager();
+    NS_TEST_ASSERT_MSG_EQ(IsEqual(gnbBm->GetBeamformingVector(ueDev), m_gnbBeam.first),
+                          true,
+                          "The gNB should use the saved beam");
+    NS_TEST_ASSERT_MSG_EQ(gnbBm->GetBeamId(ueDev), m_gnbBeam.second, "Wrong gNB beam ID");
+    NS_TEST_ASSERT_MSG_EQ(IsEqual(ueBm->GetBeamformingVector(gnbDev), m_ueBeam.first),
+                          true,
+                          "The UE should use the saved beam");
+    NS_TEST_ASSERT_MSG_EQ(ueBm->GetBeamId(gnbDev), m_ueBeam.second, "Wrong UE beam ID");
+
+    // The beamforming algorithm would have given another beam
+    const auto searched =
+        CreateDirectPathBfv(gnbSpectrumPhy->GetMobility(),
+                            ueSpectrumPhy->GetMobility(),
+                            gnbSpectrumPhy->GetAntenna()->GetObject<UniformPlanarArray>());
+    NS_TEST_ASSERT_MSG_EQ(IsEqual(searched, m_gnbBeam.first),
+                          false,
+                          "The beam of the new position should be different");
+
+    checkpointHelper->ScheduleRestoreLinkState(MilliSeconds(150), ueDevs);
+    Simulator::Schedule(MilliSeconds(150),
+                        &NrCheckpointHelperTest::CheckLinkState,
+                        this,
+                        gnbDev,
+                        ueDev);
+    Simulator::Stop(MilliSeconds(200));
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(m_linkStateChecked, true, "The link state should be checked");
+}
+
+/**
+ * \brief Test suite for the NrCheckpointHelper
+ */
+class NrCheckpointHelperTestSuite : public TestSuite
+{
+  public:
+    NrCheckpointHelperTestSuite()
+        : TestSuite("nr-checkpoint-helper-test", UNIT)
+    {
+        AddTestCase(new NrCheckpointHelperTest(), QUICK);
+    }
+};
+
+static NrCheckpointHelperTestSuite nrCheckpointHelperTestSuite; //!< Checkpoint helper test suite
+
+} // namespace ns3
@@ -0,0 +1,429 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/beam-conf-id.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
+#include <ns3/nr-amc.h>
+#include <ns3/nr-fh-control.h>
+#include <ns3/nr-gnb-mac.h>
+#include <ns3/nr-mac-sched-sap.h>
+#include <ns3/nr-mac-scheduler-ns3.h>
+#include <ns3/nr-phy-sap.h>
+#include <ns3/object-factory.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+
+/**
+ * \file nr-fh-control-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the NrFhControl
+ *
+ * The first test checks the accounting of the NrFhControl alone. The second
+ * one checks how an OFDMA scheduler, with a fake MAC and PHY, fits the DL
+ * data of a UE in the fronthaul capacity with each control method.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check the fronthaul bits of the allocations, with both compressions,
+ * and the accounting of the fronthaul capacity of a slot
+ */
+class NrFhControlTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrFhControlTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Save the FH load of a slot
+     * \param sfn the slot
+     * \param requestedRate the requested FH rate
+     * \param allocatedRate the allocated FH rate
+     */
+    void FhLoad(const SfnSf& sfn, double requestedRate, double allocatedRate);
+
+    uint32_t m_numSlots{0};    //!< Number of slots traced
+    double m_requestedRate{0}; //!< Requested FH rate of the last slot
+    double m_allocatedRate{0}; //!< Allocated FH rate of the last slot
+};
+
+void
+NrFhControlTest::FhLoad([[maybe_unused]] const SfnSf& sfn,
+                        double requestedRate,
+                        double allocatedRate)
+{
+    ++m_numSlots;
+    m_requestedRate = requestedRate;
+    m_allocatedRate = allocatedRate;
+}
+
+void
+NrFhControlTest::DoRun()
+{
+    Ptr<NrFhControl> fh = CreateObject<NrFhControl>();
+    fh->SetAttribute("FhCapacity", DataRateValue(DataRate("1Gbps")));
+    fh->TraceConnectWithoutContext("FhLoad", MakeCallback(&NrFhControlTest::FhLoad, this));
+
+    // 12 subcarriers x 2 samples x 9 bits + 8 bits of parameters, per RB
+    NS_TEST_ASSERT_MSG_EQ(fh->DependsOnModulation(), false, "BFP does not depend on the MCS");
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAllocationBits(10, 6, 2), 4480U, "Wrong bits with BFP");
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAllocationBits(10, 2, 2), 4480U, "Wrong bits with BFP");
+    fh->SetAttribute("TransportOverhead", DoubleValue(0.1));
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAllocationBits(10, 6, 2), 4928U, "Wrong bits with overhead");
+    fh->SetAttribute("TransportOverhead", DoubleValue(0.0));
+
+    // 12 subcarriers x 2 samples x Qm/2 bits + 8 bits of parameters, per RB
+    fh->SetAttribute("Compression", EnumValue(NrFhControl::MODULATION_COMPRESSION));
+    NS_TEST_ASSERT_MSG_EQ(fh->DependsOnModulation(), true, "MC depends on the MCS");
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAllocationBits(10, 6, 1), 800U, "Wrong bits with 64-QAM");
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAllocationBits(10, 2, 1), 320U, "Wrong bits with QPSK");
+
+    // A slot of 1 ms carries 10^6 bits
+    fh->StartSlot(SfnSf(0, 0, 0, 0), MilliSeconds(1));
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAvailableBits(), 1000000U, "Wrong capacity of the slot");
+    fh->AddAllocation(600000, 600000);
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAvailableBits(), 400000U, "Wrong available bits");
+    fh->AddAllocation(700000, 500000);
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAvailableBits(), 0U, "The capacity should be exhausted");
+    fh->EndSlot();
+
+    NS_TEST_ASSERT_MSG_EQ(m_numSlots, 1U, "The load of the slot should be traced");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_requestedRate, 1.3e9, 1, "Wrong requested rate");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_allocatedRate, 1.1e9, 1, "Wrong allocated rate");
+
+    fh->StartSlot(SfnSf(0, 0, 1, 0), MilliSeconds(1));
+    NS_TEST_ASSERT_MSG_EQ(fh->GetAvailableBits(), 1000000U, "A new slot starts empty");
+    fh->EndSlot();
+    NS_TEST_ASSERT_MSG_EQ(m_numSlots, 2U, "The load of the second slot should be traced");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_requestedRate, 0, 1e-9, "Wrong requested rate of an empty slot");
+}
+
+/**
+ * \brief A PHY SAP provider with a slot of 14 symbols of 1 ms, and a single beam
+ */
+class TestFhPhySapProvider : public NrPhySapProvider
+{
+  public:
+    uint32_t GetSymbolsPerSlot() const override
+    {
+        return 14;
+    }
+
+    Ptr<const SpectrumModel> GetSpectrumModel() override
+    {
+        return nullptr;
+    }
+
+    uint16_t GetBwpId() const override
+    {
+        return 0;
+    }
+
+    uint16_t GetCellId() const override
+    {
+        return 0;
+    }
+
+    Time GetSlotPeriod() const override
+    {
+        return MilliSeconds(1);
+    }
+
+    void SendMacPdu([[maybe_unused]] const Ptr<Packet>& p,
+                    [[maybe_unused]] const SfnSf& sfn,
+                    [[maybe_unused]] uint8_t symStart,
+                    [[maybe_unused]] uint8_t streamId) override
+    {
+    }
+
+    void SendMacPduBurst([[maybe_unused]] const Ptr<PacketBurst>& pb,
+                         [[maybe_unused]] const SfnSf& sfn,
+                         [[maybe_unused]] uint8_t symStart,
+                         [[maybe_unused]] uint8_t streamId) override
+    {
+    }
+
+    void SendControlMessage([[maybe_unused]] Ptr<NrControlMessage> msg) override
+    {
+    }
+
+    void SendRachPreamble([[maybe_unused]] uint8_t PreambleId,
+                          [[maybe_unused]] uint8_t Rnti) override
+    {
+    }
+
+    void SetSlotAllocInfo([[maybe_unused]] SlotAllocInfo slotAllocInfo) override
+    {
+    }
+
+    void NotifyConnectionSuccessful() override
+    {
+    }
+
+    uint32_t GetRbNum() const override
+    {
+        NS_FATAL_ERROR("GetRbNum should not be called");
+        return 53;
+    }
+
+    BeamConfId GetBeamConfId([[maybe_unused]] uint8_t rnti) const override
+    {
+        return BeamConfId(BeamId(0, 0.0), BeamId::GetEmptyBeamId());
+    }
+};
+
+/**
+ * \brief A gNB MAC that saves the DL data DCIs of the scheduler
+ */
+class TestFhGnbMac : public NrGnbMac
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::TestFhGnbMac").SetParent<NrGnbMac>();
+        return tid;
+    }
+
+    void DoSchedConfigIndication(NrMacSchedSapUser::SchedConfigIndParameters ind) override
+    {
+        for (const auto& alloc : ind.m_slotAllocInfo.m_varTtiAllocInfo)
+        {
+            if (alloc.m_dci->m_type == DciInfoElementTdma::DATA &&
+                alloc.m_dci->m_format == DciInfoElementTdma::DL)
+            {
+                m_dlDcis.push_back(alloc.m_dci);
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<DciInfoElementTdma>> m_dlDcis; //!< DL data DCIs
+};
+
+NS_OBJECT_ENSURE_REGISTERED(TestFhGnbMac);
+
+/**
+ * \brief Check that the scheduler fits the DL data in the fronthaul capacity
+ *
+ * A single UE, with a fixed 64-QAM MCS and a full buffer, is scheduled in two
+ * slots. In the first one, the fronthaul capacity is half of the bits of the
+ * full band: the UE is dropped (DROPPING), gets a lower modulation on all the
+ * RBGs (OPTIMIZE_MCS, with the modulation compression), or gets less RBGs
+ * with the same MCS (OPTIMIZE_RBS), and the FhLoad trace reports a requested
+ * rate higher than the allocated one. In the second slot, the capacity is
+ * large, and the UE gets again the full band with the original MCS.
+ */
+class NrFhControlSchedulerTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     * \param method the FH control method
+     */
+    NrFhControlSchedulerTest(const std::string& name, NrFhControl::FhControlMethod method)
+        : TestCase(name),
+          m_method(method)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Save the FH load of a slot
+     * \param sfn the slot
+     * \param requestedRate the requested FH rate
+     * \param allocatedRate the allocated FH rate
+     */
+    void FhLoad(const SfnSf& sfn, double requestedRate, double allocatedRate);
+
+    NrFhControl::FhControlMethod m_method;            //!< The FH control method
+    std::vector<std::pair<double, double>> m_fhLoads; //!< Requested and allocated rates
+};
+
+void
+NrFhControlSchedulerTest::FhLoad([[maybe_unused]] const SfnSf& sfn,
+                                 double requestedRate,
+                                 double allocatedRate)
+{
+    m_fhLoads.emplace_back(requestedRate, allocatedRate);
+}
+
+void
+NrFhControlSchedulerTest::DoRun()
+{
+    const uint8_t mcs = 20;     // 64-QAM with the MCS table 1
+    const uint32_t numRbg = 53; // 1 RB per RBG
+    const uint32_t numSym = 13; // 1 DL CTRL symbol
+    const uint16_t rnti = 1;
+
+    ObjectFactory schedFactory;
+    schedFactory.SetTypeId("ns3::NrMacSchedulerOfdmaPF");
+    schedFactory.Set("FixedMcsDl", BooleanValue(true));
+    schedFactory.Set("StartingMcsDl", UintegerValue(mcs));
+    Ptr<NrMacSchedulerNs3> sched = DynamicCast<NrMacSchedulerNs3>(schedFactory.Create());
+
+    Ptr<NrFhControl> fh = CreateObject<NrFhControl>();
+    fh->SetAttribute("ControlMethod", EnumValue(m_method));
+    if (m_method == NrFhControl::OPTIMIZE_MCS)
+    {
+        fh->SetAttribute("Compression", EnumValue(NrFhControl::MODULATION_COMPRESSION));
+    }
+    fh->TraceConnectWithoutContext("FhLoad",
+                                   MakeCallback(&NrFhControlSchedulerTest::FhLoad, this));
+    sched->SetFhControl(fh);
+
+    Ptr<TestFhGnbMac> mac = CreateObject<TestFhGnbMac>();
+    TestFhPhySapProvider phySapProvider;
+    mac->SetPhySapProvider(&phySapProvider);
+    mac->SetNrMacSchedSapProvider(sched->GetMacSchedSapProvider());
+    mac->SetNrMacCschedSapProvider(sched->GetMacCschedSapProvider());
+    sched->SetMacSchedSapUser(mac->GetNrMacSchedSapUser());
+    sched->SetMacCschedSapUser(mac->GetNrMacCschedSapUser());
+
+    NrMacCschedSapProvider::CschedCellConfigReqParameters params;
+    params.m_ulBandwidth = numRbg;
+    params.m_dlBandwidth = numRbg;
+    sched->DoCschedCellConfigReq(params);
+
+    Ptr<NrAmc> amc = CreateObject<NrAmc>();
+    sched->InstallDlAmc(amc);
+    const uint8_t qm = amc->GetModulationOrder(mcs);
+    NS_TEST_ASSERT_MSG_GT(qm, amc->GetModulationOrder(0), "The MCS should be lowerable");
+
+    NrMacCschedSapProvider::CschedUeConfigReqParameters paramsUe;
+    paramsUe.m_rnti = rnti;
+    paramsUe.m_beamConfId = phySapProvider.GetBeamConfId(rnti);
+    sched->DoCschedUeConfigReq(paramsUe);
+
+    NrMacCschedSapProvider::CschedLcConfigReqParameters paramsLc;
+    paramsLc.m_rnti = rnti;
+    paramsLc.m_reconfigureFlag = false;
+    LogicalChannelConfigListElement_s lc;
+    lc.m_logicalChannelIdentity = 1;
+    lc.m_logicalChannelGroup = 2;
+    lc.m_direction = LogicalChannelConfigListElement_s::DIR_DL;
+    lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+    lc.m_qci = 9;
+    paramsLc.m_logicalChannelConfigList.emplace_back(lc);
+    sched->DoCschedLcConfigReq(paramsLc);
+
+    NrMacSchedSapProvider::SchedDlRlcBufferReqParameters paramsDlRlc;
+    paramsDlRlc.m_rnti = rnti;
+    paramsDlRlc.m_logicalChannelIdentity = 1;
+    paramsDlRlc.m_rlcRetransmissionHolDelay = 0;
+    paramsDlRlc.m_rlcRetransmissionQueueSize = 0;
+    paramsDlRlc.m_rlcStatusPduSize = 0;
+    paramsDlRlc.m_rlcTransmissionQueueHolDelay = 0;
+    paramsDlRlc.m_rlcTransmissionQueueSize = 1000000;
+    sched->DoSchedDlRlcBufferReq(paramsDlRlc);
+
+    // Half of the bits of the full band, in a slot of 1 ms. With the
+    // modulation compression, it is more than the bits with QPSK.
+    const uint64_t fullBits = fh->GetAllocationBits(numRbg * numSym, qm, 1);
+    NS_TEST_ASSERT_MSG_LT(fh->GetAllocationBits(numRbg * numSym, amc->GetModulationOrder(0), 1),
+                          fullBits / 2,
+                          "The full band with the lowest modulation should fit");
+    fh->SetAttribute("FhCapacity", DataRateValue(DataRate(fullBits / 2 * 1000)));
+
+    NrMacSchedSapProvider::SchedDlTriggerReqParameters paramsDlTrigger;
+    paramsDlTrigger.m_snfSf = SfnSf(0, 0, 0, 0);
+    paramsDlTrigger.m_slotType = LteNrTddSlotType::DL;
+    sched->DoSchedDlTriggerReq(paramsDlTrigger);
+
+    NS_TEST_ASSERT_MSG_EQ(m_fhLoads.size(), 1U, "The FH load of the slot should be traced");
+    NS_TEST_ASSERT_MSG_GT(m_fhLoads.at(0).first,
+                          m_fhLoads.at(0).second,
+                          "The requested FH rate should be higher than the allocated one");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_fhLoads.at(0).second,
+                                fullBits / 2 * 1000.0,
+                                "The allocated FH rate should fit in the capacity");
+    if (m_method == NrFhControl::DROPPING)
+    {
+        NS_TEST_ASSERT_MSG_EQ(mac->m_dlDcis.size(), 0U, "The UE should be dropped");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(mac->m_dlDcis.size(), 1U, "The UE should be scheduled");
+        const auto& dci = mac->m_dlDcis.at(0);
+        const auto rbgs = static_cast<uint32_t>(
+            std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 1));
+        if (m_method == NrFhControl::OPTIMIZE_MCS)
+        {
+            NS_TEST_ASSERT_MSG_LT(amc->GetModulationOrder(dci->m_mcs.at(0)),
+                                  qm,
+                                  "The modulation order should be lowered");
+            NS_TEST_ASSERT_MSG_EQ(rbgs, numRbg, "The RBGs should not be reduced");
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(+dci->m_mcs.at(0), +mcs, "The MCS should not be lowered");
+            NS_TEST_ASSERT_MSG_LT(rbgs, numRbg, "The RBGs should be reduced");
+        }
+    }
+
+    // A large capacity: the MCS lowered in the previous slot is restored
+    fh->SetAttribute("FhCapacity", DataRateValue(DataRate("10Gbps")));
+    mac->m_dlDcis.clear();
+    paramsDlTrigger.m_snfSf = SfnSf(0, 0, 1, 0);
+    sched->DoSchedDlTriggerReq(paramsDlTrigger);
+
+    NS_TEST_ASSERT_MSG_EQ(m_fhLoads.size(), 2U, "The FH load of the slot should be traced");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_fhLoads.at(1).first,
+                              m_fhLoads.at(1).second,
+                              1e-6,
+                              "The whole requested FH rate should be allocated");
+    NS_TEST_ASSERT_MSG_EQ(mac->m_dlDcis.size(), 1U, "The UE should be scheduled");
+    const auto& dci = mac->m_dlDcis.at(0);
+    NS_TEST_ASSERT_MSG_EQ(+dci->m_mcs.at(0), +mcs, "The MCS should be restored");
+    NS_TEST_ASSERT_MSG_EQ(static_cast<uint32_t>(
+                              std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 1)),
+                          numRbg,
+                          "The UE should get the full band");
+}
+
+/**
+ * \brief Test suite for the NrFhControl
+ */
+class NrFhControlTestSuite : public TestSuite
+{
+  public:
+    NrFhControlTestSuite()
+        : TestSuite("nr-fh-control-test", UNIT)
+    {
+        AddTestCase(new NrFhControlTest("Fronthaul bits and slot capacity test"), QUICK);
+        AddTestCase(new NrFhControlSchedulerTest("Scheduler with dropping", NrFhControl::DROPPING),
+                    QUICK);
+        AddTestCase(new NrFhControlSchedulerTest("Scheduler with MCS optimization",
+                                                 NrFhControl::OPTIMIZE_MCS),
+                    QUICK);
+        AddTestCase(new NrFhControlSchedulerTest("Scheduler with RBs optimization",
+                                                 NrFhControl::OPTIMIZE_RBS),
+                    QUICK);
+    }
+};
+
+static NrFhControlTestSuite nrFhControlTestSuite; //!< Fronthaul control test suite
+
+} // namespace ns3
@@ -0,0 +1,540 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/beam-manager.h>
+#include <ns3/beamforming-vector.h>
+#include <ns3/boolean.h>
+#include <ns3/cc-bwp-helper.h>
+#include <ns3/channel-condition-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/hexagonal-grid-scenario-helper.h>
+#include <ns3/ideal-beamforming-algorithm.h>
+#include <ns3/ideal-beamforming-helper.h>
+#include <ns3/mobility-model.h>
+#include <ns3/nr-gnb-net-device.h>
+#include <ns3/nr-gnb-phy.h>
+#include <ns3/nr-helper.h>
+#include <ns3/nr-spectrum-phy.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/nr-ue-phy.h>
+#include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/test.h>
+#include <ns3/three-gpp-propagation-loss-model.h>
+#include <ns3/three-gpp-spectrum-propagation-loss-model.h>
+#include <ns3/uinteger.h>
+#include <ns3/uniform-planar-array.h>
+#include <ns3/wrap-around-channel-condition-model.h>
+#include <ns3/wrap-around-propagation-loss-model.h>
+#include <ns3/wrap-around-spectrum-propagation-loss-model.h>
+
+#include <cmath>
+#include <memory>
+
+/**
+ * \file nr-hexagonal-grid-scenario-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the HexagonalGridScenarioHelper
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check the number and the positions of the sites of the hexagonal
+ * layouts, also beyond the 5 rings of the original tables, and the
+ * wrap-around of the complete hexagons
+ */
+class NrHexagonalGridScenarioTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrHexagonalGridScenarioTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+NrHexagonalGridScenarioTest::DoRun()
+{
+    ScenarioParameters params;
+    params.SetScenarioParameters("UMi");
+    params.SetSectorization(ScenarioParameters::SINGLE);
+    const double isd = 500;
+    const double antennaOffset = 1;
+
+    const std::vector<std::size_t> expectedSites{1, 7, 13, 19, 31, 37, 43, 55, 61};
+    for (uint8_t rings = 0; rings < expectedSites.size(); ++rings)
+    {
+        HexagonalGridScenarioHelper scenario;
+        scenario.SetScenarioParameters(params);
+        scenario.SetNumRings(rings);
+        NS_TEST_ASSERT_MSG_EQ(scenario.GetNumSites(),
+                              expectedSites[rings],
+                              "Wrong number of sites with " << +rings << " rings");
+    }
+
+    // Sites of the rings 6, 7 and 8 (the central site is the first one)
+    HexagonalGridScenarioHelper scenario;
+    scenario.SetScenarioParameters(params);
+    scenario.SetResultsDir(CreateTempDirFilename(""));
+    scenario.SetNumRings(8);
+    scenario.SetUtNumber(scenario.GetNumSites());
+    scenario.CreateScenario();
+
+    const NodeContainer& bs = scenario.GetBaseStations();
+    NS_TEST_ASSERT_MSG_EQ(bs.GetN(), 61U, "Wrong number of base stations");
+    for (uint32_t i = 37; i < bs.GetN(); ++i)
+    {
+        const double expected = i < 43 ? std::sqrt(12) : (i < 55 ? std::sqrt(13) : 4);
+        Vector pos = bs.Get(i)->GetObject<MobilityModel>()->GetPosition();
+        NS_TEST_ASSERT_MSG_EQ_TOL(std::hypot(pos.x, pos.y),
+                                  expected * isd,
+                                  antennaOffset,
+                                  "Wrong distance of site " << i);
+        for (uint32_t j = 0; j < i; ++j)
+        {
+            Vector other = bs.Get(j)->GetObject<MobilityModel>()->GetPosition();
+            NS_TEST_ASSERT_MSG_GT(CalculateDistance(pos, other),
+                                  isd - 2 * antennaOffset,
+                                  "Sites " << j << " and " << i << " are too close");
+        }
+    }
+
+    // The copies of a 19-site layout are at sqrt(19) ISD from it
+    HexagonalGridScenarioHelper wrapped;
+    wrapped.SetScenarioParameters(params);
+    wrapped.SetNumRings(3);
+    const auto offsets = wrapped.GetWrapAroundOffsets();
+    NS_TEST_ASSERT_MSG_EQ(offsets.size(), 6U, "Wrong number of copies");
+    for (const auto& offset : offsets)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(offset.GetLength(),
+                                  std::sqrt(19) * isd,
+                                  1e-6,
+                                  "Wrong offset of a copy");
+    }
+
+    // A UE at the edge of the layout is close to a copy of the site at the
+    // opposite edge
+    const Vector bsPos(-std::sqrt(3) * isd, 0, 10);
+    const Vector utPos(2.2 * isd, 0, 1.5);
+    Vector wrappedPos = wrapped.GetWrappedPosition(bsPos, utPos);
+    NS_TEST_ASSERT_MSG_LT(CalculateDistance(wrappedPos, utPos),
+                          isd,
+                          "The closest copy of the site should be used");
+    NS_TEST_ASSERT_MSG_EQ_TOL(wrappedPos.z, bsPos.z, 1e-9, "The height should not change");
+    wrappedPos = wrapped.GetWrappedPosition(Vector(0, 0, 10), Vector(isd / 2, 0, 1.5));
+    NS_TEST_ASSERT_MSG_EQ_TOL(wrappedPos.GetLength(), 10, 1e-9, "A close site is not wrapped");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \brief A channel condition model that records the distance of the last link
+ */
+class NrWrapAroundTestConditionModel : public ChannelConditionModel
+{
+  public:
+    Ptr<ChannelCondition> GetChannelCondition(Ptr<const MobilityModel> a,
+                                              Ptr<const MobilityModel> b) const override
+    {
+        m_lastDistance = a->GetDistanceFrom(b);
+        return CreateObject<ChannelCondition>(ChannelCondition::LOS);
+    }
+
+    int64_t AssignStreams([[maybe_unused]] int64_t stream) override
+    {
+        return 0;
+    }
+
+    mutable double m_lastDistance{0.0}; //!< Distance of the last link
+};
+
+/**
+ * \brief A spectrum propagation loss model that records the distance of the
+ * last link, and does not change the PSD
+ */
+class NrWrapAroundTestSpectrumModel : public PhasedArraySpectrumPropagationLossModel
+{
+  public:
+    mutable double m_lastDistance{0.0}; //!< Distance of the last link
+
+  private:
+    Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity(
+        Ptr<const SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        [[maybe_unused]] Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        [[maybe_unused]] Ptr<const PhasedArrayModel> bPhasedArrayModel) const override
+    {
+        m_lastDistance = a->GetDistanceFrom(b);
+        return params->psd->Copy();
+    }
+
+    int64_t DoAssignStreams([[maybe_unused]] int64_t stream) override
+    {
+        return 0;
+    }
+};
+
+/**
+ * \brief Check that the channel models wrapped by the wrap-around use the
+ * closest copy of each site: a UE at the edge of the layout receives the
+ * interference of the site at the opposite edge from its copy, next to the UE
+ */
+class NrWrapAroundChannelTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrWrapAroundChannelTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+NrWrapAroundChannelTest::DoRun()
+{
+    ScenarioParameters params;
+    params.SetScenarioParameters("UMi");
+    params.SetSectorization(ScenarioParameters::SINGLE);
+    const double isd = 500;
+
+    HexagonalGridScenarioHelper scenario;
+    scenario.SetScenarioParameters(params);
+    scenario.SetResultsDir(CreateTempDirFilename(""));
+    scenario.SetNumRings(3);
+    scenario.SetUtNumber(1);
+    scenario.CreateScenario();
+    const NodeContainer& bs = scenario.GetBaseStations();
+
+    // A UE at the edge of the layout, and the farthest site
+    Ptr<MobilityModel> ue = scenario.GetUserTerminals().Get(0)->GetObject<MobilityModel>();
+    ue->SetPosition(Vector(2.2 * isd, 0, 1.5));
+    Ptr<MobilityModel> far;
+    Ptr<MobilityModel> close;
+    for (uint32_t i = 0; i < bs.GetN(); ++i)
+    {
+        Ptr<MobilityModel> site = bs.Get(i)->GetObject<MobilityModel>();
+        if (far == nullptr || site->GetDistanceFrom(ue) > far->GetDistanceFrom(ue))
+        {
+            far = site;
+        }
+        if (close == nullptr || site->GetDistanceFrom(ue) < close->GetDistanceFrom(ue))
+        {
+            close = site;
+        }
+    }
+    Ptr<MobilityModel> copy = CreateObject<ConstantPositionMobilityModel>();
+    copy->SetPosition(scenario.GetWrappedPosition(far->GetPosition(), ue->GetPosition()));
+    const double wrappedDistance = copy->GetDistanceFrom(ue);
+    NS_TEST_ASSERT_MSG_GT(far->GetDistanceFrom(ue), 3 * isd, "The site should be far");
+    NS_TEST_ASSERT_MSG_LT(wrappedDistance, isd, "The copy of the site should be close");
+
+    Ptr<WrapAroundModel> wrapAround = scenario.CreateWrapAroundModel();
+    NS_TEST_ASSERT_MSG_EQ(wrapAround->GetNumBaseStations(), bs.GetN(), "Missing base stations");
+
+    // Pathloss: the interference comes from the copy, in both directions
+    Ptr<PropagationLossModel> friis = CreateObject<FriisPropagationLossModel>();
+    auto propagation = CreateObject<WrapAroundPropagationLossModel>();
+    propagation->SetPropagationLossModel(friis);
+    propagation->SetWrapAroundModel(wrapAround);
+    const double rxFromCopy = friis->CalcRxPower(0, copy, ue);
+    NS_TEST_ASSERT_MSG_EQ_TOL(propagation->CalcRxPower(0, far, ue),
+                              rxFromCopy,
+                              1e-9,
+                              "The DL interference should come from the copy");
+    NS_TEST_ASSERT_MSG_EQ_TOL(propagation->CalcRxPower(0, ue, far),
+                              rxFromCopy,
+                              1e-9,
+                              "The UL interference should come from the copy");
+    NS_TEST_ASSERT_MSG_GT(rxFromCopy,
+                          friis->CalcRxPower(0, far, ue) + 10,
+                          "The wrap-around should increase the interference");
+    NS_TEST_ASSERT_MSG_EQ_TOL(propagation->CalcRxPower(0, close, ue),
+                              friis->CalcRxPower(0, close, ue),
+                              1e-9,
+                              "The closest site should not be wrapped");
+
+    // Channel condition
+    auto recordingCondition = CreateObject<NrWrapAroundTestConditionModel>();
+    auto condition = CreateObject<WrapAroundChannelConditionModel>();
+    condition->SetChannelConditionModel(recordingCondition);
+    condition->SetWrapAroundModel(wrapAround);
+    condition->GetChannelCondition(ue, far);
+    NS_TEST_ASSERT_MSG_EQ_TOL(recordingCondition->m_lastDistance,
+                              wrappedDistance,
+                              1e-9,
+                              "The condition should be the one of the copy");
+
+    // Fast fading and beamforming
+    auto recordingFading = CreateObject<NrWrapAroundTestSpectrumModel>();
+    auto fading = CreateObject<WrapAroundSpectrumPropagationLossModel>();
+    fading->SetSpectrumPropagationLossModel(recordingFading);
+    fading->SetWrapAroundModel(wrapAround);
+    auto signal = Create<SpectrumSignalParameters>();
+    signal->psd = Create<SpectrumValue>(Create<SpectrumModel>(std::vector<double>{28e9, 28.1e9}));
+    (*signal->psd) = 1.0;
+    fading->CalcRxPowerSpectralDensity(signal, far, ue, nullptr, nullptr);
+    NS_TEST_ASSERT_MSG_EQ_TOL(recordingFading->m_lastDistance,
+                              wrappedDistance,
+                              1e-9,
+                              "The fast fading should be the one of the copy");
+
+    // The helper replaces the models of a band, and their condition model
+    auto bwp = std::make_unique<BandwidthPartInfo>();
+    auto threeGppPropagation = CreateObject<ThreeGppUmiStreetCanyonPropagationLossModel>();
+    threeGppPropagation->SetChannelConditionModel(
+        CreateObject<ThreeGppUmiStreetCanyonChannelConditionModel>());
+    bwp->m_propagation = threeGppPropagation;
+    auto threeGppFading = CreateObject<ThreeGppSpectrumPropagationLossModel>();
+    bwp->m_3gppChannel = threeGppFading;
+    auto cc = std::make_unique<ComponentCarrierInfo>();
+    cc->m_bwp.push_back(std::move(bwp));
+    OperationBandInfo band;
+    band.m_cc.push_back(std::move(cc));
+
+    HexagonalGridScenarioHelper::ApplyWrapAround(&band, wrapAround);
+    const auto& wrappedBwp = band.m_cc.at(0)->m_bwp.at(0);
+    NS_TEST_ASSERT_MSG_NE(DynamicCast<WrapAroundPropagationLossModel>(wrappedBwp->m_propagation),
+                          nullptr,
+                          "The propagation loss model should be wrapped");
+    NS_TEST_ASSERT_MSG_NE(
+        DynamicCast<WrapAroundSpectrumPropagationLossModel>(wrappedBwp->m_3gppChannel),
+        nullptr,
+        "The spectrum propagation loss model should be wrapped");
+    NS_TEST_ASSERT_MSG_NE(DynamicCast<WrapAroundChannelConditionModel>(
+                              threeGppPropagation->GetChannelConditionModel()),
+                          nullptr,
+                          "The condition model of the pathloss should be wrapped");
+    PointerValue fadingCondition;
+    threeGppFading->GetChannelModel()->GetAttribute("ChannelConditionModel", fadingCondition);
+    NS_TEST_ASSERT_MSG_EQ(fadingCondition.Get<ChannelConditionModel>(),
+                          threeGppPropagation->GetChannelConditionModel(),
+                          "The fast fading should use the same condition model");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \brief Check the wrap-around on the devices installed by NrHelper
+ *
+ * A UE at the edge of a 7-site layout is attached to the farthest site, that
+ * uses the direct path beamforming. NrHelper::AssignStreams must reach the
+ * 3GPP models behind the wrappers, as many streams as without the
+ * wrap-around, and the beam of the gNB must point at its copy closest to the
+ * UE. The periodic searches of the static pair must be skipped, because the
+ * beamforming helper finds the channel matrix of the pair behind the wrapper.
+ */
+class NrWrapAroundHelperTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrWrapAroundHelperTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Run a short simulation with the UE and the farthest site
+     * \param wrapAround whether the wrap-around is applied to the band
+     * \return the number of streams assigned to the devices
+     */
+    int64_t RunSimulation(bool wrapAround);
+
+    /**
+     * \brief Check that two beamforming vectors are equal
+     * \param a the first vector
+     * \param b the second vector
+     * \return true if they have the same elements
+     */
+    static bool IsEqual(const PhasedArrayModel::ComplexVector& a,
+                        const PhasedArrayModel::ComplexVector& b);
+};
+
+bool
+NrWrapAroundHelperTest::IsEqual(const PhasedArrayModel::ComplexVector& a,
+                                const PhasedArrayModel::ComplexVector& b)
+{
+    if (a.GetSize() != b.GetSize())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.GetSize(); ++i)
+    {
+        if (a[i] != b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t
+NrWrapAroundHelperTest::RunSimulation(bool wrapAround)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    ScenarioParameters params;
+    params.SetScenarioParameters("UMi");
+    params.SetSectorization(ScenarioParameters::SINGLE);
+    const double isd = 500;
+
+    HexagonalGridScenarioHelper scenario;
+    scenario.SetScenarioParameters(params);
+    scenario.SetResultsDir(CreateTempDirFilename(""));
+    scenario.SetNumRings(1);
+    scenario.SetUtNumber(1);
+    scenario.CreateScenario();
+    const NodeContainer& bs = scenario.GetBaseStations();
+
+    // A UE at the edge of the layout, and the farthest site
+    Ptr<Node> ueNode = scenario.GetUserTerminals().Get(0);
+    Ptr<MobilityModel> ue = ueNode->GetObject<MobilityModel>();
+    ue->SetPosition(Vector(1.2 * isd, 0, 1.5));
+    Ptr<Node> farNode;
+    for (uint32_t i = 0; i < bs.GetN(); ++i)
+    {
+        if (farNode == nullptr ||
+            bs.Get(i)->GetObject<MobilityModel>()->GetDistanceFrom(ue) >
+                farNode->GetObject<MobilityModel>()->GetDistanceFrom(ue))
+        {
+            farNode = bs.Get(i);
+        }
+    }
+    Ptr<MobilityModel> far = farNode->GetObject<MobilityModel>();
+
+    Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper>();
+    idealBeamformingHelper->SetAttribute("BeamformingMethod",
+                                         TypeIdValue(DirectPathBeamforming::GetTypeId()));
+    idealBeamformingHelper->SetAttribute("BeamformingPeriodicity", TimeValue(MilliSeconds(10)));
+    idealBeamformingHelper->SetAttribute("SkipUnchangedPairs", BooleanValue(true));
+
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(idealBeamformingHelper);
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(4));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(4));
+
+    CcBwpCreator::SimpleOperationBandConf bandConf(28e9,
+                                                   20e6,
+                                                   1,
+                                                   BandwidthPartInfo::UMi_StreetCanyon);
+    CcBwpCreator ccBwpCreator;
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    if (wrapAround)
+    {
+        nrHelper->InitializeOperationBand(&band,
+                                          NrHelper::INIT_PROPAGATION | NrHelper::INIT_FADING);
+        HexagonalGridScenarioHelper::ApplyWrapAround(&band, scenario.CreateWrapAroundModel());
+    }
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice(NodeContainer(farNode), allBwps);
+    NetDeviceContainer ueDevs = nrHelper->InstallUeDevice(NodeContainer(ueNode), allBwps);
+    int64_t streams = nrHelper->AssignStreams(gnbDevs, 1);
+    streams += nrHelper->AssignStreams(ueDevs, 1 + streams);
+    for (auto it = gnbDevs.Begin(); it != gnbDevs.End(); ++it)
+    {
+        DynamicCast<NrGnbNetDevice>(*it)->UpdateConfig();
+    }
+    for (auto it = ueDevs.Begin(); it != ueDevs.End(); ++it)
+    {
+        DynamicCast<NrUeNetDevice>(*it)->UpdateConfig();
+    }
+    nrHelper->AttachToEnb(ueDevs.Get(0), gnbDevs.Get(0));
+
+    Simulator::Stop(MilliSeconds(25));
+    Simulator::Run();
+
+    // The gNB points at its copy closest to the UE, or at itself without the wrap-around
+    Ptr<MobilityModel> target = CreateObject<ConstantPositionMobilityModel>();
+    target->SetPosition(wrapAround
+                            ? scenario.GetWrappedPosition(far->GetPosition(), ue->GetPosition())
+                            : far->GetPosition());
+    Ptr<NrSpectrumPhy> gnbSpectrumPhy =
+        NrHelper::GetGnbPhy(gnbDevs.Get(0), 0)->GetSpectrumPhy(0);
+    Ptr<const UniformPlanarArray> gnbAntenna =
+        gnbSpectrumPhy->GetAntenna()->GetObject<UniformPlanarArray>();
+    const PhasedArrayModel::ComplexVector gnbBeam =
+        gnbSpectrumPhy->GetBeamManager()->GetBeamformingVector(ueDevs.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(IsEqual(gnbBeam, CreateDirectPathBfv(target, ue, gnbAntenna)),
+                          true,
+                          "The gNB should point at the " << (wrapAround ? "copy" : "site"));
+    if (wrapAround)
+    {
+        NS_TEST_EXPECT_MSG_LT(target->GetDistanceFrom(ue),
+                              far->GetDistanceFrom(ue),
+                              "The copy of the site should be closer than the site");
+        NS_TEST_EXPECT_MSG_EQ(IsEqual(gnbBeam, CreateDirectPathBfv(far, ue, gnbAntenna)),
+                              false,
+                              "The gNB should not point at the site");
+    }
+    NS_TEST_EXPECT_MSG_EQ(idealBeamformingHelper->GetNumSkippedSearches(),
+                          2U,
+                          "The periodic searches of the static pair should be skipped");
+
+    Simulator::Destroy();
+    return streams;
+}
+
+void
+NrWrapAroundHelperTest::DoRun()
+{
+    const int64_t streams = RunSimulation(false);
+    const int64_t wrappedStreams = RunSimulation(true);
+    NS_TEST_ASSERT_MSG_GT(streams, 0, "Streams should be assigned");
+    NS_TEST_ASSERT_MSG_EQ(wrappedStreams,
+                          streams,
+                          "The wrapped models should take the streams of the 3GPP models");
+}
+
+/**
+ * \brief Test suite for the HexagonalGridScenarioHelper
+ */
+class NrHexagonalGridScenarioTestSuite : public TestSuite
+{
+  public:
+    NrHexagonalGridScenarioTestSuite()
+        : TestSuite("nr-hexagonal-grid-scenario-test", UNIT)
+    {
+        AddTestCase(new NrHexagonalGridScenarioTest("Hexagonal layouts and wrap-around test"),
+                    QUICK);
+        AddTestCase(new NrWrapAroundChannelTest("Channel models with the wrap-around"), QUICK);
+        AddTestCase(new NrWrapAroundHelperTest("NrHelper devices with the wrap-around"), QUICK);
+    }
+};
+
+static NrHexagonalGridScenarioTestSuite
+    nrHexagonalGridScenarioTestSuite; //!< Hexagonal grid scenario test suite
+
+} // namespace ns3
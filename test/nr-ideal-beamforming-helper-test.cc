@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/antenna-module.h>
+#include <ns3/core-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/nr-module.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-ideal-beamforming-helper-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the skip of the unchanged pairs of the IdealBeamformingHelper
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check the periodic beamforming, with and without the skip of the
+ * unchanged pairs
+ *
+ * A gNB and a UE use the cell scan beamforming, searched every 10 ms for
+ * 55 ms (5 periodic searches). If the UE does not move, the pair is skipped
+ * by all the periodic searches, and the beams at the end are the ones of a
+ * simulation where the skip is disabled. If the UE moves, the pair is
+ * searched by all the periodic searches.
+ */
+class NrIdealBeamformingHelperTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     * \param moving whether the UE moves
+     */
+    NrIdealBeamformingHelperTest(const std::string& name, bool moving)
+        : TestCase(name),
+          m_moving(moving)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief The result of a simulation
+     */
+    struct Result
+    {
+        BeamformingVector m_gnbBeam;      //!< Beam of the gNB at the end
+        BeamformingVector m_ueBeam;       //!< Beam of the UE at the end
+        uint64_t m_numSearches{0};        //!< Searches of the periodic beamforming
+        uint64_t m_numSkippedSearches{0}; //!< Skipped searches of the periodic beamforming
+    };
+
+    /**
+     * \brief Run a simulation with a gNB and a UE
+     * \param skipUnchangedPairs the value of the attribute SkipUnchangedPairs
+     * \return the beams and the searches at the end of the simulation
+     */
+    Result RunSimulation(bool skipUnchangedPairs) const;
+
+    /**
+     * \brief Check that two beamforming vectors are equal
+     * \param a the first vector
+     * \param b the second vector
+     * \return true if they have the same elements
+     */
+    static bool IsEqual(const PhasedArrayModel::ComplexVector& a,
+                        const PhasedArrayModel::ComplexVector& b);
+
+    bool m_moving; //!< Whether the UE moves
+};
+
+NrIdealBeamformingHelperTest::Result
+NrIdealBeamformingHelperTest::RunSimulation(bool skipUnchangedPairs) const
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer gnbNodes;
+    NodeContainer ueNodes;
+    gnbNodes.Create(1);
+    ueNodes.Create(1);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(gnbNodes);
+    gnbNodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(0.0, 0.0, 10.0));
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(ueNodes);
+    ueNodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(30.0, 10.0, 1.5));
+    ueNodes.Get(0)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(
+        m_moving ? Vector(0.0, 10.0, 0.0) : Vector(0.0, 0.0, 0.0));
+
+    Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper>();
+    idealBeamformingHelper->SetAttribute("BeamformingMethod",
+                                         TypeIdValue(CellScanBeamforming::GetTypeId()));
+    idealBeamformingHelper->SetAttribute("BeamformingPeriodicity", TimeValue(MilliSeconds(10)));
+    idealBeamformingHelper->SetAttribute("SkipUnchangedPairs", BooleanValue(skipUnchangedPairs));
+
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(idealBeamformingHelper);
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(4));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(4));
+
+    CcBwpCreator::SimpleOperationBandConf bandConf(28e9,
+                                                   20e6,
+                                                   1,
+                                                   BandwidthPartInfo::UMi_StreetCanyon);
+    CcBwpCreator ccBwpCreator;
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice(gnbNodes, allBwps);
+    NetDeviceContainer ueDevs = nrHelper->InstallUeDevice(ueNodes, allBwps);
+    nrHelper->AssignStreams(gnbDevs, 1);
+    nrHelper->AssignStreams(ueDevs, 1);
+    for (auto it = gnbDevs.Begin(); it != gnbDevs.End(); ++it)
+    {
+        DynamicCast<NrGnbNetDevice>(*it)->UpdateConfig();
+    }
+    for (auto it = ueDevs.Begin(); it != ueDevs.End(); ++it)
+    {
+        DynamicCast<NrUeNetDevice>(*it)->UpdateConfig();
+    }
+    nrHelper->AttachToEnb(ueDevs.Get(0), gnbDevs.Get(0));
+
+    Simulator::Stop(MilliSeconds(55));
+    Simulator::Run();
+
+    Ptr<NetDevice> gnbDev = gnbDevs.Get(0);
+    Ptr<NetDevice> ueDev = ueDevs.Get(0);
+    Ptr<BeamManager> gnbBm = nrHelper->GetGnbPhy(gnbDev, 0)->GetSpectrumPhy(0)->GetBeamManager();
+    Ptr<BeamManager> ueBm = nrHelper->GetUePhy(ueDev, 0)->GetSpectrumPhy(0)->GetBeamManager();
+    Result result;
+    result.m_gnbBeam = std::make_pair(gnbBm->GetBeamformingVector(ueDev), gnbBm->GetBeamId(ueDev));
+    result.m_ueBeam = std::make_pair(ueBm->GetBeamformingVector(gnbDev), ueBm->GetBeamId(gnbDev));
+    result.m_numSearches = idealBeamformingHelper->GetNumSearches();
+    result.m_numSkippedSearches = idealBeamformingHelper->GetNumSkippedSearches();
+
+    Simulator::Destroy();
+    return result;
+}
+
+bool
+NrIdealBeamformingHelperTest::IsEqual(const PhasedArrayModel::ComplexVector& a,
+                                      const PhasedArrayModel::ComplexVector& b)
+{
+    if (a.GetSize() != b.GetSize())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.GetSize(); ++i)
+    {
+        if (a[i] != b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+NrIdealBeamformingHelperTest::DoRun()
+{
+    const Result searched = RunSimulation(false);
+    NS_TEST_ASSERT_MSG_EQ(searched.m_numSearches, 5U, "Every periodic search should run");
+    NS_TEST_ASSERT_MSG_EQ(searched.m_numSkippedSearches, 0U, "No search should be skipped");
+
+    const Result skipped = RunSimulation(true);
+    if (m_moving)
+    {
+        NS_TEST_ASSERT_MSG_EQ(skipped.m_numSearches,
+                              5U,
+                              "The pair that moves should be searched again");
+        NS_TEST_ASSERT_MSG_EQ(skipped.m_numSkippedSearches,
+                              0U,
+                              "The pair that moves should not be skipped");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(skipped.m_numSearches, 0U, "The static pair should be skipped");
+        NS_TEST_ASSERT_MSG_EQ(skipped.m_numSkippedSearches,
+                              5U,
+                              "Every periodic search of the static pair should be skipped");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(IsEqual(skipped.m_gnbBeam.first, searched.m_gnbBeam.first),
+                          true,
+                          "The gNB beam should be the one of the search");
+    NS_TEST_ASSERT_MSG_EQ(skipped.m_gnbBeam.second,
+                          searched.m_gnbBeam.second,
+                          "The gNB beam ID should be the one of the search");
+    NS_TEST_ASSERT_MSG_EQ(IsEqual(skipped.m_ueBeam.first, searched.m_ueBeam.first),
+                          true,
+                          "The UE beam should be the one of the search");
+    NS_TEST_ASSERT_MSG_EQ(skipped.m_ueBeam.second,
+                          searched.m_ueBeam.second,
+                          "The UE beam ID should be the one of the search");
+}
+
+/**
+ * \brief Test suite for the IdealBeamformingHelper
+ */
+class NrIdealBeamformingHelperTestSuite : public TestSuite
+{
+  public:
+    NrIdealBeamformingHelperTestSuite()
+        : TestSuite("nr-ideal-beamforming-helper-test", UNIT)
+    {
+        AddTestCase(new NrIdealBeamformingHelperTest("Static pair", false), QUICK);
+        AddTestCase(new NrIdealBeamformingHelperTest("Moving pair", true), QUICK);
+    }
+};
+
+static NrIdealBeamformingHelperTestSuite
+    nrIdealBeamformingHelperTestSuite; //!< Ideal beamforming helper test suite
+
+} // namespace ns3
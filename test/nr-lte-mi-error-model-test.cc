@@ -0,0 +1,158 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-lte-mi-error-model.h>
+#include <ns3/nr-spectrum-value-helper.h>
+#include <ns3/test.h>
+
+#include <cmath>
+
+/**
+ * \file nr-lte-mi-error-model-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the NrLteMiErrorModel
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check the TBLER of the NrLteMiErrorModel, which maps the MI in batches
+ * of RBs and tabulates the BLER curves, against the values of the previous
+ * implementation, which mapped each RB separately and evaluated erf for each
+ * code block
+ */
+class NrLteMiErrorModelTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrLteMiErrorModelTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Create a SINR vector, whose SINR changes around a mean value
+     * \param numRbs the number of RBs
+     * \param sinrDb the mean SINR (dB)
+     * \return the SINR vector
+     */
+    static SpectrumValue CreateSinr(uint32_t numRbs, double sinrDb);
+};
+
+SpectrumValue
+NrLteMiErrorModelTest::CreateSinr(uint32_t numRbs, double sinrDb)
+{
+    const double offsetDb[4] = {-2.0, 0.0, 1.5, 3.0};
+    SpectrumValue sinr(NrSpectrumValueHelper::GetSpectrumModel(numRbs, 2e9, 15e3));
+    for (uint32_t rb = 0; rb < numRbs; ++rb)
+    {
+        sinr[rb] = std::pow(10.0, (sinrDb + offsetDb[rb % 4]) / 10.0);
+    }
+    return sinr;
+}
+
+void
+NrLteMiErrorModelTest::DoRun()
+{
+    /**
+     * \brief A transmission, and its TBLER
+     */
+    struct TestPoint
+    {
+        uint8_t m_mcs;     //!< MCS
+        uint32_t m_tbSize; //!< TB size (bytes)
+        uint32_t m_numRbs; //!< Number of RBs
+        double m_sinrDb;   //!< Mean SINR (dB)
+        double m_expected; //!< TBLER of the previous implementation
+    };
+
+    const std::vector<TestPoint> points{
+        {4, 100, 25, -4.5, 0.7629814298554622},
+        {4, 100, 25, -3.5, 0.015633219789257136},
+        {13, 1500, 50, 4.75, 0.5759792564664827},
+        {13, 1500, 50, 5.5, 3.73485748328406e-07},
+        {24, 6000, 100, 15.5, 0.2957418069445128},
+        {28, 9000, 100, 19.5, 0.4500982482318734},
+        {28, 9000, 100, 20.0, 0.012690589868832758},
+        {9, 500, 30, -20.0, 1.0},
+        {20, 3000, 60, 40.0, 0.0},
+    };
+    const double tolerance = 1e-5;
+
+    Ptr<NrLteMiErrorModel> em = CreateObject<NrLteMiErrorModel>();
+    for (const auto& p : points)
+    {
+        std::vector<int> map(p.m_numRbs);
+        for (uint32_t rb = 0; rb < p.m_numRbs; ++rb)
+        {
+            map[rb] = static_cast<int>(rb);
+        }
+        auto output = em->GetTbDecodificationStats(CreateSinr(p.m_numRbs, p.m_sinrDb),
+                                                   map,
+                                                   p.m_tbSize,
+                                                   p.m_mcs,
+                                                   NrErrorModel::NrErrorModelHistory());
+        NS_TEST_ASSERT_MSG_EQ_TOL(output->m_tbler,
+                                  p.m_expected,
+                                  tolerance,
+                                  "Wrong TBLER with MCS " << +p.m_mcs << " and SINR "
+                                                          << p.m_sinrDb << " dB");
+    }
+
+    // A retransmission, 3 dB below the first transmission
+    const std::vector<TestPoint> retxPoints{
+        {13, 1500, 50, 1.5, 0.3585370617838769},
+        {24, 6000, 100, 5.5, 0.6101650065407159},
+        {6, 300, 25, -4.25, 0.7004550745113803},
+    };
+    for (const auto& p : retxPoints)
+    {
+        std::vector<int> map(p.m_numRbs);
+        for (uint32_t rb = 0; rb < p.m_numRbs; ++rb)
+        {
+            map[rb] = static_cast<int>(rb);
+        }
+        NrErrorModel::NrErrorModelHistory history;
+        history.push_back(em->GetTbDecodificationStats(CreateSinr(p.m_numRbs, p.m_sinrDb),
+                                                       map,
+                                                       p.m_tbSize,
+                                                       p.m_mcs,
+                                                       history));
+        auto output = em->GetTbDecodificationStats(CreateSinr(p.m_numRbs, p.m_sinrDb - 3),
+                                                   map,
+                                                   p.m_tbSize,
+                                                   p.m_mcs,
+                                                   history);
+        NS_TEST_ASSERT_MSG_EQ_TOL(output->m_tbler,
+                                  p.m_expected,
+                                  tolerance,
+                                  "Wrong TBLER of the retransmission with MCS " << +p.m_mcs);
+    }
+}
+
+/**
+ * \brief Test suite for the NrLteMiErrorModel
+ */
+class NrLteMiErrorModelTestSuite : public TestSuite
+{
+  public:
+    NrLteMiErrorModelTestSuite()
+        : TestSuite("nr-lte-mi-error-model-test", UNIT)
+    {
+        AddTestCase(new NrLteMiErrorModelTest("MI mapping and tabulated BLER test"), QUICK);
+    }
+};
+
+static NrLteMiErrorModelTestSuite nrLteMiErrorModelTestSuite; //!< MI error model test suite
+
+} // namespace ns3
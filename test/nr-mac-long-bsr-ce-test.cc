@@ -0,0 +1,274 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/boolean.h>
+#include <ns3/nr-mac-long-bsr-ce.h>
+#include <ns3/nr-mac-short-bsr-ce.h>
+#include <ns3/nr-mac-short-truncated-bsr-ce.h>
+#include <ns3/nr-ue-mac.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-mac-long-bsr-ce-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the LONG_BSR CE
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Serialize and deserialize a LONG_BSR, and check the level conversion
+ */
+class NrMacLongBsrCeTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrMacLongBsrCeTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+NrMacLongBsrCeTest::DoRun()
+{
+    Packet::EnablePrinting();
+    Packet::EnableChecking();
+
+    Ptr<Packet> pdu = Create<Packet>();
+
+    // LCG 2, 4 and 6 are empty, and therefore not serialized
+    const std::vector<uint64_t> bytes = {12, 400, 0, 5400, 0, 500000, 0, 100000000};
+
+    {
+        NrMacLongBsrCe bsr;
+        for (uint8_t lcg = 0; lcg < NrMacLongBsrCe::MAX_LCG; ++lcg)
+        {
+            bsr.m_bufferSizeLevel[lcg] = NrMacLongBsrCe::FromBytesToLevel(bytes.at(lcg));
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(bsr.GetNumReportedLcg(), 5, "Wrong number of reported LCG");
+        NS_TEST_ASSERT_MSG_EQ(bsr.GetSerializedSize(),
+                              NrMacLongBsrCe::GetSerializedSizeFor(5),
+                              "Wrong serialized size");
+
+        pdu->AddHeader(bsr);
+    }
+
+    std::cout << " the pdu is: ";
+    pdu->Print(std::cout);
+    std::cout << std::endl;
+
+    NS_TEST_ASSERT_MSG_EQ(pdu->GetSize(), 2 + 1 + 5, "Wrong PDU size");
+
+    {
+        NrMacLongBsrCe bsr;
+
+        pdu->RemoveHeader(bsr);
+
+        for (uint8_t lcg = 0; lcg < NrMacLongBsrCe::MAX_LCG; ++lcg)
+        {
+            NS_TEST_ASSERT_MSG_EQ(+bsr.m_bufferSizeLevel[lcg],
+                                  +NrMacLongBsrCe::FromBytesToLevel(bytes.at(lcg)),
+                                  "Deserialize failed for BufferLevel of LCG " << +lcg);
+        }
+        NS_TEST_ASSERT_MSG_EQ(pdu->GetSize(), 0, "Not all the PDU was read");
+    }
+
+    // The level conversion returns the upper bound of the level, that is
+    // greater or equal than the original value
+    for (uint64_t b : {0, 1, 10, 11, 150, 150000, 81338368})
+    {
+        uint8_t level = NrMacLongBsrCe::FromBytesToLevel(b);
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(NrMacLongBsrCe::FromLevelToBytes(level),
+                                    b,
+                                    "Level " << +level << " is lower than " << b << " bytes");
+        if (level > 0)
+        {
+            NS_TEST_ASSERT_MSG_LT(NrMacLongBsrCe::FromLevelToBytes(level - 1),
+                                  b,
+                                  "Level " << +level << " is not the lowest for " << b << " B");
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(+NrMacLongBsrCe::FromBytesToLevel(0), 0, "Wrong level for 0 B");
+    NS_TEST_ASSERT_MSG_EQ(+NrMacLongBsrCe::FromBytesToLevel(81338369),
+                          254,
+                          "Wrong level for the biggest buffer");
+}
+
+/**
+ * \brief Serialize and deserialize a SHORT_TRUNCATED_BSR, and check its
+ * conversion into LONG_BSR levels
+ */
+class NrMacShortTruncatedBsrCeTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrMacShortTruncatedBsrCeTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+NrMacShortTruncatedBsrCeTest::DoRun()
+{
+    Packet::EnablePrinting();
+    Packet::EnableChecking();
+
+    for (uint8_t lcg = 0; lcg < NrMacLongBsrCe::MAX_LCG; ++lcg)
+    {
+        Ptr<Packet> pdu = Create<Packet>();
+
+        NrMacShortTruncatedBsrCe sent;
+        sent.m_lcg = lcg;
+        sent.m_bufferSizeLevel = NrMacShortBsrCe::FromBytesToLevel(1000 + lcg);
+        pdu->AddHeader(sent);
+
+        NS_TEST_ASSERT_MSG_EQ(pdu->GetSize(), 2, "Wrong PDU size");
+
+        NrMacShortTruncatedBsrCe received;
+        pdu->RemoveHeader(received);
+        NS_TEST_ASSERT_MSG_EQ(+received.m_lcg, +lcg, "Deserialize failed for the LCG");
+        NS_TEST_ASSERT_MSG_EQ((received == sent), true, "Deserialize failed for the level");
+        NS_TEST_ASSERT_MSG_EQ(pdu->GetSize(), 0, "Not all the PDU was read");
+
+        std::vector<uint8_t> levels = received.ToLongBsrLevels();
+        NS_TEST_ASSERT_MSG_EQ(levels.size(), NrMacLongBsrCe::MAX_LCG, "Wrong number of levels");
+        for (uint8_t other = 0; other < NrMacLongBsrCe::MAX_LCG; ++other)
+        {
+            if (other != lcg)
+            {
+                NS_TEST_ASSERT_MSG_EQ(+levels.at(other), 0, "Only one LCG should be reported");
+            }
+        }
+        // The LONG_BSR level covers the bytes of the SHORT_BSR level
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(NrMacLongBsrCe::FromLevelToBytes(levels.at(lcg)),
+                                    NrMacShortBsrCe::FromLevelToBytes(sent.m_bufferSizeLevel),
+                                    "Wrong conversion of the level");
+    }
+}
+
+/**
+ * \brief Check the BSR format selected by the UE MAC, for the LCGs with data
+ * and the bytes of the grant left for the BSR
+ */
+class NrUeMacBsrFormatTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrUeMacBsrFormatTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Check the format and the size of the BSR selected by a UE MAC
+     * \param mac the UE MAC
+     * \param lcgBufferSizes the bytes waiting in each LCG
+     * \param availableBytes the bytes of the grant left for the BSR
+     * \param format the expected format
+     * \param size the expected size of the BSR
+     */
+    void CheckFormat(const Ptr<NrUeMac>& mac,
+                     const std::vector<uint32_t>& lcgBufferSizes,
+                     uint32_t availableBytes,
+                     NrUeMac::BsrFormat format,
+                     uint32_t size);
+};
+
+void
+NrUeMacBsrFormatTest::CheckFormat(const Ptr<NrUeMac>& mac,
+                                  const std::vector<uint32_t>& lcgBufferSizes,
+                                  uint32_t availableBytes,
+                                  NrUeMac::BsrFormat format,
+                                  uint32_t size)
+{
+    NS_TEST_ASSERT_MSG_EQ(+mac->SelectBsrFormat(lcgBufferSizes, availableBytes),
+                          +format,
+                          "Wrong format with " << availableBytes << " bytes available");
+    NS_TEST_ASSERT_MSG_EQ(mac->GetBsrSize(lcgBufferSizes, availableBytes),
+                          size,
+                          "Wrong size with " << availableBytes << " bytes available");
+}
+
+void
+NrUeMacBsrFormatTest::DoRun()
+{
+    Ptr<NrUeMac> mac = CreateObject<NrUeMac>();
+
+    const uint32_t shortSize = NrMacShortBsrCe().GetSerializedSize();
+    const uint32_t truncatedSize = NrMacShortTruncatedBsrCe().GetSerializedSize();
+    const uint32_t longSize3 = NrMacLongBsrCe::GetSerializedSizeFor(3);
+    NS_TEST_ASSERT_MSG_GT(shortSize, truncatedSize, "The truncated BSR should be the smallest");
+    NS_TEST_ASSERT_MSG_GT(longSize3, shortSize, "Three LCGs should not fit in a SHORT_BSR size");
+
+    // One LCG among 0 to 3 with data: SHORT_BSR, if it fits
+    const std::vector<uint32_t> oneLow = {0, 500, 0, 0, 0, 0, 0, 0};
+    CheckFormat(mac, oneLow, 100, NrUeMac::SHORT_BSR, shortSize);
+    CheckFormat(mac, oneLow, shortSize, NrUeMac::SHORT_BSR, shortSize);
+    CheckFormat(mac, oneLow, shortSize - 1, NrUeMac::SHORT_TRUNCATED_BSR, truncatedSize);
+
+    // More LCGs among 0 to 3 with data: LONG_BSR if it fits, SHORT_BSR otherwise
+    const std::vector<uint32_t> threeLow = {100, 0, 3000, 40, 0, 0, 0, 0};
+    CheckFormat(mac, threeLow, 100, NrUeMac::LONG_BSR, longSize3);
+    CheckFormat(mac, threeLow, longSize3, NrUeMac::LONG_BSR, longSize3);
+    CheckFormat(mac, threeLow, longSize3 - 1, NrUeMac::SHORT_BSR, shortSize);
+    CheckFormat(mac, threeLow, shortSize - 1, NrUeMac::SHORT_TRUNCATED_BSR, truncatedSize);
+
+    // Data in LCG 4 to 7: LONG_BSR if it fits, SHORT_TRUNCATED_BSR otherwise
+    const std::vector<uint32_t> lowAndHigh = {100, 0, 0, 0, 0, 20000, 0, 7};
+    CheckFormat(mac, lowAndHigh, longSize3, NrUeMac::LONG_BSR, longSize3);
+    CheckFormat(mac, lowAndHigh, longSize3 - 1, NrUeMac::SHORT_TRUNCATED_BSR, truncatedSize);
+
+    const std::vector<uint32_t> oneHigh = {0, 0, 0, 0, 0, 0, 1000, 0};
+    CheckFormat(mac, oneHigh, 100, NrUeMac::SHORT_TRUNCATED_BSR, truncatedSize);
+
+    // Without the LONG_BSR, the data of LCG 0 to 3 still fits in the SHORT_BSR
+    mac->SetAttribute("EnableLongBsr", BooleanValue(false));
+    CheckFormat(mac, threeLow, 100, NrUeMac::SHORT_BSR, shortSize);
+    CheckFormat(mac, lowAndHigh, 100, NrUeMac::SHORT_TRUNCATED_BSR, truncatedSize);
+
+    mac->Dispose();
+}
+
+/**
+ * \brief Test suite for the LONG_BSR CE
+ */
+class NrMacLongBsrCeTestSuite : public TestSuite
+{
+  public:
+    NrMacLongBsrCeTestSuite()
+        : TestSuite("nr-mac-long-bsr-ce-test", UNIT)
+    {
+        AddTestCase(new NrMacLongBsrCeTest("Long BSR CE test"), QUICK);
+        AddTestCase(new NrMacShortTruncatedBsrCeTest("Short truncated BSR CE test"), QUICK);
+        AddTestCase(new NrUeMacBsrFormatTest("BSR format selection test"), QUICK);
+    }
+};
+
+static NrMacLongBsrCeTestSuite nrMacLongBsrCeTestSuite;
+
+} // namespace ns3
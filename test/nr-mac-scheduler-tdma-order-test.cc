@@ -0,0 +1,127 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-mac-scheduler-tdma.h>
+#include <ns3/nr-mac-scheduler-ue-info-rr.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * \file nr-mac-scheduler-tdma-order-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the order of the UEs in the TDMA schedulers
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Run the iterations of a TDMA allocation, giving each symbol to the
+ * first UE, and check that NrMacSchedulerTdma::SortUeVector gives at each
+ * iteration the same order (and then the same allocation) of std::sort
+ */
+class NrMacSchedulerTdmaOrderTest : public TestCase
+{
+  public:
+    /**
+     * \brief Function that gives the initial number of RBG of a UE
+     */
+    using InitialRbgFn = std::function<uint32_t(uint16_t rnti)>;
+
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     * \param numUes Number of UEs
+     * \param initialRbg Initial number of RBG of each UE
+     */
+    NrMacSchedulerTdmaOrderTest(const std::string& name,
+                                uint16_t numUes,
+                                const InitialRbgFn& initialRbg)
+        : TestCase(name),
+          m_numUes(numUes),
+          m_initialRbg(initialRbg)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    uint16_t m_numUes;         //!< Number of UEs
+    InitialRbgFn m_initialRbg; //!< Initial number of RBG of each UE
+};
+
+void
+NrMacSchedulerTdmaOrderTest::DoRun()
+{
+    const BeamConfId beam(BeamId(8, 120.0), BeamId::GetEmptyBeamId());
+    auto rbPerRbg = []() -> uint32_t { return 1; };
+
+    std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> reference;
+    for (uint16_t rnti = 1; rnti <= m_numUes; ++rnti)
+    {
+        auto ue = std::make_shared<NrMacSchedulerUeInfoRR>(rnti, beam, rbPerRbg);
+        ue->m_dlRBG = m_initialRbg(rnti);
+        reference.emplace_back(ue, 1000);
+    }
+    // The UEs are shared: the metric of the UE that gets the symbol changes in both
+    std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> ueVector = reference;
+    std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> previousOrder;
+
+    const NrMacSchedulerTdma::CompareUeFn compare = NrMacSchedulerUeInfoRR::CompareUeWeightsDl;
+
+    for (uint32_t sym = 0; sym < 200; ++sym)
+    {
+        std::sort(reference.begin(), reference.end(), compare);
+        NrMacSchedulerTdma::SortUeVector(ueVector, compare, previousOrder);
+
+        for (std::size_t i = 0; i < reference.size(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(ueVector.at(i).first->m_rnti,
+                                  reference.at(i).first->m_rnti,
+                                  "Different order at symbol " << sym << ", position " << i);
+        }
+
+        if (!ueVector.empty())
+        {
+            ueVector.front().first->m_dlRBG += 3;
+        }
+    }
+}
+
+/**
+ * \brief Test suite for the order of the UEs in the TDMA schedulers
+ */
+class NrMacSchedulerTdmaOrderTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerTdmaOrderTestSuite()
+        : TestSuite("nr-mac-scheduler-tdma-order-test", UNIT)
+    {
+        auto equal = []([[maybe_unused]] uint16_t rnti) -> uint32_t { return 0; };
+        auto fewEqual = [](uint16_t rnti) -> uint32_t { return rnti % 4; };
+        auto distinct = [](uint16_t rnti) -> uint32_t { return rnti * 1000; };
+
+        AddTestCase(new NrMacSchedulerTdmaOrderTest("No UE", 0, equal), QUICK);
+        AddTestCase(new NrMacSchedulerTdmaOrderTest("1 UE", 1, equal), QUICK);
+        AddTestCase(new NrMacSchedulerTdmaOrderTest("10 UEs with the same metric", 10, equal),
+                    QUICK);
+        AddTestCase(new NrMacSchedulerTdmaOrderTest("40 UEs with the same metric", 40, equal),
+                    QUICK);
+        AddTestCase(new NrMacSchedulerTdmaOrderTest("40 UEs with 4 metrics", 40, fewEqual),
+                    QUICK);
+        AddTestCase(new NrMacSchedulerTdmaOrderTest("40 UEs with distinct metrics", 40, distinct),
+                    QUICK);
+    }
+};
+
+static NrMacSchedulerTdmaOrderTestSuite
+    nrMacSchedulerTdmaOrderTestSuite; //!< TDMA UE order test suite
+
+} // namespace ns3
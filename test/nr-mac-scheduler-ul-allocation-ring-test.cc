@@ -0,0 +1,175 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-mac-scheduler-ofdma-rr.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-mac-scheduler-ul-allocation-ring-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the ring of the UL allocations of NrMacSchedulerNs3
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check the lookup, the release and the horizon of the ring of the UL
+ * allocations that wait for their UL CQI
+ *
+ * The ring starts with 8 positions, and it does not grow when a slot takes
+ * the position of a pending slot: storing it would abort the simulation. The
+ * ring is enlarged only by the horizon given by the PHY, rounded up to a power
+ * of two, and the stored allocations are still found after it. A released
+ * position is reused, and keeps the storage of its allocations.
+ */
+class NrMacSchedulerUlAllocationRingTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrMacSchedulerUlAllocationRingTestCase(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Get the slot that follows the first one by a number of slots
+     * \param slotN the number of slots
+     * \return the slot
+     */
+    static SfnSf GetSlot(uint32_t slotN);
+
+    /**
+     * \brief Check that a slot is stored, with its number of UL symbols
+     * \param sched the scheduler
+     * \param slotN the slot, as in GetSlot
+     * \param totUlSym the expected number of UL symbols
+     */
+    void CheckStored(const Ptr<NrMacSchedulerNs3>& sched, uint32_t slotN, uint8_t totUlSym);
+};
+
+SfnSf
+NrMacSchedulerUlAllocationRingTestCase::GetSlot(uint32_t slotN)
+{
+    SfnSf sfn(0, 0, 0, 1);
+    sfn.Add(slotN);
+    return sfn;
+}
+
+void
+NrMacSchedulerUlAllocationRingTestCase::CheckStored(const Ptr<NrMacSchedulerNs3>& sched,
+                                                    uint32_t slotN,
+                                                    uint8_t totUlSym)
+{
+    NrMacSchedulerNs3::SlotElem* elem = sched->FindUlAllocations(GetSlot(slotN));
+    NS_TEST_ASSERT_MSG_EQ((elem != nullptr), true, "The slot " << slotN << " should be stored");
+    NS_TEST_ASSERT_MSG_EQ(+elem->m_totUlSym,
+                          +totUlSym,
+                          "Wrong UL symbols for the slot " << slotN);
+}
+
+void
+NrMacSchedulerUlAllocationRingTestCase::DoRun()
+{
+    Ptr<NrMacSchedulerNs3> sched = CreateObject<NrMacSchedulerOfdmaRR>();
+    auto& ring = sched->m_ulAllocationRing;
+
+    NS_TEST_ASSERT_MSG_EQ(ring.GetCapacity(), 8U, "The first ring has 8 positions");
+    NS_TEST_ASSERT_MSG_EQ((sched->FindUlAllocations(GetSlot(0)) == nullptr),
+                          true,
+                          "No slot should be stored in an empty ring");
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        sched->GetUlAllocations(GetSlot(i)).m_totUlSym = static_cast<uint8_t>(i + 1);
+    }
+    NS_TEST_ASSERT_MSG_EQ(ring.GetSize(), 8U, "Wrong number of stored slots");
+    NS_TEST_ASSERT_MSG_EQ((&sched->GetUlAllocations(GetSlot(3)) ==
+                           sched->FindUlAllocations(GetSlot(3))),
+                          true,
+                          "A stored slot should not be stored again");
+    NS_TEST_ASSERT_MSG_EQ((sched->FindUlAllocations(GetSlot(8)) == nullptr),
+                          true,
+                          "A slot in the position of another one should not be found");
+
+    // The position of the slot 8 is taken by the slot 0, still pending: the
+    // ring is not enlarged, and storing the slot 8 would overflow it
+    NS_TEST_ASSERT_MSG_EQ(ring.CanStore(GetSlot(8)), false, "The slot 8 overflows the ring");
+    NS_TEST_ASSERT_MSG_EQ(ring.CanStore(GetSlot(3)), true, "A stored slot can be stored");
+    NS_TEST_ASSERT_MSG_EQ(ring.GetCapacity(), 8U, "The ring should not grow by itself");
+
+    // The horizon of the PHY enlarges the ring, keeping the stored slots
+    sched->DoSchedSetUlAllocationHorizon(19);
+    NS_TEST_ASSERT_MSG_EQ(ring.GetCapacity(),
+                          32U,
+                          "The horizon should be rounded up to a power of two");
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        CheckStored(sched, i, static_cast<uint8_t>(i + 1));
+    }
+    sched->DoSchedSetUlAllocationHorizon(2);
+    NS_TEST_ASSERT_MSG_EQ(ring.GetCapacity(), 32U, "A shorter horizon should not reduce it");
+    sched->GetUlAllocations(GetSlot(8)).m_totUlSym = 9;
+    CheckStored(sched, 8, 9);
+
+    sched->ReleaseUlAllocations(GetSlot(0));
+    NS_TEST_ASSERT_MSG_EQ((sched->FindUlAllocations(GetSlot(0)) == nullptr),
+                          true,
+                          "A released slot should not be found");
+    NS_TEST_ASSERT_MSG_EQ(ring.GetSize(), 8U, "Wrong number of stored slots");
+
+    // The released position is reused, with the storage of its allocations
+    NrMacSchedulerNs3::SlotElem& slot1 = sched->GetUlAllocations(GetSlot(1));
+    for (uint16_t rnti = 1; rnti <= 4; ++rnti)
+    {
+        slot1.m_ulAllocations.emplace_back(rnti, 100, 1, 1, 0, std::vector<uint8_t>());
+    }
+    const std::size_t capacity = slot1.m_ulAllocations.capacity();
+    sched->ReleaseUlAllocations(GetSlot(1));
+    NS_TEST_ASSERT_MSG_EQ(ring.CanStore(GetSlot(33)), true, "A released position is free");
+    NrMacSchedulerNs3::SlotElem& slot33 = sched->GetUlAllocations(GetSlot(33));
+    NS_TEST_ASSERT_MSG_EQ(ring.GetCapacity(), 32U, "A released position should be reused");
+    NS_TEST_ASSERT_MSG_EQ(+slot33.m_totUlSym, 0, "A reused position should be empty");
+    NS_TEST_ASSERT_MSG_EQ(slot33.m_ulAllocations.empty(), true, "A reused position is empty");
+    NS_TEST_ASSERT_MSG_EQ(slot33.m_ulAllocations.capacity(),
+                          capacity,
+                          "A reused position should keep the storage of its allocations");
+    slot33.m_totUlSym = 33;
+    CheckStored(sched, 33, 33);
+
+    for (uint32_t i = 2; i <= 8; ++i)
+    {
+        sched->ReleaseUlAllocations(GetSlot(i));
+    }
+    sched->ReleaseUlAllocations(GetSlot(33));
+    NS_TEST_ASSERT_MSG_EQ(ring.GetSize(), 0U, "All the slots should be released");
+
+    sched->Dispose();
+}
+
+/**
+ * \brief Test suite for the ring of the UL allocations of NrMacSchedulerNs3
+ */
+class NrMacSchedulerUlAllocationRingTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerUlAllocationRingTestSuite()
+        : TestSuite("nr-mac-scheduler-ul-allocation-ring-test", UNIT)
+    {
+        AddTestCase(new NrMacSchedulerUlAllocationRingTestCase("Lookup, release and horizon"),
+                    QUICK);
+    }
+};
+
+static NrMacSchedulerUlAllocationRingTestSuite
+    nrMacSchedulerUlAllocationRingTestSuite; //!< UL allocation ring test suite
+
+} // namespace ns3
@@ -0,0 +1,658 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/antenna-module.h>
+#include <ns3/applications-module.h>
+#include <ns3/core-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/nr-module.h>
+#include <ns3/nr-parallel-slot-executor.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/test.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file nr-parallel-slot-executor-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the NrParallelSlotExecutor
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check that the indications of a slot boundary run in the first slot
+ * start, except the ones of a group after a slot start not run yet, that the
+ * commits of each owner run in its slot start, in order, and that the result
+ * does not depend on the number of threads
+ */
+class NrParallelSlotExecutorTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrParallelSlotExecutorTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief The state of the owner of a lane
+     */
+    struct Owner
+    {
+        uint32_t m_group{0};        //!< Group of the owner
+        uint64_t m_state{0};        //!< State touched only by the tasks of the lane
+        std::vector<int> m_order{}; //!< Tasks run, in order
+    };
+
+    /**
+     * \brief Announce the slot starts of all the owners, and schedule them
+     * \param executor the executor
+     * \param owners the owners of the lanes
+     * \param log the log of the indications, of the main-thread tasks, of the
+     * commits and of the slot starts
+     */
+    static void AnnounceSlotStarts(Ptr<NrParallelSlotExecutor> executor,
+                                   std::vector<Owner>* owners,
+                                   std::vector<std::string>* log);
+
+    /**
+     * \brief The indication of an owner: submit its tasks
+     * \param executor the executor
+     * \param owner the owner
+     * \param index the index of the owner
+     * \param log the log
+     */
+    static void Indication(Ptr<NrParallelSlotExecutor> executor,
+                           Owner* owner,
+                           size_t index,
+                           std::vector<std::string>* log);
+
+    /**
+     * \brief The slot start of an owner
+     * \param executor the executor
+     * \param owner the owner
+     * \param index the index of the owner
+     * \param log the log
+     */
+    static void SlotStart(Ptr<NrParallelSlotExecutor> executor,
+                          Owner* owner,
+                          size_t index,
+                          std::vector<std::string>* log);
+
+    /**
+     * \brief Run a simulation with an executor
+     * \param numThreads the number of threads of the executor
+     * \param owners the owners of the lanes
+     * \return the log
+     */
+    std::vector<std::string> RunWith(uint32_t numThreads, std::vector<Owner>* owners);
+};
+
+void
+NrParallelSlotExecutorTest::AnnounceSlotStarts(Ptr<NrParallelSlotExecutor> executor,
+                                               std::vector<Owner>* owners,
+                                               std::vector<std::string>* log)
+{
+    for (size_t i = 0; i < owners->size(); ++i)
+    {
+        Owner* owner = &owners->at(i);
+        executor->AddSlotStart(
+            owner,
+            &owners->at(owner->m_group),
+            [executor, owner, i, log]() { Indication(executor, owner, i, log); },
+            []() { return true; });
+        Simulator::ScheduleNow(&NrParallelSlotExecutorTest::SlotStart, executor, owner, i, log);
+    }
+}
+
+void
+NrParallelSlotExecutorTest::Indication(Ptr<NrParallelSlotExecutor> executor,
+                                       Owner* owner,
+                                       size_t index,
+                                       std::vector<std::string>* log)
+{
+    log->push_back("indication " + std::to_string(index));
+    NrParallelSlotExecutor::RunAtCommit(
+        [log, index]() { log->push_back("indication commit " + std::to_string(index)); });
+
+    for (int step = 0; step < 4; ++step)
+    {
+        // The third step of each lane uses the log, shared by the lanes
+        const bool concurrent = step != 2;
+        executor->Submit(
+            [owner, log, index, step, concurrent]() {
+                for (uint32_t k = 0; k < 10000; ++k)
+                {
+                    owner->m_state = owner->m_state * 6364136223846793005ULL + index + step;
+                }
+                owner->m_order.push_back(step);
+                if (!concurrent)
+                {
+                    log->push_back("main " + std::to_string(index));
+                }
+                NrParallelSlotExecutor::RunAtCommit([log, index, step]() {
+                    log->push_back("commit " + std::to_string(index) + " " + std::to_string(step));
+                });
+            },
+            concurrent);
+    }
+}
+
+void
+NrParallelSlotExecutorTest::SlotStart(Ptr<NrParallelSlotExecutor> executor,
+                                      Owner* owner,
+                                      size_t index,
+                                      std::vector<std::string>* log)
+{
+    log->push_back("start " + std::to_string(index));
+    const bool run = executor->RunSlotStart(owner);
+    log->push_back("continue " + std::to_string(index) + " " + std::to_string(run));
+}
+
+std::vector<std::string>
+NrParallelSlotExecutorTest::RunWith(uint32_t numThreads, std::vector<Owner>* owners)
+{
+    std::vector<std::string> log;
+    Ptr<NrParallelSlotExecutor> executor =
+        CreateObjectWithAttributes<NrParallelSlotExecutor>("NumThreads", UintegerValue(numThreads));
+
+    Simulator::Schedule(MilliSeconds(1),
+                        &NrParallelSlotExecutorTest::AnnounceSlotStarts,
+                        executor,
+                        owners,
+                        &log);
+    Simulator::Schedule(MilliSeconds(2), [this, executor, owners]() {
+        NS_TEST_EXPECT_MSG_EQ(executor->RunSlotStart(&owners->at(0)),
+                              false,
+                              "A slot start not announced should not run");
+    });
+    Simulator::Run();
+
+    // The last owner is in the group of the one before it, so it waits for its slot start
+    NS_TEST_EXPECT_MSG_EQ(executor->GetNumJoins(), 2U, "Wrong number of joins");
+    NS_TEST_EXPECT_MSG_EQ(executor->GetNumEarlyIndications(),
+                          owners->size() - 2,
+                          "Wrong number of indications run early");
+    NS_TEST_EXPECT_MSG_EQ(executor->GetNumTasks(), owners->size() * 5, "Wrong number of tasks");
+
+    executor->Dispose();
+    Simulator::Destroy();
+    return log;
+}
+
+void
+NrParallelSlotExecutorTest::DoRun()
+{
+    const size_t numLanes = 8;
+
+    std::vector<Owner> sequential(numLanes);
+    for (size_t i = 0; i < numLanes; ++i)
+    {
+        sequential.at(i).m_group = i;
+    }
+    sequential.at(numLanes - 1).m_group = numLanes - 2;
+    std::vector<Owner> parallel = sequential;
+
+    std::vector<std::string> expected;
+    auto addSlotStart = [&expected](size_t first, size_t last) {
+        expected.push_back("start " + std::to_string(first));
+        for (size_t i = first; i <= last; ++i)
+        {
+            expected.push_back("indication " + std::to_string(i));
+        }
+        for (size_t i = first; i <= last; ++i)
+        {
+            expected.push_back("main " + std::to_string(i));
+        }
+        for (size_t i = first; i <= last; ++i)
+        {
+            if (i != first)
+            {
+                expected.push_back("start " + std::to_string(i));
+            }
+            expected.push_back("indication commit " + std::to_string(i));
+            for (int step = 0; step < 4; ++step)
+            {
+                expected.push_back("commit " + std::to_string(i) + " " + std::to_string(step));
+            }
+            expected.push_back("continue " + std::to_string(i) + " 1");
+        }
+    };
+    addSlotStart(0, numLanes - 2);
+    addSlotStart(numLanes - 1, numLanes - 1);
+
+    std::vector<std::string> reference = RunWith(1, &sequential);
+
+    NS_TEST_ASSERT_MSG_EQ(reference.size(), expected.size(), "Wrong number of log entries");
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(reference.at(i), expected.at(i), "Wrong order");
+    }
+    for (size_t i = 0; i < numLanes; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ((sequential.at(i).m_order == std::vector<int>{0, 1, 2, 3}),
+                              true,
+                              "The tasks of a lane should run in order");
+    }
+
+    std::vector<std::string> result = RunWith(4, &parallel);
+
+    NS_TEST_ASSERT_MSG_EQ(result.size(), reference.size(), "Different number of log entries");
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(result.at(i), reference.at(i), "The result depends on the threads");
+    }
+    for (size_t i = 0; i < numLanes; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(parallel.at(i).m_state,
+                              sequential.at(i).m_state,
+                              "The state of a lane depends on the threads");
+    }
+}
+
+/**
+ * \brief Check that a multi-cell simulation fires the same traces, in the same
+ * order, without the executor and with it, with 1 and 4 threads
+ *
+ * Three gNBs, each with two BWPs, serve two UEs each, with DL and UL UDP
+ * traffic. The traces of the MACs, of the schedulers (including the FH load),
+ * and of the receptions are logged in the order in which they are fired.
+ */
+class NrParallelSlotExecutorSystemTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrParallelSlotExecutorSystemTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Run a simulation
+     * \param numThreads the number of threads of the executor, or 0 to run without it
+     * \param numEarlyIndications the number of indications run before their slot start
+     * \return the traces fired, in order
+     */
+    std::vector<std::string> RunSimulation(uint32_t numThreads,
+                                           uint64_t* numEarlyIndications) const;
+
+    /**
+     * \brief Log a scheduling trace of a MAC
+     * \param log the log
+     * \param tag the MAC that fired the trace
+     * \param info the scheduling information
+     */
+    static void Scheduling(std::vector<std::string>* log,
+                           std::string tag,
+                           NrSchedulingCallbackInfo info);
+
+    /**
+     * \brief Log a control message received by a MAC
+     * \param log the log
+     * \param tag the MAC that fired the trace
+     * \param sfn the slot
+     * \param cellId the cell
+     * \param rnti the RNTI
+     * \param bwpId the BWP
+     * \param msg the message
+     */
+    static void RxedCtrlMsg(std::vector<std::string>* log,
+                            std::string tag,
+                            const SfnSf sfn,
+                            const uint16_t cellId,
+                            const uint16_t rnti,
+                            const uint8_t bwpId,
+                            Ptr<const NrControlMessage> msg);
+
+    /**
+     * \brief Log the symbols assigned to a beam by a scheduler
+     * \param log the log
+     * \param tag the scheduler that fired the trace
+     * \param oldValue the previous value
+     * \param newValue the new value
+     */
+    static void SymPerBeam(std::vector<std::string>* log,
+                           std::string tag,
+                           uint32_t oldValue,
+                           uint32_t newValue);
+
+    /**
+     * \brief Log the FH load of a slot
+     * \param log the log
+     * \param tag the scheduler that fired the trace
+     * \param sfn the slot
+     * \param requested the requested throughput
+     * \param allocated the allocated throughput
+     */
+    static void FhLoad(std::vector<std::string>* log,
+                       std::string tag,
+                       const SfnSf& sfn,
+                       double requested,
+                       double allocated);
+
+    /**
+     * \brief Log the reception of a TB
+     * \param log the log
+     * \param tag the PHY that fired the trace
+     * \param params the reception
+     */
+    static void RxPacket(std::vector<std::string>* log,
+                         std::string tag,
+                         RxPacketTraceParams params);
+};
+
+void
+NrParallelSlotExecutorSystemTest::Scheduling(std::vector<std::string>* log,
+                                             std::string tag,
+                                             NrSchedulingCallbackInfo info)
+{
+    std::ostringstream oss;
+    oss << Simulator::Now().GetTimeStep() << " " << tag << " " << info.m_frameNum << " "
+        << +info.m_subframeNum << " " << info.m_slotNum << " " << +info.m_symStart << " "
+        << +info.m_numSym << " " << info.m_rnti << " " << +info.m_mcs << " " << info.m_tbSize
+        << " " << +info.m_ndi << " " << +info.m_rv << " " << +info.m_harqId;
+    log->push_back(oss.str());
+}
+
+void
+NrParallelSlotExecutorSystemTest::RxedCtrlMsg(std::vector<std::string>* log,
+                                              std::string tag,
+                                              const SfnSf sfn,
+                                              const uint16_t cellId,
+                                              const uint16_t rnti,
+                                              const uint8_t bwpId,
+                                              Ptr<const NrControlMessage> msg)
+{
+    std::ostringstream oss;
+    oss << Simulator::Now().GetTimeStep() << " " << tag << " " << sfn << " " << cellId << " "
+        << rnti << " " << +bwpId << " " << msg->GetMessageType();
+    log->push_back(oss.str());
+}
+
+void
+NrParallelSlotExecutorSystemTest::SymPerBeam(std::vector<std::string>* log,
+                                             std::string tag,
+                                             uint32_t oldValue,
+                                             uint32_t newValue)
+{
+    std::ostringstream oss;
+    oss << Simulator::Now().GetTimeStep() << " " << tag << " " << oldValue << " " << newValue;
+    log->push_back(oss.str());
+}
+
+void
+NrParallelSlotExecutorSystemTest::FhLoad(std::vector<std::string>* log,
+                                         std::string tag,
+                                         const SfnSf& sfn,
+                                         double requested,
+                                         double allocated)
+{
+    std::ostringstream oss;
+    oss << Simulator::Now().GetTimeStep() << " " << tag << " " << sfn << " " << requested << " "
+        << allocated;
+    log->push_back(oss.str());
+}
+
+void
+NrParallelSlotExecutorSystemTest::RxPacket(std::vector<std::string>* log,
+                                           std::string tag,
+                                           RxPacketTraceParams params)
+{
+    std::ostringstream oss;
+    oss << Simulator::Now().GetTimeStep() << " " << tag << " " << params.m_cellId << " "
+        << params.m_rnti << " " << params.m_tbSize << " " << +params.m_mcs << " "
+        << params.m_sinr << " " << params.m_tbler << " " << params.m_corrupt;
+    log->push_back(oss.str());
+}
+
+std::vector<std::string>
+NrParallelSlotExecutorSystemTest::RunSimulation(uint32_t numThreads,
+                                                uint64_t* numEarlyIndications) const
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    const uint32_t gnbNum = 3;
+    const uint32_t uePerGnbNum = 2;
+
+    NodeContainer gnbNodes;
+    NodeContainer ueNodes;
+    gnbNodes.Create(gnbNum);
+    ueNodes.Create(gnbNum * uePerGnbNum);
+
+    Ptr<ListPositionAllocator> gnbPositionAlloc = CreateObject<ListPositionAllocator>();
+    Ptr<ListPositionAllocator> uePositionAlloc = CreateObject<ListPositionAllocator>();
+    for (uint32_t i = 0; i < gnbNum; ++i)
+    {
+        gnbPositionAlloc->Add(Vector(60.0 * i, 0.0, 10.0));
+        for (uint32_t j = 0; j < uePerGnbNum; ++j)
+        {
+            uePositionAlloc->Add(Vector(60.0 * i + 5.0, 10.0 + 10.0 * j, 1.5));
+        }
+    }
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(gnbPositionAlloc);
+    mobility.Install(gnbNodes);
+    mobility.SetPositionAllocator(uePositionAlloc);
+    mobility.Install(ueNodes);
+
+    Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper>();
+    Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper>();
+    idealBeamformingHelper->SetAttribute("BeamformingMethod",
+                                         TypeIdValue(DirectPathBeamforming::GetTypeId()));
+
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(idealBeamformingHelper);
+    nrHelper->SetEpcHelper(epcHelper);
+    nrHelper->SetSchedulerTypeId(NrMacSchedulerOfdmaRR::GetTypeId());
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(4));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(4));
+    nrHelper->SetPathlossAttribute("ShadowingEnabled", BooleanValue(false));
+    nrHelper->EnableFhControl();
+    if (numThreads > 0)
+    {
+        nrHelper->EnableParallelSlotProcessing(numThreads);
+    }
+
+    CcBwpCreator::SimpleOperationBandConf bandConf(28e9,
+                                                   40e6,
+                                                   1,
+                                                   BandwidthPartInfo::UMi_StreetCanyon);
+    bandConf.m_numBwp = 2;
+    CcBwpCreator ccBwpCreator;
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice(gnbNodes, allBwps);
+    NetDeviceContainer ueDevs = nrHelper->InstallUeDevice(ueNodes, allBwps);
+    int64_t randomStream = 1;
+    randomStream += nrHelper->AssignStreams(gnbDevs, randomStream);
+    randomStream += nrHelper->AssignStreams(ueDevs, randomStream);
+    for (auto it = gnbDevs.Begin(); it != gnbDevs.End(); ++it)
+    {
+        DynamicCast<NrGnbNetDevice>(*it)->UpdateConfig();
+    }
+    for (auto it = ueDevs.Begin(); it != ueDevs.End(); ++it)
+    {
+        DynamicCast<NrUeNetDevice>(*it)->UpdateConfig();
+    }
+
+    Ptr<Node> pgw = epcHelper->GetPgwNode();
+    NodeContainer remoteHostContainer;
+    remoteHostContainer.Create(1);
+    Ptr<Node> remoteHost = remoteHostContainer.Get(0);
+    InternetStackHelper internet;
+    internet.Install(remoteHostContainer);
+    PointToPointHelper p2ph;
+    p2ph.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Gb/s")));
+    p2ph.SetDeviceAttribute("Mtu", UintegerValue(2500));
+    p2ph.SetChannelAttribute("Delay", TimeValue(Seconds(0.0)));
+    NetDeviceContainer internetDevices = p2ph.Install(pgw, remoteHost);
+    Ipv4AddressHelper ipv4h;
+    ipv4h.SetBase("1.0.0.0", "255.0.0.0");
+    Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign(internetDevices);
+    Ipv4Address remoteHostAddr = internetIpIfaces.GetAddress(1);
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    Ptr<Ipv4StaticRouting> remoteHostStaticRouting =
+        ipv4RoutingHelper.GetStaticRouting(remoteHost->GetObject<Ipv4>());
+    remoteHostStaticRouting->AddNetworkRouteTo(Ipv4Address("7.0.0.0"), Ipv4Mask("255.0.0.0"), 1);
+    internet.Install(ueNodes);
+    Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address(ueDevs);
+    for (uint32_t j = 0; j < ueNodes.GetN(); ++j)
+    {
+        Ptr<Ipv4StaticRouting> ueStaticRouting =
+            ipv4RoutingHelper.GetStaticRouting(ueNodes.Get(j)->GetObject<Ipv4>());
+        ueStaticRouting->SetDefaultRoute(epcHelper->GetUeDefaultGatewayAddress(), 1);
+    }
+    nrHelper->AttachToClosestEnb(ueDevs, gnbDevs);
+
+    const uint16_t dlPort = 1234;
+    const uint16_t ulPort = 2000;
+    ApplicationContainer serverApps;
+    ApplicationContainer clientApps;
+    serverApps.Add(UdpServerHelper(ulPort).Install(remoteHost));
+    serverApps.Add(UdpServerHelper(dlPort).Install(ueNodes));
+    for (uint32_t j = 0; j < ueNodes.GetN(); ++j)
+    {
+        UdpClientHelper dlClient(ueIpIface.GetAddress(j), dlPort);
+        dlClient.SetAttribute("MaxPackets", UintegerValue(1000));
+        dlClient.SetAttribute("PacketSize", UintegerValue(500));
+        dlClient.SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+        clientApps.Add(dlClient.Install(remoteHost));
+
+        UdpClientHelper ulClient(remoteHostAddr, ulPort);
+        ulClient.SetAttribute("MaxPackets", UintegerValue(1000));
+        ulClient.SetAttribute("PacketSize", UintegerValue(200));
+        ulClient.SetAttribute("Interval", TimeValue(MilliSeconds(1)));
+        clientApps.Add(ulClient.Install(ueNodes.Get(j)));
+    }
+    serverApps.Start(MilliSeconds(100));
+    clientApps.Start(MilliSeconds(100));
+
+    std::vector<std::string> log;
+    for (uint32_t i = 0; i < gnbDevs.GetN(); ++i)
+    {
+        for (uint32_t bwp = 0; bwp < bandConf.m_numBwp; ++bwp)
+        {
+            const std::string tag = std::to_string(i) + "/" + std::to_string(bwp);
+            Ptr<NrGnbMac> mac = NrHelper::GetGnbMac(gnbDevs.Get(i), bwp);
+            mac->TraceConnectWithoutContext(
+                "DlScheduling",
+                MakeBoundCallback(&NrParallelSlotExecutorSystemTest::Scheduling,
+                                  &log,
+                                  "DL " + tag));
+            mac->TraceConnectWithoutContext(
+                "UlScheduling",
+                MakeBoundCallback(&NrParallelSlotExecutorSystemTest::Scheduling,
+                                  &log,
+                                  "UL " + tag));
+            mac->TraceConnectWithoutContext(
+                "GnbMacRxedCtrlMsgsTrace",
+                MakeBoundCallback(&NrParallelSlotExecutorSystemTest::RxedCtrlMsg, &log, tag));
+
+            Ptr<NrMacScheduler> sched = NrHelper::GetScheduler(gnbDevs.Get(i), bwp);
+            sched->TraceConnectWithoutContext(
+                "SymPerBeam",
+                MakeBoundCallback(&NrParallelSlotExecutorSystemTest::SymPerBeam, &log, tag));
+            DynamicCast<NrMacSchedulerNs3>(sched)->GetFhControl()->TraceConnectWithoutContext(
+                "FhLoad",
+                MakeBoundCallback(&NrParallelSlotExecutorSystemTest::FhLoad, &log, tag));
+
+            NrHelper::GetGnbPhy(gnbDevs.Get(i), bwp)
+                ->GetSpectrumPhy(0)
+                ->TraceConnectWithoutContext(
+                    "RxPacketTraceEnb",
+                    MakeBoundCallback(&NrParallelSlotExecutorSystemTest::RxPacket, &log, tag));
+        }
+    }
+    for (uint32_t j = 0; j < ueDevs.GetN(); ++j)
+    {
+        for (uint32_t bwp = 0; bwp < bandConf.m_numBwp; ++bwp)
+        {
+            const std::string tag = "UE " + std::to_string(j) + "/" + std::to_string(bwp);
+            NrHelper::GetUePhy(ueDevs.Get(j), bwp)
+                ->GetSpectrumPhy(0)
+                ->TraceConnectWithoutContext(
+                    "RxPacketTraceUe",
+                    MakeBoundCallback(&NrParallelSlotExecutorSystemTest::RxPacket, &log, tag));
+        }
+    }
+
+    Simulator::Stop(MilliSeconds(200));
+    Simulator::Run();
+
+    Ptr<NrParallelSlotExecutor> executor =
+        NrHelper::GetScheduler(gnbDevs.Get(0), 0)->GetSlotExecutor();
+    *numEarlyIndications = executor != nullptr ? executor->GetNumEarlyIndications() : 0;
+
+    Simulator::Destroy();
+    return log;
+}
+
+void
+NrParallelSlotExecutorSystemTest::DoRun()
+{
+    uint64_t numEarlyIndications = 0;
+    const std::vector<std::string> reference = RunSimulation(0, &numEarlyIndications);
+    NS_TEST_ASSERT_MSG_GT(reference.size(), 0U, "No trace was fired");
+
+    for (uint32_t numThreads : {1, 4})
+    {
+        const std::vector<std::string> result = RunSimulation(numThreads, &numEarlyIndications);
+        NS_TEST_ASSERT_MSG_GT(numEarlyIndications,
+                              0U,
+                              "No indication ran concurrently with the ones of another cell");
+        NS_TEST_ASSERT_MSG_EQ(result.size(),
+                              reference.size(),
+                              "Different number of traces with " << numThreads << " threads");
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(result.at(i),
+                                  reference.at(i),
+                                  "Different trace with " << numThreads << " threads");
+        }
+    }
+}
+
+/**
+ * \brief Test suite for the NrParallelSlotExecutor
+ */
+class NrParallelSlotExecutorTestSuite : public TestSuite
+{
+  public:
+    NrParallelSlotExecutorTestSuite()
+        : TestSuite("nr-parallel-slot-executor-test", UNIT)
+    {
+        AddTestCase(new NrParallelSlotExecutorTest("Determinism with 1 and 4 threads"), QUICK);
+        AddTestCase(new NrParallelSlotExecutorSystemTest("Same traces as without the executor"),
+                    EXTENSIVE);
+    }
+};
+
+static NrParallelSlotExecutorTestSuite nrParallelSlotExecutorTestSuite; //!< Executor test suite
+
+} // namespace ns3
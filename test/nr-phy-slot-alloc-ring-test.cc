@@ -0,0 +1,213 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-gnb-phy.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-phy-slot-alloc-ring-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the ring of the slot allocations of NrPhy
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check the insertion, the merge, the retrieval, the renumbering and the
+ * growth of the ring of the slot allocations of NrPhy
+ *
+ * The ring starts with 8 positions. An allocation for a stored slot is merged
+ * with it, and a slot whose position is taken by another pending slot enlarges
+ * the ring. The allocations are retrieved in chronological order, or by slot,
+ * and PushFrontSlotAllocInfo moves all the stored allocations after the new one.
+ */
+class NrPhySlotAllocRingTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrPhySlotAllocRingTestCase(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Get the slot that follows the first one by a number of slots
+     * \param slotN the number of slots
+     * \return the slot
+     */
+    static SfnSf GetSlot(uint32_t slotN);
+
+    /**
+     * \brief Create an allocation
+     * \param slotN the slot, as in GetSlot
+     * \param type the type of the allocation
+     * \param numSym the number of allocated symbols
+     * \return the allocation
+     */
+    static SlotAllocInfo CreateAllocation(uint32_t slotN,
+                                          SlotAllocInfo::AllocationType type,
+                                          uint32_t numSym);
+
+    /**
+     * \brief Check that a slot is stored, with its number of allocated symbols
+     * \param phy the PHY
+     * \param slotN the slot, as in GetSlot
+     * \param numSym the expected number of allocated symbols
+     */
+    void CheckStored(const Ptr<NrPhy>& phy, uint32_t slotN, uint32_t numSym);
+};
+
+SfnSf
+NrPhySlotAllocRingTestCase::GetSlot(uint32_t slotN)
+{
+    SfnSf sfn(0, 0, 0, 0);
+    sfn.Add(slotN);
+    return sfn;
+}
+
+SlotAllocInfo
+NrPhySlotAllocRingTestCase::CreateAllocation(uint32_t slotN,
+                                             SlotAllocInfo::AllocationType type,
+                                             uint32_t numSym)
+{
+    SlotAllocInfo alloc(GetSlot(slotN));
+    alloc.m_type = type;
+    alloc.m_numSymAlloc = numSym;
+    return alloc;
+}
+
+void
+NrPhySlotAllocRingTestCase::CheckStored(const Ptr<NrPhy>& phy, uint32_t slotN, uint32_t numSym)
+{
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoExists(GetSlot(slotN)),
+                          true,
+                          "The slot " << slotN << " should be stored");
+    NS_TEST_ASSERT_MSG_EQ(phy->PeekSlotAllocInfo(GetSlot(slotN)).m_numSymAlloc,
+                          numSym,
+                          "Wrong allocated symbols for the slot " << slotN);
+}
+
+void
+NrPhySlotAllocRingTestCase::DoRun()
+{
+    Ptr<NrPhy> phy = CreateObject<NrGnbPhy>();
+
+    NS_TEST_ASSERT_MSG_EQ(phy->m_slotAllocInfo.GetCapacity(), 8U, "The first ring has 8 positions");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 0U, "No slot should be stored");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoExists(GetSlot(0)),
+                          false,
+                          "No slot should be stored in an empty ring");
+
+    // Insertion
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        phy->PushBackSlotAllocInfo(CreateAllocation(i, SlotAllocInfo::DL, i + 1));
+    }
+    NS_TEST_ASSERT_MSG_EQ(phy->m_slotAllocInfo.GetCapacity(),
+                          8U,
+                          "The ring should not be enlarged");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 8U, "Wrong number of stored slots");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoExists(GetSlot(8)),
+                          false,
+                          "A slot in the position of another one should not be found");
+    NS_TEST_ASSERT_MSG_EQ((phy->m_slotAllocInfo.Find(GetSlot(3)) != nullptr),
+                          true,
+                          "The position of a stored slot should hold its allocation");
+
+    // Merge into an existing slot
+    phy->PushBackSlotAllocInfo(CreateAllocation(3, SlotAllocInfo::UL, 10));
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 8U, "A merge should not store a new slot");
+    CheckStored(phy, 3, 14);
+    NS_TEST_ASSERT_MSG_EQ(phy->PeekSlotAllocInfo(GetSlot(3)).m_type,
+                          SlotAllocInfo::BOTH,
+                          "A DL and an UL allocation should be merged in a BOTH allocation");
+
+    // The position of the slot 8 is taken by the slot 0, still pending
+    phy->PushBackSlotAllocInfo(CreateAllocation(8, SlotAllocInfo::UL, 9));
+    NS_TEST_ASSERT_MSG_EQ(phy->m_slotAllocInfo.GetCapacity(), 16U, "The ring should be doubled");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 9U, "Wrong number of stored slots");
+    for (uint32_t i = 0; i <= 8; ++i)
+    {
+        CheckStored(phy, i, i == 3 ? 14 : i + 1);
+    }
+
+    // A longer horizon keeps the allocations as well
+    phy->SetSlotAllocHorizon(19);
+    NS_TEST_ASSERT_MSG_EQ(phy->m_slotAllocInfo.GetCapacity(),
+                          32U,
+                          "The size should be rounded up to a power of two");
+    for (uint32_t i = 0; i <= 8; ++i)
+    {
+        CheckStored(phy, i, i == 3 ? 14 : i + 1);
+    }
+
+    // Retrieval of the first slot, and of a given slot
+    SlotAllocInfo first = phy->RetrieveSlotAllocInfo();
+    NS_TEST_ASSERT_MSG_EQ(first.m_sfnSf, GetSlot(0), "The first slot should be retrieved");
+    NS_TEST_ASSERT_MSG_EQ(first.m_numSymAlloc, 1U, "Wrong allocation retrieved");
+    SlotAllocInfo fifth = phy->RetrieveSlotAllocInfo(GetSlot(5));
+    NS_TEST_ASSERT_MSG_EQ(fifth.m_sfnSf, GetSlot(5), "The slot 5 should be retrieved");
+    NS_TEST_ASSERT_MSG_EQ(fifth.m_numSymAlloc, 6U, "Wrong allocation retrieved");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoExists(GetSlot(0)),
+                          false,
+                          "A retrieved slot should not be found");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoExists(GetSlot(5)),
+                          false,
+                          "A retrieved slot should not be found");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 7U, "Wrong number of stored slots");
+
+    // The new allocation goes in the slot 1, and the stored slots 1, 2, 3, 4,
+    // 6, 7 and 8 are moved, in this order, to the slots from 2 to 8
+    phy->PushFrontSlotAllocInfo(GetSlot(1), CreateAllocation(100, SlotAllocInfo::DL, 50));
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 8U, "Wrong number of stored slots");
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoExists(GetSlot(100)),
+                          false,
+                          "The new allocation should be moved to its new slot");
+    const std::vector<uint32_t> expectedSym = {50, 2, 3, 14, 5, 7, 8, 9};
+    for (uint32_t i = 0; i < expectedSym.size(); ++i)
+    {
+        CheckStored(phy, i + 1, expectedSym.at(i));
+        NS_TEST_ASSERT_MSG_EQ(phy->PeekSlotAllocInfo(GetSlot(i + 1)).m_sfnSf,
+                              GetSlot(i + 1),
+                              "The allocation should be renumbered");
+    }
+
+    // The allocations are retrieved in chronological order
+    for (uint32_t i = 0; i < expectedSym.size(); ++i)
+    {
+        SlotAllocInfo alloc = phy->RetrieveSlotAllocInfo();
+        NS_TEST_ASSERT_MSG_EQ(alloc.m_sfnSf, GetSlot(i + 1), "Wrong order of retrieval");
+        NS_TEST_ASSERT_MSG_EQ(alloc.m_numSymAlloc, expectedSym.at(i), "Wrong allocation");
+    }
+    NS_TEST_ASSERT_MSG_EQ(phy->SlotAllocInfoSize(), 0U, "All the slots should be retrieved");
+
+    phy->Dispose();
+}
+
+/**
+ * \brief Test suite for the ring of the slot allocations of NrPhy
+ */
+class NrPhySlotAllocRingTestSuite : public TestSuite
+{
+  public:
+    NrPhySlotAllocRingTestSuite()
+        : TestSuite("nr-phy-slot-alloc-ring-test", UNIT)
+    {
+        AddTestCase(new NrPhySlotAllocRingTestCase(
+                        "Insertion, merge, retrieval, renumbering and growth"),
+                    QUICK);
+    }
+};
+
+static NrPhySlotAllocRingTestSuite nrPhySlotAllocRingTestSuite; //!< PHY slot allocation ring suite
+
+} // namespace ns3
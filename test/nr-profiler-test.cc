@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/boolean.h>
+#include <ns3/nr-profiler.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+
+#include <fstream>
+#include <sstream>
+
+/**
+ * \file nr-profiler-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the NrProfiler
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check that the profiler counts only when enabled, and that it writes
+ * one report for each interval plus the totals
+ */
+class NrProfilerTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrProfilerTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+NrProfilerTest::DoRun()
+{
+    const std::string filename = CreateTempDirFilename("NrProfiler.txt");
+
+    {
+        NrProfiler::ScopedTimer timer(NrProfiler::SCHEDULER_DL);
+    }
+    NS_TEST_ASSERT_MSG_EQ(NrProfiler::IsEnabled(), false, "The profiler should be disabled");
+    NS_TEST_ASSERT_MSG_EQ(NrProfiler::GetTotalCount(NrProfiler::SCHEDULER_DL),
+                          0,
+                          "A disabled profiler should not count");
+
+    Ptr<NrProfiler> profiler = NrProfiler::Get();
+    profiler->SetAttribute("OutputFilename", StringValue(filename));
+    profiler->SetAttribute("Enabled", BooleanValue(true));
+
+    const uint32_t calls = 25;
+    for (uint32_t i = 0; i < calls; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(50 + 100 * i), []() {
+            NrProfiler::ScopedTimer outer(NrProfiler::GNB_MAC_SLOT_DL);
+            NrProfiler::ScopedTimer inner(NrProfiler::SCHEDULER_DL);
+        });
+    }
+
+    // The last call is at 2.45 s: the report at 3 s is the last one, as after
+    // it the simulation has nothing else to do
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(NrProfiler::GetTotalCount(NrProfiler::SCHEDULER_DL),
+                          calls,
+                          "Wrong number of scheduler calls");
+    NS_TEST_ASSERT_MSG_EQ(NrProfiler::GetTotalCount(NrProfiler::GNB_MAC_SLOT_DL),
+                          calls,
+                          "Nested timers should both count");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(NrProfiler::GetTotalNs(NrProfiler::GNB_MAC_SLOT_DL),
+                                NrProfiler::GetTotalNs(NrProfiler::SCHEDULER_DL),
+                                "The outer timer should include the inner one");
+    NS_TEST_ASSERT_MSG_EQ(NrProfiler::GetTotalCount(NrProfiler::BEAMFORMING),
+                          0,
+                          "Beamforming was never called");
+
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(NrProfiler::IsEnabled(), false, "Destroy should stop the profiler");
+
+    std::ifstream file(filename);
+    NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "Can't open " << filename);
+
+    std::string line;
+    uint32_t lines = 0;
+    uint32_t reports = 0;
+    uint32_t schedulerCalls = 0;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.at(0) == '%')
+        {
+            continue;
+        }
+        ++lines;
+        std::istringstream iss(line);
+        double time;
+        std::string section;
+        uint64_t count;
+        iss >> time >> section >> count;
+        if (section == "SIMULATOR" && time >= 0.0)
+        {
+            ++reports;
+        }
+        if (section == "SCHEDULER_DL" && time >= 0.0)
+        {
+            schedulerCalls += count;
+        }
+    }
+
+    // Three reports plus the totals, each one with the SIMULATOR line and the sections
+    NS_TEST_ASSERT_MSG_EQ(reports, 3, "Wrong number of reports");
+    NS_TEST_ASSERT_MSG_EQ(lines,
+                          4U * (NrProfiler::NUM_SECTIONS + 1),
+                          "Wrong number of lines");
+    NS_TEST_ASSERT_MSG_EQ(schedulerCalls, calls, "Wrong number of reported scheduler calls");
+}
+
+/**
+ * \brief Test suite for the NrProfiler
+ */
+class NrProfilerTestSuite : public TestSuite
+{
+  public:
+    NrProfilerTestSuite()
+        : TestSuite("nr-profiler-test", UNIT)
+    {
+        AddTestCase(new NrProfilerTest("Profiler counters and report test"), QUICK);
+    }
+};
+
+static NrProfilerTestSuite nrProfilerTestSuite;
+
+} // namespace ns3
@@ -45,9 +45,13 @@ class TestNotchingPhySapProvider : public NrPhySapProvider
                     const SfnSf& sfn,
                     uint8_t symStart,
                     uint8_t streamId) override;
+    void SendMacPduBurst(const Ptr<PacketBurst>& pb,
+                         const SfnSf& sfn,
+                         uint8_t symStart,
+                         uint8_t streamId) override;
     void SendControlMessage(Ptr<NrControlMessage> msg) override;
     void SendRachPreamble(uint8_t PreambleId, uint8_t Rnti) override;
-    void SetSlotAllocInfo(const SlotAllocInfo& slotAllocInfo) override;
+    void SetSlotAllocInfo(SlotAllocInfo slotAllocInfo) override;
     void NotifyConnectionSuccessful() override;
     uint32_t GetRbNum() const override;
     BeamConfId GetBeamConfId(uint8_t rnti) const override;
@@ -112,6 +116,14 @@ TestNotchingPhySapProvider::SendMacPdu(const Ptr<Packet>& p,
 {
 }
 
+void
+TestNotchingPhySapProvider::SendMacPduBurst(const Ptr<PacketBurst>& pb,
+                                            const SfnSf& sfn,
+                                            uint8_t symStart,
+                                            uint8_t streamId)
+{
+}
+
 void
 TestNotchingPhySapProvider::SendControlMessage(Ptr<NrControlMessage> msg)
 {
@@ -123,7 +135,7 @@ TestNotchingPhySapProvider::SendRachPreamble(uint8_t PreambleId, uint8_t Rnti)
 }
 
 void
-TestNotchingPhySapProvider::SetSlotAllocInfo(const SlotAllocInfo& slotAllocInfo)
+TestNotchingPhySapProvider::SetSlotAllocInfo(SlotAllocInfo slotAllocInfo)
 {
 }
 
@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-ue-phy.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <vector>
+
+/**
+ * \file nr-ue-rsrp-measurement-test.cc
+ * \ingroup test
+ * \brief Unit-testing for the RSRP measurements of the NrUePhy
+ *
+ */
+namespace ns3
+{
+
+/**
+ * \brief Feed PSS to a NrUePhy, and check the reported RSRP against values
+ * computed by hand: the samples of a period are averaged in linear unit, and
+ * the averages of the periods go through the layer-3 filter with the
+ * configured coefficient
+ */
+class NrUeRsrpMeasurementTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     */
+    NrUeRsrpMeasurementTest(const std::string& name)
+        : TestCase(name)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief A RSRP report
+     */
+    struct Report
+    {
+        uint16_t m_cellId; //!< Cell measured
+        double m_rsrpDbm;  //!< Reported RSRP (dBm)
+    };
+
+    /**
+     * \brief Trace sink of ReportRsrp
+     * \param cellId the cell measured
+     * \param imsi the IMSI of the UE
+     * \param rnti the RNTI of the UE
+     * \param rsrp the reported RSRP (dBm)
+     * \param bwpId the BWP of the PHY
+     */
+    void ReportRsrp(uint16_t cellId, uint16_t imsi, uint16_t rnti, double rsrp, uint8_t bwpId);
+
+    std::vector<Report> m_reports; //!< Reports received
+};
+
+void
+NrUeRsrpMeasurementTest::ReportRsrp(uint16_t cellId,
+                                    [[maybe_unused]] uint16_t imsi,
+                                    [[maybe_unused]] uint16_t rnti,
+                                    double rsrp,
+                                    [[maybe_unused]] uint8_t bwpId)
+{
+    m_reports.push_back({cellId, rsrp});
+}
+
+void
+NrUeRsrpMeasurementTest::DoRun()
+{
+    Ptr<NrUePhy> phy = CreateObject<NrUePhy>();
+    phy->SetNumerology(0);
+    // TS 36.331: a = 1/2^(k/4), so k = 8 gives a = 0.25
+    phy->GetUeCphySapProvider()->SetRsrpFilterCoefficient(8);
+    phy->TraceConnectWithoutContext("ReportRsrp",
+                                    MakeCallback(&NrUeRsrpMeasurementTest::ReportRsrp, this));
+
+    // A PSS with the same power in each RE (the subcarrier spacing is 15 kHz)
+    Ptr<SpectrumModel> model =
+        Create<SpectrumModel>(std::vector<double>{28.0e9, 28.1e9, 28.2e9, 28.3e9});
+    auto schedulePss = [phy, model](Time t, uint16_t cellId, double powerPerReW) {
+        Ptr<SpectrumValue> pss = Create<SpectrumValue>(model);
+        (*pss) = powerPerReW / 15000.0;
+        Simulator::Schedule(t, &NrUePhy::ReceivePss, phy, cellId, pss);
+    };
+
+    // The reports are at 0, 200 and 400 ms
+    schedulePss(MilliSeconds(50), 5, 1e-12);
+    schedulePss(MilliSeconds(100), 5, 3e-12);
+    schedulePss(MilliSeconds(250), 5, 4e-12);
+    // -170 dBm, below the detection threshold: never reported
+    schedulePss(MilliSeconds(60), 2, 1e-20);
+    // The highest cell ID is measured as well
+    schedulePss(MilliSeconds(300), 65535, 1e-12);
+
+    Simulator::Stop(MilliSeconds(450));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_reports.size(), 3, "Wrong number of reports");
+    NS_TEST_ASSERT_MSG_EQ(m_reports.at(0).m_cellId, 5, "Wrong cell reported");
+    NS_TEST_ASSERT_MSG_EQ(m_reports.at(1).m_cellId, 5, "Wrong cell reported");
+    NS_TEST_ASSERT_MSG_EQ(m_reports.at(2).m_cellId, 65535, "Wrong cell reported");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_reports.at(2).m_rsrpDbm, -90.0, 1e-9, "Wrong RSRP");
+
+    // First period: linear average of 1 pW and 3 pW, i.e., 2 pW (-86.99 dBm),
+    // and not the average of -90 and -85.23 dBm. The filter starts from it.
+    const double first = 10 * std::log10(1000 * 2e-12);
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_reports.at(0).m_rsrpDbm, first, 1e-9, "Wrong L1 average");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_reports.at(0).m_rsrpDbm, -86.9897, 1e-4, "Wrong L1 average");
+
+    // Second period: 4 pW (-83.98 dBm), filtered as 0.75 * F_1 + 0.25 * M_2
+    const double second = 0.75 * first + 0.25 * 10 * std::log10(1000 * 4e-12);
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_reports.at(1).m_rsrpDbm, second, 1e-9, "Wrong L3 filtering");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_reports.at(1).m_rsrpDbm, -86.2371, 1e-4, "Wrong L3 filtering");
+}
+
+/**
+ * \brief Test suite for the RSRP measurements of the NrUePhy
+ */
+class NrUeRsrpMeasurementTestSuite : public TestSuite
+{
+  public:
+    NrUeRsrpMeasurementTestSuite()
+        : TestSuite("nr-ue-rsrp-measurement-test", UNIT)
+    {
+        AddTestCase(new NrUeRsrpMeasurementTest("Linear average and L3 filter of the RSRP"),
+                    QUICK);
+    }
+};
+
+static NrUeRsrpMeasurementTestSuite nrUeRsrpMeasurementTestSuite; //!< RSRP measurement test suite
+
+} // namespace ns3
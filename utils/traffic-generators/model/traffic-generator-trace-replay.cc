@@ -0,0 +1,248 @@
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "traffic-generator-trace-replay.h"
+
+#include "ns3/abort.h"
+#include "ns3/address.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TrafficGeneratorTraceReplay");
+NS_OBJECT_ENSURE_REGISTERED(TrafficGeneratorTraceReplay);
+
+TypeId
+TrafficGeneratorTraceReplay::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TrafficGeneratorTraceReplay")
+            .SetParent<TrafficGenerator>()
+            .SetGroupName("Applications")
+            .AddConstructor<TrafficGeneratorTraceReplay>()
+            .AddAttribute("TraceFile",
+                          "The name of the binary traffic trace to replay",
+                          StringValue(""),
+                          MakeStringAccessor(&TrafficGeneratorTraceReplay::m_traceFilename),
+                          MakeStringChecker())
+            .AddAttribute("FlowId",
+                          "The flow of the trace to replay. The default value "
+                          "(TrafficTraceFile::ALL_FLOWS) replays all the records",
+                          UintegerValue(TrafficTraceFile::ALL_FLOWS),
+                          MakeUintegerAccessor(&TrafficGeneratorTraceReplay::m_flowId),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("StartOffset",
+                          "The random variable used to draw, when the application "
+                          "starts, the position in the trace (in seconds) from which "
+                          "the replay starts",
+                          StringValue("ns3::ConstantRandomVariable[Constant=0]"),
+                          MakePointerAccessor(&TrafficGeneratorTraceReplay::m_startOffset),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("Loop",
+                          "If true, the replay restarts from the beginning of the "
+                          "trace when its end is reached",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&TrafficGeneratorTraceReplay::m_loop),
+                          MakeBooleanChecker())
+            .AddAttribute("Remote",
+                          "The address of the destination",
+                          AddressValue(),
+                          MakeAddressAccessor(&TrafficGenerator::SetRemote),
+                          MakeAddressChecker())
+            .AddAttribute("Protocol",
+                          "The type of protocol to use.",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&TrafficGenerator::SetProtocol),
+                          MakeTypeIdChecker())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&TrafficGenerator::m_txTrace),
+                            "ns3::TrafficGenerator::TxTracedCallback");
+    return tid;
+}
+
+TrafficGeneratorTraceReplay::TrafficGeneratorTraceReplay()
+    : TrafficGenerator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TrafficGeneratorTraceReplay::~TrafficGeneratorTraceReplay()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time
+TrafficGeneratorTraceReplay::GetFirstPacketTime() const
+{
+    return m_firstPacketTime;
+}
+
+void
+TrafficGeneratorTraceReplay::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_traceFilename.empty(), "The trace file has not been set");
+
+    m_trace = TrafficTraceFile::Open(m_traceFilename);
+    m_flowRecords = nullptr;
+    if (m_flowId != TrafficTraceFile::ALL_FLOWS)
+    {
+        m_flowRecords = &m_trace->GetFlowRecords(m_flowId);
+        NS_ABORT_MSG_IF(m_flowRecords->empty(),
+                        "Flow " << m_flowId << " has no records in trace " << m_traceFilename);
+    }
+
+    const uint64_t duration = m_trace->GetDurationNs();
+    const uint32_t numRecords = GetNumFlowRecords();
+    NS_ABORT_MSG_IF(m_loop && duration == 0,
+                    "Trace " << m_traceFilename << " can not be looped, its duration is 0");
+
+    const double offsetS = m_startOffset->GetValue();
+    NS_ABORT_MSG_IF(offsetS < 0, "The start offset can not be negative");
+    uint64_t offset = static_cast<uint64_t>(Seconds(offsetS).GetNanoSeconds());
+    if (m_loop)
+    {
+        offset %= duration;
+    }
+
+    // First record not earlier than the offset
+    uint32_t low = 0;
+    uint32_t high = numRecords;
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        if (GetFlowRecord(mid).m_timeNs < offset)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    uint64_t delay = 0;
+    if (low < numRecords)
+    {
+        delay = GetFlowRecord(low).m_timeNs - offset;
+    }
+    else if (m_loop)
+    {
+        delay = duration - offset + GetFlowRecord(0).m_timeNs;
+        low = 0;
+    }
+    else
+    {
+        NS_LOG_INFO("The start offset is beyond the end of the trace, nothing to replay");
+        return;
+    }
+
+    m_burstEnd = low;
+    m_firstPacketTime = NanoSeconds(delay);
+    NS_LOG_DEBUG("Replay starts from record " << low << " in " << m_firstPacketTime);
+    Simulator::Schedule(m_firstPacketTime, &TrafficGenerator::SendPacketBurst, this);
+}
+
+void
+TrafficGeneratorTraceReplay::PacketBurstSent()
+{
+    NS_LOG_FUNCTION(this);
+    const uint64_t current = GetFlowRecord(m_burstStart).m_timeNs;
+    uint64_t gap = 0;
+    if (m_burstEnd < GetNumFlowRecords())
+    {
+        gap = GetFlowRecord(m_burstEnd).m_timeNs - current;
+    }
+    else if (m_loop)
+    {
+        // GenerateNextPacketBurstSize restarts from the first record
+        gap = m_trace->GetDurationNs() - current + GetFlowRecord(0).m_timeNs;
+    }
+    else
+    {
+        NS_LOG_INFO("End of the trace reached");
+        return;
+    }
+    NS_LOG_DEBUG("Next packet burst in " << NanoSeconds(gap));
+    Simulator::Schedule(NanoSeconds(gap), &TrafficGenerator::SendPacketBurst, this);
+}
+
+void
+TrafficGeneratorTraceReplay::GenerateNextPacketBurstSize()
+{
+    NS_LOG_FUNCTION(this);
+    const uint32_t numRecords = GetNumFlowRecords();
+    if (m_burstEnd == numRecords)
+    {
+        m_burstEnd = 0;
+    }
+    m_burstStart = m_burstEnd;
+
+    const uint64_t time = GetFlowRecord(m_burstStart).m_timeNs;
+    uint64_t burstSize = 0;
+    while (m_burstEnd < numRecords && GetFlowRecord(m_burstEnd).m_timeNs == time)
+    {
+        burstSize += GetFlowRecord(m_burstEnd).m_size;
+        ++m_burstEnd;
+    }
+    NS_ABORT_MSG_IF(burstSize > UINT32_MAX,
+                    "The packets at time " << time << " ns of trace " << m_traceFilename
+                                           << " are too many to be sent in one burst");
+
+    NS_LOG_DEBUG("New packet burst of " << m_burstEnd - m_burstStart << " packets and "
+                                        << burstSize << " bytes");
+    SetPacketBurstSizeInBytes(static_cast<uint32_t>(burstSize));
+}
+
+uint32_t
+TrafficGeneratorTraceReplay::GetNextPacketSize() const
+{
+    NS_LOG_FUNCTION(this);
+    // The size is not consumed here: it may be asked again if the send buffer is full
+    const uint32_t i = m_burstStart + GetCurrentBurstTotPackets();
+    NS_ASSERT(i < m_burstEnd);
+    return GetFlowRecord(i).m_size;
+}
+
+uint32_t
+TrafficGeneratorTraceReplay::GetNumFlowRecords() const
+{
+    if (m_flowRecords != nullptr)
+    {
+        return static_cast<uint32_t>(m_flowRecords->size());
+    }
+    return static_cast<uint32_t>(m_trace->GetNumRecords());
+}
+
+const TrafficTraceFile::Record&
+TrafficGeneratorTraceReplay::GetFlowRecord(uint32_t i) const
+{
+    if (m_flowRecords != nullptr)
+    {
+        return m_trace->GetRecord((*m_flowRecords)[i]);
+    }
+    return m_trace->GetRecord(i);
+}
+
+void
+TrafficGeneratorTraceReplay::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_startOffset = nullptr;
+    m_flowRecords = nullptr;
+    m_trace.reset();
+    // chain up
+    TrafficGenerator::DoDispose();
+}
+
+} // namespace ns3
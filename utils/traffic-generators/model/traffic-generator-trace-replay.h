@@ -0,0 +1,106 @@
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef TRAFFIC_GENERATOR_TRACE_REPLAY_H
+#define TRAFFIC_GENERATOR_TRACE_REPLAY_H
+
+#include "traffic-generator.h"
+#include "traffic-trace-file.h"
+
+#include <ns3/random-variable-stream.h>
+
+#include <memory>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applications
+ *
+ * \brief Traffic generator that replays a binary traffic trace
+ *
+ * The generator sends the packets of a TrafficTraceFile, with the sizes and
+ * the inter-packet times recorded in the trace. Only the records of the flow
+ * selected with the attribute FlowId are replayed, or all of them if it is
+ * set to TrafficTraceFile::ALL_FLOWS. The records with the same timestamp are
+ * sent as a single packet burst, so they can be sent in one event (see the
+ * attribute TrafficGenerator::SingleEventBurst).
+ *
+ * Many generators can replay the same trace: the file is opened and mapped in
+ * memory only once, and each generator keeps only its position in it. To
+ * avoid that all the generators send their packets at the same time, each
+ * one starts to replay the trace from an offset, drawn from the random
+ * variable of the attribute StartOffset when the application starts. When the
+ * end of the trace is reached, the replay restarts from the beginning if the
+ * attribute Loop is true, after the time needed to complete the duration of
+ * the trace.
+ */
+class TrafficGeneratorTraceReplay : public TrafficGenerator
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TrafficGeneratorTraceReplay();
+
+    ~TrafficGeneratorTraceReplay() override;
+
+    /**
+     * \brief Get the time of the first packet, relative to the start of the application
+     * \return the time of the first packet
+     *
+     * Valid after the application has been started.
+     */
+    Time GetFirstPacketTime() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    // inherited from Application base class.
+    void StartApplication() override;
+
+    // inherited from TrafficGenerator
+    void PacketBurstSent() override;
+    /**
+     * \brief Sets the packet burst size: the sum of the sizes of the records
+     * with the timestamp of the next record
+     */
+    void GenerateNextPacketBurstSize() override;
+    /**
+     * \brief Get the size of the next packet in bytes
+     * \return the size of the next packet in bytes
+     */
+    uint32_t GetNextPacketSize() const override;
+
+    /**
+     * \brief Get the number of records of the replayed flow
+     * \return the number of records of the replayed flow
+     */
+    uint32_t GetNumFlowRecords() const;
+    /**
+     * \brief Get a record of the replayed flow
+     * \param i the index of the record, among the ones of the replayed flow
+     * \return the record
+     */
+    const TrafficTraceFile::Record& GetFlowRecord(uint32_t i) const;
+
+    std::string m_traceFilename;                    //!< The name of the trace file
+    uint32_t m_flowId{TrafficTraceFile::ALL_FLOWS}; //!< The flow to replay
+    Ptr<RandomVariableStream> m_startOffset;        //!< Offset in the trace at the start, in s
+    bool m_loop{true};                              //!< Restart from the beginning at the end
+
+    std::shared_ptr<const TrafficTraceFile> m_trace;    //!< The trace
+    const std::vector<uint32_t>* m_flowRecords{nullptr}; //!< Records of the flow, if filtered
+    uint32_t m_burstStart{0}; //!< Index (in the flow) of the first record of the current burst
+    uint32_t m_burstEnd{0};   //!< Index (in the flow) after the last record of the current burst
+    Time m_firstPacketTime;   //!< Time of the first packet, since the application start
+};
+
+} // namespace ns3
+
+#endif /* TRAFFIC_GENERATOR_TRACE_REPLAY_H */
@@ -7,6 +7,7 @@
 #include "traffic-generator.h"
 
 #include "ns3/address.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
@@ -31,7 +32,18 @@ TypeId
 TrafficGenerator::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::TrafficGenerator").SetParent<Application>().SetGroupName("Applications");
+        TypeId("ns3::TrafficGenerator")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddAttribute("SingleEventBurst",
+                          "If true, the packets of a packet burst that have to be sent with a "
+                          "zero inter-packet time are sent all in the same event, instead of "
+                          "scheduling a new event for each of them. Generators that space "
+                          "all their packets (e.g., one packet per video frame) are not "
+                          "affected.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TrafficGenerator::m_singleEventBurst),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -244,6 +256,12 @@ TrafficGenerator::GetPacketBurstSizeInPackets() const
     return m_packetBurstSizeInPackets;
 }
 
+uint32_t
+TrafficGenerator::GetCurrentBurstTotPackets() const
+{
+    return m_currentBurstTotPackets;
+}
+
 void
 TrafficGenerator::SendNextPacket()
 {
@@ -263,77 +281,95 @@ TrafficGenerator::SendNextPacket()
         GenerateNextPacketBurstSize();
     }
 
-    NS_ASSERT(m_packetBurstSizeInBytes || m_packetBurstSizeInPackets);
-
-    // Time to send more
-    uint32_t toSend = GetNextPacketSize();
-    // Make sure we don't send too many
-    if ((m_packetBurstSizeInBytes > 0) and
-        (m_packetBurstSizeInBytes - m_currentBurstTotBytes > toSend))
+    // The socket send callback is ignored only while the packets that follow
+    // a zero inter-packet time are sent in this event (see SendNextPacketIfConnected)
+    m_sendingBurst = false;
+    while (true)
     {
-        toSend = std::min(toSend, m_packetBurstSizeInBytes - m_currentBurstTotBytes);
-        NS_LOG_INFO("Sending a packet at " << Simulator::Now() << " of size:" << toSend);
-        //<< ", and left to send: " << (m_packetBurstSizeInBytes - m_currentBurstTotBytes));
-    }
-    NS_ASSERT(toSend);
-    int actual = 0;
-    /*
-    XrHeader xrHeader (GetTrafficType());
-    if (m_socket->GetTxAvailable() > toSend + xrHeader.GetSerializedSize ())
-    */
-    if (m_socket->GetTxAvailable() > toSend)
-    {
-        Ptr<Packet> packet = Create<Packet>(toSend);
-        m_txTrace(packet);
-        actual = m_socket->Send(packet);
-        // NS_ASSERT (actual == (int) (toSend + xrHeader.GetSerializedSize ()));
-        NS_ASSERT(actual == (int)(toSend));
-    }
-    else
-    {
-        // it may happen that the buffer is full
-        NS_LOG_WARN("Unable to send packet; actual " << actual << " size " << toSend
-                                                     << "; caching for later attempt");
-    }
-    NS_LOG_INFO("Sent data: " << actual << " bytes.");
+        NS_ASSERT(m_packetBurstSizeInBytes || m_packetBurstSizeInPackets);
 
-    if ((actual < (int)toSend))
-    {
-        // We exit this loop when actual < toSend as the send side
-        // buffer is full. The "DataSent" callback will pop when
-        // some buffer space has freed ip.
-        NS_LOG_DEBUG("Send buffer is full.");
-        return;
-    }
-    else
-    {
-        m_currentBurstTotBytes += actual;
-        m_totBytes += actual;
-        m_currentBurstTotPackets++;
-        m_totPackets++;
-        NS_LOG_INFO("Sending " << actual
-                               << " bytes. "
-                                  "Total bytes: "
-                               << m_currentBurstTotBytes
-                               << ", and packetBurstSize: " << m_packetBurstSizeInBytes);
-    }
+        // Time to send more
+        uint32_t toSend = GetNextPacketSize();
+        // Make sure we don't send too many
+        if ((m_packetBurstSizeInBytes > 0) and
+            (m_packetBurstSizeInBytes - m_currentBurstTotBytes > toSend))
+        {
+            toSend = std::min(toSend, m_packetBurstSizeInBytes - m_currentBurstTotBytes);
+            NS_LOG_INFO("Sending a packet at " << Simulator::Now() << " of size:" << toSend);
+            //<< ", and left to send: " << (m_packetBurstSizeInBytes - m_currentBurstTotBytes));
+        }
+        NS_ASSERT(toSend);
+        int actual = 0;
+        /*
+        XrHeader xrHeader (GetTrafficType());
+        if (m_socket->GetTxAvailable() > toSend + xrHeader.GetSerializedSize ())
+        */
+        if (m_socket->GetTxAvailable() > toSend)
+        {
+            Ptr<Packet> packet = Create<Packet>(toSend);
+            m_txTrace(packet);
+            actual = m_socket->Send(packet);
+            // NS_ASSERT (actual == (int) (toSend + xrHeader.GetSerializedSize ()));
+            NS_ASSERT(actual == (int)(toSend));
+        }
+        else
+        {
+            // it may happen that the buffer is full
+            NS_LOG_WARN("Unable to send packet; actual " << actual << " size " << toSend
+                                                         << "; caching for later attempt");
+        }
+        NS_LOG_INFO("Sent data: " << actual << " bytes.");
 
-    if (m_currentBurstTotBytes < m_packetBurstSizeInBytes ||
-        m_currentBurstTotPackets < m_packetBurstSizeInPackets || m_packetBurstSizeInPackets == 1)
-    {
-        Time nextPacketTime = GetNextPacketTime();
-        NS_ASSERT(nextPacketTime.GetSeconds() >= 0);
-        m_eventIdSendNextPacket =
-            Simulator::Schedule(nextPacketTime, &TrafficGenerator::SendNextPacket, this);
-    }
-    else // we finished transmitting this packet burst
-    {
-        m_currentBurstTotBytes = 0;
-        m_currentBurstTotPackets = 0;
-        m_eventIdSendNextPacket.Cancel();
-        m_waitForNextPacketBurst = true;
-        PacketBurstSent();
+        if ((actual < (int)toSend))
+        {
+            // We exit this loop when actual < toSend as the send side
+            // buffer is full. The "DataSent" callback will pop when
+            // some buffer space has freed ip.
+            NS_LOG_DEBUG("Send buffer is full.");
+            m_sendingBurst = false;
+            return;
+        }
+        else
+        {
+            m_currentBurstTotBytes += actual;
+            m_totBytes += actual;
+            m_currentBurstTotPackets++;
+            m_totPackets++;
+            NS_LOG_INFO("Sending " << actual
+                                   << " bytes. "
+                                      "Total bytes: "
+                                   << m_currentBurstTotBytes
+                                   << ", and packetBurstSize: " << m_packetBurstSizeInBytes);
+        }
+
+        if (m_currentBurstTotBytes < m_packetBurstSizeInBytes ||
+            m_currentBurstTotPackets < m_packetBurstSizeInPackets ||
+            m_packetBurstSizeInPackets == 1)
+        {
+            Time nextPacketTime = GetNextPacketTime();
+            NS_ASSERT(nextPacketTime.GetSeconds() >= 0);
+            if (m_singleEventBurst && nextPacketTime.IsZero() && m_packetBurstSizeInPackets != 1)
+            {
+                // Send the next packet now, without going through the scheduler
+                m_sendingBurst = true;
+                continue;
+            }
+            m_eventIdSendNextPacket =
+                Simulator::Schedule(nextPacketTime, &TrafficGenerator::SendNextPacket, this);
+        }
+        else // we finished transmitting this packet burst
+        {
+            m_currentBurstTotBytes = 0;
+            m_currentBurstTotPackets = 0;
+            m_eventIdSendNextPacket.Cancel();
+            m_waitForNextPacketBurst = true;
+            m_sendingBurst = false;
+            PacketBurstSent();
+            return;
+        }
+        break;
     }
+    m_sendingBurst = false;
 }
 
 void
@@ -399,8 +435,10 @@ TrafficGenerator::SendNextPacketIfConnected(Ptr<Socket>, uint32_t)
         { // Only send new data if the connection has completed
             NS_LOG_LOGIC("TrafficGenerator SendNextPacketIfConnected callback triggers new "
                          "SendNextPacket call");
-            // Only if the event is not running scheule it
-            if (!m_eventIdSendNextPacket.IsRunning() && !m_waitForNextPacketBurst)
+            // Only if the event is not running scheule it, and if we are not
+            // already sending the packets of the burst in this event
+            if (!m_eventIdSendNextPacket.IsRunning() && !m_waitForNextPacketBurst &&
+                !m_sendingBurst)
             {
                 Time nextPacketTime = GetNextPacketTime();
                 m_eventIdSendNextPacket =
@@ -135,6 +135,11 @@ class TrafficGenerator : public Application
      * of bytes
      */
     uint32_t GetPacketBurstSizeInPackets() const;
+    /*
+     * \brief Returns the number of packets of the current packet burst that
+     * have already been sent
+     */
+    uint32_t GetCurrentBurstTotPackets() const;
     /*
      * \brief Called at the time specified by the Stop.
      * Notice that we want to allow that child classes can call stop of this class,
@@ -227,6 +232,8 @@ class TrafficGenerator : public Application
     uint16_t m_tgId{0};            //!< traffic generator ID for the tracing purposes
     uint16_t m_packetId{
         0}; //!< packetId of the current flow, when it reaches the maximum value starts from zero
+    bool m_singleEventBurst{false}; //!< Send the zero-spaced packets of a burst in one event
+    bool m_sendingBurst{false};     //!< True while SendNextPacket sends zero-spaced packets
 };
 
 } // namespace ns3
@@ -0,0 +1,162 @@
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "traffic-trace-file.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TrafficTraceFile");
+
+static_assert(sizeof(TrafficTraceFile::Record) == 16, "Unexpected size of the trace records");
+
+std::map<std::string, std::weak_ptr<const TrafficTraceFile>> TrafficTraceFile::s_files;
+
+std::shared_ptr<const TrafficTraceFile>
+TrafficTraceFile::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    auto it = s_files.find(filename);
+    if (it != s_files.end())
+    {
+        if (auto file = it->second.lock())
+        {
+            return file;
+        }
+    }
+
+    std::shared_ptr<const TrafficTraceFile> file(new TrafficTraceFile(filename));
+    s_files[filename] = file;
+    return file;
+}
+
+void
+TrafficTraceFile::Write(const std::string& filename,
+                        const std::vector<Record>& records,
+                        uint64_t durationNs)
+{
+    NS_LOG_FUNCTION(filename << records.size() << durationNs);
+
+    for (std::size_t i = 1; i < records.size(); ++i)
+    {
+        NS_ABORT_MSG_IF(records[i].m_timeNs < records[i - 1].m_timeNs,
+                        "The records must be sorted by timestamp");
+    }
+    NS_ABORT_MSG_IF(!records.empty() && durationNs < records.back().m_timeNs,
+                    "The duration can not be lower than the last timestamp");
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!out.is_open(), "Can't open file " << filename);
+
+    Header header;
+    std::memcpy(header.m_magic, "NRTT", 4);
+    header.m_version = VERSION;
+    header.m_numRecords = records.size();
+    header.m_durationNs = durationNs;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(Record)));
+    NS_ABORT_MSG_IF(!out.good(), "Error writing file " << filename);
+}
+
+TrafficTraceFile::TrafficTraceFile(const std::string& filename)
+    : m_filename(filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Can't open file " << filename);
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(fd, &st) != 0, "Can't get the size of file " << filename);
+    size = static_cast<std::size_t>(st.st_size);
+    NS_ABORT_MSG_IF(size < sizeof(Header), "File " << filename << " is not a traffic trace");
+    m_mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    NS_ABORT_MSG_IF(m_mapping == MAP_FAILED, "Can't map file " << filename);
+    m_mappingSize = size;
+    data = static_cast<const uint8_t*>(m_mapping);
+#else
+    std::ifstream in(filename, std::ios::binary);
+    NS_ABORT_MSG_IF(!in.is_open(), "Can't open file " << filename);
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    size = m_buffer.size();
+    NS_ABORT_MSG_IF(size < sizeof(Header), "File " << filename << " is not a traffic trace");
+    data = m_buffer.data();
+#endif
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    NS_ABORT_MSG_IF(std::memcmp(header.m_magic, "NRTT", 4) != 0,
+                    "File " << filename << " is not a traffic trace");
+    NS_ABORT_MSG_IF(header.m_version != VERSION,
+                    "Unsupported version " << header.m_version << " of trace " << filename);
+    NS_ABORT_MSG_IF(size != sizeof(Header) + header.m_numRecords * sizeof(Record),
+                    "Trace " << filename << " is truncated");
+
+    m_records = reinterpret_cast<const Record*>(data + sizeof(Header));
+    m_numRecords = header.m_numRecords;
+    m_durationNs = header.m_durationNs;
+
+    NS_ABORT_MSG_IF(m_numRecords == 0, "Trace " << filename << " is empty");
+    NS_ABORT_MSG_IF(m_numRecords > UINT32_MAX, "Trace " << filename << " is too long");
+    NS_ABORT_MSG_IF(m_durationNs < m_records[m_numRecords - 1].m_timeNs,
+                    "The duration of trace " << filename << " is lower than its last timestamp");
+
+    NS_LOG_INFO("Opened trace " << filename << " with " << m_numRecords << " records, lasting "
+                                << m_durationNs << " ns");
+}
+
+TrafficTraceFile::~TrafficTraceFile()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef _WIN32
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+const std::vector<uint32_t>&
+TrafficTraceFile::GetFlowRecords(uint32_t flowId) const
+{
+    NS_ASSERT(flowId != ALL_FLOWS);
+
+    auto it = m_flowRecords.find(flowId);
+    if (it == m_flowRecords.end())
+    {
+        it = m_flowRecords.emplace(flowId, std::vector<uint32_t>()).first;
+        for (uint32_t i = 0; i < m_numRecords; ++i)
+        {
+            if (m_records[i].m_flowId == flowId)
+            {
+                it->second.push_back(i);
+            }
+        }
+        NS_LOG_INFO("Flow " << flowId << " of trace " << m_filename << " has "
+                            << it->second.size() << " records");
+    }
+    return it->second;
+}
+
+} // namespace ns3
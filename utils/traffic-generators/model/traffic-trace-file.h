@@ -0,0 +1,157 @@
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef TRAFFIC_TRACE_FILE_H
+#define TRAFFIC_TRACE_FILE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applications
+ *
+ * \brief A read-only, memory-mapped, binary traffic trace
+ *
+ * The trace is a sequence of (timestamp, size, flow) records, sorted by
+ * timestamp. The binary format (little endian) is:
+ *
+ * - a 24-byte header: the magic "NRTT", the format version (uint32_t), the
+ *   number of records (uint64_t) and the duration of the trace in ns
+ *   (uint64_t), i.e. the period after which the trace restarts when looping;
+ * - the records, 16 bytes each: the timestamp in ns from the start of the
+ *   trace (uint64_t), the packet size in bytes (uint32_t) and the flow ID
+ *   (uint32_t).
+ *
+ * The file is opened once, however many generators replay it: Open() returns
+ * the same instance as long as someone is using it. The records are accessed
+ * through a memory mapping of the file (on POSIX systems), so they are
+ * loaded in memory by the OS only when (and if) they are read.
+ *
+ * Traces can be created from text files with the traffic-trace-converter
+ * program, or with Write().
+ */
+class TrafficTraceFile
+{
+  public:
+    /**
+     * \brief A record of the trace
+     */
+    struct Record
+    {
+        uint64_t m_timeNs; //!< Timestamp from the start of the trace, in ns
+        uint32_t m_size;   //!< Packet size, in bytes
+        uint32_t m_flowId; //!< Flow ID
+    };
+
+    static constexpr uint32_t VERSION = 1;            //!< Version of the binary format
+    static constexpr uint32_t ALL_FLOWS = UINT32_MAX; //!< Flow ID that selects all the records
+
+    /**
+     * \brief Open a trace, or get the instance already opened
+     * \param filename the name of the file
+     * \return the trace
+     *
+     * Aborts if the file can not be opened, or if it is not a valid trace.
+     */
+    static std::shared_ptr<const TrafficTraceFile> Open(const std::string& filename);
+
+    /**
+     * \brief Write a trace
+     * \param filename the name of the file
+     * \param records the records, sorted by timestamp
+     * \param durationNs the duration of the trace, not lower than the last timestamp
+     */
+    static void Write(const std::string& filename,
+                      const std::vector<Record>& records,
+                      uint64_t durationNs);
+
+    /**
+     * \brief Unmap the file
+     */
+    ~TrafficTraceFile();
+
+    TrafficTraceFile(const TrafficTraceFile&) = delete;
+    TrafficTraceFile& operator=(const TrafficTraceFile&) = delete;
+
+    /**
+     * \brief Get the number of records
+     * \return the number of records
+     */
+    uint64_t GetNumRecords() const
+    {
+        return m_numRecords;
+    }
+
+    /**
+     * \brief Get a record
+     * \param i the index of the record
+     * \return the record
+     */
+    const Record& GetRecord(uint64_t i) const
+    {
+        return m_records[i];
+    }
+
+    /**
+     * \brief Get the duration of the trace
+     * \return the duration of the trace, in ns
+     */
+    uint64_t GetDurationNs() const
+    {
+        return m_durationNs;
+    }
+
+    /**
+     * \brief Get the indexes of the records of a flow
+     * \param flowId the flow ID (not ALL_FLOWS)
+     * \return the indexes of the records of the flow, sorted by timestamp
+     *
+     * The index is built the first time that a flow is requested, and then
+     * shared by all the users of the trace.
+     */
+    const std::vector<uint32_t>& GetFlowRecords(uint32_t flowId) const;
+
+  private:
+    /**
+     * \brief Map a file, and check its content
+     * \param filename the name of the file
+     */
+    explicit TrafficTraceFile(const std::string& filename);
+
+    /**
+     * \brief The header of the file
+     */
+    struct Header
+    {
+        char m_magic[4];       //!< "NRTT"
+        uint32_t m_version;    //!< Format version
+        uint64_t m_numRecords; //!< Number of records
+        uint64_t m_durationNs; //!< Duration of the trace, in ns
+    };
+
+    std::string m_filename;           //!< Name of the file
+    void* m_mapping{nullptr};         //!< The mapped file
+    std::size_t m_mappingSize{0};     //!< Size of the mapped file
+    std::vector<uint8_t> m_buffer;    //!< The file content, where memory mapping is not available
+    const Record* m_records{nullptr}; //!< The records
+    uint64_t m_numRecords{0};         //!< Number of records
+    uint64_t m_durationNs{0};         //!< Duration of the trace, in ns
+
+    mutable std::unordered_map<uint32_t, std::vector<uint32_t>>
+        m_flowRecords; //!< Indexes of the records of each flow
+
+    static std::map<std::string, std::weak_ptr<const TrafficTraceFile>>
+        s_files; //!< The opened traces
+};
+
+} // namespace ns3
+
+#endif /* TRAFFIC_TRACE_FILE_H */
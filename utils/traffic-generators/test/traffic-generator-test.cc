@@ -6,6 +6,7 @@
 #include "traffic-generator-test.h"
 
 #include <ns3/boolean.h>
+#include <ns3/double.h>
 #include <ns3/ping-helper.h>
 
 namespace ns3
@@ -16,11 +17,13 @@ bool TGT_ENABLE_PRINTING =
 
 TrafficGeneratorTestCase::TrafficGeneratorTestCase(std::string name,
                                                    TypeId trafficGeneratorType,
-                                                   std::string transportProtocol)
+                                                   std::string transportProtocol,
+                                                   bool singleEventBurst)
     : TestCase("(TX bytes == RX bytes) when " + name)
 {
     m_trafficGeneratorType = trafficGeneratorType;
     m_transportProtocol = transportProtocol;
+    m_singleEventBurst = singleEventBurst;
 }
 
 TrafficGeneratorTestCase::~TrafficGeneratorTestCase()
@@ -65,6 +68,7 @@ TrafficGeneratorTestCase::DoRun()
         m_transportProtocol,
         InetSocketAddress(ipv4Interfaces.GetAddress(1, 0), port),
         m_trafficGeneratorType);
+    trafficGeneratorHelper.SetAttribute("SingleEventBurst", BooleanValue(m_singleEventBurst));
 
     ApplicationContainer generatorApplication = trafficGeneratorHelper.Install(nodes.Get(0));
     generatorApplication.Start(Seconds(2));
@@ -647,6 +651,257 @@ TrafficGeneratorThreeGppHttpTestCase::DoRun()
     Simulator::Destroy();
 }
 
+TrafficGeneratorTraceReplayTestCase::TrafficGeneratorTraceReplayTestCase(uint32_t flowId,
+                                                                         Time startOffset,
+                                                                         bool loop)
+    : TestCase("Trace replay of flow " + std::to_string(flowId) + " from " +
+               std::to_string(startOffset.GetMilliSeconds()) + " ms" + (loop ? " with loop" : ""))
+{
+    m_flowId = flowId;
+    m_startOffset = startOffset;
+    m_loop = loop;
+}
+
+TrafficGeneratorTraceReplayTestCase::~TrafficGeneratorTraceReplayTestCase()
+{
+}
+
+void
+TrafficGeneratorTraceReplayTestCase::TxTrace(Ptr<const Packet> packet)
+{
+    m_sentPackets.emplace_back(Simulator::Now(), packet->GetSize());
+}
+
+void
+TrafficGeneratorTraceReplayTestCase::DoRun()
+{
+    // Two flows: flow 1 has two packets with the same timestamp, which are sent as one burst
+    const std::vector<TrafficTraceFile::Record> records = {{0, 100, 1},
+                                                           {0, 200, 2},
+                                                           {10000000, 300, 1},
+                                                           {25000000, 400, 1},
+                                                           {25000000, 150, 1}};
+    const Time traceDuration = MilliSeconds(40);
+    std::string traceFilename = CreateTempDirFilename("traffic-trace-replay-test.nrtt");
+    TrafficTraceFile::Write(traceFilename, records, traceDuration.GetNanoSeconds());
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    // link the two nodes
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    nodes.Get(0)->AddDevice(txDev);
+    nodes.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    txDev->SetChannel(channel1);
+    NetDeviceContainer devices;
+    devices.Add(txDev);
+    devices.Add(rxDev);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer ipv4Interfaces = ipv4.Assign(devices);
+
+    // install the packet sink at the receiver node
+    uint16_t port = 4000;
+    InetSocketAddress rxAddress(Ipv4Address::GetAny(), port);
+    PacketSinkHelper packetSinkHelper("ns3::UdpSocketFactory", rxAddress);
+    ApplicationContainer sinkApplication = packetSinkHelper.Install(nodes.Get(1));
+    sinkApplication.Start(Seconds(1));
+    sinkApplication.Stop(Seconds(4));
+
+    // install the traffic generator at the transmitter node
+    const Time appStart = Seconds(2);
+    const Time appStop = Seconds(2.1);
+    TrafficGeneratorHelper trafficGeneratorHelper(
+        "ns3::UdpSocketFactory",
+        InetSocketAddress(ipv4Interfaces.GetAddress(1, 0), port),
+        TrafficGeneratorTraceReplay::GetTypeId());
+    trafficGeneratorHelper.SetAttribute("TraceFile", StringValue(traceFilename));
+    trafficGeneratorHelper.SetAttribute("FlowId", UintegerValue(m_flowId));
+    trafficGeneratorHelper.SetAttribute(
+        "StartOffset",
+        StringValue("ns3::ConstantRandomVariable[Constant=" +
+                    std::to_string(m_startOffset.GetSeconds()) + "]"));
+    trafficGeneratorHelper.SetAttribute("Loop", BooleanValue(m_loop));
+
+    ApplicationContainer generatorApplication = trafficGeneratorHelper.Install(nodes.Get(0));
+    generatorApplication.Start(appStart);
+    generatorApplication.Stop(appStop);
+    generatorApplication.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&TrafficGeneratorTraceReplayTestCase::TxTrace, this));
+
+    // Seed the ARP cache by pinging early in the simulation
+    // This is a workaround until a static ARP capability is provided
+    PingHelper pingHelper(ipv4Interfaces.GetAddress(1, 0));
+    ApplicationContainer pingApps = pingHelper.Install(nodes.Get(0));
+    pingApps.Start(Seconds(1));
+    pingApps.Stop(Seconds(2));
+
+    Simulator::Run();
+
+    // Compute the expected packets, replaying the trace from the offset
+    std::vector<std::pair<Time, uint32_t>> expectedPackets;
+    for (Time loopStart = -m_startOffset; appStart + loopStart < appStop;
+         loopStart += traceDuration)
+    {
+        for (const auto& record : records)
+        {
+            Time t = appStart + loopStart + NanoSeconds(record.m_timeNs);
+            bool inFlow = m_flowId == TrafficTraceFile::ALL_FLOWS || record.m_flowId == m_flowId;
+            if (inFlow && t >= appStart && t < appStop)
+            {
+                expectedPackets.emplace_back(t, record.m_size);
+            }
+        }
+        if (!m_loop)
+        {
+            break;
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(expectedPackets.empty(), false, "The test should send some packets");
+    NS_TEST_ASSERT_MSG_EQ(m_sentPackets.size(),
+                          expectedPackets.size(),
+                          "Unexpected number of packets sent");
+    for (std::size_t i = 0; i < std::min(m_sentPackets.size(), expectedPackets.size()); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sentPackets[i].first,
+                              expectedPackets[i].first,
+                              "Unexpected time of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_sentPackets[i].second,
+                              expectedPackets[i].second,
+                              "Unexpected size of packet " << i);
+    }
+
+    Ptr<TrafficGenerator> trafficGenerator =
+        generatorApplication.Get(0)->GetObject<TrafficGenerator>();
+    Ptr<PacketSink> packetSink = sinkApplication.Get(0)->GetObject<PacketSink>();
+    NS_TEST_ASSERT_MSG_EQ(trafficGenerator->GetTotalBytes(),
+                          packetSink->GetTotalRx(),
+                          "Packets were lost !");
+
+    Simulator::Destroy();
+}
+
+TrafficGeneratorSingleEventBurstTestCase::TrafficGeneratorSingleEventBurstTestCase(
+    bool singleEventBurst)
+    : TestCase(std::string("Packets of a FTP file sent in ") +
+               (singleEventBurst ? "one event" : "more events")),
+      m_singleEventBurst(singleEventBurst)
+{
+}
+
+TrafficGeneratorSingleEventBurstTestCase::~TrafficGeneratorSingleEventBurstTestCase()
+{
+}
+
+void
+TrafficGeneratorSingleEventBurstTestCase::TxTrace([[maybe_unused]] Ptr<const Packet> packet)
+{
+    // The executed-event count does not change within an event
+    m_sentPackets.emplace_back(Simulator::Now(), Simulator::GetEventCount());
+}
+
+void
+TrafficGeneratorSingleEventBurstTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    // link the two nodes
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    nodes.Get(0)->AddDevice(txDev);
+    nodes.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    txDev->SetChannel(channel1);
+    NetDeviceContainer devices;
+    devices.Add(txDev);
+    devices.Add(rxDev);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer ipv4Interfaces = ipv4.Assign(devices);
+
+    // install the packet sink at the receiver node
+    uint16_t port = 4000;
+    InetSocketAddress rxAddress(Ipv4Address::GetAny(), port);
+    PacketSinkHelper packetSinkHelper("ns3::UdpSocketFactory", rxAddress);
+    ApplicationContainer sinkApplication = packetSinkHelper.Install(nodes.Get(1));
+    sinkApplication.Start(Seconds(1));
+    sinkApplication.Stop(Seconds(4));
+
+    // Small files (at most 20 packets), with a short reading time between them
+    TrafficGeneratorHelper trafficGeneratorHelper(
+        "ns3::UdpSocketFactory",
+        InetSocketAddress(ipv4Interfaces.GetAddress(1, 0), port),
+        TrafficGeneratorNgmnFtpMulti::GetTypeId());
+    trafficGeneratorHelper.SetAttribute("MaxFileSize", UintegerValue(20000));
+    trafficGeneratorHelper.SetAttribute("PacketSize", UintegerValue(1000));
+    trafficGeneratorHelper.SetAttribute("ReadingTimeMean", DoubleValue(0.05));
+    trafficGeneratorHelper.SetAttribute("SingleEventBurst", BooleanValue(m_singleEventBurst));
+
+    ApplicationContainer generatorApplication = trafficGeneratorHelper.Install(nodes.Get(0));
+    generatorApplication.Start(Seconds(2));
+    generatorApplication.Stop(Seconds(2.5));
+    generatorApplication.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&TrafficGeneratorSingleEventBurstTestCase::TxTrace, this));
+
+    // Seed the ARP cache by pinging early in the simulation
+    // This is a workaround until a static ARP capability is provided
+    PingHelper pingHelper(ipv4Interfaces.GetAddress(1, 0));
+    ApplicationContainer pingApps = pingHelper.Install(nodes.Get(0));
+    pingApps.Start(Seconds(1));
+    pingApps.Stop(Seconds(2));
+
+    Simulator::Run();
+
+    // The events in which the packets sent at the same time were sent
+    std::map<Time, std::set<uint64_t>> eventsAtTime;
+    std::map<Time, uint32_t> packetsAtTime;
+    for (const auto& sent : m_sentPackets)
+    {
+        eventsAtTime[sent.first].insert(sent.second);
+        packetsAtTime[sent.first]++;
+    }
+
+    uint32_t bursts = 0;
+    uint32_t burstsInMoreEvents = 0;
+    for (const auto& it : packetsAtTime)
+    {
+        if (it.second > 1)
+        {
+            ++bursts;
+            burstsInMoreEvents += eventsAtTime.at(it.first).size() > 1 ? 1 : 0;
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_GT(bursts, 0U, "The test should send some files of more packets");
+    if (m_singleEventBurst)
+    {
+        NS_TEST_ASSERT_MSG_EQ(burstsInMoreEvents, 0U, "A file should be sent in one event");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(burstsInMoreEvents, bursts, "A file should take more events");
+    }
+
+    Ptr<TrafficGenerator> trafficGenerator =
+        generatorApplication.Get(0)->GetObject<TrafficGenerator>();
+    Ptr<PacketSink> packetSink = sinkApplication.Get(0)->GetObject<PacketSink>();
+    NS_TEST_ASSERT_MSG_EQ(trafficGenerator->GetTotalBytes(),
+                          packetSink->GetTotalRx(),
+                          "Packets were lost !");
+
+    Simulator::Destroy();
+}
+
 TrafficGeneratorTestSuite::TrafficGeneratorTestSuite()
     : TestSuite("traffic-generator-test", UNIT)
 {
@@ -667,6 +922,29 @@ TrafficGeneratorTestSuite::TrafficGeneratorTestSuite()
         }
     }
 
+    // The FTP files are sent as a burst of packets with no inter-packet time
+    for (auto transportProtocol : transportProtocols)
+    {
+        std::string name = TrafficGeneratorNgmnFtpMulti::GetTypeId().GetName() + " and " +
+                           transportProtocol + " with SingleEventBurst";
+        AddTestCase(new TrafficGeneratorTestCase(name,
+                                                 TrafficGeneratorNgmnFtpMulti::GetTypeId(),
+                                                 transportProtocol,
+                                                 true),
+                    TestCase::QUICK);
+    }
+
+    AddTestCase(new TrafficGeneratorTraceReplayTestCase(TrafficTraceFile::ALL_FLOWS,
+                                                        MilliSeconds(0),
+                                                        false),
+                TestCase::QUICK);
+    AddTestCase(new TrafficGeneratorTraceReplayTestCase(1, MilliSeconds(15), false),
+                TestCase::QUICK);
+    AddTestCase(new TrafficGeneratorTraceReplayTestCase(1, MilliSeconds(15), true),
+                TestCase::QUICK);
+
+    AddTestCase(new TrafficGeneratorSingleEventBurstTestCase(true), TestCase::QUICK);
+    AddTestCase(new TrafficGeneratorSingleEventBurstTestCase(false), TestCase::QUICK);
     AddTestCase(new TrafficGeneratorNgmnFtpTestCase(), TestCase::QUICK);
     AddTestCase(new TrafficGeneratorNgmnVideoTestCase(), TestCase::QUICK);
     AddTestCase(new TrafficGeneratorNgmnGamingTestCase(), TestCase::QUICK);
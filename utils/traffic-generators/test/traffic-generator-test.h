@@ -26,10 +26,14 @@
 #include <ns3/traffic-generator-ngmn-gaming.h>
 #include <ns3/traffic-generator-ngmn-video.h>
 #include <ns3/traffic-generator-ngmn-voip.h>
+#include <ns3/traffic-generator-trace-replay.h>
 #include <ns3/uinteger.h>
 
 #include <fstream>
 #include <list>
+#include <map>
+#include <set>
+#include <vector>
 
 namespace ns3
 {
@@ -52,7 +56,8 @@ class TrafficGeneratorTestCase : public TestCase
   public:
     TrafficGeneratorTestCase(std::string name,
                              TypeId trafficGeneratorType,
-                             std::string transportProtocol);
+                             std::string transportProtocol,
+                             bool singleEventBurst = false);
     ~TrafficGeneratorTestCase() override;
 
   private:
@@ -60,6 +65,7 @@ class TrafficGeneratorTestCase : public TestCase
     TypeId m_trafficGeneratorType;   //!< the traffic generator application to be tested: NGMN VoIP,
                                      //!< NGMN VIDEO, NGMN GAMING, NGMN FTP
     std::string m_transportProtocol; //!< the transport protocol to be used: TCP or UDP
+    bool m_singleEventBurst;         //!< the value of the SingleEventBurst attribute
 };
 
 /**
@@ -147,6 +153,60 @@ class TrafficGeneratorThreeGppHttpTestCase : public TestCase
     void DoRun() override;
 };
 
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Test that the trace replay generator sends the packets of the replayed flow
+ * with the sizes and at the times of the trace, starting from the configured
+ * offset and, if looping, restarting from the beginning of the trace at its end
+ */
+class TrafficGeneratorTraceReplayTestCase : public TestCase
+{
+  public:
+    TrafficGeneratorTraceReplayTestCase(uint32_t flowId, Time startOffset, bool loop);
+    ~TrafficGeneratorTraceReplayTestCase() override;
+
+  private:
+    void DoRun() override;
+    /**
+     * \brief Save the time and the size of a packet sent by the generator
+     * \param packet the packet
+     */
+    void TxTrace(Ptr<const Packet> packet);
+
+    uint32_t m_flowId;                                    //!< the replayed flow
+    Time m_startOffset;                                   //!< the offset in the trace at the start
+    bool m_loop;                                          //!< the value of the Loop attribute
+    std::vector<std::pair<Time, uint32_t>> m_sentPackets; //!< time and size of the sent packets
+};
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Test that, with the attribute SingleEventBurst, the zero-spaced packets of an
+ * FTP file are sent in a single event, and that without it they are sent in
+ * more events
+ */
+class TrafficGeneratorSingleEventBurstTestCase : public TestCase
+{
+  public:
+    TrafficGeneratorSingleEventBurstTestCase(bool singleEventBurst);
+    ~TrafficGeneratorSingleEventBurstTestCase() override;
+
+  private:
+    void DoRun() override;
+    /**
+     * \brief Save the time and the event of a packet sent by the generator
+     * \param packet the packet
+     */
+    void TxTrace(Ptr<const Packet> packet);
+
+    bool m_singleEventBurst;                               //!< the value of SingleEventBurst
+    std::vector<std::pair<Time, uint64_t>> m_sentPackets; //!< time and event of the sent packets
+};
+
 /**
  * \ingroup applications-test
  * \ingroup tests
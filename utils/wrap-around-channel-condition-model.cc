@@ -0,0 +1,100 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "wrap-around-channel-condition-model.h"
+
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WrapAroundChannelConditionModel");
+NS_OBJECT_ENSURE_REGISTERED(WrapAroundChannelConditionModel);
+
+TypeId
+WrapAroundChannelConditionModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::WrapAroundChannelConditionModel")
+            .SetParent<ChannelConditionModel>()
+            .SetGroupName("Nr")
+            .AddConstructor<WrapAroundChannelConditionModel>()
+            .AddAttribute("ChannelConditionModel",
+                          "The channel condition model evaluated on the wrapped geometry",
+                          PointerValue(),
+                          MakePointerAccessor(
+                              &WrapAroundChannelConditionModel::SetChannelConditionModel,
+                              &WrapAroundChannelConditionModel::GetChannelConditionModel),
+                          MakePointerChecker<ChannelConditionModel>())
+            .AddAttribute("WrapAroundModel",
+                          "The copies of the base stations",
+                          PointerValue(),
+                          MakePointerAccessor(&WrapAroundChannelConditionModel::m_wrapAround),
+                          MakePointerChecker<WrapAroundModel>());
+    return tid;
+}
+
+WrapAroundChannelConditionModel::WrapAroundChannelConditionModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WrapAroundChannelConditionModel::~WrapAroundChannelConditionModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+WrapAroundChannelConditionModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_channelConditionModel = nullptr;
+    m_wrapAround = nullptr;
+    ChannelConditionModel::DoDispose();
+}
+
+void
+WrapAroundChannelConditionModel::SetChannelConditionModel(const Ptr<ChannelConditionModel>& model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_channelConditionModel = model;
+}
+
+Ptr<ChannelConditionModel>
+WrapAroundChannelConditionModel::GetChannelConditionModel() const
+{
+    return m_channelConditionModel;
+}
+
+void
+WrapAroundChannelConditionModel::SetWrapAroundModel(const Ptr<WrapAroundModel>& wrapAround)
+{
+    NS_LOG_FUNCTION(this << wrapAround);
+    m_wrapAround = wrapAround;
+}
+
+Ptr<ChannelCondition>
+WrapAroundChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
+                                                     Ptr<const MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << a << b);
+    NS_ASSERT_MSG(m_channelConditionModel != nullptr, "The wrapped model is not set");
+    NS_ASSERT_MSG(m_wrapAround != nullptr, "The wrap-around model is not set");
+
+    const auto [wrappedA, wrappedB] =
+        m_wrapAround->GetWrappedLink(ConstCast<MobilityModel>(a), ConstCast<MobilityModel>(b));
+    return m_channelConditionModel->GetChannelCondition(wrappedA, wrappedB);
+}
+
+int64_t
+WrapAroundChannelConditionModel::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    return m_channelConditionModel != nullptr ? m_channelConditionModel->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,96 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef WRAP_AROUND_CHANNEL_CONDITION_MODEL_H
+#define WRAP_AROUND_CHANNEL_CONDITION_MODEL_H
+
+#include "wrap-around-model.h"
+
+#include "ns3/channel-condition-model.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup nr-utils
+ * \brief A channel condition model that evaluates another model on the
+ * wrapped geometry of each link
+ *
+ * The base station of each link is replaced by its copy that is the closest
+ * to the other node (see WrapAroundModel::GetWrappedLink), before calling the
+ * wrapped model. The copies are not base stations of the WrapAroundModel, so
+ * the links that are already wrapped (e.g., by WrapAroundPropagationLossModel)
+ * are passed unchanged, and get the same condition.
+ *
+ * \see WrapAroundModel
+ */
+class WrapAroundChannelConditionModel : public ChannelConditionModel
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief WrapAroundChannelConditionModel constructor
+     */
+    WrapAroundChannelConditionModel();
+
+    /**
+     * \brief ~WrapAroundChannelConditionModel
+     */
+    ~WrapAroundChannelConditionModel() override;
+
+    /**
+     * \brief Set the wrapped channel condition model
+     * \param model the channel condition model
+     */
+    void SetChannelConditionModel(const Ptr<ChannelConditionModel>& model);
+
+    /**
+     * \brief Get the wrapped channel condition model
+     * \return the channel condition model
+     */
+    Ptr<ChannelConditionModel> GetChannelConditionModel() const;
+
+    /**
+     * \brief Set the wrap-around model
+     * \param wrapAround the wrap-around model
+     */
+    void SetWrapAroundModel(const Ptr<WrapAroundModel>& wrapAround);
+
+    /**
+     * \brief Get the condition of the channel between a and b, with the wrapped geometry
+     * \param a mobility model
+     * \param b mobility model
+     * \return the condition of the channel between a and b
+     */
+    Ptr<ChannelCondition> GetChannelCondition(Ptr<const MobilityModel> a,
+                                              Ptr<const MobilityModel> b) const override;
+
+    /**
+     * \brief Assign the streams of the wrapped model
+     * \param stream the first stream index to use
+     * \return the number of stream indices assigned
+     */
+    int64_t AssignStreams(int64_t stream) override;
+
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object
+     */
+    void DoDispose() override;
+
+  private:
+    Ptr<ChannelConditionModel> m_channelConditionModel; //!< The wrapped model
+    Ptr<WrapAroundModel> m_wrapAround;                  //!< The copies of the base stations
+};
+
+} // namespace ns3
+
+#endif // WRAP_AROUND_CHANNEL_CONDITION_MODEL_H
@@ -0,0 +1,121 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "wrap-around-model.h"
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/hexagonal-grid-scenario-helper.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WrapAroundModel");
+NS_OBJECT_ENSURE_REGISTERED(WrapAroundModel);
+
+TypeId
+WrapAroundModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::WrapAroundModel")
+                            .SetParent<Object>()
+                            .SetGroupName("Nr")
+                            .AddConstructor<WrapAroundModel>();
+    return tid;
+}
+
+WrapAroundModel::WrapAroundModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WrapAroundModel::~WrapAroundModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+WrapAroundModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_baseStations.clear();
+    Object::DoDispose();
+}
+
+void
+WrapAroundModel::SetOffsets(const std::vector<Vector>& offsets)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_baseStations.empty(),
+                    "The offsets must be set before adding the base stations");
+    m_offsets = offsets;
+}
+
+void
+WrapAroundModel::AddBaseStation(const Ptr<Node>& bs)
+{
+    NS_LOG_FUNCTION(this << bs->GetId());
+
+    Ptr<MobilityModel> mobility = bs->GetObject<MobilityModel>();
+    NS_ABORT_MSG_IF(mobility == nullptr,
+                    "The base station " << bs->GetId() << " does not have a mobility model");
+
+    BaseStation baseStation;
+    baseStation.m_mobility = mobility;
+    baseStation.m_nodeId = bs->GetId();
+    for (const auto& offset : m_offsets)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<ConstantPositionMobilityModel> copy = CreateObject<ConstantPositionMobilityModel>();
+        copy->SetPosition(mobility->GetPosition() + offset);
+        node->AggregateObject(copy);
+        baseStation.m_copies.emplace_back(copy);
+    }
+    m_baseStations[PeekPointer(mobility)] = std::move(baseStation);
+}
+
+std::size_t
+WrapAroundModel::GetNumBaseStations() const
+{
+    return m_baseStations.size();
+}
+
+Ptr<MobilityModel>
+WrapAroundModel::GetClosestCopy(const BaseStation& bs, const Ptr<MobilityModel>& other) const
+{
+    const Vector bsPos = bs.m_mobility->GetPosition();
+    const Vector wrapped =
+        HexagonalGridScenarioHelper::GetWrappedPosition(bsPos, other->GetPosition(), m_offsets);
+    for (std::size_t i = 0; i < m_offsets.size(); ++i)
+    {
+        if (wrapped == bsPos + m_offsets.at(i))
+        {
+            // Follow the base station, if it moved since the copy was created
+            bs.m_copies.at(i)->SetPosition(wrapped);
+            return bs.m_copies.at(i);
+        }
+    }
+    return bs.m_mobility;
+}
+
+std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>
+WrapAroundModel::GetWrappedLink(const Ptr<MobilityModel>& a, const Ptr<MobilityModel>& b) const
+{
+    auto aIt = m_baseStations.find(PeekPointer(a));
+    auto bIt = m_baseStations.find(PeekPointer(b));
+
+    if (aIt != m_baseStations.end() &&
+        (bIt == m_baseStations.end() || aIt->second.m_nodeId < bIt->second.m_nodeId))
+    {
+        return {GetClosestCopy(aIt->second, b), b};
+    }
+    if (bIt != m_baseStations.end())
+    {
+        return {a, GetClosestCopy(bIt->second, a)};
+    }
+    return {a, b};
+}
+
+} // namespace ns3
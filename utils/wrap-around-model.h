@@ -0,0 +1,129 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef WRAP_AROUND_MODEL_H
+#define WRAP_AROUND_MODEL_H
+
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/object.h"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup nr-utils
+ * \brief The copies of the base stations in the wrap-around model of 3GPP
+ * TR 38.901
+ *
+ * With the wrap-around, the layout of the sites is repeated around itself
+ * (see HexagonalGridScenarioHelper::GetWrapAroundOffsets), and each link
+ * between a base station and another node is evaluated with the copy of the
+ * base station that is the closest to the node (see
+ * HexagonalGridScenarioHelper::GetWrappedPosition).
+ *
+ * Each copy of a base station is a Node with a ConstantPositionMobilityModel,
+ * created when the base station is added, so that the channel models, that
+ * key their state (e.g., the channel condition, or the channel matrix) by
+ * node, see each copy as a different node. The copies are in the NodeList,
+ * but they do not have devices.
+ *
+ * The model is used by the wrappers of the channel models:
+ * WrapAroundPropagationLossModel, WrapAroundChannelConditionModel and
+ * WrapAroundSpectrumPropagationLossModel.
+ */
+class WrapAroundModel : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief WrapAroundModel constructor
+     */
+    WrapAroundModel();
+
+    /**
+     * \brief ~WrapAroundModel
+     */
+    ~WrapAroundModel() override;
+
+    /**
+     * \brief Set the offsets of the copies of the layout
+     * \param offsets the offsets, in meters
+     *
+     * It must be called before adding the base stations.
+     */
+    void SetOffsets(const std::vector<Vector>& offsets);
+
+    /**
+     * \brief Add a base station, and create its copies
+     * \param bs the base station, with its mobility model
+     */
+    void AddBaseStation(const Ptr<Node>& bs);
+
+    /**
+     * \brief Get the number of base stations added
+     * \return the number of base stations
+     */
+    std::size_t GetNumBaseStations() const;
+
+    /**
+     * \brief Get the mobility models that give the wrapped geometry of a link
+     * \param a the mobility model of the first node
+     * \param b the mobility model of the second node
+     * \return a and b, with the base station replaced by its copy that is the
+     * closest to the other node
+     *
+     * If both nodes are base stations, the one with the lowest node id is
+     * replaced, so that the two directions of a link use the same copy.
+     * The links without base stations are not changed.
+     */
+    std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>> GetWrappedLink(
+        const Ptr<MobilityModel>& a,
+        const Ptr<MobilityModel>& b) const;
+
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object
+     */
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief A base station, and its copies
+     */
+    struct BaseStation
+    {
+        Ptr<MobilityModel> m_mobility;            //!< Mobility model of the base station
+        uint32_t m_nodeId{0};                     //!< Node id of the base station
+        std::vector<Ptr<MobilityModel>> m_copies; //!< Copies, one for each offset
+    };
+
+    /**
+     * \brief Get the copy of a base station that is the closest to another node
+     * \param bs the base station
+     * \param other the mobility model of the other node
+     * \return the mobility model of the closest copy (or of the base station)
+     */
+    Ptr<MobilityModel> GetClosestCopy(const BaseStation& bs, const Ptr<MobilityModel>& other) const;
+
+    std::vector<Vector> m_offsets; //!< Offsets of the copies of the layout
+    std::unordered_map<const MobilityModel*, BaseStation>
+        m_baseStations; //!< Base stations, by their mobility model
+};
+
+} // namespace ns3
+
+#endif // WRAP_AROUND_MODEL_H
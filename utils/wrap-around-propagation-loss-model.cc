@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "wrap-around-propagation-loss-model.h"
+
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WrapAroundPropagationLossModel");
+NS_OBJECT_ENSURE_REGISTERED(WrapAroundPropagationLossModel);
+
+TypeId
+WrapAroundPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::WrapAroundPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Nr")
+            .AddConstructor<WrapAroundPropagationLossModel>()
+            .AddAttribute("PropagationLossModel",
+                          "The propagation loss model evaluated on the wrapped geometry",
+                          PointerValue(),
+                          MakePointerAccessor(
+                              &WrapAroundPropagationLossModel::SetPropagationLossModel,
+                              &WrapAroundPropagationLossModel::GetPropagationLossModel),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("WrapAroundModel",
+                          "The copies of the base stations",
+                          PointerValue(),
+                          MakePointerAccessor(&WrapAroundPropagationLossModel::m_wrapAround),
+                          MakePointerChecker<WrapAroundModel>());
+    return tid;
+}
+
+WrapAroundPropagationLossModel::WrapAroundPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WrapAroundPropagationLossModel::~WrapAroundPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+WrapAroundPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_propagationLossModel = nullptr;
+    m_wrapAround = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+WrapAroundPropagationLossModel::SetPropagationLossModel(const Ptr<PropagationLossModel>& model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_propagationLossModel = model;
+}
+
+Ptr<PropagationLossModel>
+WrapAroundPropagationLossModel::GetPropagationLossModel() const
+{
+    return m_propagationLossModel;
+}
+
+Ptr<PropagationLossModel>
+WrapAroundPropagationLossModel::Unwrap(const Ptr<PropagationLossModel>& model)
+{
+    auto wrapAround = DynamicCast<WrapAroundPropagationLossModel>(model);
+    return wrapAround != nullptr ? wrapAround->GetPropagationLossModel() : model;
+}
+
+void
+WrapAroundPropagationLossModel::SetWrapAroundModel(const Ptr<WrapAroundModel>& wrapAround)
+{
+    NS_LOG_FUNCTION(this << wrapAround);
+    m_wrapAround = wrapAround;
+}
+
+double
+WrapAroundPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                              Ptr<MobilityModel> a,
+                                              Ptr<MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b);
+    NS_ASSERT_MSG(m_propagationLossModel != nullptr, "The wrapped model is not set");
+    NS_ASSERT_MSG(m_wrapAround != nullptr, "The wrap-around model is not set");
+
+    const auto [wrappedA, wrappedB] = m_wrapAround->GetWrappedLink(a, b);
+    return m_propagationLossModel->CalcRxPower(txPowerDbm, wrappedA, wrappedB);
+}
+
+int64_t
+WrapAroundPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    return m_propagationLossModel != nullptr ? m_propagationLossModel->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
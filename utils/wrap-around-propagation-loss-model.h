@@ -0,0 +1,94 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef WRAP_AROUND_PROPAGATION_LOSS_MODEL_H
+#define WRAP_AROUND_PROPAGATION_LOSS_MODEL_H
+
+#include "wrap-around-model.h"
+
+#include "ns3/propagation-loss-model.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup nr-utils
+ * \brief A propagation loss model that evaluates another model on the
+ * wrapped geometry of each link
+ *
+ * The base station of each link is replaced by its copy that is the closest
+ * to the other node (see WrapAroundModel::GetWrappedLink), before calling the
+ * wrapped model, so that the distance, the channel condition and the
+ * shadowing are the ones of the closest copy.
+ *
+ * \see WrapAroundModel
+ */
+class WrapAroundPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief WrapAroundPropagationLossModel constructor
+     */
+    WrapAroundPropagationLossModel();
+
+    /**
+     * \brief ~WrapAroundPropagationLossModel
+     */
+    ~WrapAroundPropagationLossModel() override;
+
+    /**
+     * \brief Set the wrapped propagation loss model
+     * \param model the propagation loss model
+     */
+    void SetPropagationLossModel(const Ptr<PropagationLossModel>& model);
+
+    /**
+     * \brief Get the wrapped propagation loss model
+     * \return the propagation loss model
+     */
+    Ptr<PropagationLossModel> GetPropagationLossModel() const;
+
+    /**
+     * \brief Set the wrap-around model
+     * \param wrapAround the wrap-around model
+     */
+    void SetWrapAroundModel(const Ptr<WrapAroundModel>& wrapAround);
+
+    /**
+     * \brief Get the model that a propagation loss model wraps
+     * \param model the propagation loss model, that can be a WrapAroundPropagationLossModel
+     * \return the wrapped model, or model if it does not wrap another model
+     *
+     * It gives the 3GPP model of a channel, whether the wrap-around is applied or not.
+     */
+    static Ptr<PropagationLossModel> Unwrap(const Ptr<PropagationLossModel>& model);
+
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object
+     */
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    Ptr<PropagationLossModel> m_propagationLossModel; //!< The wrapped model
+    Ptr<WrapAroundModel> m_wrapAround;                //!< The copies of the base stations
+};
+
+} // namespace ns3
+
+#endif // WRAP_AROUND_PROPAGATION_LOSS_MODEL_H
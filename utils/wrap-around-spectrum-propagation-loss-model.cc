@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "wrap-around-spectrum-propagation-loss-model.h"
+
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/spectrum-signal-parameters.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WrapAroundSpectrumPropagationLossModel");
+NS_OBJECT_ENSURE_REGISTERED(WrapAroundSpectrumPropagationLossModel);
+
+TypeId
+WrapAroundSpectrumPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::WrapAroundSpectrumPropagationLossModel")
+            .SetParent<PhasedArraySpectrumPropagationLossModel>()
+            .SetGroupName("Nr")
+            .AddConstructor<WrapAroundSpectrumPropagationLossModel>()
+            .AddAttribute(
+                "SpectrumPropagationLossModel",
+                "The spectrum propagation loss model evaluated on the wrapped geometry",
+                PointerValue(),
+                MakePointerAccessor(
+                    &WrapAroundSpectrumPropagationLossModel::SetSpectrumPropagationLossModel,
+                    &WrapAroundSpectrumPropagationLossModel::GetSpectrumPropagationLossModel),
+                MakePointerChecker<PhasedArraySpectrumPropagationLossModel>())
+            .AddAttribute(
+                "WrapAroundModel",
+                "The copies of the base stations",
+                PointerValue(),
+                MakePointerAccessor(&WrapAroundSpectrumPropagationLossModel::m_wrapAround),
+                MakePointerChecker<WrapAroundModel>());
+    return tid;
+}
+
+WrapAroundSpectrumPropagationLossModel::WrapAroundSpectrumPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WrapAroundSpectrumPropagationLossModel::~WrapAroundSpectrumPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+WrapAroundSpectrumPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_spectrumPropagationLossModel = nullptr;
+    m_wrapAround = nullptr;
+    PhasedArraySpectrumPropagationLossModel::DoDispose();
+}
+
+void
+WrapAroundSpectrumPropagationLossModel::SetSpectrumPropagationLossModel(
+    const Ptr<PhasedArraySpectrumPropagationLossModel>& model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_spectrumPropagationLossModel = model;
+}
+
+Ptr<PhasedArraySpectrumPropagationLossModel>
+WrapAroundSpectrumPropagationLossModel::GetSpectrumPropagationLossModel() const
+{
+    return m_spectrumPropagationLossModel;
+}
+
+Ptr<PhasedArraySpectrumPropagationLossModel>
+WrapAroundSpectrumPropagationLossModel::Unwrap(
+    const Ptr<PhasedArraySpectrumPropagationLossModel>& model)
+{
+    auto wrapAround = DynamicCast<WrapAroundSpectrumPropagationLossModel>(model);
+    return wrapAround != nullptr ? wrapAround->GetSpectrumPropagationLossModel() : model;
+}
+
+std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>
+WrapAroundSpectrumPropagationLossModel::GetWrappedLink(
+    const Ptr<const PhasedArraySpectrumPropagationLossModel>& model,
+    const Ptr<MobilityModel>& a,
+    const Ptr<MobilityModel>& b)
+{
+    auto wrapAround = DynamicCast<const WrapAroundSpectrumPropagationLossModel>(model);
+    if (wrapAround == nullptr || wrapAround->m_wrapAround == nullptr)
+    {
+        return {a, b};
+    }
+    return wrapAround->m_wrapAround->GetWrappedLink(a, b);
+}
+
+void
+WrapAroundSpectrumPropagationLossModel::SetWrapAroundModel(const Ptr<WrapAroundModel>& wrapAround)
+{
+    NS_LOG_FUNCTION(this << wrapAround);
+    m_wrapAround = wrapAround;
+}
+
+Ptr<SpectrumValue>
+WrapAroundSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_spectrumPropagationLossModel != nullptr, "The wrapped model is not set");
+    NS_ASSERT_MSG(m_wrapAround != nullptr, "The wrap-around model is not set");
+
+    const auto [wrappedA, wrappedB] =
+        m_wrapAround->GetWrappedLink(ConstCast<MobilityModel>(a), ConstCast<MobilityModel>(b));
+    return m_spectrumPropagationLossModel->CalcRxPowerSpectralDensity(params,
+                                                                      wrappedA,
+                                                                      wrappedB,
+                                                                      aPhasedArrayModel,
+                                                                      bPhasedArrayModel);
+}
+
+int64_t
+WrapAroundSpectrumPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    return m_spectrumPropagationLossModel != nullptr
+               ? m_spectrumPropagationLossModel->AssignStreams(stream)
+               : 0;
+}
+
+} // namespace ns3
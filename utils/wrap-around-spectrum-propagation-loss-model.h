@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2023 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef WRAP_AROUND_SPECTRUM_PROPAGATION_LOSS_MODEL_H
+#define WRAP_AROUND_SPECTRUM_PROPAGATION_LOSS_MODEL_H
+
+#include "wrap-around-model.h"
+
+#include "ns3/phased-array-spectrum-propagation-loss-model.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup nr-utils
+ * \brief A spectrum propagation loss model that evaluates another model on
+ * the wrapped geometry of each link
+ *
+ * The base station of each link is replaced by its copy that is the closest
+ * to the other node (see WrapAroundModel::GetWrappedLink), before calling the
+ * wrapped model (e.g., a ThreeGppSpectrumPropagationLossModel), so that the
+ * fast fading and the beamforming gain are the ones of the closest copy. The
+ * antenna arrays are the ones of the real nodes.
+ *
+ * The algorithms that need the ThreeGppSpectrumPropagationLossModel of the
+ * channel (e.g., the realistic beamforming) are not supported.
+ *
+ * \see WrapAroundModel
+ */
+class WrapAroundSpectrumPropagationLossModel : public PhasedArraySpectrumPropagationLossModel
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return the type id of the object
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief WrapAroundSpectrumPropagationLossModel constructor
+     */
+    WrapAroundSpectrumPropagationLossModel();
+
+    /**
+     * \brief ~WrapAroundSpectrumPropagationLossModel
+     */
+    ~WrapAroundSpectrumPropagationLossModel() override;
+
+    /**
+     * \brief Set the wrapped spectrum propagation loss model
+     * \param model the spectrum propagation loss model
+     */
+    void SetSpectrumPropagationLossModel(const Ptr<PhasedArraySpectrumPropagationLossModel>& model);
+
+    /**
+     * \brief Get the wrapped spectrum propagation loss model
+     * \return the spectrum propagation loss model
+     */
+    Ptr<PhasedArraySpectrumPropagationLossModel> GetSpectrumPropagationLossModel() const;
+
+    /**
+     * \brief Set the wrap-around model
+     * \param wrapAround the wrap-around model
+     */
+    void SetWrapAroundModel(const Ptr<WrapAroundModel>& wrapAround);
+
+    /**
+     * \brief Get the model that a spectrum propagation loss model wraps
+     * \param model the spectrum propagation loss model, that can be a
+     * WrapAroundSpectrumPropagationLossModel
+     * \return the wrapped model, or model if it does not wrap another model
+     *
+     * It gives the 3GPP model of a channel, whether the wrap-around is applied or not.
+     */
+    static Ptr<PhasedArraySpectrumPropagationLossModel> Unwrap(
+        const Ptr<PhasedArraySpectrumPropagationLossModel>& model);
+
+    /**
+     * \brief Get the mobility models on which a spectrum propagation loss model
+     * evaluates a link
+     * \param model the spectrum propagation loss model, that can be a
+     * WrapAroundSpectrumPropagationLossModel
+     * \param a the mobility model of the first node
+     * \param b the mobility model of the second node
+     * \return a and b, with the base station replaced by its closest copy if
+     * model applies the wrap-around
+     *
+     * The channel matrix that the wrapped model uses for the link, and the
+     * direction of the link, are the ones of the returned mobility models.
+     */
+    static std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>> GetWrappedLink(
+        const Ptr<const PhasedArraySpectrumPropagationLossModel>& model,
+        const Ptr<MobilityModel>& a,
+        const Ptr<MobilityModel>& b);
+
+  protected:
+    /**
+     * \brief DoDispose method inherited from Object
+     */
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Computes the received PSD with the wrapped model, on the wrapped geometry
+     * \param params tx parameters
+     * \param a first node mobility model
+     * \param b second node mobility model
+     * \param aPhasedArrayModel the antenna array of the first node
+     * \param bPhasedArrayModel the antenna array of the second node
+     * \return the received PSD
+     */
+    Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity(
+        Ptr<const SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    Ptr<PhasedArraySpectrumPropagationLossModel>
+        m_spectrumPropagationLossModel; //!< The wrapped model
+    Ptr<WrapAroundModel> m_wrapAround;  //!< The copies of the base stations
+};
+
+} // namespace ns3
+
+#endif // WRAP_AROUND_SPECTRUM_PROPAGATION_LOSS_MODEL_H